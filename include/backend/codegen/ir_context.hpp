@@ -20,6 +20,7 @@
 #include <stack>
 #include <optional>
 #include "frontend/checker/type.hpp"
+#include "frontend/checker/scope_table.hpp"
 #include "frontend/ast/ast.hpp"
 
 // Forward declarations
@@ -49,86 +50,76 @@ struct SymbolInfo {
 
 /**
  * Tabela de símbolos com escopos aninhados
+ *
+ * Uma ScopeTable indexada por SymbolId: a busca é direta (sem percorrer os
+ * escopos) e abrir/fechar escopo não aloca. As versões por string internam o
+ * nome; os ponteiros devolvidos valem até o escopo do símbolo ser fechado.
  */
 class SymbolTable {
 private:
-    struct Scope {
-        std::unordered_map<std::string, SymbolInfo> symbols;
-        std::shared_ptr<Scope> parent;
-        
-        Scope(std::shared_ptr<Scope> p = nullptr) : parent(p) {}
-    };
-
-    std::shared_ptr<Scope> current_scope;
+    ScopeTable<SymbolInfo> table;
 
 public:
-    SymbolTable() : current_scope(std::make_shared<Scope>()) {}
-
     /**
      * Entra em um novo escopo
      */
     void push_scope() {
-        current_scope = std::make_shared<Scope>(current_scope);
+        table.push_scope();
     }
 
     /**
-     * Sai do escopo atual
+     * Sai do escopo atual (o escopo global nunca é fechado)
      */
     void pop_scope() {
-        if (current_scope && current_scope->parent) {
-            current_scope = current_scope->parent;
-        }
+        table.pop_scope();
     }
 
     /**
      * Define um símbolo no escopo atual
      */
-    void define_symbol(const std::string& name, const SymbolInfo& info) {
-        current_scope->symbols[name] = info;
+    const SymbolInfo& define_symbol(SymbolId symbol, const SymbolInfo& info) {
+        return table.define(symbol, info).value;
+    }
+
+    const SymbolInfo& define_symbol(const std::string& name, const SymbolInfo& info) {
+        return define_symbol(intern_symbol(name), info);
     }
 
     /**
-     * Atualiza um símbolo existente (procura em todos os escopos)
+     * Atualiza um símbolo existente (no escopo onde está visível)
      */
     bool update_symbol(const std::string& name, const SymbolInfo& info) {
-        auto scope = current_scope;
-        while (scope) {
-            if (scope->symbols.find(name) != scope->symbols.end()) {
-                scope->symbols[name] = info;
-                return true;
-            }
-            scope = scope->parent;
-        }
-        return false;
+        auto* binding = table.find(intern_symbol(name));
+        if (!binding) return false;
+        binding->value = info;
+        return true;
     }
 
     /**
-     * Busca um símbolo (procura em todos os escopos)
+     * Busca um símbolo visível; nullptr se não existir
      */
-    std::optional<SymbolInfo> lookup_symbol(const std::string& name) const {
-        auto scope = current_scope;
-        while (scope) {
-            auto it = scope->symbols.find(name);
-            if (it != scope->symbols.end()) {
-                return it->second;
-            }
-            scope = scope->parent;
-        }
-        return std::nullopt;
+    const SymbolInfo* lookup_symbol(SymbolId symbol) const {
+        auto* binding = table.find(symbol);
+        return binding ? &binding->value : nullptr;
+    }
+
+    const SymbolInfo* lookup_symbol(const std::string& name) const {
+        return lookup_symbol(intern_symbol(name));
     }
 
     /**
      * Verifica se um símbolo existe no escopo atual (sem procurar nos pais)
      */
     bool exists_in_current_scope(const std::string& name) const {
-        return current_scope->symbols.find(name) != current_scope->symbols.end();
+        auto* binding = table.find(intern_symbol(name));
+        return binding && binding->depth == table.depth();
     }
 
     /**
      * Verifica se um símbolo existe em qualquer escopo
      */
     bool exists(const std::string& name) const {
-        return lookup_symbol(name).has_value();
+        return lookup_symbol(name) != nullptr;
     }
 };
 
@@ -145,7 +136,15 @@ private:
         std::string loop_name;             // Nome identificador do loop
     };
 
+    // Chamada que libera um recurso aberto por um loop (ex.: json_stream_close)
+    struct Cleanup {
+        llvm::Function* function;  // Função em que o recurso foi aberto
+        llvm::Function* callee;
+        llvm::Value* arg;
+    };
+
     std::stack<LoopContext> loop_stack;
+    std::vector<Cleanup> cleanups;
 
 public:
     /**
@@ -210,6 +209,42 @@ public:
         }
         return nullptr;
     }
+
+    /**
+     * Registra a liberação de um recurso que precisa acontecer mesmo se um
+     * `return` sair da função no meio do loop; a saída normal continua
+     * chamando `callee` por conta própria e depois desempilha com pop_cleanup
+     */
+    void push_cleanup(llvm::Function* function, llvm::Function* callee, llvm::Value* arg) {
+        cleanups.push_back({function, callee, arg});
+    }
+
+    void pop_cleanup() {
+        if (!cleanups.empty()) {
+            cleanups.pop_back();
+        }
+    }
+
+    /**
+     * Emite as liberações pendentes de `function`, da mais interna para a mais externa
+     */
+    void emit_cleanups(llvm::IRBuilder<llvm::NoFolder>& builder, llvm::Function* function) const {
+        for (auto it = cleanups.rbegin(); it != cleanups.rend(); ++it) {
+            if (it->function == function) {
+                builder.CreateCall(it->callee, {it->arg});
+            }
+        }
+    }
+};
+
+/**
+ * Registro de uma decisão de paralelização de loop (exibido por --explain-parallel)
+ */
+struct ParallelLoopReport {
+    size_t line;
+    size_t column;
+    bool parallelized;
+    std::string reason;
 };
 
 /**
@@ -257,6 +292,13 @@ private:
     };
     std::vector<GlobalInit> pending_global_inits;
 
+    // Paralelização automática de loops `for` de intervalo
+    bool auto_parallel = false;
+    bool parallel_region = false;   // gerando o corpo extraído de um loop paralelo
+    // Container escrito em [i] -> local do chunk com 1 + maior índice escrito
+    std::unordered_map<std::string, llvm::AllocaInst*> parallel_write_ends;
+    std::vector<ParallelLoopReport> parallel_reports;
+
 public:
     IRGenerationContext(
         llvm::LLVMContext& ctx,
@@ -339,6 +381,24 @@ public:
     llvm::Value* peek_value() { return eval_stack.empty() ? nullptr : eval_stack.back(); }
     bool has_value() const { return !eval_stack.empty(); }
 
+    // Paralelização automática
+    void set_auto_parallel(bool enabled) { auto_parallel = enabled; }
+    bool is_auto_parallel() const { return auto_parallel; }
+    void set_in_parallel_region(bool inside) { parallel_region = inside; }
+    bool in_parallel_region() const { return parallel_region; }
+    void set_parallel_write_end(const std::string& container, llvm::AllocaInst* end) {
+        parallel_write_ends[container] = end;
+    }
+    llvm::AllocaInst* get_parallel_write_end(const std::string& container) const {
+        auto it = parallel_write_ends.find(container);
+        return it == parallel_write_ends.end() ? nullptr : it->second;
+    }
+    void clear_parallel_write_ends() { parallel_write_ends.clear(); }
+    void record_parallel_loop(const PositionData* pos, bool parallelized, const std::string& reason) {
+        parallel_reports.push_back({pos ? pos->line : 0, pos ? pos->col[0] : 0, parallelized, reason});
+    }
+    const std::vector<ParallelLoopReport>& get_parallel_reports() const { return parallel_reports; }
+
     // Checker de tipos
     void set_type_checker(void* checker) { type_checker_ptr = checker; }
     void* get_type_checker() { return type_checker_ptr; }
@@ -388,7 +448,8 @@ public:
     /**
      * Obtém informações de um símbolo
      */
-    std::optional<SymbolInfo> get_symbol_info(const std::string& name);
+    const SymbolInfo* get_symbol_info(const std::string& name);
+    const SymbolInfo* get_symbol_info(SymbolId symbol);
 
     /**
      * Gerenciamento de escopos
@@ -2,6 +2,7 @@
 
 #include "backend/codegen/ir_context.hpp"
 #include "frontend/ast/ast.hpp"
+#include "frontend/ast/operators.hpp"
 #include "frontend/checker/type.hpp"
 #include <llvm/IR/Value.h>
 #include <llvm/IR/Function.h>
@@ -39,13 +40,13 @@ llvm::Value* create_comparison(
     IRGenerationContext& context,
     llvm::Value* lhs,
     llvm::Value* rhs,
-    const std::string& op
+    BinaryOp op
 );
 llvm::Value* create_binary_op(
     IRGenerationContext& context,
     llvm::Value* lhs,
     llvm::Value* rhs,
-    const std::string& op
+    BinaryOp op
 );
 llvm::Value* create_unary_op(
     IRGenerationContext& context,
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "backend/codegen/ir_context.hpp"
+#include "frontend/ast/ast.hpp"
+#include <string>
+#include <vector>
+
+namespace nv {
+
+enum class ReductionKind { Sum, Min, Max };
+
+/**
+ * Variável externa acumulada pelo loop (`+=`/`-=`, ou padrão de min/max:
+ * `if e < r { r = e }`). Cada chunk acumula numa cópia privada e as
+ * parciais são combinadas em ordem de chunk após o loop.
+ */
+struct ReductionInfo {
+    std::string symbol;
+    ReductionKind kind;
+};
+
+/**
+ * Resultado da análise de independência de um `for` de intervalo.
+ * Quando `parallel` é falso, `reason` explica o que impediu a paralelização.
+ */
+struct ParallelLoopPlan {
+    bool parallel = false;
+    std::string reason;
+    std::vector<std::string> captures;        // locais externos usados no corpo (ordem estável)
+    std::vector<ReductionInfo> reductions;
+    std::vector<std::string> indexed_writes;  // containers escritos apenas em [i]
+    std::vector<std::string> indexed_reads;   // containers lidos em índices arbitrários
+};
+
+/**
+ * Prova que as iterações de `loop` são independentes: sem escritas entre
+ * iterações, escritas em containers apenas no índice da indução e reduções
+ * reconhecidas. Consulta a tabela de símbolos de `ctx` para distinguir
+ * variáveis externas das declaradas no corpo.
+ */
+ParallelLoopPlan analyze_parallel_loop(const ForStmtNode& loop, IRGenerationContext& ctx);
+
+} // namespace nv
@@ -2,6 +2,7 @@
 #define RUNTIME_H
 
 #include "prototypes.h"
+#include <stddef.h>
 #include <stdint.h>
 
 /* ============================================================= */
@@ -13,6 +14,9 @@ void create_int(Value* out, int32_t v);
 void create_float(Value* out, double v);
 void create_bool(Value* out, int b);
 void create_str(Value* out, const char* s);
+// Sem cópia: `s` precisa viver tanto quanto o Value (strings são imutáveis
+// e nunca liberadas pelo runtime; usado para referenciar buffers mapeados)
+void create_str_borrowed(Value* out, const char* s);
 
 // Criar estruturas de dados
 void create_array(Value* out, int size);
@@ -47,6 +51,24 @@ void vector_pop_method(Value* out, Value* self);
 void vector_get_method(Value* out, Value* self, int index);
 void vector_set_method(Value* self, int index, const Value* value);
 
+// Callback gerado pelo compilador para uma função do usuário: out = fn(a[, b])
+typedef void (*nv_value_fn)(Value* out, const Value* a, const Value* b);
+
+// Métodos data-parallel (aceitam vector e array). `parallel` = 0 quando o
+// compilador não provou que o callback é livre de efeitos colaterais.
+void vector_map_method(Value* out, Value* self, nv_value_fn fn, int32_t parallel);
+void vector_filter_method(Value* out, Value* self, nv_value_fn fn, int32_t parallel);
+// Sempre serial: `fn` pode ser qualquer função de dois argumentos
+void vector_reduce_method(Value* out, Value* self, nv_value_fn fn, const Value* init);
+void vector_sort_method(Value* out, Value* self);
+void vector_sum_method(Value* out, Value* self);
+void vector_min_method(Value* out, Value* self);
+void vector_max_method(Value* out, Value* self);
+// Operações numéricas sobre os kernels SIMD (resultado float se houver float)
+void vector_dot_method(Value* out, Value* self, const Value* other);
+void vector_scale_method(Value* out, Value* self, const Value* k);
+void vector_add_method(Value* out, Value* self, const Value* other);
+
 /* ============================================================= */
 /*                    MÉTODOS DE MAP                             */
 /* ============================================================= */
@@ -60,6 +82,8 @@ void map_set_method(Value* self, const char* key, Value value);
 
 Value array_get_index(Array* arr, int index);
 void array_set_index(Array* arr, int index, Value value);
+// Grava em [index] < capacity sem alterar o size (escritas de loops paralelos)
+void array_set_reserved(Array* arr, int index, Value value);
 void array_get_index_v(Value* out, Value* self, int index);
 void array_set_index_v(Value* self, int index, const Value* value);
 
@@ -81,6 +105,8 @@ void vector_set_impl(Vector* v, int i, Value val);
 
 Value map_get_impl(Map* m, const char* key);
 void map_set_impl(Map* m, const char* key, Value val);
+// Guarda `key` sem copiar; o chamador garante que a chave vive tanto quanto o map
+void map_set_borrowed(Map* m, const char* key, Value val);
 
 /* ============================================================= */
 /*                    I/O E PRINT                               */
@@ -88,13 +114,55 @@ void map_set_impl(Map* m, const char* key, Value val);
 
 void nv_write(Value* v);
 void nv_write_no_nl(Value* v);
+// Limites do print (0 = sem limite): profundidade de containers aninhados e
+// elementos por container. Padrão: NV_PRINT_DEPTH (64) e NV_PRINT_WIDTH (0)
+void nv_print_set_limits(int32_t max_depth, int32_t max_width);
 
 /* ============================================================= */
 /*                    OPERAÇÕES JSON                             */
 /* ============================================================= */
 
+// Abre `filename` relativo a nv_base_dir (se houver), com fallback para o
+// caminho como foi passado; -1 em erro
+int nv_json_open(const char* filename, int flags, int mode);
+
 void json_load(Value* out, const char* filename);
 
+// Leitura incremental de NDJSON ou de um array de topo, um registro por vez.
+// Sem `keep`, o registro só vale até a próxima chamada (a arena é reaproveitada).
+void* json_stream_open(const char* filename);
+int32_t json_stream_next(void* stream, Value* out, int32_t keep);
+void json_stream_close(void* stream);
+// Versão materializada: todos os registros em um vector
+void json_stream(Value* out, const char* filename);
+
+// Serialização. `indent` > 0 ativa pretty-printing com esse número de espaços.
+// NaN/infinito, ciclos e tipos sem representação JSON viram null.
+char* json_stringify(Value* v, int32_t indent);
+// Escreve direto no arquivo em blocos de 64 KB ("-" = stdout); 0 em erro de I/O
+int32_t json_dump(Value* v, const char* filename, int32_t indent);
+
+/* ============================================================= */
+/*                    OPERAÇÕES CSV                              */
+/* ============================================================= */
+
+// Carrega um CSV como map nome da coluna -> vector. `options` (map, opcional):
+// "delimiter" (string, padrão ",") e "header" (bool, padrão true; sem cabeçalho
+// as colunas se chamam "0", "1", ...). Cada coluna tem um único tipo inferido
+// (int, float ou string); células numéricas vazias viram null.
+void csv_load(Value* out, const char* filename, Value* options);
+
+/* ============================================================= */
+/*                    SNAPSHOTS BINÁRIOS                         */
+/* ============================================================= */
+
+// Grafo de Values completo (arrays, tuplas, ciclos, tipos customizados pelo
+// nome registrado) em um arquivo binário versionado; 0 em erro de I/O
+int32_t snapshot_save(Value* v, const char* filename);
+// Mapeia o arquivo e materializa a raiz ou, com `key`, só essa entrada do map
+// raiz. Strings apontam para o mapeamento. Null se o arquivo é inválido.
+void snapshot_load(Value* out, const char* filename, const char* key);
+
 /* ============================================================= */
 /*                    ACESSO DINÂMICO                           */
 /* ============================================================= */
@@ -134,6 +202,119 @@ TypeInfo* get_value_type_info(const Value* v);
 // Imprimir informações de tipo (para debug)
 void print_type_info(const Value* v);
 
+/* ============================================================= */
+/*                    FORMATAÇÃO NUMÉRICA                        */
+/* ============================================================= */
+
+// Tamanho suficiente para qualquer saída dos formatadores (inclui o '\0')
+#define NV_FORMAT_BUFFER_SIZE 32
+
+// Escrevem em `buf` terminado em '\0' e retornam o comprimento
+int nv_format_int64(int64_t v, char* buf);
+int nv_format_uint64(uint64_t v, char* buf);
+// Menor representação decimal que faz round-trip; "inf", "nan", "-0"
+int nv_format_double(double d, char* buf);
+
+/* ============================================================= */
+/*                    SAÍDA BUFERIZADA                           */
+/* ============================================================= */
+
+// Toda escrita do runtime em stdout passa por um buffer de 64 KB
+void nv_out_write(const char* data, size_t len);
+void nv_out_puts(const char* s);
+void nv_out_putc(char c);
+// Escreve '\n'; em terminal também esvazia o buffer
+void nv_out_newline(void);
+void nv_out_flush(void);
+// Esvazia o buffer do runtime e os streams do stdio (o código gerado chama antes de _exit)
+void nv_flush_all(void);
+
+/* ============================================================= */
+/*                    ENTRADA BUFERIZADA                         */
+/* ============================================================= */
+
+// Próxima linha de stdin sem o '\n', como view no buffer de entrada
+// (válida até a próxima leitura); 0 em EOF
+int32_t nv_in_next_line(char** line);
+// read(): cópia da próxima linha, ou NULL em EOF
+char* nv_read(void);
+// read_lines(): vector com as linhas restantes de stdin
+void nv_read_lines(Value* out);
+
+/* ============================================================= */
+/*                    LOOPS PARALELOS                            */
+/* ============================================================= */
+
+// Limite de chunks: o compilador reserva um slot de redução parcial por chunk
+#define NV_PARALLEL_MAX_CHUNKS 1024
+
+// Corpo de loop extraído pelo compilador: executa as iterações [lo, hi)
+// e grava as reduções parciais no slot `chunk`
+typedef void (*nv_parallel_body)(int32_t lo, int32_t hi, int32_t chunk, void* env);
+
+// Quantidade de chunks para o intervalo [lo, hi) (1 = executar serialmente)
+int32_t nv_parallel_chunks(int32_t lo, int32_t hi);
+
+// Executa os chunks no pool de threads e retorna quando todos terminarem
+void nv_parallel_for(int32_t lo, int32_t hi, int32_t chunks, nv_parallel_body body, void* env);
+
+// Garante capacity >= `size` em array/vector antes de escritas concorrentes
+// em [i]; o size não muda
+void nv_parallel_reserve(Value* self, int32_t size);
+
+// Escrita em [index] dentro de um chunk: não realoca nem altera o size
+void nv_parallel_store(Value* self, int32_t index, const Value* value);
+// Leitura de [index] < capacity: enxerga o que o chunk já escreveu além do size
+void nv_parallel_load(Value* out, Value* self, int32_t index);
+
+// Depois do loop: size = max(size, written_end[c]) para c em [0, chunks),
+// onde written_end[c] é 1 + o maior índice escrito pelo chunk c (0 se nenhum)
+void nv_parallel_commit(Value* self, const int32_t* written_end, int32_t chunks);
+
+// Verifica se dois arrays/vectors compartilham o mesmo armazenamento
+int32_t nv_same_storage(Value* a, Value* b);
+
+/* ============================================================= */
+/*                    KERNELS SIMD                               */
+/* ============================================================= */
+
+// Nível escolhido via CPUID: "scalar", "sse4.2", "avx2" ou "avx512"
+const char* nv_simd_level(void);
+
+// Kernels sobre buffers contíguos; min/max exigem n > 0
+double nv_simd_sum_f64(const double* x, int64_t n);
+int64_t nv_simd_sum_i64(const int64_t* x, int64_t n);
+double nv_simd_dot_f64(const double* a, const double* b, int64_t n);
+double nv_simd_min_f64(const double* x, int64_t n);
+double nv_simd_max_f64(const double* x, int64_t n);
+void nv_simd_scale_f64(double* out, const double* x, double k, int64_t n);
+void nv_simd_add_f64(double* out, const double* a, const double* b, int64_t n);
+
+// Classificação de blocos de 64 bytes para o estágio 1 do parser JSON
+// (bit i de cada máscara = byte i do bloco)
+typedef struct {
+    uint64_t quote;       // '"'
+    uint64_t backslash;   // '\\'
+    uint64_t op;          // { } [ ] : ,
+    uint64_t space;       // ' ' \t \n \r
+    uint64_t control;     // bytes < 0x20 (proibidos dentro de strings)
+    uint64_t high;        // bytes >= 0x80 (exigem validação UTF-8)
+} NvJsonBlock;
+void nv_simd_json_classify(const uint8_t* data, size_t nblocks, NvJsonBlock* out);
+
+// Mesmo formato para o loader CSV: separador de campo, '\n' e '"'
+typedef struct {
+    uint64_t delim;
+    uint64_t newline;
+    uint64_t quote;
+} NvCsvBlock;
+void nv_simd_csv_classify(const uint8_t* data, size_t nblocks, uint8_t delim, NvCsvBlock* out);
+
+// Reduções de `for i in lo..hi { acc += a[i] }` / `acc += a[i] * b[i]` reconhecidas
+// pelo compilador: aritmética inteira módulo 2^32, como o loop escalar em i32
+int32_t nv_simd_sum_values(Value* self, int32_t lo, int32_t hi);
+int32_t nv_simd_dot_values(Value* a, Value* b, int32_t lo, int32_t hi);
+
 /* ============================================================= */
 /*                    GARBAGE COLLECTION                         */
 /* ============================================================= */
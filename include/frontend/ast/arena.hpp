@@ -0,0 +1,131 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// Memória da AST.
+//
+// Os nós são alocados por bump em blocos de 64 KiB alinhados ao próprio
+// tamanho, então o bloco de qualquer nó é encontrado mascarando o endereço.
+// Cada bloco conta as alocações vivas (mais uma referência enquanto é o bloco
+// corrente de uma arena): liberar um nó é só um decremento, e o bloco volta
+// ao sistema quando o último nó dele morre. A posse continua sendo
+// std::unique_ptr, mas sem um malloc/free por nó.
+//
+// Parser::produce_ast abre um AstArena::Scope por módulo, de modo que os nós
+// de um módulo ficam contíguos; nós criados fora de um escopo (checker,
+// codegen) vão para a arena padrão da thread. As posições (PositionData) usam
+// uma região separada da arena, fora dos blocos que o checker e o codegen
+// percorrem.
+//
+// Uma arena só aloca na thread do seu escopo; liberar é seguro de qualquer thread.
+class AstArena {
+public:
+    static constexpr size_t kChunkSize = 64 * 1024;
+
+    AstArena() = default;
+    AstArena(const AstArena&) = delete;
+    AstArena& operator=(const AstArena&) = delete;
+
+    ~AstArena() {
+        retire(nodes_);
+        retire(positions_);
+    }
+
+    void* allocate_node(size_t size) {
+        ++node_count_;
+        return allocate(nodes_, size, alignof(std::max_align_t));
+    }
+
+    // Nós alocados por esta arena (estatística para benchmarks)
+    size_t node_count() const { return node_count_; }
+
+    void* allocate_position(size_t size) {
+        return allocate(positions_, size, alignof(uint32_t));
+    }
+
+    static void deallocate(void* p) noexcept {
+        if (!p) return;
+        auto address = reinterpret_cast<uintptr_t>(p) & ~static_cast<uintptr_t>(kChunkSize - 1);
+        release(reinterpret_cast<Chunk*>(address));
+    }
+
+    // Arena onde os nós criados nesta thread são alocados
+    static AstArena& current() {
+        if (current_) return *current_;
+        thread_local AstArena fallback;
+        return fallback;
+    }
+
+    class Scope {
+    public:
+        explicit Scope(AstArena& arena) : previous_(current_) { current_ = &arena; }
+        ~Scope() { current_ = previous_; }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        AstArena* previous_;
+    };
+
+private:
+    struct alignas(std::max_align_t) Chunk {
+        std::atomic<size_t> refs;
+    };
+
+    struct Region {
+        Chunk* chunk = nullptr;
+        char* cursor = nullptr;
+        char* end = nullptr;
+    };
+
+    static Chunk* new_chunk(size_t bytes) {
+        void* memory = std::aligned_alloc(kChunkSize, bytes);
+        if (!memory) throw std::bad_alloc();
+        return new (memory) Chunk{{1}};
+    }
+
+    static void release(Chunk* chunk) noexcept {
+        if (chunk->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            chunk->~Chunk();
+            std::free(chunk);
+        }
+    }
+
+    static void retire(Region& region) noexcept {
+        if (region.chunk) release(region.chunk);
+        region = Region{};
+    }
+
+    static void* allocate(Region& region, size_t size, size_t align) {
+        size = (size + align - 1) & ~(align - 1);
+        char* p = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(region.cursor) + align - 1) & ~(align - 1));
+        if (region.chunk && p + size <= region.end) {
+            region.cursor = p + size;
+            region.chunk->refs.fetch_add(1, std::memory_order_relaxed);
+            return p;
+        }
+
+        // Alocações maiores que um bloco ganham um bloco próprio (múltiplo de
+        // kChunkSize, com o cabeçalho nos primeiros 64 KiB como nos demais)
+        if (size > kChunkSize / 4) {
+            size_t bytes = (sizeof(Chunk) + size + kChunkSize - 1) & ~(kChunkSize - 1);
+            Chunk* own = new_chunk(bytes);
+            return reinterpret_cast<char*>(own) + sizeof(Chunk);
+        }
+
+        retire(region);
+        region.chunk = new_chunk(kChunkSize);
+        region.cursor = reinterpret_cast<char*>(region.chunk) + sizeof(Chunk);
+        region.end = reinterpret_cast<char*>(region.chunk) + kChunkSize;
+        return allocate(region, size, align);
+    }
+
+    Region nodes_;
+    Region positions_;
+    size_t node_count_ = 0;
+
+    static inline thread_local AstArena* current_ = nullptr;
+};
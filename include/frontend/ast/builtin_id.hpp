@@ -0,0 +1,114 @@
+#pragma once
+#include "symbol.hpp"
+#include <cstdint>
+#include <initializer_list>
+#include <unordered_map>
+#include <utility>
+
+// Funções e métodos com lowering próprio no codegen. Cada CallExprNode guarda
+// o id do que chama (resolvido pelo checker a partir do SymbolId dos nomes) e
+// o codegen despacha com switch; um builtin novo é uma entrada aqui e um case lá.
+enum class BuiltinId : uint8_t {
+    Unresolved,  // ainda não consultado
+    None,        // chamada comum
+    // Funções livres
+    Write, Read, ReadLines,
+    // Objetos builtin
+    JsonLoad, JsonStream, JsonStringify, JsonDump,
+    CsvLoad,
+    SnapshotSave, SnapshotLoad,
+    // Métodos de string
+    StringToUpperCase, StringReplace, StringIncludes,
+    // Métodos de vector
+    VectorPush, VectorPop, VectorGet, VectorSet,
+    VectorMap, VectorFilter, VectorReduce,
+    VectorSort, VectorSum, VectorMin, VectorMax,
+    VectorDot, VectorScale, VectorAdd,
+};
+
+enum class BuiltinObject : uint8_t { None, Json, Csv, Snapshot };
+
+namespace builtin_ids {
+    template <typename Id>
+    using Table = std::unordered_map<SymbolId, Id>;
+
+    template <typename Id>
+    Table<Id> make_table(std::initializer_list<std::pair<const char*, Id>> entries) {
+        Table<Id> table;
+        for (const auto& [name, id] : entries) table.emplace(intern_symbol(name), id);
+        return table;
+    }
+
+    template <typename Id>
+    Id lookup(const Table<Id>& table, SymbolId name, Id missing) {
+        auto it = table.find(name);
+        return it == table.end() ? missing : it->second;
+    }
+}
+
+// write(...), read(...), read_lines()
+inline BuiltinId builtin_function_id(SymbolId name) {
+    static const auto table = builtin_ids::make_table<BuiltinId>({
+        {"write", BuiltinId::Write},
+        {"read", BuiltinId::Read},
+        {"read_lines", BuiltinId::ReadLines},
+    });
+    return builtin_ids::lookup(table, name, BuiltinId::None);
+}
+
+// Objetos `json`, `csv` e `snapshot`
+inline BuiltinObject builtin_object_id(SymbolId name) {
+    static const auto table = builtin_ids::make_table<BuiltinObject>({
+        {"json", BuiltinObject::Json},
+        {"csv", BuiltinObject::Csv},
+        {"snapshot", BuiltinObject::Snapshot},
+    });
+    return builtin_ids::lookup(table, name, BuiltinObject::None);
+}
+
+// Métodos de um objeto builtin (json.load, csv.load, snapshot.save, ...)
+inline BuiltinId builtin_object_method_id(BuiltinObject object, SymbolId method) {
+    static const auto json = builtin_ids::make_table<BuiltinId>({
+        {"load", BuiltinId::JsonLoad},
+        {"stream", BuiltinId::JsonStream},
+        {"stringify", BuiltinId::JsonStringify},
+        {"dump", BuiltinId::JsonDump},
+    });
+    static const auto csv = builtin_ids::make_table<BuiltinId>({
+        {"load", BuiltinId::CsvLoad},
+    });
+    static const auto snapshot = builtin_ids::make_table<BuiltinId>({
+        {"save", BuiltinId::SnapshotSave},
+        {"load", BuiltinId::SnapshotLoad},
+    });
+    switch (object) {
+        case BuiltinObject::Json: return builtin_ids::lookup(json, method, BuiltinId::None);
+        case BuiltinObject::Csv: return builtin_ids::lookup(csv, method, BuiltinId::None);
+        case BuiltinObject::Snapshot: return builtin_ids::lookup(snapshot, method, BuiltinId::None);
+        default: return BuiltinId::None;
+    }
+}
+
+// Métodos de string e vector (o codegen escolhe pelo nome, não pelo tipo do objeto)
+inline BuiltinId builtin_method_id(SymbolId method) {
+    static const auto table = builtin_ids::make_table<BuiltinId>({
+        {"toUpperCase", BuiltinId::StringToUpperCase},
+        {"replace", BuiltinId::StringReplace},
+        {"includes", BuiltinId::StringIncludes},
+        {"push", BuiltinId::VectorPush},
+        {"pop", BuiltinId::VectorPop},
+        {"get", BuiltinId::VectorGet},
+        {"set", BuiltinId::VectorSet},
+        {"map", BuiltinId::VectorMap},
+        {"filter", BuiltinId::VectorFilter},
+        {"reduce", BuiltinId::VectorReduce},
+        {"sort", BuiltinId::VectorSort},
+        {"sum", BuiltinId::VectorSum},
+        {"min", BuiltinId::VectorMin},
+        {"max", BuiltinId::VectorMax},
+        {"dot", BuiltinId::VectorDot},
+        {"scale", BuiltinId::VectorScale},
+        {"add", BuiltinId::VectorAdd},
+    });
+    return builtin_ids::lookup(table, method, BuiltinId::None);
+}
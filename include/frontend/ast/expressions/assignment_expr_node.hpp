@@ -14,16 +14,6 @@ public:
 
     ~AssignmentExprNode() override = default;
 
-    Node* clone() const override {
-        auto cloned_target = target ? std::unique_ptr<Expr>(static_cast<Expr*>(target->clone())) : nullptr;
-        auto cloned_value = value ? std::unique_ptr<Expr>(static_cast<Expr*>(value->clone())) : nullptr;
-        auto* node = new AssignmentExprNode(std::move(cloned_target), op, std::move(cloned_value));
-        if (position) {
-            node->position = std::make_unique<PositionData>(*position);
-        }
-        return node;
-    }
-
     void codegen(nv::IRGenerationContext& ctx) override;
 };
 
@@ -9,13 +9,5 @@ class BooleanLiteralNode: public Expr {
 
         ~BooleanLiteralNode() override = default;
 
-        Node* clone() const override {
-            auto* node = new BooleanLiteralNode(value);
-            if (position) {
-                node->position = std::make_unique<PositionData>(*position);
-            }
-            return node;
-        }
-
         void codegen(nv::IRGenerationContext& ctx) override;
 };
\ No newline at end of file
@@ -1,5 +1,8 @@
 #pragma once
 #include "../types.hpp"
+#include "../builtin_id.hpp"
+#include "identifier_node.hpp"
+#include "member_expr_node.hpp"
 #include <vector>
 #include <memory>
 
@@ -7,25 +10,34 @@ class CallExprNode : public Expr {
 public:
     std::unique_ptr<Expr> caller;
     std::vector<std::unique_ptr<Expr>> args;
+    // Builtin ou método chamado; o checker resolve, o codegen só consulta
+    mutable BuiltinId builtin = BuiltinId::Unresolved;
 
     CallExprNode(std::unique_ptr<Expr> caller, std::vector<std::unique_ptr<Expr>> args)
         : Expr(NodeType::CallExpression), caller(std::move(caller)), args(std::move(args)) {}
 
     ~CallExprNode() override = default;
 
-    Node* clone() const override {
-        auto cloned_caller = caller ? std::unique_ptr<Expr>(static_cast<Expr*>(caller->clone())) : nullptr;
-        std::vector<std::unique_ptr<Expr>> cloned_args;
-        for (const auto& expr : args) {
-            cloned_args.push_back(std::unique_ptr<Expr>(static_cast<Expr*>(expr->clone())));
+    // Id do builtin chamado (BuiltinId::None para chamadas comuns)
+    BuiltinId resolve_builtin() const {
+        if (builtin != BuiltinId::Unresolved) return builtin;
+        builtin = BuiltinId::None;
+        if (!caller) return builtin;
+        if (caller->kind == NodeType::Identifier) {
+            builtin = builtin_function_id(static_cast<const IdentifierNode*>(caller.get())->symbol_id);
+        } else if (caller->kind == NodeType::MemberExpression) {
+            auto* mem = static_cast<const MemberExprNode*>(caller.get());
+            if (!mem->property || mem->property->kind != NodeType::Identifier) return builtin;
+            SymbolId method = static_cast<const IdentifierNode*>(mem->property.get())->symbol_id;
+            BuiltinObject object = BuiltinObject::None;
+            if (mem->object && mem->object->kind == NodeType::Identifier) {
+                object = builtin_object_id(static_cast<const IdentifierNode*>(mem->object.get())->symbol_id);
+            }
+            builtin = object != BuiltinObject::None ? builtin_object_method_id(object, method)
+                                                    : builtin_method_id(method);
         }
-        auto* node = new CallExprNode(std::move(cloned_caller), std::move(cloned_args));
-        if (position) {
-            node->position = std::make_unique<PositionData>(*position);
-        }
-        return node;
+        return builtin;
     }
 
     void codegen(nv::IRGenerationContext& ctx) override;
 };
-
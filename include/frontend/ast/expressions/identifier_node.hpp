@@ -1,24 +1,18 @@
 #pragma once
 #include "../types.hpp"
+#include "../symbol.hpp"
 #include <string>
 
 class IdentifierNode : public Expr {
 public:
     std::string symbol;
+    SymbolId symbol_id;  // nome internado (chave das tabelas de escopo)
 
     IdentifierNode(std::string sym)
-        : Expr(NodeType::Identifier), symbol(std::move(sym)) {}
+        : Expr(NodeType::Identifier), symbol(std::move(sym)), symbol_id(intern_symbol(symbol)) {}
 
     ~IdentifierNode() override;
 
-    Node* clone() const override {
-        auto* node = new IdentifierNode(symbol);
-        if (position) {
-            node->position = std::make_unique<PositionData>(*position);
-        }
-        return node;
-    }
-
     void codegen(nv::IRGenerationContext& ctx) override;
 };
 
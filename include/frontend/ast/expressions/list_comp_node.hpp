@@ -24,26 +24,6 @@ public:
 
     ~ListCompNode() override = default;
 
-    Node* clone() const override {
-        std::vector<std::pair<std::unique_ptr<Expr>, std::unique_ptr<Expr>>> cloned_gens;
-        for (const auto& [target, source] : generators) {
-            cloned_gens.push_back(std::make_pair(
-                std::unique_ptr<Expr>(static_cast<Expr*>(target->clone())),
-                std::unique_ptr<Expr>(static_cast<Expr*>(source->clone()))
-            ));
-        }
-        auto* node = new ListCompNode(
-            std::unique_ptr<Expr>(static_cast<Expr*>(elt->clone())),
-            std::move(cloned_gens),
-            if_cond ? std::unique_ptr<Expr>(static_cast<Expr*>(if_cond->clone())) : nullptr,
-            else_expr ? std::unique_ptr<Expr>(static_cast<Expr*>(else_expr->clone())) : nullptr
-        );
-        if (position) {
-            node->position = std::make_unique<PositionData>(*position);
-        }
-        return node;
-    }
-
     void codegen(nv::IRGenerationContext& ctx) override;
 };
 
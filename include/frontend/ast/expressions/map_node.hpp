@@ -12,18 +12,6 @@ public:
 
     ~MapNode() override = default;
 
-    Node* clone() const override {
-        std::vector<std::unique_ptr<Expr>> cloned_properties;
-        for (const auto& property : properties) {
-            cloned_properties.push_back(std::unique_ptr<Expr>(static_cast<Expr*>(property->clone())));
-        }
-        auto* node = new MapNode(std::move(cloned_properties));
-        if (position) {
-            node->position = std::make_unique<PositionData>(*position);
-        }
-        return node;
-    }
-
     void codegen(nv::IRGenerationContext& ctx) override;
 };
 
@@ -22,14 +22,6 @@ public:
         return *this;
     }
 
-    Node* clone() const override {
-        auto* node = new ParamNode(*this);
-        if (position) {
-            node->position = std::make_unique<PositionData>(*position);
-        }
-        return node;
-    }
-
     void codegen(nv::IRGenerationContext& ctx) override;
 };
 
@@ -18,15 +18,5 @@ public:
 
     ~RangeExprNode() override = default;
 
-    Node* clone() const override {
-        auto s = start ? std::unique_ptr<Expr>(static_cast<Expr*>(start->clone())) : nullptr;
-        auto e = end ? std::unique_ptr<Expr>(static_cast<Expr*>(end->clone())) : nullptr;
-        auto* node = new RangeExprNode(std::move(s), std::move(e), inclusive);
-        if (position) {
-            node->position = std::make_unique<PositionData>(*position);
-        }
-        return node;
-    }
-
     void codegen(nv::IRGenerationContext& ctx) override;
 };
@@ -11,14 +11,6 @@ public:
 
     ~StringLiteralNode() override = default;
 
-    Node* clone() const override {
-        auto* node = new StringLiteralNode(value);
-        if (position) {
-            node->position = std::make_unique<PositionData>(*position);
-        }
-        return node;
-    }
-
     void codegen(nv::IRGenerationContext& ctx) override;
 };
 
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+// Operadores binários resolvidos uma vez pelo parser (BinaryExprNode::opcode);
+// checker e codegen despacham com switch em vez de comparar strings
+enum class BinaryOp : uint8_t {
+    Add, Sub, Mul, Div, FloorDiv, Mod, Pow,
+    Eq, Ne, Lt, Gt, Le, Ge,
+    And, Or,
+    Unknown,
+};
+
+inline BinaryOp binary_op_from_string(std::string_view op) {
+    switch (op.size()) {
+        case 1:
+            switch (op[0]) {
+                case '+': return BinaryOp::Add;
+                case '-': return BinaryOp::Sub;
+                case '*': return BinaryOp::Mul;
+                case '/': return BinaryOp::Div;
+                case '%': return BinaryOp::Mod;
+                case '<': return BinaryOp::Lt;
+                case '>': return BinaryOp::Gt;
+            }
+            break;
+        case 2:
+            if (op == "==") return BinaryOp::Eq;
+            if (op == "!=") return BinaryOp::Ne;
+            if (op == "<=") return BinaryOp::Le;
+            if (op == ">=") return BinaryOp::Ge;
+            if (op == "&&") return BinaryOp::And;
+            if (op == "||") return BinaryOp::Or;
+            if (op == "**") return BinaryOp::Pow;
+            if (op == "//") return BinaryOp::FloorDiv;
+            break;
+    }
+    return BinaryOp::Unknown;
+}
+
+inline bool is_arithmetic_op(BinaryOp op) {
+    return op <= BinaryOp::Pow;
+}
+
+inline bool is_comparison_op(BinaryOp op) {
+    return op >= BinaryOp::Eq && op <= BinaryOp::Ge;
+}
+
+inline bool is_logical_op(BinaryOp op) {
+    return op == BinaryOp::And || op == BinaryOp::Or;
+}
+
+// Operador de uma atribuição composta ("+=" -> Add); Unknown para "=" e desconhecidos
+inline BinaryOp compound_assign_op(std::string_view op) {
+    if (op.size() < 2 || op.back() != '=') return BinaryOp::Unknown;
+    BinaryOp bin = binary_op_from_string(op.substr(0, op.size() - 1));
+    return is_arithmetic_op(bin) ? bin : BinaryOp::Unknown;
+}
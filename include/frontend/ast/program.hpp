@@ -49,14 +49,6 @@ public:
         return body;
     }
 
-    Node* clone() const override {
-        auto new_program = std::make_unique<Program>();
-        for (const auto& stmt : body) {
-            new_program->add_statement(std::unique_ptr<Stmt>(static_cast<Stmt*>(stmt->clone())));
-        }
-        return new_program.release();
-    }
-
     // Debug
     void print() {
         std::cout << "Program: \n";
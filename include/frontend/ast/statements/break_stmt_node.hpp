@@ -7,13 +7,6 @@ public:
 
     ~BreakStmtNode() override = default;
     
-    Node* clone() const override {
-        auto* node = new BreakStmtNode();
-        if (position) {
-            node->position = std::make_unique<PositionData>(*position);
-        }
-        return node;
-    }
 
     void codegen(nv::IRGenerationContext& ctx) override;
 };
@@ -7,13 +7,6 @@ public:
 
     ~ContinueStmtNode() override = default;
     
-    Node* clone() const override {
-        auto* node = new ContinueStmtNode();
-        if (position) {
-            node->position = std::make_unique<PositionData>(*position);
-        }
-        return node;
-    }
 
     void codegen(nv::IRGenerationContext& ctx) override;
 };
@@ -17,16 +17,6 @@ public:
     
     ~DeclarationStmtNode() override = default;
 
-    Node* clone() const override {
-        auto cloned_target = target ? std::unique_ptr<Expr>(static_cast<Expr*>(target->clone())) : nullptr;
-        auto cloned_value = value ? std::unique_ptr<Expr>(static_cast<Expr*>(value->clone())) : nullptr;
-        auto* node = new DeclarationStmtNode(std::move(cloned_target), std::move(cloned_value), this->typ, this->constant);
-        if (position) {
-            node->position = std::make_unique<PositionData>(*position);
-        }
-        return node;
-    }
-
     void codegen(nv::IRGenerationContext& ctx) override;
 };
 
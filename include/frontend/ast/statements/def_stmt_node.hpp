@@ -26,19 +26,6 @@ public:
 
     ~DefStmtNode() override = default;
 
-    Node* clone() const override {
-        std::vector<std::unique_ptr<Stmt>> cloned_body;
-        for (const auto& stmt : body) {
-            cloned_body.push_back(std::unique_ptr<Stmt>(static_cast<Stmt*>(stmt->clone())));
-        }
-
-        auto* node = new DefStmtNode(name, parameters, return_type, std::move(cloned_body));
-        if (position) {
-            node->position = std::make_unique<PositionData>(*position);
-        }
-        return node;
-    }
-
     void codegen(nv::IRGenerationContext& ctx) override;
 };
 
@@ -32,45 +32,6 @@ public:
 
     ~ForStmtNode() override = default;
 
-    Node* clone() const override {
-        std::vector<std::unique_ptr<Expr>> cloned_bindings;
-        cloned_bindings.reserve(bindings.size());
-        for (const auto& binding : bindings) {
-            cloned_bindings.push_back(std::unique_ptr<Expr>(static_cast<Expr*>(binding->clone())));
-        }
-
-        auto cloned_range_start = range_start ? std::unique_ptr<Expr>(static_cast<Expr*>(range_start->clone())) : nullptr;
-        auto cloned_range_end = range_end ? std::unique_ptr<Expr>(static_cast<Expr*>(range_end->clone())) : nullptr;
-
-        auto cloned_iterable = iterable ? std::unique_ptr<Expr>(static_cast<Expr*>(iterable->clone())) : nullptr;
-
-        std::vector<std::unique_ptr<Stmt>> cloned_body;
-        cloned_body.reserve(body.size());
-        for (const auto& stmt : body) {
-            cloned_body.push_back(std::unique_ptr<Stmt>(static_cast<Stmt*>(stmt->clone())));
-        }
-
-        std::vector<std::unique_ptr<Stmt>> cloned_else;
-        cloned_else.reserve(else_block.size());
-        for (const auto& stmt : else_block) {
-            cloned_else.push_back(std::unique_ptr<Stmt>(static_cast<Stmt*>(stmt->clone())));
-        }
-
-        auto* node = new ForStmtNode(
-            std::move(cloned_bindings),
-            std::move(cloned_range_start),
-            std::move(cloned_range_end),
-            range_inclusive,
-            std::move(cloned_iterable),
-            std::move(cloned_body),
-            std::move(cloned_else)
-        );
-        if (position) {
-            node->position = std::make_unique<PositionData>(*position);
-        }
-        return node;
-    }
-
     void codegen(nv::IRGenerationContext& ctx) override;
 };
 
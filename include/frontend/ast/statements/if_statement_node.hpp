@@ -14,27 +14,6 @@ public:
 
     ~IfStatementNode() override = default;
 
-    Node* clone() const override {
-        auto cloned_condition = condition ? std::unique_ptr<Expr>(static_cast<Expr*>(condition->clone())) : nullptr;
-        std::vector<std::unique_ptr<Stmt>> cloned_consequent;
-        for (const auto& stmt : consequent) {
-            cloned_consequent.push_back(std::unique_ptr<Stmt>(static_cast<Stmt*>(stmt->clone())));
-        }
-        std::vector<std::unique_ptr<Stmt>> cloned_alternate;
-        for (const auto& stmt : alternate) {
-            cloned_alternate.push_back(std::unique_ptr<Stmt>(static_cast<Stmt*>(stmt->clone())));
-        }
-        auto* node = new IfStatementNode(
-            std::move(cloned_condition),
-            std::move(cloned_consequent),
-            std::move(cloned_alternate)
-        );
-        if (position) {
-            node->position = std::make_unique<PositionData>(*position);
-        }
-        return node;
-    }
-
     void codegen(nv::IRGenerationContext& ctx) override;
 };
 
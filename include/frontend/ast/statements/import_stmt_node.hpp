@@ -26,13 +26,5 @@ public:
     
     ~ImportStmtNode() override = default;
 
-    Node* clone() const override {
-        auto* node = new ImportStmtNode(this->module_path, this->imports, this->filename);
-        if (position) {
-            node->position = std::make_unique<PositionData>(*position);
-        }
-        return node;
-    }
-
     void codegen(nv::IRGenerationContext& ctx) override;
 };
@@ -11,21 +11,6 @@ public:
 
     ~LoopStmtNode() override = default;
     
-    Node* clone() const override {
-        std::vector<std::unique_ptr<Stmt>> cloned_body;
-        cloned_body.reserve(body.size());
-        for (const auto& stmt : body) {
-            cloned_body.push_back(std::unique_ptr<Stmt>(static_cast<Stmt*>(stmt->clone())));
-        }
-
-        auto* node = new LoopStmtNode(
-            std::move(cloned_body)
-        );
-        if (position) {
-            node->position = std::make_unique<PositionData>(*position);
-        }
-        return node;
-    }
 
     void codegen(nv::IRGenerationContext& ctx) override;
 };
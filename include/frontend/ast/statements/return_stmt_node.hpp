@@ -11,14 +11,6 @@ public:
 
     ~ReturnStmtNode() override = default;
     
-    Node* clone() const override {
-        auto cloned_value = value ? std::unique_ptr<Expr>(static_cast<Expr*>(value->clone())) : nullptr;
-        auto* node = new ReturnStmtNode(std::move(cloned_value));
-        if (position) {
-            node->position = std::make_unique<PositionData>(*position);
-        }
-        return node;
-    }
 
     void codegen(nv::IRGenerationContext& ctx) override;
 };
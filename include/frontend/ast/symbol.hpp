@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+using SymbolId = uint32_t;
+
+// Identificadores internados. Cada nome distinto recebe um id denso na
+// primeira vez que aparece (o parser interna todo IdentifierNode), e as
+// tabelas de escopo do checker e do codegen são indexadas por esse id em vez
+// de hashear o nome a cada nível. Os nomes nunca são liberados nem movidos.
+class SymbolInterner {
+public:
+    static SymbolInterner& instance() {
+        static SymbolInterner interner;
+        return interner;
+    }
+
+    SymbolId intern(std::string_view name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        if (it != ids_.end()) return it->second;
+        names_.emplace_back(name);
+        auto id = static_cast<SymbolId>(names_.size() - 1);
+        ids_.emplace(names_.back(), id);
+        return id;
+    }
+
+    const std::string& name(SymbolId id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return names_[id];
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::deque<std::string> names_;
+    std::unordered_map<std::string_view, SymbolId> ids_;
+};
+
+// Cada thread guarda os nomes que já viu, então o parser só passa pela
+// tabela global (com lock) na primeira ocorrência de cada identificador
+inline SymbolId intern_symbol(std::string_view name) {
+    thread_local std::unordered_map<std::string_view, SymbolId> cache;
+    auto it = cache.find(name);
+    if (it != cache.end()) return it->second;
+    auto& interner = SymbolInterner::instance();
+    SymbolId id = interner.intern(name);
+    cache.emplace(interner.name(id), id);
+    return id;
+}
+
+inline const std::string& symbol_name(SymbolId id) {
+    return SymbolInterner::instance().name(id);
+}
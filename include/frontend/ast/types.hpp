@@ -1,6 +1,8 @@
 #pragma once
+#include <cstdint>
 #include <memory>
 #include <vector>
+#include "frontend/ast/arena.hpp"
 
 // Forward declarations to avoid circular dependencies
 namespace llvm { class Value; }
@@ -48,14 +50,20 @@ enum class NodeType {
     ImportStatement
 };
 
+// 20 bytes, alocada na região de posições da arena (longe dos nós)
 class PositionData {
 public:
-    size_t line;
-    size_t col[2];
-    size_t pos[2];
+    uint32_t line;
+    uint32_t col[2];
+    uint32_t pos[2];
 
     PositionData(size_t line, size_t col_start, size_t col_end, size_t pos_start, size_t pos_end)
-        : line(line), col{col_start, col_end}, pos{pos_start, pos_end} {}
+        : line(static_cast<uint32_t>(line)),
+          col{static_cast<uint32_t>(col_start), static_cast<uint32_t>(col_end)},
+          pos{static_cast<uint32_t>(pos_start), static_cast<uint32_t>(pos_end)} {}
+
+    static void* operator new(size_t size) { return AstArena::current().allocate_position(size); }
+    static void operator delete(void* p) noexcept { AstArena::deallocate(p); }
 };
 
 class Node {
@@ -63,8 +71,12 @@ public:
     NodeType kind;
     std::unique_ptr<PositionData> position;
     explicit Node(NodeType k) : kind(k) {}
+
+    // Nós vêm da arena corrente (ver arena.hpp); a posse segue por unique_ptr
+    static void* operator new(size_t size) { return AstArena::current().allocate_node(size); }
+    static void operator delete(void* p) noexcept { AstArena::deallocate(p); }
+
     virtual ~Node() = default;
-    virtual Node* clone() const = 0;
     virtual void codegen(nv::IRGenerationContext& ctx) = 0;
 };
 
@@ -46,4 +46,24 @@ namespace nv {
      * Lista de funções builtin disponíveis
      */
     extern const std::vector<BuiltinFunction> BUILTIN_FUNCTIONS;
+
+    /**
+     * Métodos do objeto builtin `json` (load, stream, stringify, dump)
+     */
+    extern const std::vector<BuiltinFunction> JSON_METHODS;
+
+    /**
+     * Métodos do objeto builtin `csv` (load)
+     */
+    extern const std::vector<BuiltinFunction> CSV_METHODS;
+
+    /**
+     * Métodos do objeto builtin `snapshot` (save, load)
+     */
+    extern const std::vector<BuiltinFunction> SNAPSHOT_METHODS;
+
+    /**
+     * Tabela de métodos de um objeto builtin (`json`, `csv`, `snapshot`); nullptr se `name` não é um
+     */
+    const std::vector<BuiltinFunction>* builtin_object_methods(const std::string& name);
 }
@@ -1,8 +1,12 @@
 #pragma once
 #include "frontend/checker/type.hpp"
 #include "frontend/checker/namespace.hpp"
+#include "frontend/checker/scope.hpp"
+#include "frontend/checker/interface.hpp"
 #include "frontend/checker/unification.hpp"
 #include "frontend/ast/ast.hpp"
+#include "frontend/lexer/source_manager.hpp"
+#include <optional>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -10,15 +14,12 @@
 namespace nv {
     class Checker {
         private:
-            std::vector<std::string> lines;
-            size_t line_count = 0;
-            
-            void read_lines(const std::string& filename);
+            std::optional<FileId> source_file;  // contexto das mensagens de erro
+
             void print_error_context(const PositionData* pos);
             
         public:
-            std::vector<std::shared_ptr<nv::Namespace>> namespaces;
-            std::shared_ptr<nv::Namespace> scope;
+            nv::Scope scope;
             std::unordered_map<std::string, std::shared_ptr<Type>> types;
             UnificationContext unify_ctx;
             bool err;
@@ -27,6 +28,9 @@ namespace nv {
             std::unordered_set<const void*> reported_errors;  // Nós que já tiveram erros reportados (usando ponteiro como chave)
             // Rastrear tipo de retorno da função atual (para verificação de return statements)
             std::shared_ptr<Type> current_return_type = nullptr;
+            // Módulos importados (direta ou indiretamente) e o hash do fonte de cada um;
+            // vão para a interface (.nvi) do módulo verificado
+            std::vector<InterfaceDependency> module_dependencies;
             Checker();
             nv::Type& getty(std::string ty);
             std::shared_ptr<nv::Type>& gettyptr(std::string ty);
@@ -0,0 +1,57 @@
+#pragma once
+#include "frontend/checker/type.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nv {
+    // Interface de um módulo (arquivo .nvi ao lado do .nv): nomes exportados
+    // com os tipos já verificados e generalizados, mais o hash do fonte e das
+    // dependências. Quem importa um módulo inalterado carrega a interface em
+    // vez de tokenizar, analisar e verificar o fonte de novo.
+    struct InterfaceDependency {
+        std::string path;
+        uint64_t hash;
+    };
+
+    struct InterfaceExport {
+        std::string name;
+        std::shared_ptr<Type> type;
+        bool constant;
+    };
+
+    struct ModuleInterface {
+        uint64_t source_hash = 0;
+        // Módulos importados (direta ou indiretamente) e o hash do fonte de cada um
+        std::vector<InterfaceDependency> dependencies;
+        std::vector<InterfaceExport> exports;
+
+        const InterfaceExport* find(const std::string& name) const;
+    };
+
+    // Gera uma variável de tipo nova no contexto de quem importa
+    using FreshTypeVar = std::function<std::shared_ptr<TypeVar>()>;
+
+    uint64_t hash_source(std::string_view source);
+
+    // Caminho da interface de um fonte: `dir/mod.nv` -> `dir/mod.nvi`
+    std::string interface_path(const std::string& source_path);
+
+    // Grava a interface; false se algum tipo não puder ser serializado ou se a
+    // escrita falhar (a interface é só um cache, então o erro não é fatal)
+    bool write_interface(const std::string& path, const ModuleInterface& iface);
+
+    // Lê a interface; nullopt se o arquivo não existir ou estiver corrompido.
+    // Variáveis de tipo viram variáveis novas de `fresh_var`.
+    std::optional<ModuleInterface> read_interface(const std::string& path, const FreshTypeVar& fresh_var);
+
+    // Interface de `source_path` se ela existir e o fonte (hash `source_hash`)
+    // e todas as dependências registradas estiverem inalterados
+    std::optional<ModuleInterface> load_current_interface(const std::string& source_path,
+                                                          uint64_t source_hash,
+                                                          const FreshTypeVar& fresh_var);
+}
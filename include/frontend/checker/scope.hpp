@@ -0,0 +1,35 @@
+#pragma once
+#include "frontend/checker/scope_table.hpp"
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+namespace nv {
+    struct Type;
+
+    // Ambiente de tipos do checker: nomes visíveis em cada ponto do programa.
+    // Mesma interface do antigo encadeamento de Namespaces, sobre uma
+    // ScopeTable indexada por SymbolId (Namespace continua sendo a tabela de
+    // métodos dos prototypes).
+    class Scope {
+        public:
+            void push_scope() { table.push_scope(); }
+            void pop_scope() { table.pop_scope(); }
+
+            // Tipo visível do nome; lança std::runtime_error se não existir
+            std::shared_ptr<nv::Type>& get_key(SymbolId k);
+            std::shared_ptr<nv::Type>& get_key(const std::string& k);
+            // Tipo visível do nome, ou nullptr
+            std::shared_ptr<nv::Type>* find(SymbolId k);
+
+            // Define no escopo atual; lança se o nome já for constante nele
+            void put_key(SymbolId k, const std::shared_ptr<nv::Type>& v, bool islocked = false);
+            void put_key(const std::string& k, const std::shared_ptr<nv::Type>& v, bool islocked = false);
+
+            // Coletar variáveis de tipo livres de todas as ligações visíveis ou sombreadas
+            void collect_free_vars(std::unordered_set<int>& free_vars) const;
+
+        private:
+            ScopeTable<std::shared_ptr<nv::Type>> table;
+    };
+}
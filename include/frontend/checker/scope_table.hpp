@@ -0,0 +1,85 @@
+#pragma once
+#include "frontend/ast/symbol.hpp"
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace nv {
+    // Escopos aninhados numa única pilha de ligações.
+    //
+    // Cada ligação guarda o índice da ligação que ela sombreia, e `heads[id]`
+    // aponta para a ligação visível do símbolo, então a busca é um acesso
+    // direto. Abrir um escopo só empilha uma marca; fechar desempilha as
+    // ligações até a marca restaurando as sombreadas. Referências a ligações
+    // continuam válidas até o escopo delas ser fechado.
+    template <typename V>
+    class ScopeTable {
+    public:
+        struct Binding {
+            SymbolId symbol;
+            uint32_t shadowed;  // ligação anterior do mesmo símbolo (ou kNone)
+            uint32_t depth;     // escopo onde foi definida (0 = global)
+            bool constant;
+            V value;
+        };
+
+        void push_scope() {
+            marks.push_back(static_cast<uint32_t>(bindings.size()));
+        }
+
+        void pop_scope() {
+            if (marks.empty()) return;
+            uint32_t mark = marks.back();
+            marks.pop_back();
+            while (bindings.size() > mark) {
+                const Binding& b = bindings.back();
+                heads[b.symbol] = b.shadowed;
+                bindings.pop_back();
+            }
+        }
+
+        uint32_t depth() const { return static_cast<uint32_t>(marks.size()); }
+
+        // Ligação visível do símbolo, ou nullptr
+        Binding* find(SymbolId symbol) {
+            if (symbol >= heads.size() || heads[symbol] == kNone) return nullptr;
+            return &bindings[heads[symbol]];
+        }
+
+        const Binding* find(SymbolId symbol) const {
+            return const_cast<ScopeTable*>(this)->find(symbol);
+        }
+
+        // Ligação do símbolo no escopo atual, ou nullptr
+        Binding* find_local(SymbolId symbol) {
+            Binding* b = find(symbol);
+            return b && b->depth == depth() ? b : nullptr;
+        }
+
+        // Define no escopo atual; redefinir no mesmo escopo sobrescreve
+        Binding& define(SymbolId symbol, const V& value, bool constant = false) {
+            if (Binding* local = find_local(symbol)) {
+                local->value = value;
+                local->constant = local->constant || constant;
+                return *local;
+            }
+            if (symbol >= heads.size()) heads.resize(static_cast<size_t>(symbol) + 1, kNone);
+            bindings.push_back(Binding{symbol, heads[symbol], depth(), constant, value});
+            heads[symbol] = static_cast<uint32_t>(bindings.size() - 1);
+            return bindings.back();
+        }
+
+        // Todas as ligações vivas, inclusive as sombreadas
+        template <typename F>
+        void for_each(F&& fn) const {
+            for (const Binding& b : bindings) fn(b);
+        }
+
+    private:
+        static constexpr uint32_t kNone = UINT32_MAX;
+
+        std::deque<Binding> bindings;
+        std::vector<uint32_t> heads;  // heads[symbol]
+        std::vector<uint32_t> marks;  // início de cada escopo aberto
+    };
+}
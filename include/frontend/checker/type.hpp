@@ -1,5 +1,6 @@
 // types.hpp
 #pragma once
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <vector>
@@ -23,8 +24,32 @@ namespace nv {
         POLY_TYPE,
         ERROR
     };
+
+    struct Type;
+
+    // Tabela de tipos (hash-consing): cada tipo sem variáveis livres existe
+    // uma única vez e recebe um id de 32 bits em Type::type_id (0 = não internado).
+    // Dois tipos internados são iguais se e só se têm o mesmo id, e substituir
+    // variáveis num tipo internado devolve o próprio tipo. Tipos que contêm
+    // variáveis (TypeVar, PolyType e compostos sobre elas) são criados à parte,
+    // assim como Vector: cada vector tem métodos com variáveis próprias.
+    using TypeId = uint32_t;
+
+    std::shared_ptr<Type> int_type();
+    std::shared_ptr<Type> float_type();
+    std::shared_ptr<Type> string_type();
+    std::shared_ptr<Type> bool_type();
+    std::shared_ptr<Type> void_type();
+    std::shared_ptr<Type> make_array_type(const std::shared_ptr<Type>& elem, size_t size);
+    std::shared_ptr<Type> make_tuple_type(const std::vector<std::shared_ptr<Type>>& elems);
+    std::shared_ptr<Type> make_map_type(const std::shared_ptr<Type>& key, const std::shared_ptr<Type>& value);
+    std::shared_ptr<Type> make_def_type(const std::vector<std::shared_ptr<Type>>& params, const std::shared_ptr<Type>& ret);
+    // Versão canônica de `t` se ele puder ser internado; senão o próprio `t`
+    std::shared_ptr<Type> intern_type(const std::shared_ptr<Type>& t);
+
     struct Type : public std::enable_shared_from_this<Type> {
         Kind kind;
+        TypeId type_id = 0;
         // apenas para função: param types + return
         std::vector<std::shared_ptr<Type>> params;
         std::shared_ptr<Type> ret;
@@ -36,7 +61,7 @@ namespace nv {
         virtual bool equals(std::shared_ptr<Type> &other) const { return this->kind == other->kind; };
         virtual std::string toString() = 0;
 
-        std::shared_ptr<Type> get_method(const std::string& name) const;
+        virtual std::shared_ptr<Type> get_method(const std::string& name) const;
 
         virtual std::shared_ptr<Type> get_length() const { return nullptr; }
         
@@ -114,17 +139,29 @@ namespace nv {
             if (it != subst.end()) {
                 return it->second;
             }
-            // Retornar nova variável de tipo com mesmo ID (não substituída)
-            return std::make_shared<TypeVar>(id);
+            // Variável não substituída: é a mesma variável, sem cópia
+            return std::const_pointer_cast<Type>(shared_from_this());
+        }
+        
+        // Representante da classe desta variável; `instance` apontando para
+        // outra variável é o elo da union-find (UnificationContext), e cada
+        // passo encurta o caminho pela metade (path halving)
+        TypeVar* find() {
+            TypeVar* tv = this;
+            while (tv->instance && tv->instance->kind == Kind::TYPE_VAR) {
+                auto* parent = static_cast<TypeVar*>(tv->instance.get());
+                if (parent->instance && parent->instance->kind == Kind::TYPE_VAR) {
+                    tv->instance = parent->instance;
+                }
+                tv = static_cast<TypeVar*>(tv->instance.get());
+            }
+            return tv;
         }
-        
-        // Resolver instância (path compression)
+
+        // Tipo ao qual a variável está vinculada, ou o representante se livre
         std::shared_ptr<Type> resolve() {
-            if (instance && instance->kind == Kind::TYPE_VAR) {
-                auto tv = std::static_pointer_cast<TypeVar>(instance);
-                instance = tv->resolve();
-            }
-            return instance ? instance : std::static_pointer_cast<Type>(shared_from_this());
+            TypeVar* root = find();
+            return root->instance ? root->instance : std::static_pointer_cast<Type>(root->shared_from_this());
         }
     };
     
@@ -229,6 +266,7 @@ namespace nv {
         bool equals(const Type &other) const override;
         
         void collect_free_vars(std::unordered_set<int>& free_vars) const override {
+            if (type_id) return;
             for (const auto& param : paramstype) {
                 param->collect_free_vars(free_vars);
             }
@@ -236,12 +274,13 @@ namespace nv {
         }
         
         std::shared_ptr<Type> substitute(const std::unordered_map<int, std::shared_ptr<Type>>& subst) const override {
+            if (type_id) return std::const_pointer_cast<Type>(shared_from_this());
             std::vector<std::shared_ptr<Type>> new_params;
             for (const auto& param : paramstype) {
                 new_params.push_back(param->substitute(subst));
             }
             auto new_ret = returntype->substitute(subst);
-            return std::make_shared<Def>(new_params, new_ret);
+            return make_def_type(new_params, new_ret);
         }
     };
 
@@ -258,15 +297,17 @@ namespace nv {
         }
         bool equals(const Type& other) const override;
         std::shared_ptr<Type> get_length() const override {
-            return std::make_shared<Int>();
+            return int_type();
         }
         
         void collect_free_vars(std::unordered_set<int>& free_vars) const override {
+            if (type_id) return;
             element_type->collect_free_vars(free_vars);
         }
         
         std::shared_ptr<Type> substitute(const std::unordered_map<int, std::shared_ptr<Type>>& subst) const override {
-            return std::make_shared<Array>(element_type->substitute(subst), size);
+            if (type_id) return std::const_pointer_cast<Type>(shared_from_this());
+            return make_array_type(element_type->substitute(subst), size);
         }
     };
 
@@ -274,7 +315,13 @@ namespace nv {
         // Vector heterogêneo ou de tamanho variável
         // Não tem tipo de elemento específico (pode conter qualquer tipo)
         Vector() : Type(Kind::VECTOR) { init_prototype(); }
+        // Tipo de retorno de map/filter/sort: o prototype só é criado no primeiro
+        // get_method (criar já no construtor geraria outro vector sem fim, e
+        // reaproveitar o prototype de quem chamou fecharia um ciclo de shared_ptr)
+        struct Deferred {};
+        explicit Vector(Deferred) : Type(Kind::VECTOR) {}
         void init_prototype();
+        std::shared_ptr<Type> get_method(const std::string& name) const override;
 
         std::string toString() override {
             return "vector";
@@ -283,7 +330,7 @@ namespace nv {
             return other.kind == Kind::VECTOR;
         }
         std::shared_ptr<Type> get_length() const override {
-            return std::make_shared<Int>();
+            return int_type();
         }
         
         void collect_free_vars(std::unordered_set<int>& free_vars) const override {
@@ -319,17 +366,19 @@ namespace nv {
         }
         
         void collect_free_vars(std::unordered_set<int>& free_vars) const override {
+            if (type_id) return;
             for (const auto& elem : element_type) {
                 elem->collect_free_vars(free_vars);
             }
         }
         
         std::shared_ptr<Type> substitute(const std::unordered_map<int, std::shared_ptr<Type>>& subst) const override {
+            if (type_id) return std::const_pointer_cast<Type>(shared_from_this());
             std::vector<std::shared_ptr<Type>> new_elements;
             for (const auto& elem : element_type) {
                 new_elements.push_back(elem->substitute(subst));
             }
-            return std::make_shared<Tuple>(new_elements);
+            return make_tuple_type(new_elements);
         }
     };
 
@@ -347,6 +396,7 @@ namespace nv {
         
         bool equals(const Type& other) const override {
             if (other.kind != Kind::MAP) return false;
+            if (type_id && other.type_id) return type_id == other.type_id;
             const Map* m = static_cast<const Map*>(&other);
             return key_type->equals(*m->key_type) && value_type->equals(*m->value_type);
         }
@@ -356,16 +406,18 @@ namespace nv {
         }
         
         std::shared_ptr<Type> get_length() const override {
-            return std::make_shared<Int>();
+            return int_type();
         }
         
         void collect_free_vars(std::unordered_set<int>& free_vars) const override {
+            if (type_id) return;
             key_type->collect_free_vars(free_vars);
             value_type->collect_free_vars(free_vars);
         }
         
         std::shared_ptr<Type> substitute(const std::unordered_map<int, std::shared_ptr<Type>>& subst) const override {
-            return std::make_shared<Map>(key_type->substitute(subst), value_type->substitute(subst));
+            if (type_id) return std::const_pointer_cast<Type>(shared_from_this());
+            return make_map_type(key_type->substitute(subst), value_type->substitute(subst));
         }
     };
 };
\ No newline at end of file
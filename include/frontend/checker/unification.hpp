@@ -1,36 +1,72 @@
 #pragma once
 #include "frontend/checker/type.hpp"
+#include <algorithm>
+#include <cstdint>
 #include <unordered_map>
+#include <unordered_set>
 #include <stdexcept>
+#include <vector>
 
 namespace nv {
-    // Contexto de unificação para inferência de tipos
+    // Contexto de unificação para inferência de tipos.
+    //
+    // As variáveis formam uma union-find: `TypeVar::instance` apontando para
+    // outra variável é o elo para o pai, e a raiz guarda o tipo vinculado à
+    // classe (ou nullptr). A busca usa path halving e a união é por rank, com
+    // os ranks em um vetor denso indexado pelo id. Variáveis criadas fora do
+    // contexto (ids negativos dos prototypes, instâncias de PolyType) entram
+    // na mesma estrutura com rank 0.
     class UnificationContext {
     private:
         int next_var_id;
-        std::unordered_map<int, std::shared_ptr<TypeVar>> type_vars;
-        
+        std::vector<std::shared_ptr<TypeVar>> type_vars; // type_vars[id]
+        std::vector<uint8_t> ranks;                      // ranks[id]
+
+        // Occurs check: marca por época das variáveis já visitadas (por id) e
+        // dos tipos compostos já percorridos
+        std::vector<uint32_t> occurs_marks;              // occurs_marks[id]
+        uint32_t occurs_epoch = 0;
+        std::unordered_set<const Type*> occurs_seen;
+        std::vector<const Type*> occurs_stack;
+
+        // A variável é a criada por new_type_var com esse id?
+        bool owns(const TypeVar* tv) const {
+            return tv->id >= 0 && static_cast<size_t>(tv->id) < type_vars.size() &&
+                   type_vars[tv->id].get() == tv;
+        }
+
+        uint8_t rank_of(const TypeVar* tv) const {
+            return owns(tv) ? ranks[tv->id] : 0;
+        }
+
+        // União por rank de duas raízes distintas e livres
+        void link(TypeVar* a, TypeVar* b) {
+            uint8_t ra = rank_of(a);
+            uint8_t rb = rank_of(b);
+            if (ra < rb) {
+                a->instance = b->shared_from_this();
+            } else {
+                b->instance = a->shared_from_this();
+                if (ra == rb && owns(a)) ++ranks[a->id];
+            }
+        }
+
     public:
         UnificationContext() : next_var_id(0) {}
         
         // Criar nova variável de tipo
         std::shared_ptr<TypeVar> new_type_var() {
             auto tv = std::make_shared<TypeVar>(next_var_id++);
-            type_vars[tv->id] = tv;
+            type_vars.push_back(tv);
+            ranks.push_back(0);
+            occurs_marks.push_back(0);
             return tv;
         }
         
-        // Resolver variável de tipo (com path compression)
-        std::shared_ptr<Type> resolve(std::shared_ptr<Type> t) {
-            if (t->kind == Kind::TYPE_VAR) {
-                auto tv = std::static_pointer_cast<TypeVar>(t);
-                auto resolved = tv->resolve();
-                if (resolved->kind == Kind::TYPE_VAR) {
-                    return resolved;
-                }
-                return resolved;
-            }
-            return t;
+        // Resolver variável de tipo: tipo vinculado à classe ou o representante
+        std::shared_ptr<Type> resolve(const std::shared_ptr<Type>& t) {
+            if (t->kind != Kind::TYPE_VAR) return t;
+            return static_cast<TypeVar*>(t.get())->resolve();
         }
         
         // Unificar dois tipos
@@ -38,22 +74,20 @@ namespace nv {
             t1 = resolve(t1);
             t2 = resolve(t2);
             
-            // Se são iguais, nada a fazer
-            if (t1->equals(t2)) {
+            // Se são iguais, nada a fazer (mesmo representante ou tipo internado)
+            if (t1 == t2 || t1->equals(t2)) {
                 return;
             }
             
-            // Se ambos são variáveis de tipo
+            // Se ambos são variáveis de tipo, unir as classes
             if (t1->kind == Kind::TYPE_VAR && t2->kind == Kind::TYPE_VAR) {
-                auto tv1 = std::static_pointer_cast<TypeVar>(t1);
-                auto tv2 = std::static_pointer_cast<TypeVar>(t2);
-                tv1->instance = t2;
+                link(static_cast<TypeVar*>(t1.get()), static_cast<TypeVar*>(t2.get()));
                 return;
             }
             
             // Se t1 é variável de tipo, vincular t2 a ela
             if (t1->kind == Kind::TYPE_VAR) {
-                auto tv1 = std::static_pointer_cast<TypeVar>(t1);
+                auto* tv1 = static_cast<TypeVar*>(t1.get());
                 // Verificar ocorrência (occurs check)
                 if (occurs_in(tv1, t2)) {
                     throw std::runtime_error("Type error: circular type constraint");
@@ -64,7 +98,7 @@ namespace nv {
             
             // Se t2 é variável de tipo, vincular t1 a ela
             if (t2->kind == Kind::TYPE_VAR) {
-                auto tv2 = std::static_pointer_cast<TypeVar>(t2);
+                auto* tv2 = static_cast<TypeVar*>(t2.get());
                 // Verificar ocorrência (occurs check)
                 if (occurs_in(tv2, t1)) {
                     throw std::runtime_error("Type error: circular type constraint");
@@ -127,8 +161,6 @@ namespace nv {
             
             if ((t1_is_int && t2_is_float) || (t1_is_float && t2_is_int)) {
                 // Promover int para float - ambos os tipos devem ser float
-                // Criar um tipo float compartilhado para vincular
-                auto float_type = std::make_shared<Float>();
                 // Se t1 era int, vincular t1 a float (mas t1 já é concreto, então não faz sentido)
                 // Na verdade, como ambos são tipos concretos, apenas permitimos a unificação
                 // O tipo resultante será float (o mais específico)
@@ -141,42 +173,67 @@ namespace nv {
                                    "' with '" + t2->toString() + "'");
         }
         
-        // Verificar se variável ocorre em tipo (occurs check)
-        bool occurs_in(std::shared_ptr<TypeVar> var, std::shared_ptr<Type> t) {
-            t = resolve(t);
-            
-            if (t->kind == Kind::TYPE_VAR) {
-                auto tv = std::static_pointer_cast<TypeVar>(t);
-                return var->id == tv->id;
+        // Verificar se a variável (raiz livre) ocorre em tipo (occurs check).
+        // Percorre cada variável e cada tipo composto uma única vez, mesmo
+        // quando a estrutura compartilha subtipos
+        bool occurs_in(const TypeVar* var, const std::shared_ptr<Type>& t) {
+            if (++occurs_epoch == 0) {
+                std::fill(occurs_marks.begin(), occurs_marks.end(), 0);
+                occurs_epoch = 1;
             }
-            
-            // Verificar recursivamente em tipos compostos
-            switch (t->kind) {
-                case Kind::ARRAY: {
-                    auto a = std::static_pointer_cast<Array>(t);
-                    return occurs_in(var, a->element_type);
-                }
-                case Kind::VECTOR: {
-                    // Vector não tem variáveis de tipo
-                    return false;
-                }
-                case Kind::TUPLE: {
-                    auto tu = std::static_pointer_cast<Tuple>(t);
-                    for (const auto& elem : tu->element_type) {
-                        if (occurs_in(var, elem)) return true;
+            occurs_seen.clear();
+            occurs_stack.clear();
+            occurs_stack.push_back(t.get());
+
+            while (!occurs_stack.empty()) {
+                const Type* current = occurs_stack.back();
+                occurs_stack.pop_back();
+
+                if (current->kind == Kind::TYPE_VAR) {
+                    TypeVar* root = const_cast<TypeVar*>(static_cast<const TypeVar*>(current))->find();
+                    if (root == var || root->id == var->id) return true;
+                    if (owns(root)) {
+                        if (occurs_marks[root->id] == occurs_epoch) continue;
+                        occurs_marks[root->id] = occurs_epoch;
+                    } else if (!occurs_seen.insert(root).second) {
+                        continue;
                     }
-                    return false;
+                    if (root->instance) occurs_stack.push_back(root->instance.get());
+                    continue;
                 }
-                case Kind::DEF: {
-                    auto l = std::static_pointer_cast<Def>(t);
-                    for (const auto& param : l->paramstype) {
-                        if (occurs_in(var, param)) return true;
+
+                // Tipos internados não têm variáveis
+                if (current->type_id) continue;
+
+                // Verificar em tipos compostos
+                switch (current->kind) {
+                    case Kind::ARRAY: {
+                        if (!occurs_seen.insert(current).second) break;
+                        occurs_stack.push_back(static_cast<const Array*>(current)->element_type.get());
+                        break;
                     }
-                    return occurs_in(var, l->returntype);
+                    case Kind::TUPLE: {
+                        if (!occurs_seen.insert(current).second) break;
+                        for (const auto& elem : static_cast<const Tuple*>(current)->element_type) {
+                            occurs_stack.push_back(elem.get());
+                        }
+                        break;
+                    }
+                    case Kind::DEF: {
+                        if (!occurs_seen.insert(current).second) break;
+                        const auto* l = static_cast<const Def*>(current);
+                        for (const auto& param : l->paramstype) {
+                            occurs_stack.push_back(param.get());
+                        }
+                        occurs_stack.push_back(l->returntype.get());
+                        break;
+                    }
+                    default:
+                        // Vector e tipos básicos não têm variáveis de tipo
+                        break;
                 }
-                default:
-                    return false;
             }
+            return false;
         }
         
         // Generalizar tipo (criar tipo polimórfico)
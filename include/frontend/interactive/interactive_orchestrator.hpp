@@ -36,6 +36,9 @@ public:
 
     void reset();
 
+    // Blocks until hot functions queued for tier-up are recompiled (tests).
+    void wait_for_tier_up();
+
     SessionManager& session_manager();
 
 private:
@@ -1,24 +1,66 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <llvm/ExecutionEngine/Orc/Core.h>
 
 namespace llvm {
 class Module;
+class TargetMachine;
 }
 
 namespace llvm::orc {
-class LLJIT;
+class LLLazyJIT;
+class IndirectStubsManager;
+class SymbolLinkagePromoter;
 class ThreadSafeContext;
+class ThreadSafeModule;
 }
 
 namespace narval::frontend::interactive {
 
+/**
+ * JitExecutionEngine
+ *
+ * Runs interactive fragments with two-tier compilation:
+ * - Tier 0: the whole fragment is compiled without optimization (O0 /
+ *   FastISel) so every REPL line or cell runs with minimal latency. Each
+ *   defined function gets a call counter in its prologue and is reached
+ *   through an indirect stub that owns the original symbol name.
+ * - Tier 1: once a function's counter crosses the hot threshold it is
+ *   recompiled at O2 on a background thread, and its stub pointer is
+ *   swapped to the optimized body. Calls already in flight finish in the
+ *   old code; new calls take the new one.
+ *
+ * Fragments go through a CompileOnDemandLayer: each function is compiled
+ * on its first call (through a lazy stub), so defining a large library of
+ * helpers costs only IR generation until they are used.
+ *
+ * NV_JIT_TIERING=0 disables tiering (everything is compiled at the default
+ * level), NV_JIT_HOT_THRESHOLD sets the call threshold and NV_JIT_LAZY=0
+ * compiles whole fragments eagerly when they are added (benchmarking).
+ */
 class JitExecutionEngine {
 public:
+    struct Options {
+        bool tiering = true;
+        bool lazy = true;
+        uint64_t hot_threshold = 1000;
+
+        // Defaults overridden by the environment variables above.
+        static Options from_env();
+    };
+
     JitExecutionEngine();
+    explicit JitExecutionEngine(const Options& options);
     ~JitExecutionEngine();
 
     llvm::orc::ResourceTrackerSP add_module(
@@ -30,8 +72,42 @@ public:
 
     void execute_void_function(const std::string& name);
 
+    // Blocks until the tier-up queue is drained (tests and benchmarks).
+    void wait_for_tier_up();
+
 private:
-    std::unique_ptr<llvm::orc::LLJIT> jit_;
+    // A tier-0 function waiting for (or already promoted to) tier 1.
+    struct TieredFunction {
+        std::string name;
+        std::atomic<uint64_t> calls{0};
+        llvm::orc::ResourceTrackerSP tracker;
+        std::shared_ptr<llvm::orc::ThreadSafeModule> source;  // pristine IR, before instrumentation
+        bool alive = true;
+    };
+
+    void instrument_module(
+        llvm::Module& module,
+        const std::vector<std::string>& names,
+        const std::vector<size_t>& ids
+    );
+
+    void tier_up(size_t id, llvm::TargetMachine& tm);
+    void tier_up_worker();
+    static void on_hot_function(JitExecutionEngine* self, uint64_t id);
+
+    Options options_;
+    std::unique_ptr<llvm::orc::LLLazyJIT> jit_;
+    std::unique_ptr<llvm::orc::IndirectStubsManager> stubs_;
+    std::unique_ptr<llvm::orc::SymbolLinkagePromoter> promote_;
+
+    std::mutex tier_mutex_;
+    std::condition_variable tier_cv_;
+    std::condition_variable tier_idle_cv_;
+    std::deque<std::unique_ptr<TieredFunction>> tiered_;  // stable addresses: JIT'd code bumps `calls`
+    std::deque<size_t> tier_queue_;
+    bool tier_busy_ = false;
+    bool tier_stop_ = false;
+    std::thread tier_thread_;
 };
 
 } // namespace narval::frontend::interactive
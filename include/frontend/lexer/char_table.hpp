@@ -0,0 +1,120 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Classes de caracteres do lexer: uma consulta na tabela substitui as chamadas
+// a std::isalnum/isspace por byte. Bytes >= 0x80 não pertencem a nenhuma
+// classe (mesmo comportamento de <cctype> no locale "C").
+enum CharClass : uint8_t {
+    CHAR_SPACE = 1 << 0,
+    CHAR_IDENT_START = 1 << 1,
+    CHAR_DIGIT = 1 << 2,
+    CHAR_OPERATOR = 1 << 3,
+    CHAR_QUOTE = 1 << 4,
+    CHAR_IDENT = CHAR_IDENT_START | CHAR_DIGIT,
+};
+
+struct CharTable {
+    uint8_t classes[256];
+};
+
+constexpr CharTable make_char_table() {
+    CharTable table{};
+    for (int c = 'a'; c <= 'z'; ++c) table.classes[c] |= CHAR_IDENT_START;
+    for (int c = 'A'; c <= 'Z'; ++c) table.classes[c] |= CHAR_IDENT_START;
+    for (int c = '0'; c <= '9'; ++c) table.classes[c] |= CHAR_DIGIT;
+    table.classes[static_cast<unsigned char>('_')] |= CHAR_IDENT_START;
+    for (char c : {' ', '\t', '\n', '\v', '\f', '\r'}) table.classes[static_cast<unsigned char>(c)] |= CHAR_SPACE;
+    for (char c : {'"', '\''}) table.classes[static_cast<unsigned char>(c)] |= CHAR_QUOTE;
+    for (char c : {'=', ';', ':', ',', '.', '(', ')', '{', '}', '[', ']', '+', '-', '*', '/', '%', '!', '<', '>', '|', '&'}) {
+        table.classes[static_cast<unsigned char>(c)] |= CHAR_OPERATOR;
+    }
+    return table;
+}
+
+inline constexpr CharTable char_table = make_char_table();
+
+inline bool char_is(char c, uint8_t classes) {
+    return (char_table.classes[static_cast<unsigned char>(c)] & classes) != 0;
+}
+
+#if defined(__SSE2__)
+// Máscara (1 bit por byte) dos bytes [A-Za-z0-9_] de um bloco de 16
+inline unsigned ident_mask(__m128i v) {
+    // c + (0x80 - lo) < 0x80 + n  <=>  lo <= c < lo + n, em comparação com sinal
+    __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+    __m128i alpha = _mm_cmplt_epi8(_mm_add_epi8(lower, _mm_set1_epi8(static_cast<char>(0x80 - 'a'))),
+                                   _mm_set1_epi8(static_cast<char>(0x80 + 26)));
+    __m128i digit = _mm_cmplt_epi8(_mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(0x80 - '0'))),
+                                   _mm_set1_epi8(static_cast<char>(0x80 + 10)));
+    __m128i under = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(alpha, digit), under)));
+}
+
+// Máscara dos bytes de espaço (' ' e '\t'..'\r') de um bloco de 16
+inline unsigned space_mask(__m128i v) {
+    __m128i ctrl = _mm_cmplt_epi8(_mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(0x80 - '\t'))),
+                                  _mm_set1_epi8(static_cast<char>(0x80 + 5)));
+    __m128i blank = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(ctrl, blank)));
+}
+#endif
+
+// Fim da sequência [A-Za-z0-9_] que começa em `pos`
+inline size_t scan_identifier(std::string_view input, size_t pos) {
+#if defined(__SSE2__)
+    while (pos + 16 <= input.size()) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.data() + pos));
+        unsigned stop = ~ident_mask(v) & 0xFFFFu;
+        if (stop) return pos + static_cast<size_t>(__builtin_ctz(stop));
+        pos += 16;
+    }
+#endif
+    while (pos < input.size() && char_is(input[pos], CHAR_IDENT)) ++pos;
+    return pos;
+}
+
+// Pula espaços a partir de `pos`, atualizando linha e coluna como
+// Lexer::advance (a coluna volta a 1 depois de cada '\n').
+inline size_t skip_spaces(std::string_view input, size_t pos, size_t& line, size_t& column) {
+#if defined(__SSE2__)
+    while (pos + 16 <= input.size()) {
+        if (!char_is(input[pos], CHAR_SPACE)) return pos;
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.data() + pos));
+        unsigned stop = ~space_mask(v) & 0xFFFFu;
+        unsigned run = stop ? static_cast<unsigned>(__builtin_ctz(stop)) : 16u;
+        unsigned newlines = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))));
+        newlines &= (1u << run) - 1u;
+        if (newlines) {
+            unsigned last = 31u - static_cast<unsigned>(__builtin_clz(newlines));
+            line += static_cast<size_t>(__builtin_popcount(newlines));
+            column = run - last;
+        } else {
+            column += run;
+        }
+        pos += run;
+        if (run < 16) return pos;
+    }
+#endif
+    while (pos < input.size() && char_is(input[pos], CHAR_SPACE)) {
+        if (input[pos] == '\n') {
+            ++line;
+            column = 1;
+        } else {
+            ++column;
+        }
+        ++pos;
+    }
+    return pos;
+}
+
+// Posição do próximo '\n' (ou o fim do buffer); memchr já é vetorizado
+inline size_t find_line_end(std::string_view input, size_t pos) {
+    const void* nl = std::memchr(input.data() + pos, '\n', input.size() - pos);
+    return nl ? static_cast<size_t>(static_cast<const char*>(nl) - input.data()) : input.size();
+}
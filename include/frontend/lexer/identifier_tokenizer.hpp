@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include "frontend/lexer/token.hpp"
 
-Token tokenize_identifier_or_keyword(const std::string& input, size_t& pos, size_t& line, size_t& column, const std::string& filename);
+Token tokenize_identifier_or_keyword(std::string_view input, size_t& pos, size_t& line, size_t& column, FileId file);
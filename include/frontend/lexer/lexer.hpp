@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cctype>
 #include <stdexcept>
@@ -28,10 +29,10 @@ struct ImportInfo {
 
 class Lexer {
     private:
-        std::string input;
+        FileId file_id;
+        std::string_view input;     // buffer do SourceManager
         std::string filename;
-        std::string::const_iterator current;
-        std::unordered_map<std::string, std::string> operators;
+        std::string_view::const_iterator current;
         size_t line;
         size_t column;
         size_t position;
@@ -41,6 +42,7 @@ class Lexer {
         
     public:
         Lexer(std::string src, std::string file);
+        explicit Lexer(FileId file);  // arquivo já registrado no SourceManager (ex.: load_file)
         bool is_eof() const;
         char peek() const;
         void skip_whitespace();
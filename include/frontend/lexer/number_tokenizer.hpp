@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <stdexcept>
 #include "frontend/lexer/token.hpp"
 
-Token tokenize_number(const std::string& input, size_t& pos, size_t& line, size_t& column, const std::string& filename);
+Token tokenize_number(std::string_view input, size_t& pos, size_t& line, size_t& column, FileId file);
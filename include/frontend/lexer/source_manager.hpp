@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using FileId = uint32_t;
+
+// Dono dos buffers de código-fonte do frontend. Tokens apontam direto para o
+// texto registrado aqui e guardam só o FileId; os buffers nunca são liberados
+// nem movidos, então essas referências valem até o fim do processo (no REPL
+// cada entrada registra um buffer pequeno).
+//
+// Arquivos em disco são mapeados (mmap) uma única vez por caminho: lexer,
+// parser, checker e codegen leem a mesma memória, inclusive para o contexto
+// das mensagens de erro. A tabela de inícios de linha é calculada só na
+// primeira consulta a `line()`.
+class SourceManager {
+    public:
+        static SourceManager& instance();
+
+        FileId add_buffer(std::string name, std::string contents);
+        // Mapeia o arquivo ou devolve o id de quando já foi carregado;
+        // lança std::runtime_error se não conseguir abrir
+        FileId load_file(const std::string& path);
+        // Buffer ou arquivo já registrado com esse nome
+        std::optional<FileId> find(const std::string& name) const;
+
+        std::string_view buffer(FileId id) const;
+        const std::string& filename(FileId id) const;
+
+        // Linha `line` (a partir de 1) sem o '\n'; vazia fora do arquivo
+        std::string_view line(FileId id, size_t line) const;
+        size_t line_count(FileId id) const;
+
+    private:
+        struct SourceFile {
+            std::string name;
+            std::string contents;       // buffers registrados em memória
+            const char* data = nullptr;
+            size_t size = 0;
+            void* mapping = nullptr;    // região do mmap (arquivos em disco)
+
+            mutable std::once_flag lines_once;
+            mutable std::vector<size_t> line_starts;
+
+            ~SourceFile();
+            const std::vector<size_t>& lines() const;
+        };
+
+        FileId register_file(std::unique_ptr<SourceFile> source);
+        const SourceFile& file(FileId id) const;
+
+        mutable std::mutex mutex;
+        std::deque<std::unique_ptr<SourceFile>> files;
+        std::unordered_map<std::string, FileId> by_name;
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include "frontend/lexer/token.hpp"
 
-Token tokenize_string(const std::string& input, size_t& position, size_t line, size_t column, const std::string& filename);
+Token tokenize_string(std::string_view input, size_t& position, size_t line, size_t column, FileId file);
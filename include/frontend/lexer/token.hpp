@@ -1,6 +1,9 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <cstddef>
+#include <cstdint>
+#include "frontend/lexer/source_manager.hpp"
 
 enum class TokenType {
     TRUE,
@@ -132,16 +135,29 @@ inline const char* get_token_name(TokenType type) {
     }
 }
 
+// Token de tamanho fixo: o lexema não é copiado, `text` aponta para o buffer
+// registrado no SourceManager (em strings, para o conteúdo entre as aspas,
+// ainda com as sequências de escape).
 struct Token {
     TokenType type;
-    std::string lexeme;
-    size_t line;
-    size_t column_start;
-    size_t column_end;
-    size_t position_start;
-    size_t position_end;
-    std::string filename;
+    FileId file_id;
+    const char* text;
+    uint32_t length;
+    uint32_t line;
+    uint32_t column_start;
+    uint32_t column_end;
+    uint32_t position_start;
+    uint32_t position_end;
 
-    Token(TokenType t, std::string l, size_t li, size_t cs, size_t ce, size_t ps, size_t pe, std::string f)
-        : type(t), lexeme(l), line(li), column_start(cs), column_end(ce), position_start(ps), position_end(pe), filename(f) {}
+    Token(TokenType t, const char* txt, size_t len, size_t li, size_t cs, size_t ce, size_t ps, size_t pe, FileId f)
+        : type(t), file_id(f), text(txt), length(static_cast<uint32_t>(len)), line(static_cast<uint32_t>(li)),
+          column_start(static_cast<uint32_t>(cs)), column_end(static_cast<uint32_t>(ce)),
+          position_start(static_cast<uint32_t>(ps)), position_end(static_cast<uint32_t>(pe)) {}
+
+    std::string_view lexeme() const { return std::string_view(text, length); }
+
+    // Valor de um literal de string, com os escapes resolvidos (string_tokenizer.cpp)
+    std::string string_value() const;
+
+    const std::string& filename() const { return SourceManager::instance().filename(file_id); }
 };
@@ -15,7 +15,7 @@ class ModuleManager {
     public:
         struct Module {
             std::string name;
-            std::string source;
+            std::string_view source;  // buffer do SourceManager
             std::string directory;
             std::vector<Token> tokens;
             std::vector<std::string> dependencies;
@@ -25,6 +25,8 @@ class ModuleManager {
         
         ModuleManager() = default;
         void compile_module(const std::string& module_name, const std::string& file_path, int config);
+        // Move os statements usados para o programa combinado (sem cópia); os
+        // ASTs dos módulos ficam só com o que não foi incluído
         std::unique_ptr<Node> get_combined_ast(const std::string& main_module_name = "");
         const std::map<std::string, Module>& get_modules() const;
 
@@ -32,7 +34,6 @@ class ModuleManager {
 
         void load_module(const std::string& module_name, const std::string& file_path, int config);
         void resolve_dependencies(const std::string& module_name, const std::string& file_path, int config);
-        std::string read_file(const std::string& file_path);
 
         std::map<std::string, Module> modules;
         std::set<std::string> visited;
@@ -8,15 +8,14 @@
 
 class Parser {
     private:
-        std::vector<Token> tokens;
+        // Tokens do chamador (contíguos, sem cópia); válidos durante produce_ast
+        const Token* tokens = nullptr;
         size_t token_count = 0;
+        size_t node_count = 0;
         bool has_errors = false;
-        std::vector<std::string> lines;
-        size_t line_count = 0;
         size_t index = 0;
         std::vector<ImportInfo> import_infos;
 
-        void read_lines(const std::string& filename);
         void print_error_context(const Token& token);
 
     public:
@@ -25,11 +24,12 @@ class Parser {
         bool has_error() const;
         void error(const std::string& message);
         size_t get_token_count() const;
+        size_t get_node_count() const;
 
         bool not_eof() const;
-        Token current_token() const;
-        Token consume_token();
-        Token next_token() const;
-        Token expect(TokenType expectedType, const std::string& errorMsg);
+        const Token& current_token() const;
+        const Token& consume_token();
+        const Token& next_token() const;
+        const Token& expect(TokenType expectedType, const std::string& errorMsg);
         std::unique_ptr<Node> produce_ast(const std::vector<Token>& tokens, const std::vector<ImportInfo>& imports = {});
 };
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+// Apoio comum aos drivers *.test.cpp: verificações nomeadas com contagem de
+// falhas, um diretório temporário por teste e arquivos lidos/escritos em binário
+namespace nv::test {
+    inline int failures = 0;
+
+    inline void check(bool ok, const std::string& name) {
+        std::cout << (ok ? "  ok     " : "  FALHOU ") << name << "\n";
+        if (!ok) failures++;
+    }
+
+    // Diretório vazio para os arquivos do teste; o driver o remove no fim
+    inline std::filesystem::path temp_dir(const std::string& name) {
+        auto dir = std::filesystem::temp_directory_path() / name;
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        return dir;
+    }
+
+    inline std::string write_file(const std::filesystem::path& path, const std::string& content) {
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << content;
+        return path.string();
+    }
+
+    inline std::string read_file(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    // Resumo do driver; o resultado é o código de saída do main
+    inline int finish(const std::string& what) {
+        if (failures > 0) {
+            std::cerr << "\n" << failures << " verificação(ões) falharam.\n";
+            return 1;
+        }
+        std::cout << "\nTeste de " << what << " concluído com sucesso.\n";
+        return 0;
+    }
+}
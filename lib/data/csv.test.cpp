@@ -0,0 +1,168 @@
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "test_support.hpp"
+
+extern "C" {
+#include "backend/runtime/prototypes.h"
+#include "backend/runtime/nv_runtime.h"
+}
+
+namespace fs = std::filesystem;
+using namespace nv::test;
+
+namespace {
+    fs::path dir;
+
+    Value load(const std::string& name, const std::string& content, Value* options = nullptr) {
+        Value v;
+        csv_load(&v, write_file(dir / name, content).c_str(), options);
+        return v;
+    }
+
+    // Coluna `name` do resultado (nullptr se não existe)
+    Vector* column(Value table, const char* name) {
+        if (table.type != TAG_MAP) return nullptr;
+        Value col = map_get_impl((Map*)(intptr_t)table.value, name);
+        return col.type == TAG_VECTOR ? (Vector*)(intptr_t)col.value : nullptr;
+    }
+
+    std::string str_at(Vector* col, int i) {
+        const Value& v = col->elements[i];
+        return v.type == TAG_STR && v.value ? (const char*)(intptr_t)v.value : "<não string>";
+    }
+
+    double float_at(Vector* col, int i) {
+        double d = 0;
+        if (col->elements[i].type == TAG_FLOAT) std::memcpy(&d, &col->elements[i].value, sizeof(d));
+        return d;
+    }
+
+    bool ints(Vector* col, const std::vector<int>& expected) {
+        if (!col || col->size != static_cast<int>(expected.size())) return false;
+        for (size_t i = 0; i < expected.size(); i++) {
+            if (col->elements[i].type != TAG_INT || col->elements[i].value != expected[i]) return false;
+        }
+        return true;
+    }
+
+    bool strings(Vector* col, const std::vector<std::string>& expected) {
+        if (!col || col->size != static_cast<int>(expected.size())) return false;
+        for (size_t i = 0; i < expected.size(); i++) {
+            if (str_at(col, static_cast<int>(i)) != expected[i]) return false;
+        }
+        return true;
+    }
+
+    void test_fields() {
+        std::cout << "csv.load\n";
+        Value t = load("basic.csv",
+                       "id,nome,nota,obs\n"
+                       "1,\"Silva, Ana\",9.5,\n"
+                       "2,\"diz \"\"oi\"\"\",7,x\n"
+                       "3,\"duas\nlinhas\",8.25,y\n");
+        check(ints(column(t, "id"), {1, 2, 3}), "coluna int");
+        check(strings(column(t, "nome"), {"Silva, Ana", "diz \"oi\"", "duas\nlinhas"}),
+              "aspas com delimitador, \"\" e quebra de linha");
+        Vector* nota = column(t, "nota");
+        check(nota && nota->size == 3 && float_at(nota, 0) == 9.5 && float_at(nota, 1) == 7.0 &&
+              float_at(nota, 2) == 8.25, "int e float na mesma coluna viram float");
+        check(strings(column(t, "obs"), {"", "x", "y"}), "célula vazia em coluna string");
+
+        t = load("crlf.csv", "\xEF\xBB\xBF\r\na,b\r\n1,\"x\r\ny\"\r\n\r\n2,z");
+        check(ints(column(t, "a"), {1, 2}), "BOM, CRLF, linha em branco e sem '\\n' final");
+        check(strings(column(t, "b"), {"x\r\ny", "z"}), "CRLF dentro de aspas é preservado");
+
+        t = load("short.csv", "a,b,c\n1,2\n3,4,5\n");
+        Vector* c = column(t, "c");
+        check(c && c->size == 2 && c->elements[0].type == 0 && c->elements[1].value == 5,
+              "linha curta completa com valor ausente");
+
+        t = load("dup.csv", "a,a,\"b\"\n1,2,3\n");
+        check(ints(column(t, "a"), {1}) && ints(column(t, "a_1"), {2}) && ints(column(t, "b"), {3}),
+              "cabeçalhos repetidos e entre aspas");
+
+        Value options;
+        create_map(&options);
+        Value delim, header;
+        create_str(&delim, ";");
+        create_bool(&header, 0);
+        map_set_impl((Map*)(intptr_t)options.value, "delimiter", delim);
+        map_set_impl((Map*)(intptr_t)options.value, "header", header);
+        t = load("options.csv", "1;\"a;b\"\n2;c\n", &options);
+        check(ints(column(t, "0"), {1, 2}) && strings(column(t, "1"), {"a;b", "c"}),
+              "delimitador ';' sem cabeçalho");
+    }
+
+    void test_errors() {
+        std::cout << "csv.load com entrada inválida\n";
+        Value v;
+        csv_load(&v, (dir / "nao_existe.csv").string().c_str(), nullptr);
+        check(v.type == 0, "arquivo inexistente vira null");
+        v = load("empty.csv", "");
+        check(v.type == TAG_MAP && ((Map*)(intptr_t)v.value)->size == 0, "arquivo vazio vira map vazio");
+        v = load("unterminated.csv", "a,b\n1,\"sem fim\n2,3\n");
+        Vector* b = column(v, "b");
+        check(b && b->size == 1 && str_at(b, 0) == "sem fim\n2,3\n", "aspas sem fechar vão até o fim");
+    }
+
+    // Arquivos grandes são divididos em chunks: as fronteiras caem dentro de
+    // campos entre aspas com quebras de linha, delimitadores e "" escapados
+    void test_chunks() {
+        std::cout << "csv.load em chunks paralelos\n";
+        auto text = [](int i) {
+            std::string s = "linha " + std::to_string(i) + ", com \"aspas\"\ne quebra";
+            // A cada 97 linhas, um campo maior que a janela de 64 KiB do scanner
+            if (i % 97 == 0) {
+                for (int k = 0; k < 9000; k++) s += "\n,\"x\"";
+            }
+            return s;
+        };
+        auto quote = [](const std::string& s) {
+            std::string out = "\"";
+            for (char ch : s) {
+                out += ch;
+                if (ch == '"') out += '"';
+            }
+            return out + "\"";
+        };
+
+        std::string doc = "id,texto,valor\n";
+        int rows = 0;
+        while (doc.size() < 12 * 1024 * 1024) {
+            doc += std::to_string(rows) + "," + quote(text(rows)) + "," + std::to_string(rows) + ".5\n";
+            rows++;
+        }
+        int32_t kb = static_cast<int32_t>(doc.size() / 1024);
+        check(nv_parallel_chunks(0, kb) > 1, "arquivo grande o bastante para ser dividido");
+
+        Value t = load("big.csv", doc);
+        Vector* id = column(t, "id");
+        Vector* texto = column(t, "texto");
+        Vector* valor = column(t, "valor");
+        bool ok = id && texto && valor && id->size == rows && texto->size == rows && valor->size == rows;
+        for (int i = 0; ok && i < rows; i++) {
+            if (id->elements[i].type != TAG_INT || id->elements[i].value != i ||
+                str_at(texto, i) != text(i) || float_at(valor, i) != i + 0.5) {
+                std::cout << "    linha " << i << " diferente\n";
+                ok = false;
+            }
+        }
+        check(ok, std::to_string(rows) + " linhas iguais às geradas");
+    }
+}
+
+int main() {
+    // O pool lê NV_NUM_THREADS na primeira chamada: garante chunks mesmo com 1 CPU
+    setenv("NV_NUM_THREADS", "4", 0);
+    dir = temp_dir("narval_csv_test");
+
+    std::cout << "Iniciando teste de CSV...\n";
+    test_fields();
+    test_errors();
+    test_chunks();
+    fs::remove_all(dir);
+    return finish("CSV");
+}
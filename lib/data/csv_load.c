@@ -0,0 +1,644 @@
+#include "backend/runtime/nv_runtime.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+extern void* map_prototype;
+
+// Loader CSV colunar. O arquivo é mapeado e os separadores (delimitador,
+// '\n' e aspas) saem do kernel SIMD em máscaras de 64 bytes; o trecho entre
+// aspas é calculado com prefix-xor, como no estágio 1 do parser JSON.
+//
+// Arquivos com mais de alguns MB são divididos em chunks processados no pool
+// de threads, em duas fases: (A) cada chunk conta suas linhas e infere o tipo
+// de cada coluna (int ⊂ float ⊂ string); (B) com os tipos unificados e o
+// deslocamento de linha de cada chunk, os campos são convertidos direto nas
+// posições finais dos vectors de cada coluna. O início de cada chunk é
+// ajustado para a primeira quebra de linha fora de aspas, usando a paridade
+// de aspas dos chunks anteriores.
+//
+// Strings são internadas por chunk (valores repetidos compartilham o mesmo
+// ponteiro) e copiadas para uma arena, então o mapeamento é liberado no fim.
+
+#define CSV_WINDOW_BLOCKS 1024          // 64 KB de máscaras por vez
+#define CSV_ARENA_BLOCK (64 * 1024)
+
+enum {
+    CSV_EMPTY = 0,    // coluna só com células vazias
+    CSV_INT,
+    CSV_FLOAT,
+    CSV_STRING
+};
+
+enum {
+    CSV_PHASE_QUOTES,   // paridade de aspas por chunk (ajuste das fronteiras)
+    CSV_PHASE_INFER,
+    CSV_PHASE_FILL
+};
+
+typedef struct {
+    uint64_t hash;
+    const char* str;
+    size_t len;
+} CsvInterned;
+
+typedef struct {
+    size_t begin;          // [begin, end) em job->data
+    size_t end;
+    int quote_parity;
+    int64_t rows;
+    int64_t row_base;
+    uint8_t* types;        // tipo inferido de cada coluna neste chunk
+
+    CsvInterned* table;    // endereçamento aberto, capacidade potência de 2
+    size_t table_cap;
+    size_t table_len;
+    char* arena;
+    size_t arena_left;
+    char* scratch;         // campo entre aspas com "" decodificado
+    size_t scratch_cap;
+} CsvChunk;
+
+typedef struct {
+    const char* data;
+    size_t len;
+    uint8_t delim;
+    int ncols;
+    int phase;
+    CsvChunk* chunks;
+    const uint8_t* types;  // tipos unificados (fase B)
+    Value** columns;       // elements do vector de cada coluna (fase B)
+} CsvJob;
+
+typedef struct {
+    size_t field_start;
+    int col;
+    int64_t row;
+} CsvCursor;
+
+static void* csv_alloc(size_t size) {
+    void* p = malloc(size ? size : 1);
+    if (!p) {
+        fprintf(stderr, "FATAL: malloc failed in csv_load\n");
+        exit(1);
+    }
+    return p;
+}
+
+static uint64_t prefix_xor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+static int is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+/* --- Tipos e conversão de campos --- */
+
+// Tipo de um campo sem as aspas externas; int só se couber em int32
+static int csv_field_type(const char* s, size_t n) {
+    if (n == 0) return CSV_EMPTY;
+    size_t i = 0;
+    int negative = 0;
+    if (s[0] == '+' || s[0] == '-') { negative = s[0] == '-'; i++; }
+
+    size_t int_start = i;
+    uint64_t v = 0;
+    while (i < n && is_digit(s[i])) {
+        if (v < (1ULL << 32)) v = v * 10 + (uint64_t)(s[i] - '0');
+        i++;
+    }
+    size_t int_digits = i - int_start;
+    if (i == n) {
+        if (int_digits == 0) return CSV_STRING;
+        return v <= (negative ? 2147483648ULL : 2147483647ULL) ? CSV_INT : CSV_FLOAT;
+    }
+
+    size_t frac_digits = 0;
+    if (s[i] == '.') {
+        i++;
+        while (i < n && is_digit(s[i])) { i++; frac_digits++; }
+    }
+    if (int_digits + frac_digits == 0) return CSV_STRING;
+    if (i < n && (s[i] == 'e' || s[i] == 'E')) {
+        i++;
+        if (i < n && (s[i] == '+' || s[i] == '-')) i++;
+        if (i == n || !is_digit(s[i])) return CSV_STRING;
+        while (i < n && is_digit(s[i])) i++;
+    }
+    return i == n ? CSV_FLOAT : CSV_STRING;
+}
+
+static int32_t csv_parse_int(const char* s, size_t n) {
+    size_t i = 0;
+    int negative = 0;
+    if (s[0] == '+' || s[0] == '-') { negative = s[0] == '-'; i++; }
+    int64_t v = 0;
+    for (; i < n; i++) v = v * 10 + (s[i] - '0');
+    return (int32_t)(negative ? -v : v);
+}
+
+static const double pow10_exact[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static double csv_parse_float(const char* s, size_t n) {
+    // Caminho rápido (Clinger): mantissa e potência de 10 exatas em double,
+    // então uma única divisão já dá o resultado corretamente arredondado
+    size_t i = 0;
+    int negative = 0;
+    if (s[0] == '+' || s[0] == '-') { negative = s[0] == '-'; i++; }
+    uint64_t m = 0;
+    int digits = 0, frac = 0;
+    while (i < n && is_digit(s[i])) { m = m * 10 + (uint64_t)(s[i] - '0'); digits++; i++; }
+    if (i < n && s[i] == '.') {
+        i++;
+        while (i < n && is_digit(s[i])) { m = m * 10 + (uint64_t)(s[i] - '0'); digits++; frac++; i++; }
+    }
+    if (i == n && digits <= 15) {
+        double d = (double)m / pow10_exact[frac];
+        return negative ? -d : d;
+    }
+
+    // O buffer mapeado não termina em '\0': strtod trabalha sobre uma cópia
+    char small[64];
+    char* tok = n < sizeof(small) ? small : (char*)csv_alloc(n + 1);
+    memcpy(tok, s, n);
+    tok[n] = '\0';
+    double d = strtod(tok, NULL);
+    if (tok != small) free(tok);
+    return d;
+}
+
+/* --- Strings internadas por chunk --- */
+
+static uint64_t csv_hash(const char* s, size_t n) {
+    uint64_t h = 0x9E3779B97F4A7C15ULL ^ (uint64_t)n;
+    while (n >= 8) {
+        uint64_t w;
+        memcpy(&w, s, 8);
+        h = (h ^ w) * 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 32;
+        s += 8;
+        n -= 8;
+    }
+    uint64_t w = 0;
+    memcpy(&w, s, n);
+    h = (h ^ w) * 0xC4CEB9FE1A85EC53ULL;
+    return h ^ (h >> 29);
+}
+
+static char* arena_copy(CsvChunk* c, const char* s, size_t n) {
+    char* out;
+    if (n + 1 > CSV_ARENA_BLOCK / 4) {
+        out = (char*)csv_alloc(n + 1);
+    } else {
+        if (n + 1 > c->arena_left) {
+            c->arena = (char*)csv_alloc(CSV_ARENA_BLOCK);
+            c->arena_left = CSV_ARENA_BLOCK;
+        }
+        out = c->arena;
+        c->arena += n + 1;
+        c->arena_left -= n + 1;
+    }
+    memcpy(out, s, n);
+    out[n] = '\0';
+    return out;
+}
+
+static void intern_grow(CsvChunk* c) {
+    size_t cap = c->table_cap ? c->table_cap * 2 : 1024;
+    CsvInterned* table = (CsvInterned*)calloc(cap, sizeof(CsvInterned));
+    if (!table) {
+        fprintf(stderr, "FATAL: malloc failed in csv_load\n");
+        exit(1);
+    }
+    for (size_t i = 0; i < c->table_cap; i++) {
+        CsvInterned e = c->table[i];
+        if (!e.str) continue;
+        size_t j = (size_t)e.hash & (cap - 1);
+        while (table[j].str) j = (j + 1) & (cap - 1);
+        table[j] = e;
+    }
+    free(c->table);
+    c->table = table;
+    c->table_cap = cap;
+}
+
+static const char* intern(CsvChunk* c, const char* s, size_t n) {
+    if (c->table_len * 2 >= c->table_cap) intern_grow(c);
+    uint64_t h = csv_hash(s, n);
+    size_t j = (size_t)h & (c->table_cap - 1);
+    while (c->table[j].str) {
+        CsvInterned* e = &c->table[j];
+        if (e->hash == h && e->len == n && memcmp(e->str, s, n) == 0) return e->str;
+        j = (j + 1) & (c->table_cap - 1);
+    }
+    const char* str = arena_copy(c, s, n);
+    c->table[j] = (CsvInterned){h, str, n};
+    c->table_len++;
+    return str;
+}
+
+// Conteúdo de um campo entre aspas, com "" decodificado em c->scratch
+static const char* unquote(CsvChunk* c, const char* s, size_t* n) {
+    size_t len = *n;
+    if (len == 0 || s[0] != '"') return s;
+    s++;
+    len--;
+    if (len > 0 && s[len - 1] == '"') len--;
+    if (!memchr(s, '"', len)) {
+        *n = len;
+        return s;
+    }
+    if (len > c->scratch_cap) {
+        free(c->scratch);
+        c->scratch = (char*)csv_alloc(len);
+        c->scratch_cap = len;
+    }
+    size_t out = 0;
+    for (size_t i = 0; i < len; i++) {
+        c->scratch[out++] = s[i];
+        if (s[i] == '"' && i + 1 < len && s[i + 1] == '"') i++;
+    }
+    *n = out;
+    return c->scratch;
+}
+
+static Value csv_missing(int type) {
+    Value v = {0};
+    if (type == CSV_STRING) create_str_borrowed(&v, "");
+    return v;
+}
+
+static Value csv_convert(CsvChunk* c, int type, const char* s, size_t n) {
+    s = unquote(c, s, &n);
+    Value v = {0};
+    if (n == 0) return csv_missing(type);
+    switch (type) {
+        case CSV_INT:
+            create_int(&v, csv_parse_int(s, n));
+            break;
+        case CSV_FLOAT:
+            create_float(&v, csv_parse_float(s, n));
+            break;
+        case CSV_STRING:
+            create_str_borrowed(&v, intern(c, s, n));
+            break;
+        default:
+            break;
+    }
+    return v;
+}
+
+/* --- Varredura de um chunk --- */
+
+static void csv_end_field(CsvJob* job, CsvChunk* c, CsvCursor* cur, size_t end, int row_end) {
+    const char* s = job->data + cur->field_start;
+    size_t n = end - cur->field_start;
+    if (row_end && n > 0 && s[n - 1] == '\r') n--;
+    cur->field_start = end + 1;
+
+    // Linha em branco não conta como registro
+    if (row_end && cur->col == 0 && n == 0) return;
+
+    if (cur->col < job->ncols) {
+        if (job->phase == CSV_PHASE_INFER) {
+            size_t inner = n;
+            const char* p = s;
+            if (n > 0 && s[0] == '"') {
+                p = s + 1;
+                inner = n - 1;
+                if (inner > 0 && p[inner - 1] == '"') inner--;
+            }
+            int t = csv_field_type(p, inner);
+            if (t > c->types[cur->col]) c->types[cur->col] = (uint8_t)t;
+        } else {
+            int64_t row = c->row_base + cur->row;
+            job->columns[cur->col][row] = csv_convert(c, job->types[cur->col], s, n);
+        }
+    }
+    cur->col++;
+
+    if (row_end) {
+        // Linhas curtas: colunas restantes recebem o valor ausente
+        if (job->phase == CSV_PHASE_FILL) {
+            int64_t row = c->row_base + cur->row;
+            for (int col = cur->col; col < job->ncols; col++) {
+                job->columns[col][row] = csv_missing(job->types[col]);
+            }
+        }
+        cur->col = 0;
+        cur->row++;
+    }
+}
+
+static void csv_scan(CsvJob* job, CsvChunk* c) {
+    NvCsvBlock* masks = (NvCsvBlock*)csv_alloc(sizeof(NvCsvBlock) * CSV_WINDOW_BLOCKS);
+    const uint8_t* data = (const uint8_t*)job->data;
+    CsvCursor cur = {c->begin, 0, 0};
+    uint64_t in_quote = 0;
+    int quotes = 0;
+
+    for (size_t w = c->begin; w < c->end; w += 64 * CSV_WINDOW_BLOCKS) {
+        size_t bytes = c->end - w;
+        if (bytes > 64 * CSV_WINDOW_BLOCKS) bytes = 64 * CSV_WINDOW_BLOCKS;
+        size_t full = bytes / 64;
+        size_t nblocks = full;
+        nv_simd_csv_classify(data + w, full, job->delim, masks);
+        if (bytes % 64) {
+            // Último bloco parcial: cópia com padding (bits além do fim são descartados)
+            uint8_t tail[64];
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, data + w + 64 * full, bytes % 64);
+            nv_simd_csv_classify(tail, 1, job->delim, masks + full);
+            nblocks++;
+        }
+
+        for (size_t b = 0; b < nblocks; b++) {
+            size_t base = w + 64 * b;
+            size_t remaining = c->end - base;
+            uint64_t valid = remaining >= 64 ? ~0ULL : (1ULL << remaining) - 1;
+            NvCsvBlock m = masks[b];
+            m.quote &= valid;
+
+            if (job->phase == CSV_PHASE_QUOTES) {
+                quotes += __builtin_popcountll(m.quote);
+                continue;
+            }
+
+            uint64_t quoted = prefix_xor(m.quote) ^ in_quote;
+            in_quote = (uint64_t)((int64_t)quoted >> 63);
+            uint64_t seps = (m.delim | m.newline) & ~quoted & valid;
+            while (seps) {
+                size_t pos = base + (size_t)__builtin_ctzll(seps);
+                csv_end_field(job, c, &cur, pos, data[pos] == '\n');
+                seps &= seps - 1;
+            }
+        }
+    }
+    free(masks);
+
+    if (job->phase == CSV_PHASE_QUOTES) {
+        c->quote_parity = quotes & 1;
+        return;
+    }
+    // Último registro sem '\n' final
+    if (cur.field_start < c->end || cur.col > 0) csv_end_field(job, c, &cur, c->end, 1);
+    if (job->phase == CSV_PHASE_INFER) c->rows = cur.row;
+}
+
+static void csv_chunk_body(int32_t lo, int32_t hi, int32_t chunk, void* env) {
+    (void)chunk;
+    CsvJob* job = (CsvJob*)env;
+    for (int32_t i = lo; i < hi; i++) csv_scan(job, &job->chunks[i]);
+}
+
+static void csv_run_phase(CsvJob* job, int phase, int32_t nchunks) {
+    job->phase = phase;
+    nv_parallel_for(0, nchunks, nchunks, csv_chunk_body, job);
+}
+
+// Fronteiras dos chunks: cada uma avança até depois do primeiro '\n' fora de aspas
+static void csv_split(CsvJob* job, size_t body, int32_t nchunks) {
+    size_t span = job->len - body;
+    for (int32_t i = 0; i < nchunks; i++) {
+        job->chunks[i].begin = body + span * (size_t)i / (size_t)nchunks;
+        job->chunks[i].end = body + span * (size_t)(i + 1) / (size_t)nchunks;
+    }
+    if (nchunks == 1) return;
+
+    csv_run_phase(job, CSV_PHASE_QUOTES, nchunks);
+    int in_quote = 0;
+    size_t prev = body;
+    for (int32_t i = 1; i < nchunks; i++) {
+        in_quote ^= job->chunks[i - 1].quote_parity;
+        size_t pos = job->chunks[i].begin;
+        int q = in_quote;
+        while (pos < job->len) {
+            char ch = job->data[pos++];
+            if (ch == '"') q ^= 1;
+            else if (ch == '\n' && !q) break;
+        }
+        if (pos < prev) pos = prev;
+        job->chunks[i - 1].end = pos;
+        job->chunks[i].begin = pos;
+        prev = pos;
+    }
+    job->chunks[nchunks - 1].end = job->len;
+}
+
+/* --- Cabeçalho e opções --- */
+
+// Campos do primeiro registro (sem aspas); devolve o início do registro seguinte
+static size_t csv_header(CsvJob* job, size_t pos, char*** names, int* count) {
+    CsvChunk scratch = {0};
+    int cap = 16;
+    *names = (char**)csv_alloc(sizeof(char*) * (size_t)cap);
+    *count = 0;
+    size_t start = pos;
+    int q = 0;
+    for (;;) {
+        int at_end = pos >= job->len;
+        char ch = at_end ? '\n' : job->data[pos];
+        if (!at_end && ch == '"') {
+            q ^= 1;
+        } else if (at_end || (!q && (ch == '\n' || ch == (char)job->delim))) {
+            size_t n = pos - start;
+            if (ch == '\n' && n > 0 && job->data[pos - 1] == '\r') n--;
+            const char* s = unquote(&scratch, job->data + start, &n);
+            if (*count == cap) {
+                cap *= 2;
+                char** grown = (char**)realloc(*names, sizeof(char*) * (size_t)cap);
+                if (!grown) {
+                    fprintf(stderr, "FATAL: realloc failed in csv_load\n");
+                    exit(1);
+                }
+                *names = grown;
+            }
+            char* name = (char*)csv_alloc(n + 1);
+            memcpy(name, s, n);
+            name[n] = '\0';
+            (*names)[(*count)++] = name;
+            start = pos + 1;
+            if (ch == '\n') break;
+        }
+        pos++;
+    }
+    free(scratch.scratch);
+    return pos + 1 < job->len ? pos + 1 : job->len;
+}
+
+static void csv_options(Value* options, uint8_t* delim, int* header) {
+    if (!options) return;
+    Value o = *options;
+    if (o.type != TAG_MAP && o.prototype != map_prototype) return;
+    Map* m = (Map*)(intptr_t)o.value;
+    if (!m) return;
+
+    Value d = map_get_impl(m, "delimiter");
+    const char* ds = d.type == TAG_STR ? (const char*)(intptr_t)d.value : NULL;
+    if (ds && ds[0] && ds[0] != '\n' && ds[0] != '"') *delim = (uint8_t)ds[0];
+
+    Value h = map_get_impl(m, "header");
+    if (h.type == TAG_BOOL || h.type == TAG_INT) *header = h.value != 0;
+}
+
+static char* csv_read_all(int fd, size_t* out_len) {
+    size_t cap = 64 * 1024, len = 0;
+    char* buf = (char*)csv_alloc(cap);
+    for (;;) {
+        if (len == cap) {
+            cap *= 2;
+            char* grown = (char*)realloc(buf, cap);
+            if (!grown) {
+                fprintf(stderr, "FATAL: realloc failed in csv_load\n");
+                exit(1);
+            }
+            buf = grown;
+        }
+        ssize_t n = read(fd, buf + len, cap - len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        len += (size_t)n;
+    }
+    *out_len = len;
+    return buf;
+}
+
+// Nome ainda não usado no map (cabeçalhos repetidos ganham sufixo "_<coluna>")
+static char* unique_name(Map* m, char* name, int col) {
+    for (int i = 0; i < m->size; i++) {
+        if (strcmp(m->keys[i], name) == 0) {
+            size_t n = strlen(name);
+            char* renamed = (char*)csv_alloc(n + 16);
+            snprintf(renamed, n + 16, "%s_%d", name, col);
+            free(name);
+            return unique_name(m, renamed, col);
+        }
+    }
+    return name;
+}
+
+/* --- Entrada --- */
+
+void csv_load(Value* out, const char* filename, Value* options) {
+    uint8_t delim = ',';
+    int header = 1;
+    csv_options(options, &delim, &header);
+
+    int fd = nv_json_open(filename, O_RDONLY, 0);
+    if (fd < 0) {
+        *out = (Value){0};
+        return;
+    }
+    struct stat st;
+    char* buf = NULL;
+    size_t len = 0;
+    int mapped = 0;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        len = (size_t)st.st_size;
+        void* p = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            buf = (char*)p;
+            mapped = 1;
+            madvise(p, len, MADV_WILLNEED);
+        }
+    }
+    if (!buf) buf = csv_read_all(fd, &len);
+    close(fd);
+
+    create_map(out);
+    Map* result = (Map*)(intptr_t)out->value;
+
+    CsvJob job;
+    memset(&job, 0, sizeof(job));
+    job.data = buf;
+    job.len = len;
+    job.delim = delim;
+
+    size_t body = 0;
+    if (len >= 3 && memcmp(buf, "\xEF\xBB\xBF", 3) == 0) body = 3;   // BOM UTF-8
+    while (body < len && (buf[body] == '\n' || buf[body] == '\r')) body++;
+    if (body == len) {
+        if (mapped) munmap(buf, len);
+        else free(buf);
+        return;
+    }
+
+    char** names = NULL;
+    size_t first_row = csv_header(&job, body, &names, &job.ncols);
+    if (header) {
+        body = first_row;
+    } else {
+        for (int col = 0; col < job.ncols; col++) {
+            free(names[col]);
+            names[col] = (char*)csv_alloc(16);
+            snprintf(names[col], 16, "%d", col);
+        }
+    }
+
+    // Um chunk por MB, só acima de alguns MB (mesmo limiar dos loops paralelos)
+    size_t kb = (len - body) / 1024;
+    int32_t nchunks = nv_parallel_chunks(0, kb > INT32_MAX ? INT32_MAX : (int32_t)kb);
+    job.chunks = (CsvChunk*)calloc((size_t)nchunks, sizeof(CsvChunk));
+    uint8_t* types = (uint8_t*)calloc((size_t)nchunks * (size_t)job.ncols + (size_t)job.ncols, 1);
+    if (!job.chunks || !types) {
+        fprintf(stderr, "FATAL: malloc failed in csv_load\n");
+        exit(1);
+    }
+    for (int32_t i = 0; i < nchunks; i++) job.chunks[i].types = types + (size_t)job.ncols * (size_t)(i + 1);
+    csv_split(&job, body, nchunks);
+
+    // Fase A: linhas e tipos por chunk, depois unificados
+    csv_run_phase(&job, CSV_PHASE_INFER, nchunks);
+    int64_t rows = 0;
+    for (int32_t i = 0; i < nchunks; i++) {
+        job.chunks[i].row_base = rows;
+        rows += job.chunks[i].rows;
+        for (int col = 0; col < job.ncols; col++) {
+            if (job.chunks[i].types[col] > types[col]) types[col] = job.chunks[i].types[col];
+        }
+    }
+    if (rows > INT32_MAX) {
+        fprintf(stderr, "FATAL: csv_load: too many rows in %s\n", filename);
+        exit(1);
+    }
+
+    // Fase B: cada chunk escreve nas suas linhas de cada coluna
+    job.types = types;
+    job.columns = (Value**)csv_alloc(sizeof(Value*) * (size_t)job.ncols);
+    for (int col = 0; col < job.ncols; col++) {
+        Value column;
+        create_vector(&column, (int)rows);
+        Vector* vec = (Vector*)(intptr_t)column.value;
+        vec->size = (int)rows;
+        job.columns[col] = vec->elements;
+        map_set_borrowed(result, unique_name(result, names[col], col), column);
+    }
+    csv_run_phase(&job, CSV_PHASE_FILL, nchunks);
+
+    // Strings já foram copiadas para as arenas: o mapeamento pode ser liberado
+    for (int32_t i = 0; i < nchunks; i++) {
+        free(job.chunks[i].table);
+        free(job.chunks[i].scratch);
+    }
+    free(job.chunks);
+    free(job.columns);
+    free(types);
+    free(names);
+    if (mapped) munmap(buf, len);
+    else free(buf);
+}
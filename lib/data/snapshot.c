@@ -0,0 +1,808 @@
+#include "backend/runtime/nv_runtime.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+extern void* string_prototype;
+extern void* array_prototype;
+extern void* vector_prototype;
+extern void* map_prototype;
+
+// Snapshot binário de um grafo de Values. Layout (tudo alinhado em 8 bytes,
+// na ordem de bytes da máquina, verificada pela marca no cabeçalho):
+//
+//   cabeçalho   SnapHeader: magic, versão, slot raiz, offsets das tabelas
+//   nós         array/vector/tupla/campos: u64 n; SnapSlot[n]
+//               map: u64 n; u64 chave[n] (índice de string); SnapSlot[n]
+//               (bit 63 de n: nó referenciado mais de uma vez)
+//               custom opaco: u64 bytes; dados
+//   strings     bytes terminados em '\0', internados (cada conteúdo uma vez)
+//   tabela de strings   u64 n; u64 offset[n]
+//   tabela de tipos     u64 n; u64 offset[n] -> {u64 nome; u64 k; u64 campo[k]}
+//
+// Referências são offsets no arquivo, então containers compartilhados são
+// gravados uma vez e ciclos são representáveis. A escrita é feita direto em
+// um mapeamento compartilhado do arquivo (cresce por ftruncate), sem cópia
+// do snapshot inteiro em memória; o cabeçalho é gravado por último, então
+// um arquivo truncado por uma falha no meio é rejeitado na leitura.
+//
+// A leitura mapeia o arquivo e materializa só o que é pedido: strings e
+// chaves de map apontam direto para o mapeamento (sem cópia) e, com uma
+// chave, só a subárvore dessa entrada do map raiz é visitada.
+//
+// Tipos customizados são gravados pelo nome registrado; na leitura o nome é
+// procurado no TypeRegistry. Se o tipo não existir (ou os campos mudaram),
+// os campos voltam como um map.
+
+#define SNAP_MAGIC "NVSNAP\0"
+#define SNAP_VERSION 1
+#define SNAP_ENDIAN_MARK 0x01020304u
+#define SNAP_MIN_CAPACITY (1 << 20)
+#define SNAP_SHARED (1ULL << 63)
+
+typedef struct {
+    uint32_t tag;        // TAG_* do runtime; 0 = null
+    uint32_t aux;        // TAG_CUSTOM: índice na tabela de tipos
+    uint64_t payload;    // escalar, índice de string ou offset de nó
+} SnapSlot;
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t endian;
+    SnapSlot root;
+    uint64_t strings;    // offset da tabela de strings
+    uint64_t types;      // offset da tabela de tipos
+    uint64_t size;       // tamanho do arquivo
+    uint64_t reserved;
+} SnapHeader;
+
+static void* snap_alloc_mem(size_t size) {
+    void* p = malloc(size ? size : 1);
+    if (!p) {
+        fprintf(stderr, "FATAL: malloc failed in snapshot\n");
+        exit(1);
+    }
+    return p;
+}
+
+// Cresce um array dinâmico para caber `need` itens
+static void snap_grow(void** items, size_t* cap, size_t need, size_t item_size) {
+    if (need <= *cap) return;
+    size_t n = *cap ? *cap * 2 : 64;
+    while (n < need) n *= 2;
+    void* grown = realloc(*items, n * item_size);
+    if (!grown) {
+        fprintf(stderr, "FATAL: realloc failed in snapshot\n");
+        exit(1);
+    }
+    *items = grown;
+    *cap = n;
+}
+
+/* --- Tabela u64 -> u64 (endereçamento aberto; chave 0 = vazio) --- */
+
+typedef struct {
+    uint64_t* keys;
+    uint64_t* vals;
+    size_t cap;
+    size_t len;
+} SnapTable;
+
+static uint64_t snap_mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    return x;
+}
+
+// Slot do valor de `key`; se a chave é nova, ela é inserida e *found = 0.
+// O ponteiro vale até a próxima inserção.
+static uint64_t* table_slot(SnapTable* t, uint64_t key, int* found) {
+    if ((t->len + 1) * 2 > t->cap) {
+        size_t cap = t->cap ? t->cap * 2 : 1024;
+        uint64_t* keys = (uint64_t*)calloc(cap, sizeof(uint64_t));
+        uint64_t* vals = (uint64_t*)calloc(cap, sizeof(uint64_t));
+        if (!keys || !vals) {
+            fprintf(stderr, "FATAL: malloc failed in snapshot\n");
+            exit(1);
+        }
+        for (size_t i = 0; i < t->cap; i++) {
+            if (!t->keys[i]) continue;
+            size_t j = (size_t)snap_mix(t->keys[i]) & (cap - 1);
+            while (keys[j]) j = (j + 1) & (cap - 1);
+            keys[j] = t->keys[i];
+            vals[j] = t->vals[i];
+        }
+        free(t->keys);
+        free(t->vals);
+        t->keys = keys;
+        t->vals = vals;
+        t->cap = cap;
+    }
+    size_t i = (size_t)snap_mix(key) & (t->cap - 1);
+    while (t->keys[i]) {
+        if (t->keys[i] == key) {
+            *found = 1;
+            return &t->vals[i];
+        }
+        i = (i + 1) & (t->cap - 1);
+    }
+    *found = 0;
+    t->keys[i] = key;
+    t->vals[i] = 0;
+    t->len++;
+    return &t->vals[i];
+}
+
+static void table_free(SnapTable* t) {
+    free(t->keys);
+    free(t->vals);
+}
+
+/* ============================================================= */
+/*                    ESCRITA                                    */
+/* ============================================================= */
+
+typedef struct {
+    uint64_t hash;
+    const char* str;     // string do runtime (viva durante a escrita)
+    uint64_t index;
+} SnapString;
+
+typedef struct {
+    const Value* items;
+    char* const* keys;   // map: chaves (as nulas são puladas)
+    int count;
+    uint64_t node;
+} SnapPending;
+
+typedef struct {
+    int fd;
+    char* base;
+    size_t cap;
+    size_t len;
+    int error;
+
+    SnapTable containers;        // ponteiro do container -> offset do nó
+    SnapString* strings;         // internamento por conteúdo
+    size_t strings_cap;
+    size_t strings_len;
+    uint64_t* string_offsets;
+    size_t string_offsets_cap;
+    const TypeInfo** types;
+    size_t types_cap;
+    size_t types_len;
+    SnapPending* pending;
+    size_t pending_cap;
+    size_t pending_len;
+} SnapWriter;
+
+static int writer_remap(SnapWriter* w, size_t need) {
+    size_t cap = w->cap ? w->cap : SNAP_MIN_CAPACITY;
+    while (cap < need) cap *= 2;
+    if (ftruncate(w->fd, (off_t)cap) != 0) return 0;
+    if (w->base) munmap(w->base, w->cap);
+    void* p = mmap(NULL, cap, PROT_READ | PROT_WRITE, MAP_SHARED, w->fd, 0);
+    if (p == MAP_FAILED) {
+        w->base = NULL;
+        w->cap = 0;
+        return 0;
+    }
+    w->base = (char*)p;
+    w->cap = cap;
+    return 1;
+}
+
+// Reserva `n` bytes alinhados; o ponteiro base muda quando o mapeamento cresce,
+// então quem escreve sempre recalcula w->base + offset depois de alocar
+static uint64_t writer_alloc(SnapWriter* w, size_t n) {
+    if (w->error) return 0;
+    size_t off = (w->len + 7) & ~(size_t)7;
+    if (off + n > w->cap && !writer_remap(w, off + n)) {
+        w->error = 1;
+        return 0;
+    }
+    w->len = off + n;
+    return off;
+}
+
+static void writer_u64(SnapWriter* w, uint64_t off, uint64_t v) {
+    memcpy(w->base + off, &v, sizeof(v));
+}
+
+static uint64_t string_hash(const char* s, size_t n) {
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < n; i++) h = (h ^ (unsigned char)s[i]) * 0x100000001B3ULL;
+    return h;
+}
+
+static uint64_t writer_string(SnapWriter* w, const char* s) {
+    size_t n = strlen(s);
+    uint64_t h = string_hash(s, n);
+    if ((w->strings_len + 1) * 2 > w->strings_cap) {
+        size_t cap = w->strings_cap ? w->strings_cap * 2 : 1024;
+        SnapString* table = (SnapString*)calloc(cap, sizeof(SnapString));
+        if (!table) {
+            fprintf(stderr, "FATAL: malloc failed in snapshot\n");
+            exit(1);
+        }
+        for (size_t i = 0; i < w->strings_cap; i++) {
+            if (!w->strings[i].str) continue;
+            size_t j = (size_t)w->strings[i].hash & (cap - 1);
+            while (table[j].str) j = (j + 1) & (cap - 1);
+            table[j] = w->strings[i];
+        }
+        free(w->strings);
+        w->strings = table;
+        w->strings_cap = cap;
+    }
+    size_t i = (size_t)h & (w->strings_cap - 1);
+    while (w->strings[i].str) {
+        if (w->strings[i].hash == h && (w->strings[i].str == s || strcmp(w->strings[i].str, s) == 0)) {
+            return w->strings[i].index;
+        }
+        i = (i + 1) & (w->strings_cap - 1);
+    }
+
+    uint64_t off = writer_alloc(w, n + 1);
+    if (w->error) return 0;
+    memcpy(w->base + off, s, n + 1);
+    uint64_t index = w->strings_len;
+    snap_grow((void**)&w->string_offsets, &w->string_offsets_cap, w->strings_len + 1, sizeof(uint64_t));
+    w->string_offsets[index] = off;
+    w->strings[i] = (SnapString){h, s, index};
+    w->strings_len++;
+    return index;
+}
+
+static uint32_t writer_type(SnapWriter* w, const TypeInfo* info) {
+    for (size_t i = 0; i < w->types_len; i++) {
+        if (w->types[i] == info) return (uint32_t)i;
+    }
+    snap_grow((void**)&w->types, &w->types_cap, w->types_len + 1, sizeof(TypeInfo*));
+    w->types[w->types_len] = info;
+    return (uint32_t)w->types_len++;
+}
+
+// Nó de container: gravado uma vez por ponteiro; os slots são preenchidos
+// depois, a partir da pilha de pendentes (sem recursão)
+static uint64_t writer_container(SnapWriter* w, const void* ptr, const Value* items, char* const* keys, int count) {
+    int found;
+    uint64_t* seen = table_slot(&w->containers, (uint64_t)(uintptr_t)ptr, &found);
+    if (found) {
+        // Segunda referência: só nós marcados passam pela tabela na leitura
+        uint64_t node = *seen;
+        if (!w->error) {
+            uint64_t n;
+            memcpy(&n, w->base + node, sizeof(n));
+            writer_u64(w, node, n | SNAP_SHARED);
+        }
+        return node;
+    }
+
+    int n = count;
+    if (keys) {
+        n = 0;
+        for (int i = 0; i < count; i++) if (keys[i]) n++;
+    }
+    size_t bytes = 8 + (keys ? 8 * (size_t)n : 0) + sizeof(SnapSlot) * (size_t)n;
+    uint64_t node = writer_alloc(w, bytes);
+    if (w->error) return 0;
+    *seen = node;
+    writer_u64(w, node, (uint64_t)n);
+
+    snap_grow((void**)&w->pending, &w->pending_cap, w->pending_len + 1, sizeof(SnapPending));
+    w->pending[w->pending_len++] = (SnapPending){items, keys, count, node};
+    return node;
+}
+
+static SnapSlot writer_slot(SnapWriter* w, Value v) {
+    SnapSlot s = {0, 0, 0};
+    int32_t type = v.type;
+    if (type < TAG_INT || type > TAG_TUPLE) {
+        // any/tag desconhecida: mesma normalização usada pelo print
+        ensure_value_type(&v);
+        if (v.prototype == string_prototype) v.type = TAG_STR;
+        else if (v.prototype == array_prototype) v.type = TAG_ARRAY;
+        else if (v.prototype == vector_prototype) v.type = TAG_VECTOR;
+        else if (v.prototype == map_prototype) v.type = TAG_MAP;
+        type = get_value_type(&v);
+    }
+
+    switch (type) {
+        case TAG_INT:
+        case TAG_FLOAT:
+            s.tag = (uint32_t)type;
+            s.payload = (uint64_t)v.value;
+            return s;
+        case TAG_BOOL:
+            s.tag = TAG_BOOL;
+            s.payload = v.value != 0;
+            return s;
+        case TAG_STR: {
+            const char* str = (const char*)(intptr_t)v.value;
+            if (!str) return s;
+            s.tag = TAG_STR;
+            s.payload = writer_string(w, str);
+            return s;
+        }
+        case TAG_ARRAY:
+        case TAG_VECTOR: {
+            // Array e Vector têm o mesmo layout
+            Vector* vec = (Vector*)(intptr_t)v.value;
+            if (!vec) return s;
+            s.tag = (uint32_t)type;
+            s.payload = writer_container(w, vec, vec->elements, NULL, vec->size);
+            return s;
+        }
+        case TAG_TUPLE: {
+            Tuple* t = (Tuple*)(intptr_t)v.value;
+            if (!t) return s;
+            s.tag = TAG_TUPLE;
+            s.payload = writer_container(w, t, t->fields, NULL, t->field_count);
+            return s;
+        }
+        case TAG_MAP: {
+            Map* m = (Map*)(intptr_t)v.value;
+            if (!m) return s;
+            s.tag = TAG_MAP;
+            s.payload = writer_container(w, m, m->values, m->keys, m->size);
+            return s;
+        }
+        default:
+            break;
+    }
+
+    if (type < TAG_CUSTOM || !v.value) return s;
+    const TypeInfo* info = v.type_info ? (const TypeInfo*)v.type_info : get_value_type_info(&v);
+    if (!info || !info->type_name) return s;
+    const void* data = (const void*)(intptr_t)v.value;
+    if (info->field_names && info->field_count > 0) {
+        s.payload = writer_container(w, data, (const Value*)data, NULL, info->field_count);
+    } else if (info->size > 0) {
+        // Tipo opaco: os bytes como estão (sem ponteiros internos)
+        uint64_t node = writer_alloc(w, 8 + info->size);
+        if (w->error) return s;
+        writer_u64(w, node, (uint64_t)info->size);
+        memcpy(w->base + node + 8, data, info->size);
+        s.payload = node;
+    } else {
+        return s;
+    }
+    s.tag = TAG_CUSTOM;
+    s.aux = writer_type(w, info);
+    return s;
+}
+
+static void writer_drain(SnapWriter* w) {
+    while (w->pending_len > 0 && !w->error) {
+        SnapPending p = w->pending[--w->pending_len];
+        uint64_t n;
+        memcpy(&n, w->base + p.node, sizeof(n));
+        n &= ~SNAP_SHARED;
+        uint64_t keys = p.node + 8;
+        uint64_t slots = keys + (p.keys ? 8 * n : 0);
+        uint64_t j = 0;
+        for (int i = 0; i < p.count && !w->error; i++) {
+            if (p.keys) {
+                if (!p.keys[i]) continue;
+                uint64_t k = writer_string(w, p.keys[i]);
+                if (w->error) break;
+                writer_u64(w, keys + 8 * j, k);
+            }
+            SnapSlot s = writer_slot(w, p.items[i]);
+            if (w->error) break;
+            memcpy(w->base + slots + sizeof(SnapSlot) * j, &s, sizeof(s));
+            j++;
+        }
+    }
+}
+
+static uint64_t writer_type_table(SnapWriter* w) {
+    uint64_t table = writer_alloc(w, 8 + 8 * w->types_len);
+    if (w->error) return 0;
+    writer_u64(w, table, (uint64_t)w->types_len);
+    for (size_t t = 0; t < w->types_len && !w->error; t++) {
+        const TypeInfo* info = w->types[t];
+        int fields = info->field_names ? info->field_count : 0;
+        uint64_t name = writer_string(w, info->type_name);
+        uint64_t record = writer_alloc(w, 16 + 8 * (size_t)fields);
+        if (w->error) break;
+        writer_u64(w, record, name);
+        writer_u64(w, record + 8, (uint64_t)fields);
+        for (int f = 0; f < fields; f++) {
+            uint64_t field = writer_string(w, info->field_names[f] ? info->field_names[f] : "");
+            if (w->error) break;
+            writer_u64(w, record + 16 + 8 * (uint64_t)f, field);
+        }
+        writer_u64(w, table + 8 + 8 * t, record);
+    }
+    return table;
+}
+
+static uint64_t writer_string_table(SnapWriter* w) {
+    uint64_t table = writer_alloc(w, 8 + 8 * w->strings_len);
+    if (w->error) return 0;
+    writer_u64(w, table, (uint64_t)w->strings_len);
+    memcpy(w->base + table + 8, w->string_offsets, 8 * w->strings_len);
+    return table;
+}
+
+int32_t snapshot_save(Value* v, const char* filename) {
+    int fd = nv_json_open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return 0;
+
+    SnapWriter* w = (SnapWriter*)calloc(1, sizeof(SnapWriter));
+    if (!w) {
+        fprintf(stderr, "FATAL: malloc failed in snapshot_save\n");
+        exit(1);
+    }
+    w->fd = fd;
+
+    SnapHeader h;
+    memset(&h, 0, sizeof(h));
+    writer_alloc(w, sizeof(SnapHeader));
+    h.root = writer_slot(w, v ? *v : (Value){0});
+    writer_drain(w);
+    h.types = writer_type_table(w);
+    h.strings = writer_string_table(w);
+
+    int ok = !w->error;
+    if (ok) {
+        memcpy(h.magic, SNAP_MAGIC, sizeof(h.magic));
+        h.version = SNAP_VERSION;
+        h.endian = SNAP_ENDIAN_MARK;
+        h.size = w->len;
+        memcpy(w->base, &h, sizeof(h));
+    }
+    if (w->base) munmap(w->base, w->cap);
+    if (ftruncate(fd, ok ? (off_t)w->len : 0) != 0) ok = 0;
+    if (close(fd) != 0) ok = 0;
+
+    table_free(&w->containers);
+    free(w->strings);
+    free(w->string_offsets);
+    free(w->types);
+    free(w->pending);
+    free(w);
+    return ok;
+}
+
+/* ============================================================= */
+/*                    LEITURA                                    */
+/* ============================================================= */
+
+enum {
+    SNAP_TYPE_UNRESOLVED = 0,
+    SNAP_TYPE_STRUCT,    // registrado com os mesmos campos
+    SNAP_TYPE_OPAQUE,    // registrado, sem campos: bytes copiados
+    SNAP_TYPE_MAP,       // campos voltam como map
+    SNAP_TYPE_NULL       // opaco sem tipo registrado
+};
+
+typedef struct {
+    Value* items;
+    char** keys;          // map: destino das chaves
+    char** names;         // custom como map: nomes dos campos
+    uint64_t node;
+    uint64_t count;
+    int has_keys;         // nó de map (com vetor de chaves)
+} SnapFill;
+
+typedef struct {
+    const char* base;
+    size_t size;
+    int borrowed;         // algum Value aponta para o mapeamento
+
+    const uint64_t* strings;
+    uint64_t string_count;
+    const uint64_t* types;
+    uint64_t type_count;
+    uint8_t* type_mode;
+    TypeInfo** type_info;
+    char*** type_fields;
+
+    SnapTable containers; // offset de nó compartilhado -> índice + 1 em `made`
+    Value* made;
+    size_t made_cap;
+    size_t made_len;
+    SnapFill* pending;
+    size_t pending_cap;
+    size_t pending_len;
+} SnapReader;
+
+// [off, off + n) dentro do arquivo, alinhado
+static int reader_range(const SnapReader* r, uint64_t off, uint64_t n) {
+    return off % 8 == 0 && off <= r->size && n <= r->size - off;
+}
+
+static uint64_t reader_u64(const SnapReader* r, uint64_t off) {
+    uint64_t v;
+    memcpy(&v, r->base + off, sizeof(v));
+    return v;
+}
+
+static const char* reader_string(SnapReader* r, uint64_t index) {
+    if (index >= r->string_count) return NULL;
+    uint64_t off = r->strings[index];
+    if (off >= r->size) return NULL;
+    // O '\0' precisa estar dentro do mapeamento (arquivo truncado ou offset corrompido)
+    if (!memchr(r->base + off, 0, r->size - off)) return NULL;
+    return r->base + off;
+}
+
+static void reader_resolve_type(SnapReader* r, uint32_t t) {
+    r->type_mode[t] = SNAP_TYPE_NULL;
+    uint64_t record = r->types[t];
+    if (!reader_range(r, record, 16)) return;
+    const char* name = reader_string(r, reader_u64(r, record));
+    uint64_t fields = reader_u64(r, record + 8);
+    if (!name || fields > INT32_MAX || !reader_range(r, record + 16, 8 * fields)) return;
+
+    char** names = NULL;
+    if (fields > 0) {
+        names = (char**)snap_alloc_mem(sizeof(char*) * fields);
+        for (uint64_t f = 0; f < fields; f++) {
+            const char* field = reader_string(r, reader_u64(r, record + 16 + 8 * f));
+            names[f] = (char*)(field ? field : "");
+        }
+    }
+    r->type_fields[t] = names;
+
+    TypeInfo* info = get_type_info_by_name(name);
+    r->type_info[t] = info;
+    if (fields == 0) {
+        if (info && info->size > 0) r->type_mode[t] = SNAP_TYPE_OPAQUE;
+        return;
+    }
+    r->type_mode[t] = SNAP_TYPE_MAP;
+    if (!info || !info->field_names || (uint64_t)info->field_count != fields) return;
+    for (uint64_t f = 0; f < fields; f++) {
+        if (!info->field_names[f] || strcmp(info->field_names[f], names[f]) != 0) return;
+    }
+    r->type_mode[t] = SNAP_TYPE_STRUCT;
+}
+
+static Value reader_value(SnapReader* r, SnapSlot s);
+
+// Container do nó `s.payload`; os elementos entram na pilha de pendentes
+static Value reader_container(SnapReader* r, SnapSlot s) {
+    Value v = {0};
+    uint64_t node = s.payload;
+
+    int mode = 0;
+    if (s.tag == TAG_CUSTOM) {
+        if (s.aux >= r->type_count) return v;
+        if (r->type_mode[s.aux] == SNAP_TYPE_UNRESOLVED) reader_resolve_type(r, s.aux);
+        mode = r->type_mode[s.aux];
+        if (mode == SNAP_TYPE_NULL) return v;
+    }
+    if (!reader_range(r, node, 8)) return v;
+    uint64_t n = reader_u64(r, node);
+    uint64_t* made = NULL;
+    if (n & SNAP_SHARED) {
+        int found;
+        made = table_slot(&r->containers, node, &found);
+        // 0 = nó inválido (já rejeitado)
+        if (found) return *made ? r->made[*made - 1] : v;
+        n &= ~SNAP_SHARED;
+    }
+
+    if (mode == SNAP_TYPE_OPAQUE) {
+        TypeInfo* info = r->type_info[s.aux];
+        if (n != info->size || !reader_range(r, node + 8, n)) return v;
+        create_custom(&v, info->type_id, (void*)(r->base + node + 8));
+        v.type_info = info;
+        return v;
+    }
+
+    int has_keys = s.tag == TAG_MAP;
+    if (n > INT32_MAX || n > r->size || !reader_range(r, node + 8, (has_keys ? 8 : 0) * n + sizeof(SnapSlot) * n)) {
+        return v;
+    }
+    if (mode == SNAP_TYPE_MAP || mode == SNAP_TYPE_STRUCT) {
+        // Contagem diferente dos campos do tipo: arquivo corrompido
+        uint64_t record = r->types[s.aux];
+        if (reader_u64(r, record + 8) != n) return v;
+    }
+
+    SnapFill fill = {NULL, NULL, NULL, node, n, has_keys};
+    int count = (int)n;
+    switch (s.tag) {
+        case TAG_ARRAY: {
+            create_array(&v, count);
+            fill.items = ((Array*)(intptr_t)v.value)->elements;
+            break;
+        }
+        case TAG_VECTOR: {
+            create_vector(&v, count);
+            Vector* vec = (Vector*)(intptr_t)v.value;
+            vec->size = count;
+            fill.items = vec->elements;
+            break;
+        }
+        case TAG_TUPLE: {
+            create_tuple(&v, count);
+            fill.items = ((Tuple*)(intptr_t)v.value)->fields;
+            break;
+        }
+        case TAG_MAP:
+        case TAG_CUSTOM: {
+            if (mode == SNAP_TYPE_STRUCT) {
+                TypeInfo* info = r->type_info[s.aux];
+                fill.items = (Value*)snap_alloc_mem(sizeof(Value) * n);
+                v.type = info->type_id;
+                v.value = (int64_t)(intptr_t)fill.items;
+                v.type_info = info;
+                break;
+            }
+            create_map(&v);
+            Map* m = (Map*)(intptr_t)v.value;
+            if (count > m->capacity) {
+                m->keys = (char**)realloc(m->keys, sizeof(char*) * n);
+                m->values = (Value*)realloc(m->values, sizeof(Value) * n);
+                if (!m->keys || !m->values) {
+                    fprintf(stderr, "FATAL: realloc failed in snapshot_load\n");
+                    exit(1);
+                }
+                m->capacity = count;
+            }
+            m->size = count;
+            fill.items = m->values;
+            fill.keys = m->keys;
+            if (mode == SNAP_TYPE_MAP) fill.names = r->type_fields[s.aux];
+            break;
+        }
+        default:
+            return v;
+    }
+
+    if (made) {
+        snap_grow((void**)&r->made, &r->made_cap, r->made_len + 1, sizeof(Value));
+        r->made[r->made_len++] = v;
+        *made = r->made_len;
+    }
+    snap_grow((void**)&r->pending, &r->pending_cap, r->pending_len + 1, sizeof(SnapFill));
+    r->pending[r->pending_len++] = fill;
+    return v;
+}
+
+static Value reader_value(SnapReader* r, SnapSlot s) {
+    Value v = {0};
+    switch (s.tag) {
+        case TAG_INT:
+            create_int(&v, 0);
+            v.value = (int64_t)s.payload;
+            return v;
+        case TAG_FLOAT:
+            create_float(&v, 0.0);
+            v.value = (int64_t)s.payload;
+            return v;
+        case TAG_BOOL:
+            create_bool(&v, s.payload != 0);
+            return v;
+        case TAG_STR: {
+            const char* str = reader_string(r, s.payload);
+            if (str) {
+                // A string continua apontando para o mapeamento
+                r->borrowed = 1;
+                create_str_borrowed(&v, str);
+            }
+            return v;
+        }
+        case TAG_ARRAY:
+        case TAG_VECTOR:
+        case TAG_TUPLE:
+        case TAG_MAP:
+        case TAG_CUSTOM:
+            return reader_container(r, s);
+        default:
+            return v;
+    }
+}
+
+static Value reader_materialize(SnapReader* r, SnapSlot root) {
+    Value out = reader_value(r, root);
+    while (r->pending_len > 0) {
+        SnapFill f = r->pending[--r->pending_len];
+        uint64_t keys = f.node + 8;
+        uint64_t slots = keys + (f.has_keys ? 8 * f.count : 0);
+        for (uint64_t i = 0; i < f.count; i++) {
+            if (f.keys) {
+                const char* key = f.names ? f.names[i] : reader_string(r, reader_u64(r, keys + 8 * i));
+                if (key) r->borrowed = 1;
+                f.keys[i] = (char*)(key ? key : "");
+            }
+            SnapSlot s;
+            memcpy(&s, r->base + slots + sizeof(SnapSlot) * i, sizeof(s));
+            f.items[i] = reader_value(r, s);
+        }
+    }
+    return out;
+}
+
+// Slot da entrada `key` do map raiz (só as chaves são lidas); 0 se não existe
+static int reader_lookup(SnapReader* r, SnapSlot root, const char* key, SnapSlot* out) {
+    if (root.tag != TAG_MAP || !reader_range(r, root.payload, 8)) return 0;
+    uint64_t n = reader_u64(r, root.payload) & ~SNAP_SHARED;
+    uint64_t keys = root.payload + 8;
+    if (n > r->size || !reader_range(r, keys, (8 + sizeof(SnapSlot)) * n)) return 0;
+    for (uint64_t i = 0; i < n; i++) {
+        const char* k = reader_string(r, reader_u64(r, keys + 8 * i));
+        if (k && strcmp(k, key) == 0) {
+            memcpy(out, r->base + keys + 8 * n + sizeof(SnapSlot) * i, sizeof(*out));
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void snapshot_load(Value* out, const char* filename, const char* key) {
+    *out = (Value){0};
+    int fd = nv_json_open(filename, O_RDONLY, 0);
+    if (fd < 0) return;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(SnapHeader)) {
+        close(fd);
+        return;
+    }
+    size_t size = (size_t)st.st_size;
+    void* p = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return;
+
+    SnapReader r;
+    memset(&r, 0, sizeof(r));
+    r.base = (const char*)p;
+    r.size = size;
+
+    SnapHeader h;
+    memcpy(&h, r.base, sizeof(h));
+    int valid = memcmp(h.magic, SNAP_MAGIC, sizeof(h.magic)) == 0 &&
+                h.endian == SNAP_ENDIAN_MARK && h.size == size &&
+                reader_range(&r, h.strings, 8) && reader_range(&r, h.types, 8);
+    if (valid && h.version != SNAP_VERSION) {
+        fprintf(stderr, "snapshot: %s has unsupported version %u\n", filename, h.version);
+        valid = 0;
+    }
+    if (valid) {
+        r.string_count = reader_u64(&r, h.strings);
+        r.type_count = reader_u64(&r, h.types);
+        valid = r.string_count <= size && r.type_count <= size &&
+                reader_range(&r, h.strings + 8, 8 * r.string_count) &&
+                reader_range(&r, h.types + 8, 8 * r.type_count);
+    }
+    if (valid) {
+        r.strings = (const uint64_t*)(r.base + h.strings + 8);
+        r.types = (const uint64_t*)(r.base + h.types + 8);
+        r.type_mode = (uint8_t*)calloc(r.type_count + 1, 1);
+        r.type_info = (TypeInfo**)calloc(r.type_count + 1, sizeof(TypeInfo*));
+        r.type_fields = (char***)calloc(r.type_count + 1, sizeof(char**));
+        if (!r.type_mode || !r.type_info || !r.type_fields) {
+            fprintf(stderr, "FATAL: malloc failed in snapshot_load\n");
+            exit(1);
+        }
+
+        SnapSlot root = h.root;
+        if (!key || reader_lookup(&r, h.root, key, &root)) {
+            madvise(p, size, key ? MADV_RANDOM : MADV_WILLNEED);
+            *out = reader_materialize(&r, root);
+        }
+    }
+
+    // Strings e chaves apontam para o mapeamento: ele só é liberado se
+    // nada do resultado o referencia
+    if (!r.borrowed) munmap(p, size);
+    for (uint64_t t = 0; t < r.type_count && r.type_fields; t++) free(r.type_fields[t]);
+    table_free(&r.containers);
+    free(r.made);
+    free(r.pending);
+    free(r.type_mode);
+    free(r.type_info);
+    free(r.type_fields);
+}
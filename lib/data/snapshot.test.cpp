@@ -0,0 +1,202 @@
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include "test_support.hpp"
+
+extern "C" {
+#include "backend/runtime/prototypes.h"
+#include "backend/runtime/nv_runtime.h"
+}
+
+namespace fs = std::filesystem;
+using namespace nv::test;
+
+namespace {
+    fs::path dir;
+
+    std::string stringify(Value v) {
+        char* s = json_stringify(&v, 0);
+        std::string out = s ? s : "";
+        free(s);
+        return out;
+    }
+
+    // O arquivo ainda está mapeado neste processo?
+    bool mapped(const std::string& path) {
+        return read_file("/proc/self/maps").find(fs::canonical(path).string()) != std::string::npos;
+    }
+
+    Value get(Value map, const char* key) {
+        return map_get_impl((Map*)(intptr_t)map.value, key);
+    }
+
+    char* user_fields[] = {const_cast<char*>("nome"), const_cast<char*>("idade")};
+    TypeInfo user_type = {0, "SnapshotTestUser", 2 * sizeof(Value), nullptr, nullptr, nullptr,
+                          nullptr, nullptr, user_fields, nullptr, 2};
+
+    // Raiz com todos os tipos de Value, um vector compartilhado e um ciclo
+    Value make_root() {
+        Value root;
+        create_map(&root);
+        Map* m = (Map*)(intptr_t)root.value;
+
+        Value vec;
+        create_vector(&vec, 0);
+        Vector* v = (Vector*)(intptr_t)vec.value;
+        Value n, f, b;
+        create_int(&n, -7);
+        create_float(&f, 3.25);
+        create_bool(&b, 1);
+        vector_push_impl(v, n);
+        vector_push_impl(v, f);
+        vector_push_impl(v, b);
+        vector_push_impl(v, Value{});
+
+        Value arr;
+        create_array(&arr, 2);
+        ((Array*)(intptr_t)arr.value)->elements[0] = vec;
+        ((Array*)(intptr_t)arr.value)->elements[1] = vec;
+
+        Value tup, s;
+        create_tuple(&tup, 2);
+        create_str(&s, "aspas \" e \xc3\xa9");
+        ((Tuple*)(intptr_t)tup.value)->fields[0] = s;
+        ((Tuple*)(intptr_t)tup.value)->fields[1] = arr;
+
+        Value fields[2];
+        create_str(&fields[0], "ana");
+        create_int(&fields[1], 30);
+        Value user;
+        create_custom_struct(&user, user_type.type_id, fields);
+        user.type_info = &user_type;
+
+        Value name;
+        create_str(&name, "narval");
+        map_set_impl(m, "tupla", tup);
+        map_set_impl(m, "usuario", user);
+        map_set_impl(m, "nome", name);
+        map_set_impl(m, "numero", n);
+        map_set_impl(m, "eu", root);
+        return root;
+    }
+
+    void test_round_trip() {
+        std::cout << "snapshot.save / snapshot.load\n";
+        auto path = (dir / "root.nvs").string();
+        Value root = make_root();
+        check(snapshot_save(&root, path.c_str()) == 1, "snapshot_save devolve 1");
+
+        Value back;
+        snapshot_load(&back, path.c_str(), nullptr);
+        check(back.type == TAG_MAP && stringify(back) == stringify(root), "grafo inteiro volta igual");
+
+        Value tup = get(back, "tupla");
+        Value arr = tup.type == TAG_TUPLE ? ((Tuple*)(intptr_t)tup.value)->fields[1] : Value{};
+        Array* a = arr.type == TAG_ARRAY ? (Array*)(intptr_t)arr.value : nullptr;
+        check(a && a->elements[0].value == a->elements[1].value, "vector compartilhado continua compartilhado");
+        check(get(back, "eu").value == back.value, "ciclo preservado");
+
+        Value user = get(back, "usuario");
+        check(user.type == user_type.type_id && user.type_info == &user_type &&
+              stringify(user) == "{\"nome\":\"ana\",\"idade\":30}", "tipo customizado pelo nome registrado");
+
+        Value part;
+        snapshot_load(&part, path.c_str(), "nome");
+        check(stringify(part) == "\"narval\"", "load de uma chave");
+        snapshot_load(&part, path.c_str(), "nao_existe");
+        check(part.type == 0, "chave inexistente vira null");
+    }
+
+    // O mapeamento só fica vivo se alguma string do resultado aponta para ele
+    void test_mapping_release() {
+        std::cout << "liberação do mapeamento\n";
+        auto path = (dir / "release.nvs").string();
+        Value root = make_root();
+        snapshot_save(&root, path.c_str());
+
+        Value v;
+        snapshot_load(&v, path.c_str(), "nao_existe");
+        check(!mapped(path), "chave inexistente libera o arquivo");
+        snapshot_load(&v, path.c_str(), "numero");
+        check(!mapped(path), "valor sem strings libera o arquivo");
+        snapshot_load(&v, path.c_str(), "nome");
+        check(mapped(path) && stringify(v) == "\"narval\"", "string carregada mantém o arquivo mapeado");
+    }
+
+    // Arquivo truncado, estendido ou com bytes trocados: null ou um valor
+    // qualquer, nunca leitura fora do mapeamento (rode com ASan)
+    void test_corrupt() {
+        std::cout << "snapshot.load com arquivo inválido\n";
+        Value v;
+        snapshot_load(&v, (dir / "nao_existe.nvs").string().c_str(), nullptr);
+        check(v.type == 0, "arquivo inexistente vira null");
+
+        auto bad = (dir / "bad.nvs").string();
+        write_file(bad, "isto não é um snapshot");
+        snapshot_load(&v, bad.c_str(), nullptr);
+        check(v.type == 0, "arquivo qualquer vira null");
+
+        auto path = (dir / "good.nvs").string();
+        Value root = make_root();
+        snapshot_save(&root, path.c_str());
+        std::string good = read_file(path);
+
+        bool all_null = true;
+        for (size_t len = 0; len < good.size(); len++) {
+            write_file(bad, good.substr(0, len));
+            snapshot_load(&v, bad.c_str(), nullptr);
+            if (v.type != 0) all_null = false;
+        }
+        write_file(bad, good + "x");
+        snapshot_load(&v, bad.c_str(), nullptr);
+        check(all_null && v.type == 0, "arquivo truncado ou estendido vira null");
+
+        // String sem '\0' até o fim do mapeamento: o arquivo ganha bytes não
+        // nulos até fechar uma página e o offset de "narval" aponta para eles
+        uint64_t strings, count;
+        std::memcpy(&strings, good.data() + 32, 8);
+        std::memcpy(&count, good.data() + strings, 8);
+        std::string open_string = good + std::string(4096 - good.size() % 4096, 'x');
+        uint64_t size = open_string.size(), tail = size - 8;
+        std::memcpy(&open_string[48], &size, 8);
+        bool found = false;
+        for (uint64_t i = 0; i < count; i++) {
+            uint64_t off;
+            std::memcpy(&off, good.data() + strings + 8 + 8 * i, 8);
+            if (std::strcmp(good.c_str() + off, "narval") == 0) {
+                std::memcpy(&open_string[strings + 8 + 8 * i], &tail, 8);
+                found = true;
+            }
+        }
+        write_file(bad, open_string);
+        snapshot_load(&v, bad.c_str(), "nome");
+        check(found && v.type == 0, "string sem terminador no fim do arquivo vira null");
+        snapshot_load(&v, bad.c_str(), "numero");
+        check(v.type == TAG_INT && v.value == -7, "demais valores do arquivo continuam legíveis");
+
+        srand(37);
+        for (int i = 0; i < 5000; i++) {
+            std::string mutated = good;
+            for (int k = 0, flips = 1 + rand() % 4; k < flips; k++) {
+                mutated[rand() % mutated.size()] = static_cast<char>(rand());
+            }
+            write_file(bad, mutated);
+            snapshot_load(&v, bad.c_str(), nullptr);
+            snapshot_load(&v, bad.c_str(), "nome");
+        }
+        check(true, "5000 arquivos com bytes trocados sem falha de memória");
+    }
+}
+
+int main() {
+    register_custom_type(&user_type);
+    dir = temp_dir("narval_snapshot_test");
+
+    std::cout << "Iniciando teste de snapshot...\n";
+    test_round_trip();
+    test_mapping_release();
+    test_corrupt();
+    fs::remove_all(dir);
+    return finish("snapshot");
+}
@@ -0,0 +1,268 @@
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+#include <utility>
+#include "test_support.hpp"
+
+extern "C" {
+#include "backend/runtime/prototypes.h"
+#include "backend/runtime/nv_runtime.h"
+}
+
+namespace fs = std::filesystem;
+using namespace nv::test;
+
+namespace {
+    fs::path dir;
+
+    std::string stringify(Value v) {
+        char* s = json_stringify(&v, 0);
+        std::string out = s ? s : "";
+        free(s);
+        return out;
+    }
+
+    // Carrega `content` de um arquivo e devolve o resultado re-serializado
+    std::string load(const std::string& name, const std::string& content) {
+        Value v;
+        json_load(&v, write_file(dir / name, content).c_str());
+        return stringify(v);
+    }
+
+    // json.load: arquivo mapeado, strings analisadas no próprio mapeamento
+    void test_load() {
+        std::cout << "json.load\n";
+        check(load("scalars.json", "[1, -2.5, true, false, null, \"x\"]") == "[1,-2.5,true,false,null,\"x\"]",
+              "escalares");
+        check(load("object.json", "{\"a\": {\"b\": [1, 2]}, \"c\": \"d\"}") == "{\"a\":{\"b\":[1,2]},\"c\":\"d\"}",
+              "objeto aninhado");
+        check(load("spaces.json", "  \n\t{ }  \n") == "{}", "espaços em volta do documento");
+
+        // Escapes são decodificados no mapeamento privado; o arquivo fica intacto
+        std::string escaped = "[\"a\\\"b\", \"\\u00e9\\n\", \"\\\\\"]";
+        auto path = write_file(dir / "escapes.json", escaped);
+        Value v;
+        json_load(&v, path.c_str());
+        check(stringify(v) == "[\"a\\\"b\",\"\xc3\xa9\\n\",\"\\\\\"]", "escapes decodificados");
+        check(read_file(path) == escaped, "arquivo não é alterado pela análise in-place");
+
+        // Strings emprestadas continuam válidas depois que json_load retorna
+        json_load(&v, write_file(dir / "borrowed.json", "{\"nome\": \"narval\"}").c_str());
+        std::string before = stringify(v);
+        Value other;
+        json_load(&other, write_file(dir / "other.json", "{\"nome\": \"outro\"}").c_str());
+        check(stringify(v) == before && before == "{\"nome\":\"narval\"}", "strings sobrevivem ao retorno");
+    }
+
+    void test_load_errors() {
+        std::cout << "json.load com entrada inválida\n";
+        Value v;
+        json_load(&v, (dir / "nao_existe.json").string().c_str());
+        check(v.type == 0, "arquivo inexistente vira null");
+        json_load(&v, write_file(dir / "empty.json", "").c_str());
+        check(v.type == 0, "arquivo vazio vira null");
+        json_load(&v, write_file(dir / "blank.json", " \n ").c_str());
+        check(v.type == 0, "arquivo só com espaços vira null");
+    }
+
+    // Estágio 1 (índice estrutural) e estágio 2 rejeitam documentos malformados
+    void test_parser_errors() {
+        std::cout << "parser com entrada inválida\n";
+        const std::pair<const char*, std::string> cases[] = {
+            {"vírgula sobrando no objeto", "{\"a\": 1,}"},
+            {"vírgula sobrando no array", "[1, 2,]"},
+            {"array sem fechar", "[1, 2"},
+            {"objeto sem dois-pontos", "{\"a\" 1}"},
+            {"chave que não é string", "{1: 2}"},
+            {"string sem fechar", "[\"abc]"},
+            {"valor depois do documento", "[1] 2"},
+            {"fechamento sem abertura", "]"},
+            {"literal incompleto", "[tru]"},
+            {"zero à esquerda", "[01]"},
+            {"número sem dígitos", "[-]"},
+            {"expoente vazio", "[1e]"},
+            {"escape inválido", "[\"\\x\"]"},
+            {"\\u incompleto", "[\"\\u12\"]"},
+            {"caractere de controle na string", std::string("[\"a\x01b\"]")},
+            {"byte UTF-8 inválido", std::string("[\"\xff\"]")},
+            {"UTF-8 truncado no fim", std::string("[\"\xc3")},
+        };
+        int n = 0;
+        for (const auto& [name, doc] : cases) {
+            Value v;
+            json_load(&v, write_file(dir / ("bad" + std::to_string(n++) + ".json"), doc).c_str());
+            check(v.type == 0, name);
+        }
+
+        std::string deep(1024, '[');
+        deep += std::string(1024, ']');
+        check(load("deep.json", deep) == deep, "1024 níveis de aninhamento");
+        std::string too_deep(1025, '[');
+        too_deep += std::string(1025, ']');
+        check(load("too_deep.json", too_deep) == "null", "aninhamento acima do limite vira null");
+        check(load("huge_deep.json", std::string(200000, '[')) == "null", "200000 '[' sem estourar a pilha");
+    }
+
+    // Aspas e barras escapadas em todas as posições em volta dos blocos de 64 bytes
+    void test_parser_blocks() {
+        std::cout << "parser nas fronteiras de bloco e de janela\n";
+        bool all_ok = true;
+        for (int pad = 0; pad < 140; pad++) {
+            for (const char* tail : {"\\\"", "\\\\", "\\\\\\\"", "\\n\\u00e9"}) {
+                std::string doc = "[\"" + std::string(pad, 'x') + tail + "\",1]";
+                std::string expected = doc;
+                if (std::string(tail).find("u00e9") != std::string::npos) {
+                    expected = "[\"" + std::string(pad, 'x') + "\\n\xc3\xa9\",1]";
+                }
+                if (load("block.json", doc) != expected) {
+                    all_ok = false;
+                    std::cout << "    pad " << pad << ": " << doc << "\n";
+                }
+            }
+        }
+        check(all_ok, "escapes em volta de cada fronteira de bloco");
+
+        // Documento maior que a janela do estágio 1 (64 KiB), com um caractere
+        // multibyte e um escape atravessando a fronteira
+        std::string big = "[\"" + std::string(65536 - 3, 'a') + "\xc3\xa9" + "\\\"\"";
+        for (int i = 0; i < 30000; i++) big += "," + std::to_string(i);
+        big += "]";
+        check(load("window.json", big) == big, "valores atravessando a janela de 64 KiB");
+    }
+
+    Value make_str(const char* s) {
+        Value v;
+        create_str(&v, s);
+        return v;
+    }
+
+    Value make_float(double d) {
+        Value v;
+        create_float(&v, d);
+        return v;
+    }
+
+    // json.stringify / json.dump: escapes, números, indentação e ciclos
+    void test_stringify() {
+        std::cout << "json.stringify\n";
+        Value root;
+        create_map(&root);
+        Map* m = (Map*)(intptr_t)root.value;
+        map_set_impl(m, "s", make_str("aspas \" barra \\ tab \t nl \n ctl \x01 \xc3\xa9"));
+        Value items;
+        create_vector(&items, 0);
+        Vector* vec = (Vector*)(intptr_t)items.value;
+        Value n;
+        create_int(&n, -42);
+        vector_push_impl(vec, n);
+        vector_push_impl(vec, make_float(0.1));
+        vector_push_impl(vec, make_float(1e300));
+        vector_push_impl(vec, make_float(std::nan("")));
+        vector_push_impl(vec, make_float(HUGE_VAL));
+        Value b;
+        create_bool(&b, 0);
+        vector_push_impl(vec, b);
+        vector_push_impl(vec, Value{});
+        map_set_impl(m, "v", items);
+        Value empty;
+        create_map(&empty);
+        map_set_impl(m, "e", empty);
+
+        check(stringify(root) ==
+              "{\"s\":\"aspas \\\" barra \\\\ tab \\t nl \\n ctl \\u0001 \xc3\xa9\","
+              "\"v\":[-42,0.1,1e+300,null,null,false,null],\"e\":{}}",
+              "escapes, números e não finitos");
+
+        char* pretty = json_stringify(&items, 2);
+        check(std::string(pretty) == "[\n  -42,\n  0.1,\n  1e+300,\n  null,\n  null,\n  false,\n  null\n]",
+              "indentação");
+        free(pretty);
+
+        // Um vector que contém a si mesmo vira null no ponto do ciclo
+        Value self;
+        create_vector(&self, 0);
+        vector_push_impl((Vector*)(intptr_t)self.value, n);
+        vector_push_impl((Vector*)(intptr_t)self.value, self);
+        check(stringify(self) == "[-42,null]", "ciclo vira null");
+
+        // Floats voltam idênticos depois de serializados e lidos de novo
+        bool exact = true;
+        for (double d : {0.1, 1.0 / 3.0, -2.5e-8, 123456789.125, 5e-324, 1.7976931348623157e308}) {
+            Value back;
+            json_load(&back, write_file(dir / "float.json", "[" + stringify(make_float(d)) + "]").c_str());
+            Vector* bv = back.type == TAG_VECTOR ? (Vector*)(intptr_t)back.value : nullptr;
+            double got = 0;
+            if (bv && bv->size == 1) std::memcpy(&got, &bv->elements[0].value, sizeof(got));
+            if (!bv || bv->size != 1 || bv->elements[0].type != TAG_FLOAT || got != d) exact = false;
+        }
+        check(exact, "floats sobrevivem à ida e volta");
+    }
+
+    void test_dump() {
+        std::cout << "json.dump\n";
+        // Maior que o trecho de 64 KiB esvaziado a cada vez no descritor
+        Value rows;
+        create_vector(&rows, 0);
+        for (int i = 0; i < 20000; i++) {
+            Value row;
+            create_map(&row);
+            Value id;
+            create_int(&id, i);
+            map_set_impl((Map*)(intptr_t)row.value, "id", id);
+            map_set_impl((Map*)(intptr_t)row.value, "tag", make_str(i % 2 ? "par\"impar" : "x"));
+            vector_push_impl((Vector*)(intptr_t)rows.value, row);
+        }
+        auto path = (dir / "dump.json").string();
+        std::string expected = stringify(rows);
+        check(json_dump(&rows, path.c_str(), 0) == 1, "json_dump devolve 1");
+        check(read_file(path) == expected + "\n", "arquivo igual a stringify + nova linha");
+
+        Value back;
+        json_load(&back, path.c_str());
+        check(stringify(back) == expected, "json.load lê de volta o que json.dump gravou");
+
+        auto pretty_path = (dir / "pretty.json").string();
+        char* pretty = json_stringify(&rows, 4);
+        check(json_dump(&rows, pretty_path.c_str(), 4) == 1 && read_file(pretty_path) == std::string(pretty) + "\n",
+              "json_dump com indentação");
+        free(pretty);
+
+        check(json_dump(&rows, (dir / "sem_dir" / "x.json").string().c_str(), 0) == 0,
+              "diretório inexistente devolve 0");
+    }
+
+    // Descritor que não pode ser mapeado: cai na leitura para um buffer único
+    void test_load_pipe() {
+        std::cout << "json.load de um pipe\n";
+        int fds[2];
+        if (pipe(fds) != 0) {
+            check(false, "pipe");
+            return;
+        }
+        std::string doc = "{\"linhas\": [\"a\", \"b\"]}";
+        bool written = write(fds[1], doc.data(), doc.size()) == static_cast<ssize_t>(doc.size());
+        close(fds[1]);
+        Value v;
+        json_load(&v, ("/dev/fd/" + std::to_string(fds[0])).c_str());
+        close(fds[0]);
+        check(written && stringify(v) == "{\"linhas\":[\"a\",\"b\"]}", "documento lido sem mmap");
+    }
+}
+
+int main() {
+    dir = temp_dir("narval_json_test");
+
+    std::cout << "Iniciando teste de JSON...\n";
+    test_load();
+    test_load_errors();
+    test_load_pipe();
+    test_parser_errors();
+    test_parser_blocks();
+    test_stringify();
+    test_dump();
+    fs::remove_all(dir);
+    return finish("JSON");
+}
@@ -0,0 +1,337 @@
+#include "backend/runtime/nv_runtime.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+extern void* string_prototype;
+extern void* array_prototype;
+extern void* vector_prototype;
+extern void* map_prototype;
+
+// Serializador JSON sobre um único buffer crescente. json_stringify acumula o
+// documento inteiro (o buffer é reaproveitado entre chamadas e o resultado é
+// uma cópia de tamanho exato); json_dump esvazia o buffer no descritor a cada
+// 64 KB, então a memória usada não depende do tamanho da saída.
+//
+// Strings são copiadas em trechos: a tabela de escape marca os poucos bytes
+// que precisam de tratamento e o resto vai em um único memcpy. Números usam
+// os formatadores do runtime (pares de dígitos e Grisu2).
+
+#define JSON_DUMP_CHUNK (64 * 1024)
+#define JSON_DUMP_MAX_DEPTH 1024
+
+// 0 = copia direto; 'u' = \u00XX; outro = caractere após a '\'
+static const char json_escape[256] = {
+    'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+    'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+    0, 0, '"', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0,
+    // 0x60..0xFF: nenhum escape (UTF-8 passa intacto)
+};
+
+static const char hex_digits[] = "0123456789abcdef";
+
+typedef enum {
+    JSON_SINK_MEMORY,   // acumula tudo (stringify)
+    JSON_SINK_FD,       // esvazia em `fd`
+    JSON_SINK_STDOUT    // esvazia no buffer de saída do runtime
+} JsonSink;
+
+typedef struct {
+    char* buf;
+    size_t len;
+    size_t cap;
+    JsonSink sink;
+    int fd;
+    int indent;
+    int depth;
+    int error;                                   // falha de escrita no descritor
+    const void* open[JSON_DUMP_MAX_DEPTH];       // containers abertos (detecção de ciclo)
+} JsonWriter;
+
+static void writer_flush(JsonWriter* w) {
+    if (w->len == 0) return;
+    if (w->sink == JSON_SINK_STDOUT) {
+        nv_out_write(w->buf, w->len);
+    } else if (w->sink == JSON_SINK_FD && !w->error) {
+        const char* data = w->buf;
+        size_t left = w->len;
+        while (left > 0) {
+            ssize_t n = write(w->fd, data, left);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                w->error = 1;
+                break;
+            }
+            data += n;
+            left -= (size_t)n;
+        }
+    }
+    w->len = 0;
+}
+
+static void writer_make_room(JsonWriter* w, size_t extra) {
+    if (w->sink != JSON_SINK_MEMORY) {
+        writer_flush(w);
+        if (extra <= w->cap) return;
+    }
+    size_t cap = w->cap ? w->cap : JSON_DUMP_CHUNK;
+    while (cap < w->len + extra) cap *= 2;
+    char* grown = (char*)realloc(w->buf, cap);
+    if (!grown) {
+        fprintf(stderr, "FATAL: realloc failed in json writer\n");
+        exit(1);
+    }
+    w->buf = grown;
+    w->cap = cap;
+}
+
+// Garante espaço para mais `extra` bytes
+static inline void writer_reserve(JsonWriter* w, size_t extra) {
+    if (w->len + extra > w->cap) writer_make_room(w, extra);
+}
+
+static inline void put_raw(JsonWriter* w, const char* s, size_t n) {
+    writer_reserve(w, n);
+    memcpy(w->buf + w->len, s, n);
+    w->len += n;
+}
+
+static inline void put_char(JsonWriter* w, char c) {
+    writer_reserve(w, 1);
+    w->buf[w->len++] = c;
+}
+
+static void put_newline(JsonWriter* w) {
+    size_t n = (size_t)w->indent * (size_t)w->depth;
+    writer_reserve(w, n + 1);
+    w->buf[w->len++] = '\n';
+    memset(w->buf + w->len, ' ', n);
+    w->len += n;
+}
+
+static void put_string(JsonWriter* w, const char* s) {
+    const unsigned char* p = (const unsigned char*)s;
+    put_char(w, '"');
+    for (;;) {
+        const unsigned char* run = p;
+        while (*p && !json_escape[*p]) p++;
+        if (p > run) put_raw(w, (const char*)run, (size_t)(p - run));
+        if (!*p) break;
+
+        char e = json_escape[*p];
+        writer_reserve(w, 6);
+        w->buf[w->len++] = '\\';
+        if (e == 'u') {
+            w->buf[w->len++] = 'u';
+            w->buf[w->len++] = '0';
+            w->buf[w->len++] = '0';
+            w->buf[w->len++] = hex_digits[*p >> 4];
+            w->buf[w->len++] = hex_digits[*p & 0xF];
+        } else {
+            w->buf[w->len++] = e;
+        }
+        p++;
+    }
+    put_char(w, '"');
+}
+
+static void put_double(JsonWriter* w, double d) {
+    if (!isfinite(d)) {
+        put_raw(w, "null", 4);
+        return;
+    }
+    writer_reserve(w, NV_FORMAT_BUFFER_SIZE);
+    w->len += (size_t)nv_format_double(d, w->buf + w->len);
+}
+
+static void put_int(JsonWriter* w, int64_t v) {
+    writer_reserve(w, NV_FORMAT_BUFFER_SIZE);
+    w->len += (size_t)nv_format_int64(v, w->buf + w->len);
+}
+
+// Entra em um container; 0 se ele já está aberto (ciclo) ou é fundo demais
+static int enter_container(JsonWriter* w, const void* ptr) {
+    if (w->depth >= JSON_DUMP_MAX_DEPTH) return 0;
+    for (int i = 0; i < w->depth; i++) {
+        if (w->open[i] == ptr) return 0;
+    }
+    w->open[w->depth++] = ptr;
+    return 1;
+}
+
+static void put_value(JsonWriter* w, Value v);
+
+static void put_elements(JsonWriter* w, const void* ptr, const Value* items, int count) {
+    if (!enter_container(w, ptr)) {
+        put_raw(w, "null", 4);
+        return;
+    }
+    put_char(w, '[');
+    for (int i = 0; i < count; i++) {
+        if (i > 0) put_char(w, ',');
+        if (w->indent) put_newline(w);
+        put_value(w, items[i]);
+    }
+    w->depth--;
+    if (w->indent && count > 0) put_newline(w);
+    put_char(w, ']');
+}
+
+static void put_fields(JsonWriter* w, const void* ptr, char* const* keys, const Value* values, int count) {
+    if (!enter_container(w, ptr)) {
+        put_raw(w, "null", 4);
+        return;
+    }
+    put_char(w, '{');
+    int first = 1;
+    for (int i = 0; i < count; i++) {
+        if (!keys[i]) continue;
+        if (!first) put_char(w, ',');
+        first = 0;
+        if (w->indent) put_newline(w);
+        put_string(w, keys[i]);
+        if (w->indent) put_raw(w, ": ", 2);
+        else put_char(w, ':');
+        put_value(w, values[i]);
+    }
+    w->depth--;
+    if (w->indent && !first) put_newline(w);
+    put_char(w, '}');
+}
+
+static void put_value(JsonWriter* w, Value v) {
+    int32_t type = v.type;
+    if (type < TAG_INT || type > TAG_TUPLE) {
+        // any/tag desconhecida: mesma normalização usada pelo print
+        ensure_value_type(&v);
+        if (v.prototype == string_prototype) v.type = TAG_STR;
+        else if (v.prototype == array_prototype) v.type = TAG_ARRAY;
+        else if (v.prototype == vector_prototype) v.type = TAG_VECTOR;
+        else if (v.prototype == map_prototype) v.type = TAG_MAP;
+        type = get_value_type(&v);
+    }
+
+    switch (type) {
+        case TAG_INT:
+            put_int(w, v.value);
+            return;
+        case TAG_FLOAT: {
+            double d;
+            memcpy(&d, &v.value, sizeof(double));
+            put_double(w, d);
+            return;
+        }
+        case TAG_BOOL:
+            if (v.value) put_raw(w, "true", 4);
+            else put_raw(w, "false", 5);
+            return;
+        case TAG_STR: {
+            const char* s = (const char*)(intptr_t)v.value;
+            if (s) put_string(w, s);
+            else put_raw(w, "null", 4);
+            return;
+        }
+        case TAG_ARRAY: {
+            Array* a = (Array*)(intptr_t)v.value;
+            if (a) put_elements(w, a, a->elements, a->size);
+            else put_raw(w, "null", 4);
+            return;
+        }
+        case TAG_VECTOR: {
+            Vector* vec = (Vector*)(intptr_t)v.value;
+            if (vec) put_elements(w, vec, vec->elements, vec->size);
+            else put_raw(w, "null", 4);
+            return;
+        }
+        case TAG_TUPLE: {
+            Tuple* t = (Tuple*)(intptr_t)v.value;
+            if (t) put_elements(w, t, t->fields, t->field_count);
+            else put_raw(w, "null", 4);
+            return;
+        }
+        case TAG_MAP: {
+            Map* m = (Map*)(intptr_t)v.value;
+            if (m) put_fields(w, m, m->keys, m->values, m->size);
+            else put_raw(w, "null", 4);
+            return;
+        }
+        default:
+            // Tipos customizados struct-like viram objetos com os nomes dos campos
+            if (type >= TAG_CUSTOM) {
+                TypeInfo* info = get_value_type_info(&v);
+                Value* fields = (Value*)(intptr_t)v.value;
+                if (info && info->field_names && info->field_count > 0 && fields) {
+                    put_fields(w, fields, info->field_names, fields, info->field_count);
+                    return;
+                }
+            }
+            put_raw(w, "null", 4);
+            return;
+    }
+}
+
+static void writer_init(JsonWriter* w, JsonSink sink, int fd, int32_t indent) {
+    w->len = 0;
+    w->sink = sink;
+    w->fd = fd;
+    w->indent = indent > 0 ? indent : 0;
+    w->depth = 0;
+    w->error = 0;
+}
+
+// Buffer de json_stringify, reaproveitado entre chamadas (uma por thread)
+static __thread JsonWriter* string_writer = NULL;
+
+char* json_stringify(Value* v, int32_t indent) {
+    if (!string_writer) {
+        string_writer = (JsonWriter*)calloc(1, sizeof(JsonWriter));
+        if (!string_writer) {
+            fprintf(stderr, "FATAL: malloc failed in json_stringify\n");
+            exit(1);
+        }
+    }
+    JsonWriter* w = string_writer;
+    writer_init(w, JSON_SINK_MEMORY, -1, indent);
+    put_value(w, v ? *v : (Value){0});
+
+    char* out = (char*)malloc(w->len + 1);
+    if (!out) {
+        fprintf(stderr, "FATAL: malloc failed in json_stringify\n");
+        exit(1);
+    }
+    memcpy(out, w->buf, w->len);
+    out[w->len] = '\0';
+    return out;
+}
+
+int32_t json_dump(Value* v, const char* filename, int32_t indent) {
+    int to_stdout = filename && strcmp(filename, "-") == 0;
+    int fd = -1;
+    if (!to_stdout) {
+        fd = nv_json_open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return 0;
+    }
+
+    JsonWriter* w = (JsonWriter*)calloc(1, sizeof(JsonWriter));
+    if (!w) {
+        fprintf(stderr, "FATAL: malloc failed in json_dump\n");
+        exit(1);
+    }
+    writer_init(w, to_stdout ? JSON_SINK_STDOUT : JSON_SINK_FD, fd, indent);
+    put_value(w, v ? *v : (Value){0});
+    put_char(w, '\n');
+    writer_flush(w);
+
+    int ok = !w->error;
+    if (fd >= 0 && close(fd) != 0) ok = 0;
+    free(w->buf);
+    free(w);
+    return ok;
+}
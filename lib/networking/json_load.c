@@ -1,7 +1,12 @@
 #include "backend/runtime/nv_runtime.h"
+#include <errno.h>
+#include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 // Weak default for base directory; strong definitions in drivers override this
 #if defined(__GNUC__)
@@ -10,102 +15,555 @@ __attribute__((weak)) const char* nv_base_dir = NULL;
 const char* nv_base_dir = NULL;
 #endif
 
-static Value json_parse_value(const char** ptr);
+// Parser em dois estágios (no estilo simdjson), in-place sobre um buffer
+// gravável (o arquivo mapeado com MAP_PRIVATE, ou uma cópia única da entrada).
+//
+// Estágio 1: cada bloco de 64 bytes é classificado pelos kernels SIMD em
+// máscaras (aspas, '\', operadores, espaços); escapes e o interior das
+// strings são resolvidos com aritmética de bits e as posições estruturais
+// (operadores, aspas não escapadas e início de escalares) vão para um índice.
+// O índice é produzido por janelas, então a memória extra é constante.
+//
+// Estágio 2: percorre o índice montando os Values. Chaves e strings são
+// terminadas com '\0' no lugar da aspa de fechamento e referenciadas sem
+// cópia; escapes são decodificados no próprio buffer (o resultado nunca é
+// maior que o texto original), e só quando a string contém '\'. Strings do
+// runtime são imutáveis e nunca liberadas, então o buffer fica vivo enquanto
+// houver referências; se nenhuma foi criada, é liberado ao final.
+//
+// A entrada é validada (estrutura, escapes, UTF-8, caracteres de controle
+// em strings); JSON inválido resulta em null.
 
-static void skip_ws(const char** ptr) {
-    while (**ptr && (**ptr == ' ' || **ptr == '\t' || **ptr == '\n' || **ptr == '\r')) (*ptr)++;
+#define JSON_WINDOW (64 * 1024)    // bytes indexados por vez (múltiplo de 64)
+#define JSON_WINDOW_BLOCKS (JSON_WINDOW / 64)
+#define JSON_MAX_DEPTH 1024
+#define JSON_END ((size_t)-1)
+
+typedef struct {
+    char* buf;
+    size_t len;
+
+    // Estágio 1
+    size_t scanned;            // bytes já classificados
+    size_t utf8_checked;       // bytes já validados como UTF-8
+    NvJsonBlock* masks;        // classificação dos blocos da janela atual
+    uint32_t* index;           // posições estruturais da janela (relativas a `base`)
+    size_t base;
+    int window_backslash;      // a janela atual contém alguma '\'
+    size_t count;
+    size_t next;
+    uint64_t prev_escaped;     // último byte do bloco anterior escapa o próximo
+    uint64_t prev_in_string;   // ~0 se o bloco anterior terminou dentro de string
+    uint64_t prev_scalar;      // 1 se o bloco anterior terminou num escalar
+
+    // Estágio 2
+    size_t borrowed;           // strings/chaves que apontam para o buffer
+    int depth;
+    int error;
+} JsonParser;
+
+/* --- Estágio 1: índice estrutural --- */
+
+// Bits precedidos por um número ímpar de '\' consecutivos
+static uint64_t find_escaped(uint64_t backslash, uint64_t* prev_escaped) {
+    uint64_t escaped = *prev_escaped;
+    *prev_escaped = 0;
+    if (!backslash) return escaped;
+    // Raro em dados reais: percorre só as barras, em ordem
+    while (backslash) {
+        int i = __builtin_ctzll(backslash);
+        backslash &= backslash - 1;
+        if (escaped & (1ULL << i)) continue;   // barra escapada não escapa nada
+        if (i == 63) *prev_escaped = 1;
+        else escaped |= 1ULL << (i + 1);
+    }
+    return escaped;
+}
+
+// Bit i = XOR dos bits 0..i (1 entre uma aspa de abertura e a de fechamento)
+static uint64_t prefix_xor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+// Valida UTF-8 em [from, to); devolve até onde validou (uma sequência incompleta
+// no fim fica para a próxima janela, exceto se `final`) ou JSON_END se inválido
+static size_t utf8_validate(const unsigned char* s, size_t from, size_t to, int final) {
+    size_t i = from;
+    while (i < to) {
+        if (i + 8 <= to) {
+            uint64_t word;
+            memcpy(&word, s + i, 8);
+            if ((word & 0x8080808080808080ULL) == 0) { i += 8; continue; }
+        }
+        unsigned char c = s[i];
+        if (c < 0x80) { i++; continue; }
+
+        size_t n;
+        unsigned char lo = 0x80, hi = 0xBF;   // faixa do 2º byte
+        if (c >= 0xC2 && c <= 0xDF) n = 2;
+        else if (c >= 0xE0 && c <= 0xEF) {
+            n = 3;
+            if (c == 0xE0) lo = 0xA0;          // sem formas longas
+            if (c == 0xED) hi = 0x9F;          // sem surrogates
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            n = 4;
+            if (c == 0xF0) lo = 0x90;
+            if (c == 0xF4) hi = 0x8F;          // até U+10FFFF
+        } else {
+            return JSON_END;
+        }
+        if (i + n > to) return final ? JSON_END : i;
+        if (s[i + 1] < lo || s[i + 1] > hi) return JSON_END;
+        for (size_t k = 2; k < n; k++) {
+            if ((s[i + k] & 0xC0) != 0x80) return JSON_END;
+        }
+        i += n;
+    }
+    return i;
+}
+
+// Classifica a próxima janela; 0 quando não há mais entrada (ou em erro)
+static int stage1_fill(JsonParser* p) {
+    p->count = 0;
+    p->next = 0;
+    if (p->error || p->scanned >= p->len) return 0;
+
+    size_t window_start = p->scanned;
+    size_t window_end = window_start + JSON_WINDOW;
+    if (window_end > p->len) window_end = p->len;
+    p->base = window_start;
+
+    size_t nblocks = (window_end - window_start) / 64;
+    nv_simd_json_classify((const uint8_t*)p->buf + window_start, nblocks, p->masks);
+    size_t rest = (window_end - window_start) % 64;
+    if (rest) {
+        // Último bloco: completa com espaços (nunca lê além do mapeamento)
+        uint8_t tail[64];
+        memset(tail, ' ', sizeof(tail));
+        memcpy(tail, p->buf + window_start + 64 * nblocks, rest);
+        nv_simd_json_classify(tail, 1, p->masks + nblocks);
+        nblocks++;
+    }
+
+    uint64_t high = 0;
+    uint64_t backslashes = 0;
+    for (size_t b = 0; b < nblocks; b++) {
+        const NvJsonBlock m = p->masks[b];
+        uint64_t valid = (rest && b == nblocks - 1) ? (1ULL << rest) - 1 : ~0ULL;
+        high |= m.high;
+        backslashes |= m.backslash;
+
+        uint64_t escaped = find_escaped(m.backslash, &p->prev_escaped);
+        uint64_t quotes = m.quote & ~escaped;
+        uint64_t in_string = prefix_xor(quotes) ^ p->prev_in_string;
+        p->prev_in_string = (uint64_t)((int64_t)in_string >> 63);
+
+        if (m.control & in_string & valid) {
+            p->error = 1;
+            return 0;
+        }
+
+        uint64_t scalar = ~(m.op | m.space | m.quote) & ~in_string;
+        uint64_t scalar_start = scalar & ~((scalar << 1) | p->prev_scalar);
+        p->prev_scalar = scalar >> 63;
+
+        uint64_t structural = ((m.op & ~in_string) | quotes | scalar_start) & valid;
+        // Grava 4 posições por iteração (o índice tem folga para o excesso)
+        uint32_t offset = (uint32_t)(64 * b);
+        uint32_t* out = p->index + p->count;
+        p->count += (size_t)__builtin_popcountll(structural);
+        while (structural) {
+            out[0] = offset + (uint32_t)__builtin_ctzll(structural);
+            structural &= structural - 1;
+            out[1] = offset + (uint32_t)__builtin_ctzll(structural | (1ULL << 63));
+            structural &= structural - 1;
+            out[2] = offset + (uint32_t)__builtin_ctzll(structural | (1ULL << 63));
+            structural &= structural - 1;
+            out[3] = offset + (uint32_t)__builtin_ctzll(structural | (1ULL << 63));
+            structural &= structural - 1;
+            out += 4;
+        }
+    }
+    p->scanned = window_end;
+    p->window_backslash = backslashes != 0;
+
+    if (!high && p->utf8_checked == window_start) {
+        p->utf8_checked = window_end;   // janela só ASCII
+    } else {
+        size_t done = utf8_validate((const unsigned char*)p->buf, p->utf8_checked, window_end,
+                                    window_end == p->len);
+        if (done == JSON_END) {
+            p->error = 1;
+            return 0;
+        }
+        p->utf8_checked = done;
+    }
+    return 1;
+}
+
+static inline size_t next_structural(JsonParser* p) {
+    while (p->next == p->count) {
+        if (!stage1_fill(p)) return JSON_END;
+    }
+    return p->base + p->index[p->next++];
+}
+
+/* --- Estágio 2: construção dos Values --- */
+
+static Value json_fail(JsonParser* p) {
+    p->error = 1;
+    return (Value){0};
+}
+
+static int hex_value(char ch) {
+    if (ch >= '0' && ch <= '9') return ch - '0';
+    if (ch >= 'a' && ch <= 'f') return ch - 'a' + 10;
+    if (ch >= 'A' && ch <= 'F') return ch - 'A' + 10;
+    return -1;
+}
+
+// Lê os 4 dígitos de \uXXXX a partir de `p`; -1 se inválido
+static long read_hex4(const char* p, const char* end) {
+    if (end - p < 4) return -1;
+    long cp = 0;
+    for (int i = 0; i < 4; i++) {
+        int h = hex_value(p[i]);
+        if (h < 0) return -1;
+        cp = (cp << 4) | h;
+    }
+    return cp;
+}
+
+static char* put_utf8(char* w, long cp) {
+    if (cp < 0x80) {
+        *w++ = (char)cp;
+    } else if (cp < 0x800) {
+        *w++ = (char)(0xC0 | (cp >> 6));
+        *w++ = (char)(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        *w++ = (char)(0xE0 | (cp >> 12));
+        *w++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+        *w++ = (char)(0x80 | (cp & 0x3F));
+    } else {
+        *w++ = (char)(0xF0 | (cp >> 18));
+        *w++ = (char)(0x80 | ((cp >> 12) & 0x3F));
+        *w++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+        *w++ = (char)(0x80 | (cp & 0x3F));
+    }
+    return w;
+}
+
+// Decodifica in-place os escapes de [bs, close), terminando a string; 0 se inválido
+static int decode_escapes(char* bs, char* close) {
+    char* w = bs;
+    char* r = bs;
+    while (r < close) {
+        if (*r != '\\') {
+            *w++ = *r++;
+            continue;
+        }
+        if (++r >= close) return 0;
+        char esc = *r++;
+        switch (esc) {
+            case '"': case '\\': case '/': *w++ = esc; break;
+            case 'n': *w++ = '\n'; break;
+            case 't': *w++ = '\t'; break;
+            case 'r': *w++ = '\r'; break;
+            case 'b': *w++ = '\b'; break;
+            case 'f': *w++ = '\f'; break;
+            case 'u': {
+                long cp = read_hex4(r, close);
+                if (cp < 0) return 0;
+                r += 4;
+                if (cp >= 0xDC00 && cp <= 0xDFFF) return 0;   // surrogate baixo isolado
+                if (cp >= 0xD800 && cp <= 0xDBFF) {
+                    // Surrogate alto exige o baixo em seguida: viram um único code point
+                    if (close - r < 6 || r[0] != '\\' || r[1] != 'u') return 0;
+                    long lo = read_hex4(r + 2, close);
+                    if (lo < 0xDC00 || lo > 0xDFFF) return 0;
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                    r += 6;
+                }
+                w = put_utf8(w, cp);
+                break;
+            }
+            default:
+                return 0;
+        }
+    }
+    *w = '\0';
+    return 1;
+}
+
+// Há '\' em [from, to)? Usa as máscaras do estágio 1 quando a string está toda
+// na janela atual (o caso comum), sem reler os bytes
+static int has_backslash(const JsonParser* p, size_t from, size_t to) {
+    if (from >= to) return 0;
+    if (from < p->base) return memchr(p->buf + from, '\\', to - from) != NULL;
+    if (!p->window_backslash) return 0;
+    size_t first = from - p->base;
+    size_t last = to - 1 - p->base;
+    for (size_t b = first / 64; b <= last / 64; b++) {
+        uint64_t bits = p->masks[b].backslash;
+        if (b == first / 64) bits &= ~0ULL << (first % 64);
+        if (b == last / 64 && last % 64 != 63) bits &= (1ULL << (last % 64 + 1)) - 1;
+        if (bits) return 1;
+    }
+    return 0;
+}
+
+// `open` é a aspa de abertura; a de fechamento é a próxima posição do índice
+static char* json_parse_string(JsonParser* p, size_t open) {
+    size_t close = next_structural(p);
+    if (close == JSON_END || p->buf[close] != '"') {
+        p->error = 1;
+        return NULL;
+    }
+    char* start = p->buf + open + 1;
+    char* end = p->buf + close;
+    if (has_backslash(p, open + 1, close)) {
+        char* bs = (char*)memchr(start, '\\', (size_t)(end - start));
+        if (!decode_escapes(bs, end)) {
+            p->error = 1;
+            return NULL;
+        }
+    } else {
+        *end = '\0';
+    }
+    p->borrowed++;
+    return start;
+}
+
+static int is_delimiter(const JsonParser* p, size_t pos) {
+    if (pos >= p->len) return 1;
+    switch (p->buf[pos]) {
+        case ' ': case '\t': case '\n': case '\r':
+        case ',': case ':': case ']': case '}': case '[': case '{': case '"':
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static int is_digit(char ch) {
+    return ch >= '0' && ch <= '9';
+}
+
+static Value json_parse_number(JsonParser* p, size_t pos) {
+    const char* s = p->buf;
+    size_t i = pos;
+    int negative = 0;
+    if (s[i] == '-') { negative = 1; i++; }
+
+    // Parte inteira: 0 ou [1-9][0-9]*, acumulada enquanto couber em int64
+    size_t digits_start = i;
+    uint64_t n = 0;
+    if (i >= p->len || !is_digit(s[i])) return json_fail(p);
+    if (s[i] == '0') {
+        i++;
+    } else {
+        while (i < p->len && is_digit(s[i])) {
+            n = n * 10 + (uint64_t)(s[i] - '0');
+            i++;
+        }
+    }
+    size_t int_digits = i - digits_start;
+
+    int is_float = 0;
+    if (i < p->len && s[i] == '.') {
+        is_float = 1;
+        i++;
+        if (i >= p->len || !is_digit(s[i])) return json_fail(p);
+        while (i < p->len && is_digit(s[i])) i++;
+    }
+    if (i < p->len && (s[i] == 'e' || s[i] == 'E')) {
+        is_float = 1;
+        i++;
+        if (i < p->len && (s[i] == '+' || s[i] == '-')) i++;
+        if (i >= p->len || !is_digit(s[i])) return json_fail(p);
+        while (i < p->len && is_digit(s[i])) i++;
+    }
+    if (!is_delimiter(p, i)) return json_fail(p);
+
+    Value v;
+    // Caminho rápido: inteiro com até 18 dígitos (cabe em int64 sem strtod)
+    if (!is_float && int_digits <= 18) {
+        int64_t signed_n = negative ? -(int64_t)n : (int64_t)n;
+        create_int(&v, (int32_t)signed_n);
+        return v;
+    }
+
+    // O buffer mapeado não termina em '\0': strtod trabalha sobre uma cópia do token
+    size_t len = i - pos;
+    char small[64];
+    char* tok = small;
+    if (len >= sizeof(small)) {
+        tok = (char*)malloc(len + 1);
+        if (!tok) {
+            fprintf(stderr, "FATAL: malloc failed in json_parse_number\n");
+            exit(1);
+        }
+    }
+    memcpy(tok, s + pos, len);
+    tok[len] = '\0';
+    double d = strtod(tok, NULL);
+    if (tok != small) free(tok);
+    if (d == (int64_t)d) { create_int(&v, (int64_t)d); }
+    else { create_float(&v, d); }
+    return v;
 }
 
-static Value json_parse_object(const char** ptr) {
+static int match_literal(const JsonParser* p, size_t pos, const char* lit, size_t len) {
+    return p->len - pos >= len && memcmp(p->buf + pos, lit, len) == 0 && is_delimiter(p, pos + len);
+}
+
+static Value json_parse_value(JsonParser* p, size_t pos);
+
+static Value json_parse_object(JsonParser* p) {
     Value obj;
     create_map(&obj);
-    (*ptr)++; // skip '{'
-    skip_ws(ptr);
-
-    while (**ptr && **ptr != '}') {
-        skip_ws(ptr);
-        if (**ptr != '"') break;
-        (*ptr)++; // skip quote
-
-        // parse key
-        const char* start = *ptr;
-        while (**ptr && **ptr != '"') (*ptr)++;
-        int len = *ptr - start;
-        char* key = malloc(len + 1);
-        memcpy(key, start, len); key[len] = '\0';
-        (*ptr)++; // skip quote
-        skip_ws(ptr);
-        if (**ptr != ':') { free(key); break; }
-        (*ptr)++; // skip :
-        skip_ws(ptr);
-
-        Value val = json_parse_value(ptr);
-        map_set_method(&obj, key, val);
-        free(key);
-
-        skip_ws(ptr);
-        if (**ptr == ',') (*ptr)++;
-        else if (**ptr != '}') break;
-    }
-    if (**ptr == '}') (*ptr)++;
-    return obj;
-}
-
-static Value json_parse_array(const char** ptr) {
+    Map* m = (Map*)(intptr_t)obj.value;
+
+    size_t t = next_structural(p);
+    if (t != JSON_END && p->buf[t] == '}') return obj;
+    for (;;) {
+        if (t == JSON_END || p->buf[t] != '"') return json_fail(p);
+        char* key = json_parse_string(p, t);
+        if (!key) return json_fail(p);
+        t = next_structural(p);
+        if (t == JSON_END || p->buf[t] != ':') return json_fail(p);
+
+        Value val = json_parse_value(p, next_structural(p));
+        if (p->error) return (Value){0};
+        map_set_borrowed(m, key, val);
+
+        t = next_structural(p);
+        if (t == JSON_END) return json_fail(p);
+        if (p->buf[t] == '}') return obj;
+        if (p->buf[t] != ',') return json_fail(p);
+        t = next_structural(p);
+    }
+}
+
+static Value json_parse_array(JsonParser* p) {
     Value arr;
     create_vector(&arr, 0);
-    (*ptr)++; // skip '['
-    skip_ws(ptr);
-
-    while (**ptr && **ptr != ']') {
-        Value val = json_parse_value(ptr);
-        Value tmp_out; /* vector_push_method requires an out parameter */
-        vector_push_method(&tmp_out, &arr, &val);
-        skip_ws(ptr);
-        if (**ptr == ',') (*ptr)++;
-    }
-    if (**ptr == ']') (*ptr)++;
-    return arr;
-}
-
-static Value json_parse_value(const char** ptr) {
-    skip_ws(ptr);
-    if (!**ptr) return (Value){0};
-
-    if (**ptr == '{') return json_parse_object(ptr);
-    if (**ptr == '[') return json_parse_array(ptr);
-    if (**ptr == '"') {
-        (*ptr)++; // skip quote
-        const char* start = *ptr;
-        while (**ptr && **ptr != '"') (*ptr)++;
-        int len = *ptr - start;
-        char* s = malloc(len + 1);
-        memcpy(s, start, len); s[len] = '\0';
-        (*ptr)++; // skip quote
-        Value str; create_str(&str, s); free(s);
-        return str;
-    }
-    if (strncmp(*ptr, "true", 4) == 0) { *ptr += 4; Value b; create_bool(&b, 1); return b; }
-    if (strncmp(*ptr, "false", 5) == 0) { *ptr += 5; Value b; create_bool(&b, 0); return b; }
-    if (strncmp(*ptr, "null", 4) == 0) { *ptr += 4; return (Value){0}; }
-
-    // number
-    char* end;
-    double d = strtod(*ptr, &end);
-    if (end > *ptr) {
-        *ptr = end;
-        Value v;
-        if (d == (int64_t)d) { create_int(&v, (int64_t)d); }
-        else { create_float(&v, d); }
-        return v;
+    Vector* vec = (Vector*)(intptr_t)arr.value;
+
+    size_t t = next_structural(p);
+    if (t != JSON_END && p->buf[t] == ']') return arr;
+    for (;;) {
+        Value val = json_parse_value(p, t);
+        if (p->error) return (Value){0};
+        vector_push_impl(vec, val);
+
+        t = next_structural(p);
+        if (t == JSON_END) return json_fail(p);
+        if (p->buf[t] == ']') return arr;
+        if (p->buf[t] != ',') return json_fail(p);
+        t = next_structural(p);
     }
+}
 
-    return (Value){0};
+static Value json_parse_value(JsonParser* p, size_t pos) {
+    if (pos == JSON_END || p->error) return json_fail(p);
+
+    switch (p->buf[pos]) {
+        case '{':
+        case '[': {
+            if (++p->depth > JSON_MAX_DEPTH) return json_fail(p);
+            Value v = p->buf[pos] == '{' ? json_parse_object(p) : json_parse_array(p);
+            p->depth--;
+            return v;
+        }
+        case '"': {
+            Value str = {0};
+            char* s = json_parse_string(p, pos);
+            if (s) create_str_borrowed(&str, s);
+            return str;
+        }
+        case 't':
+            if (!match_literal(p, pos, "true", 4)) return json_fail(p);
+            { Value b; create_bool(&b, 1); return b; }
+        case 'f':
+            if (!match_literal(p, pos, "false", 5)) return json_fail(p);
+            { Value b; create_bool(&b, 0); return b; }
+        case 'n':
+            if (!match_literal(p, pos, "null", 4)) return json_fail(p);
+            return (Value){0};
+        default:
+            return json_parse_number(p, pos);
+    }
+}
+
+// Buffers do estágio 1; alocados uma vez por parser (o stream os reaproveita
+// entre registros)
+static void parser_alloc(JsonParser* p) {
+    memset(p, 0, sizeof(*p));
+    p->index = (uint32_t*)malloc(sizeof(uint32_t) * (JSON_WINDOW + 4));
+    p->masks = (NvJsonBlock*)malloc(sizeof(NvJsonBlock) * JSON_WINDOW_BLOCKS);
+    if (!p->index || !p->masks) {
+        fprintf(stderr, "FATAL: malloc failed in json_parse\n");
+        exit(1);
+    }
+}
+
+static void parser_free(JsonParser* p) {
+    free(p->index);
+    free(p->masks);
+}
+
+// Analisa o documento inteiro em `buf`; *borrowed recebe quantas strings o
+// resultado referencia dentro do buffer (0 = o buffer pode ser liberado)
+static Value parser_run(JsonParser* p, char* buf, size_t len, size_t* borrowed) {
+    uint32_t* index = p->index;
+    NvJsonBlock* masks = p->masks;
+    memset(p, 0, sizeof(*p));
+    p->index = index;
+    p->masks = masks;
+    p->buf = buf;
+    p->len = len;
+
+    Value result = json_parse_value(p, next_structural(p));
+    // Depois do valor só pode haver espaços
+    if (!p->error && next_structural(p) != JSON_END) p->error = 1;
+
+    if (p->error) {
+        *borrowed = 0;
+        return (Value){0};
+    }
+    *borrowed = p->borrowed;
+    return result;
+}
+
+static Value json_parse_buffer(char* buf, size_t len, size_t* borrowed) {
+    JsonParser p;
+    parser_alloc(&p);
+    Value result = parser_run(&p, buf, len, borrowed);
+    parser_free(&p);
+    return result;
 }
 
 Value json_parse(const char* input) {
-    const char* ptr = input;
-    Value result = json_parse_value(&ptr);
+    if (!input) return (Value){0};
+    // Uma única cópia da entrada serve de arena para todas as strings
+    size_t len = strlen(input);
+    char* buf = (char*)malloc(len + 1);
+    if (!buf) {
+        fprintf(stderr, "FATAL: malloc failed in json_parse\n");
+        exit(1);
+    }
+    memcpy(buf, input, len + 1);
+
+    size_t borrowed;
+    Value result = json_parse_buffer(buf, len, &borrowed);
+    if (borrowed == 0) free(buf);
     return result;
 }
 
@@ -113,7 +571,29 @@ static int is_absolute_path(const char* p) {
     return p && p[0] == '/';
 }
 
-void json_load(Value* out, const char* filename) {
+// Lê um descritor que não pode ser mapeado (pipe, /dev/stdin...) para um buffer único
+static char* read_all(int fd, size_t* out_len) {
+    size_t cap = 64 * 1024;
+    size_t len = 0;
+    char* buf = (char*)malloc(cap);
+    if (!buf) return NULL;
+    for (;;) {
+        if (len == cap) {
+            char* grown = (char*)realloc(buf, cap * 2);
+            if (!grown) { free(buf); return NULL; }
+            buf = grown;
+            cap *= 2;
+        }
+        ssize_t n = read(fd, buf + len, cap - len);
+        if (n < 0) { free(buf); return NULL; }
+        if (n == 0) break;
+        len += (size_t)n;
+    }
+    *out_len = len;
+    return buf;
+}
+
+int nv_json_open(const char* filename, int flags, int mode) {
     /* nv_base_dir may be provided by the generated program; weak default here */
     const char* base = nv_base_dir; // no env vars
     char* fullpath = NULL;
@@ -122,7 +602,7 @@ void json_load(Value* out, const char* filename) {
         size_t fl = strlen(filename);
         int need_slash = (bl > 0 && base[bl - 1] != '/');
         fullpath = (char*)malloc(bl + need_slash + fl + 1);
-        if (!fullpath) { *out = (Value){0}; return; }
+        if (!fullpath) return -1;
         memcpy(fullpath, base, bl);
         if (need_slash) { fullpath[bl] = '/'; bl += 1; }
         memcpy(fullpath + bl, filename, fl);
@@ -130,30 +610,281 @@ void json_load(Value* out, const char* filename) {
     }
 
     const char* try1 = fullpath ? fullpath : filename;
-    FILE* f = try1 ? fopen(try1, "rb") : NULL;
-    if (!f && fullpath) {
-        free(fullpath);
-        fullpath = NULL;
-        f = filename ? fopen(filename, "rb") : NULL;
+    int fd = try1 ? open(try1, flags, mode) : -1;
+    if (fd < 0 && fullpath) {
+        fd = filename ? open(filename, flags, mode) : -1;
     }
-    if (!f) {
+    if (fullpath) free(fullpath);
+    return fd;
+}
+
+void json_load(Value* out, const char* filename) {
+    int fd = nv_json_open(filename, O_RDONLY, 0);
+    if (fd < 0) {
         *out = (Value){0};
         return;
     }
 
-    if (fseek(f, 0, SEEK_END) != 0) { fclose(f); if (fullpath) free(fullpath); *out = (Value){0}; return; }
-    long len = ftell(f);
-    if (len < 0) { fclose(f); if (fullpath) free(fullpath); *out = (Value){0}; return; }
-    if (fseek(f, 0, SEEK_SET) != 0) { fclose(f); if (fullpath) free(fullpath); *out = (Value){0}; return; }
-    char* buf = (char*)malloc((size_t)len + 1);
-    if (!buf) { fclose(f); if (fullpath) free(fullpath); *out = (Value){0}; return; }
-    size_t rd = fread(buf, 1, (size_t)len, f);
-    buf[rd] = '\0';
-    fclose(f);
-    if (fullpath) { free(fullpath); }
+    struct stat st;
+    char* buf = NULL;
+    size_t len = 0;
+    int mapped = 0;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        if (st.st_size == 0) { close(fd); *out = (Value){0}; return; }
+        len = (size_t)st.st_size;
+        // MAP_PRIVATE gravável: os '\0' e escapes decodificados nunca chegam ao arquivo
+        void* p = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            buf = (char*)p;
+            mapped = 1;
+            madvise(p, len, MADV_SEQUENTIAL);
+        }
+    }
+    if (!buf) buf = read_all(fd, &len);
+    close(fd);
+    if (!buf) {
+        *out = (Value){0};
+        return;
+    }
 
-    Value v = json_parse(buf);
-    free(buf);
+    size_t borrowed;
+    Value v = json_parse_buffer(buf, len, &borrowed);
+    if (borrowed == 0) {
+        if (mapped) munmap(buf, len);
+        else free(buf);
+    }
     *out = v;
     return;
-}
\ No newline at end of file
+}
+
+/* ============================================================= */
+/*                    STREAMING (NDJSON / ARRAY)                 */
+/* ============================================================= */
+
+// json.stream lê o arquivo em um buffer de tamanho fixo (só cresce se um
+// único registro não couber) e entrega um registro de topo por vez: linhas
+// NDJSON (ou valores concatenados) ou os elementos de um array de topo.
+//
+// Os limites de cada registro são achados por contagem de profundidade fora
+// de strings; o registro é então analisado pelo mesmo parser de dois estágios.
+// Sem `keep`, a análise é in-place no buffer de leitura, que serve de arena
+// do registro: strings apontam para ele e os containers são liberados na
+// chamada seguinte, então a memória usada não depende do tamanho do arquivo.
+// Com `keep`, o registro ganha uma cópia própria e sobrevive à iteração.
+
+#define JSON_STREAM_BUFFER (1024 * 1024)
+
+typedef struct {
+    int fd;
+    char* buf;
+    size_t cap;
+    size_t start;              // início dos dados ainda não consumidos
+    size_t end;                // fim dos dados válidos
+    int eof;
+    int started;               // primeiro byte significativo já visto
+    int array;                 // documento é um array de topo
+    int done;
+    JsonParser parser;         // buffers do estágio 1, reaproveitados
+    Value current;             // registro da arena (liberado na próxima chamada)
+} JsonStream;
+
+// Libera os containers criados pelo parser; strings e chaves vivem na arena
+static void json_release(Value* v) {
+    if (v->type == TAG_MAP) {
+        Map* m = (Map*)(intptr_t)v->value;
+        for (int i = 0; i < m->size; i++) json_release(&m->values[i]);
+        free(m->keys);
+        free(m->values);
+        free(m);
+    } else if (v->type == TAG_VECTOR) {
+        Vector* vec = (Vector*)(intptr_t)v->value;
+        for (int i = 0; i < vec->size; i++) json_release(&vec->elements[i]);
+        free(vec->elements);
+        free(vec);
+    }
+    *v = (Value){0};
+}
+
+// Lê mais dados mantendo o registro parcial no início do buffer; 0 em EOF/erro
+static int stream_refill(JsonStream* s) {
+    if (s->start > 0) {
+        memmove(s->buf, s->buf + s->start, s->end - s->start);
+        s->end -= s->start;
+        s->start = 0;
+    }
+    // Registro maior que o buffer: dobra
+    if (s->end == s->cap) {
+        char* grown = (char*)realloc(s->buf, s->cap * 2);
+        if (!grown) {
+            fprintf(stderr, "FATAL: realloc failed in json_stream_next\n");
+            exit(1);
+        }
+        s->buf = grown;
+        s->cap *= 2;
+    }
+    for (;;) {
+        ssize_t n = read(s->fd, s->buf + s->end, s->cap - s->end);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            s->eof = 1;
+            return 0;
+        }
+        s->end += (size_t)n;
+        return 1;
+    }
+}
+
+static int is_space(char ch) {
+    return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';
+}
+
+// Fim (exclusivo) da string aberta em `open`, ou JSON_END se ainda não chegou
+static size_t stream_string_end(const JsonStream* s, size_t open) {
+    size_t i = open + 1;
+    for (;;) {
+        const char* q = (const char*)memchr(s->buf + i, '"', s->end - i);
+        if (!q) return JSON_END;
+        size_t close = (size_t)(q - s->buf);
+        size_t slashes = 0;
+        while (close - slashes > open + 1 && s->buf[close - slashes - 1] == '\\') slashes++;
+        if ((slashes & 1) == 0) return close + 1;
+        i = close + 1;
+    }
+}
+
+// Fim (exclusivo) do registro que começa em `from`, ou JSON_END se o buffer
+// ainda não contém o registro inteiro
+static size_t stream_record_end(const JsonStream* s, size_t from) {
+    char first = s->buf[from];
+    if (first == '"') return stream_string_end(s, from);
+
+    if (first != '{' && first != '[') {
+        // Escalar: vai até o próximo espaço ou delimitador
+        size_t i = from;
+        while (i < s->end && !is_space(s->buf[i]) && s->buf[i] != ',' &&
+               s->buf[i] != ']' && s->buf[i] != '}') i++;
+        return (i < s->end || s->eof) ? i : JSON_END;
+    }
+
+    int depth = 0;
+    size_t i = from;
+    while (i < s->end) {
+        switch (s->buf[i]) {
+            case '"':
+                i = stream_string_end(s, i);
+                if (i == JSON_END) return JSON_END;
+                continue;
+            case '{': case '[':
+                depth++;
+                break;
+            case '}': case ']':
+                if (--depth == 0) return i + 1;
+                break;
+        }
+        i++;
+    }
+    return JSON_END;
+}
+
+void* json_stream_open(const char* filename) {
+    int fd = nv_json_open(filename, O_RDONLY, 0);
+    if (fd < 0) return NULL;
+    JsonStream* s = (JsonStream*)calloc(1, sizeof(JsonStream));
+    if (!s) {
+        fprintf(stderr, "FATAL: malloc failed in json_stream_open\n");
+        exit(1);
+    }
+    s->fd = fd;
+    s->cap = JSON_STREAM_BUFFER;
+    s->buf = (char*)malloc(s->cap);
+    if (!s->buf) {
+        fprintf(stderr, "FATAL: malloc failed in json_stream_open\n");
+        exit(1);
+    }
+    parser_alloc(&s->parser);
+    return s;
+}
+
+int32_t json_stream_next(void* stream, Value* out, int32_t keep) {
+    JsonStream* s = (JsonStream*)stream;
+    *out = (Value){0};
+    if (!s) return 0;
+    // O registro anterior da arena morre aqui
+    json_release(&s->current);
+    if (s->done) return 0;
+
+    for (;;) {
+        size_t i = s->start;
+        while (i < s->end && (is_space(s->buf[i]) || (s->array && s->buf[i] == ','))) i++;
+        s->start = i;
+        if (i == s->end) {
+            if (s->eof || !stream_refill(s)) {
+                s->done = 1;
+                return 0;
+            }
+            continue;
+        }
+
+        if (!s->started) {
+            s->started = 1;
+            if (s->buf[i] == '[') {
+                s->array = 1;
+                s->start = i + 1;
+                continue;
+            }
+        }
+        if (s->array && s->buf[i] == ']') {
+            s->done = 1;
+            return 0;
+        }
+
+        size_t e = stream_record_end(s, i);
+        if (e == JSON_END) {
+            if (!s->eof && stream_refill(s)) continue;
+            // Registro truncado no fim do arquivo: vira null
+            i = s->start;
+            e = s->end;
+        } else if (e == i) {
+            e = i + 1;    // delimitador solto: registro inválido de um byte
+        }
+        s->start = e;
+
+        size_t len = e - i;
+        size_t borrowed;
+        if (keep) {
+            char* copy = (char*)malloc(len);
+            if (!copy) {
+                fprintf(stderr, "FATAL: malloc failed in json_stream_next\n");
+                exit(1);
+            }
+            memcpy(copy, s->buf + i, len);
+            *out = parser_run(&s->parser, copy, len, &borrowed);
+            if (borrowed == 0) free(copy);
+        } else {
+            s->current = parser_run(&s->parser, s->buf + i, len, &borrowed);
+            *out = s->current;
+        }
+        return 1;
+    }
+}
+
+void json_stream_close(void* stream) {
+    JsonStream* s = (JsonStream*)stream;
+    if (!s) return;
+    json_release(&s->current);
+    close(s->fd);
+    parser_free(&s->parser);
+    free(s->buf);
+    free(s);
+}
+
+void json_stream(Value* out, const char* filename) {
+    create_vector(out, 0);
+    Vector* vec = (Vector*)(intptr_t)out->value;
+    void* s = json_stream_open(filename);
+    Value record;
+    while (json_stream_next(s, &record, 1)) {
+        vector_push_impl(vec, record);
+    }
+    json_stream_close(s);
+}
@@ -1,6 +1,7 @@
 #include "frontend/ast/expressions/access_expr_node.hpp"
 #include "backend/codegen/ir_context.hpp"
 #include "backend/codegen/ir_utils.hpp"
+#include "frontend/ast/expressions/identifier_node.hpp"
 
 void AccessExprNode::codegen(nv::IRGenerationContext& ctx) {
     ctx.set_debug_location(position.get());
@@ -22,8 +23,12 @@ void AccessExprNode::codegen(nv::IRGenerationContext& ctx) {
         if (idx_v && idx_v->getType() != I32) idx_v = nv::ir_utils::promote_type(ctx, idx_v, I32);
         if (!idx_v) idx_v = llvm::ConstantInt::get(I32, 0);
 
+        // Container escrito em [i] dentro de um chunk paralelo: o size só é
+        // ajustado depois do loop, então a leitura vai até a capacidade reservada
+        auto* container = dynamic_cast<IdentifierNode*>(expr.get());
+        bool reserved = container && ctx.in_parallel_region() && ctx.get_parallel_write_end(container->symbol);
         auto decl_get = ctx.get_module().getOrInsertFunction(
-            "array_get_index_v",
+            reserved ? "nv_parallel_load" : "array_get_index_v",
             llvm::FunctionType::get(llvm::Type::getVoidTy(c), {ValuePtr, ValuePtr, I32}, false)
         );
         // out, self, index
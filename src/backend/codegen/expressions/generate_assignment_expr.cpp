@@ -65,6 +65,24 @@ void AssignmentExprNode::codegen(nv::IRGenerationContext& ctx) {
 
         auto* rhsBox = box_arg(rhs);
 
+        // Dentro de um chunk paralelo: grava sem tocar no size (o armazenamento
+        // já foi reservado) e anota o maior índice escrito para nv_parallel_commit
+        auto* container = dynamic_cast<IdentifierNode*>(acc->expr.get());
+        llvm::AllocaInst* write_end = container && ctx.in_parallel_region()
+            ? ctx.get_parallel_write_end(container->symbol) : nullptr;
+        if (write_end) {
+            auto decl = M.getOrInsertFunction(
+                "nv_parallel_store",
+                llvm::FunctionType::get(llvm::Type::getVoidTy(C), {ValuePtr, I32, ValuePtr}, false)
+            );
+            B.CreateCall(llvm::cast<llvm::Function>(decl.getCallee()), {selfAlloca, idx_v, rhsBox});
+            auto* end = B.CreateAdd(idx_v, llvm::ConstantInt::get(I32, 1));
+            auto* cur = B.CreateLoad(I32, write_end);
+            B.CreateStore(B.CreateSelect(B.CreateICmpSGT(end, cur), end, cur), write_end);
+            ctx.push_value(rhs);
+            return;
+        }
+
         // Despacho por tag: TAG_ARRAY (5) ou TAG_VECTOR (6)
         auto selfVal = B.CreateLoad(ValueTy, selfAlloca);
         auto tag = B.CreateExtractValue(selfVal, {0});
@@ -118,22 +136,11 @@ void AssignmentExprNode::codegen(nv::IRGenerationContext& ctx) {
     llvm::Value* rhs = ctx.pop_value();
     if (!rhs) { ctx.push_value(nullptr); return; }
 
-    bool is_simple_assign = (op.empty() || op == "=");
-    std::string bin_op;
-    if (!is_simple_assign) {
-        if (op == "+=") bin_op = "+";
-        else if (op == "-=") bin_op = "-";
-        else if (op == "*=") bin_op = "*";
-        else if (op == "/=") bin_op = "/";
-        else if (op == "//=") bin_op = "//";
-        else if (op == "**=") bin_op = "**";
-        else if (op == "%=") bin_op = "%";
-        else is_simple_assign = true; 
-    }
+    BinaryOp bin_op = compound_assign_op(op);
+    bool is_simple_assign = bin_op == BinaryOp::Unknown;
 
-    auto info_opt = ctx.get_symbol_table().lookup_symbol(id->symbol);
-    if (info_opt.has_value()) {
-        auto info = info_opt.value();
+    if (const auto* info_ptr = ctx.get_symbol_table().lookup_symbol(id->symbol_id)) {
+        const auto& info = *info_ptr;
         auto& B = ctx.get_builder();
         auto& M = ctx.get_module();
         auto* ValueTy = nv::ir_utils::get_value_struct(ctx);
@@ -258,8 +265,8 @@ void AssignmentExprNode::codegen(nv::IRGenerationContext& ctx) {
         
         // Garantir que o GlobalVariable está registrado na tabela de símbolos
         // (pode ter sido criado por import mas não registrado ainda, ou vice-versa)
-        auto existing_info = ctx.get_symbol_table().lookup_symbol(id->symbol);
-        if (!existing_info.has_value() || existing_info.value().value != global) {
+        const auto* existing_info = ctx.get_symbol_table().lookup_symbol(id->symbol_id);
+        if (!existing_info || existing_info->value != global) {
             // Registrar na tabela de símbolos se não estiver ou se for diferente
             nv::SymbolInfo info(
                 global,
@@ -268,7 +275,7 @@ void AssignmentExprNode::codegen(nv::IRGenerationContext& ctx) {
                 false,  // não é alocação local
                 false   // não é constante
             );
-            ctx.get_symbol_table().define_symbol(id->symbol, info);
+            ctx.get_symbol_table().define_symbol(id->symbol_id, info);
         }
     } else {
         // Variável local: comportamento original
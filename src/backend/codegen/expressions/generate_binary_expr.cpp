@@ -11,27 +11,20 @@ void BinaryExprNode::codegen(nv::IRGenerationContext& ctx) {
     if (!lhs_v || !rhs_v) { ctx.push_value(nullptr); return; }
 
     // Logical AND / OR (assume i1 operands; if not, compare != 0)
-    if (op == "&&") {
+    if (is_logical_op(opcode)) {
         auto& b = ctx.get_builder();
         if (!lhs_v->getType()->isIntegerTy(1)) lhs_v = b.CreateICmpNE(lhs_v, llvm::ConstantInt::get(lhs_v->getType(), 0));
         if (!rhs_v->getType()->isIntegerTy(1)) rhs_v = b.CreateICmpNE(rhs_v, llvm::ConstantInt::get(rhs_v->getType(), 0));
-        ctx.push_value(b.CreateAnd(lhs_v, rhs_v, "land"));
-        return;
-    }
-    if (op == "||") {
-        auto& b = ctx.get_builder();
-        if (!lhs_v->getType()->isIntegerTy(1)) lhs_v = b.CreateICmpNE(lhs_v, llvm::ConstantInt::get(lhs_v->getType(), 0));
-        if (!rhs_v->getType()->isIntegerTy(1)) rhs_v = b.CreateICmpNE(rhs_v, llvm::ConstantInt::get(rhs_v->getType(), 0));
-        ctx.push_value(b.CreateOr(lhs_v, rhs_v, "lor"));
+        ctx.push_value(opcode == BinaryOp::And ? b.CreateAnd(lhs_v, rhs_v, "land") : b.CreateOr(lhs_v, rhs_v, "lor"));
         return;
     }
 
     // Comparisons
-    if (op == "==" || op == "!=" || op == "<" || op == ">" || op == "<=" || op == ">=") {
-        ctx.push_value(nv::ir_utils::create_comparison(ctx, lhs_v, rhs_v, op));
+    if (is_comparison_op(opcode)) {
+        ctx.push_value(nv::ir_utils::create_comparison(ctx, lhs_v, rhs_v, opcode));
         return;
     }
 
     // Arithmetic
-    ctx.push_value(nv::ir_utils::create_binary_op(ctx, lhs_v, rhs_v, op));
-}
+    ctx.push_value(nv::ir_utils::create_binary_op(ctx, lhs_v, rhs_v, opcode));
+}
\ No newline at end of file
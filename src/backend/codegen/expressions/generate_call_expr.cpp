@@ -3,33 +3,13 @@
 #include "backend/codegen/ir_utils.hpp"
 #include "frontend/ast/expressions/identifier_node.hpp"
 #include "frontend/ast/expressions/member_expr_node.hpp"
+#include <llvm/Analysis/ValueTracking.h>
+#include <unordered_set>
 
 namespace {
 
 using namespace nv;
 
-struct MethodInfo {
-    const char* name;
-    int arity;
-    const char* rt_func;
-    bool returns_value;
-};
-
-const MethodInfo string_methods[] = {
-    {"toUpperCase", 0, "string_to_upper_case", true},
-    {"replace",     2, "string_replace",       true},
-    {"includes",    1, "string_includes",      true},
-    {nullptr}
-};
-
-const MethodInfo vector_methods[] = {
-    {"push", 1, "vector_push_method", false},
-    {"pop",  0, "vector_pop_method",  true},
-    {"get",  1, "vector_get_method",  true},
-    {"set",  2, "vector_set_method",  false},
-    {nullptr}
-};
-
 // === HELPER: Box any value to Value* ===
 llvm::Value* box_value(IRGenerationContext& ctx, llvm::Value* v) {
     auto& B = ctx.get_builder();
@@ -103,11 +83,12 @@ void emit_write(IRGenerationContext& ctx, llvm::Value* v, bool newline = true) {
 }
 
 // === BUILTIN: write, read, json.load ===
-llvm::Value* try_lower_builtin(IRGenerationContext& ctx, const std::string& name, const std::vector<std::unique_ptr<Expr>>& args) {
+llvm::Value* try_lower_builtin(IRGenerationContext& ctx, BuiltinId builtin, const std::vector<std::unique_ptr<Expr>>& args) {
     auto& B = ctx.get_builder();
     auto* I8P = ir_utils::get_i8_ptr(ctx);
 
-    if (name == "write") {
+    switch (builtin) {
+    case BuiltinId::Write: {
         if (args.empty()) {
             auto* empty = B.CreateGlobalStringPtr("");
             emit_write(ctx, empty);
@@ -167,7 +148,7 @@ llvm::Value* try_lower_builtin(IRGenerationContext& ctx, const std::string& name
         }
     }
 
-    if (name == "read") {
+    case BuiltinId::Read: {
         if (!args.empty()) {
             args[0]->codegen(ctx);
             emit_write(ctx, ctx.pop_value(), false);
@@ -175,26 +156,280 @@ llvm::Value* try_lower_builtin(IRGenerationContext& ctx, const std::string& name
         auto* fn = ctx.ensure_runtime_func("nv_read", {}, I8P);
         return B.CreateCall(fn, {});
     }
-    
-    return nullptr; // not builtin
+
+    // Fora de `for ... in read_lines()` (que lê sob demanda) as linhas viram um vector
+    case BuiltinId::ReadLines: {
+        auto* ValueTy = ir_utils::get_value_struct(ctx);
+        auto* out = ctx.create_alloca(ValueTy, "lines");
+        auto* fn = ctx.ensure_runtime_func("nv_read_lines", {ir_utils::get_value_ptr(ctx)});
+        B.CreateCall(fn, {out});
+        return B.CreateLoad(ValueTy, out);
+    }
+
+    default:
+        return nullptr; // not builtin
+    }
+}
+
+// Argumento string de json.*; valores não-ponteiro viram ""
+llvm::Value* json_string_arg(IRGenerationContext& ctx, Expr* arg) {
+    arg->codegen(ctx);
+    llvm::Value* v = ctx.pop_value();
+    auto* I8P = ir_utils::get_i8_ptr(ctx);
+    if (!v || !v->getType()->isPointerTy()) return ctx.get_builder().CreateGlobalStringPtr("");
+    return v->getType() == I8P ? v : ctx.get_builder().CreateBitCast(v, I8P);
+}
+
+// Argumento `indent` opcional de json.stringify/json.dump (0 = compacto)
+llvm::Value* json_indent_arg(IRGenerationContext& ctx, const std::vector<std::unique_ptr<Expr>>& args, size_t index) {
+    auto* I32 = llvm::Type::getInt32Ty(ctx.get_context());
+    if (args.size() <= index) return llvm::ConstantInt::get(I32, 0);
+    args[index]->codegen(ctx);
+    llvm::Value* v = ctx.pop_value();
+    if (!v || !v->getType()->isIntegerTy()) return llvm::ConstantInt::get(I32, 0);
+    return v->getType() == I32 ? v : ctx.get_builder().CreateSExtOrTrunc(v, I32);
+}
+
+// === json.load / json.stream / json.stringify / json.dump ===
+// (`for r in json.stream(f)` é gerado sob demanda em generate_for_stmt; aqui
+// json.stream materializa todos os registros num vector)
+llvm::Value* lower_json_call(IRGenerationContext& ctx, BuiltinId method, const std::vector<std::unique_ptr<Expr>>& args) {
+    auto& B = ctx.get_builder();
+    auto* I8P = ir_utils::get_i8_ptr(ctx);
+    auto* I32 = llvm::Type::getInt32Ty(ctx.get_context());
+    auto* ValueTy = ir_utils::get_value_struct(ctx);
+    auto* ValuePtr = ir_utils::get_value_ptr(ctx);
+
+    switch (method) {
+    case BuiltinId::JsonLoad:
+    case BuiltinId::JsonStream: {
+        if (args.empty()) return nullptr;
+        llvm::Value* filename = json_string_arg(ctx, args[0].get());
+        // void json_load/json_stream(Value*, const char*)
+        auto* fn = ctx.ensure_runtime_func(method == BuiltinId::JsonLoad ? "json_load" : "json_stream", {ValuePtr, I8P});
+        auto* out = ctx.create_alloca(ValueTy, "json_out");
+        B.CreateCall(fn, {out, filename});
+        return B.CreateLoad(ValueTy, out);
+    }
+
+    case BuiltinId::JsonStringify: {
+        if (args.empty()) return nullptr;
+        args[0]->codegen(ctx);
+        auto* boxed = box_value(ctx, ctx.pop_value());
+        auto* indent = json_indent_arg(ctx, args, 1);
+        auto* fn = ctx.ensure_runtime_func("json_stringify", {ValuePtr, I32}, I8P);
+        return B.CreateCall(fn, {boxed, indent}, "json.text");
+    }
+
+    case BuiltinId::JsonDump: {
+        if (args.size() < 2) return nullptr;
+        args[0]->codegen(ctx);
+        auto* boxed = box_value(ctx, ctx.pop_value());
+        llvm::Value* filename = json_string_arg(ctx, args[1].get());
+        auto* indent = json_indent_arg(ctx, args, 2);
+        auto* fn = ctx.ensure_runtime_func("json_dump", {ValuePtr, I8P, I32}, I32);
+        auto* ok = B.CreateCall(fn, {boxed, filename, indent});
+        return B.CreateICmpNE(ok, llvm::ConstantInt::get(I32, 0), "json.dumped");
+    }
+
+    default:
+        return nullptr;
+    }
+}
+
+// === csv.load(arquivo[, opções]) ===
+llvm::Value* lower_csv_call(IRGenerationContext& ctx, BuiltinId method, const std::vector<std::unique_ptr<Expr>>& args) {
+    auto& B = ctx.get_builder();
+    auto* ValueTy = ir_utils::get_value_struct(ctx);
+    auto* ValuePtr = ir_utils::get_value_ptr(ctx);
+
+    if (method == BuiltinId::CsvLoad && !args.empty()) {
+        llvm::Value* filename = json_string_arg(ctx, args[0].get());
+        llvm::Value* options = llvm::ConstantPointerNull::get(ValuePtr);
+        if (args.size() > 1) {
+            args[1]->codegen(ctx);
+            options = box_value(ctx, ctx.pop_value());
+        }
+        // void csv_load(Value* out, const char* filename, Value* options)
+        auto* fn = ctx.ensure_runtime_func("csv_load", {ValuePtr, ir_utils::get_i8_ptr(ctx), ValuePtr});
+        auto* out = ctx.create_alloca(ValueTy, "csv_out");
+        B.CreateCall(fn, {out, filename, options});
+        return B.CreateLoad(ValueTy, out);
+    }
+
+    return nullptr;
+}
+
+// === snapshot.save(valor, arquivo) / snapshot.load(arquivo[, chave]) ===
+llvm::Value* lower_snapshot_call(IRGenerationContext& ctx, BuiltinId method, const std::vector<std::unique_ptr<Expr>>& args) {
+    auto& B = ctx.get_builder();
+    auto* I8P = ir_utils::get_i8_ptr(ctx);
+    auto* I32 = llvm::Type::getInt32Ty(ctx.get_context());
+    auto* ValueTy = ir_utils::get_value_struct(ctx);
+    auto* ValuePtr = ir_utils::get_value_ptr(ctx);
+
+    if (method == BuiltinId::SnapshotSave && args.size() >= 2) {
+        args[0]->codegen(ctx);
+        auto* boxed = box_value(ctx, ctx.pop_value());
+        llvm::Value* filename = json_string_arg(ctx, args[1].get());
+        auto* fn = ctx.ensure_runtime_func("snapshot_save", {ValuePtr, I8P}, I32);
+        auto* ok = B.CreateCall(fn, {boxed, filename});
+        return B.CreateICmpNE(ok, llvm::ConstantInt::get(I32, 0), "snapshot.saved");
+    }
+
+    if (method == BuiltinId::SnapshotLoad && !args.empty()) {
+        llvm::Value* filename = json_string_arg(ctx, args[0].get());
+        llvm::Value* key = args.size() > 1 ? json_string_arg(ctx, args[1].get())
+                                           : llvm::ConstantPointerNull::get(llvm::cast<llvm::PointerType>(I8P));
+        // void snapshot_load(Value* out, const char* filename, const char* key)
+        auto* fn = ctx.ensure_runtime_func("snapshot_load", {ValuePtr, I8P, I8P});
+        auto* out = ctx.create_alloca(ValueTy, "snapshot_out");
+        B.CreateCall(fn, {out, filename, key});
+        return B.CreateLoad(ValueTy, out);
+    }
+
+    return nullptr;
+}
+
+// Funções do runtime que não tocam estado compartilhado e podem rodar em qualquer thread
+const std::unordered_set<std::string> reentrant_runtime_funcs = {
+    "create_int", "create_float", "create_bool", "create_str",
+    "create_array", "create_vector", "create_map", "create_tuple",
+    "ensure_value_type", "get_value_type", "validate_value_type",
+    "array_get_index_v", "vector_get_method", "map_get_method", "tuple_get_impl",
+    "any_has", "any_get", "any_get_index", "any_index_valid",
+    "string_to_upper_case", "string_replace", "string_includes",
+    "string_concat", "string_repeat", "strcmp", "strlen",
+    "json_stringify",
+};
+
+// Prova (de forma conservadora, sobre o IR) que `fn` não tem efeitos colaterais
+// visíveis: não escreve em globais e só chama funções igualmente seguras
+bool is_parallel_safe(llvm::Function* fn, std::unordered_set<llvm::Function*>& visiting) {
+    if (!fn) return false;
+    if (fn->isIntrinsic()) return true;
+    if (fn->isDeclaration()) return reentrant_runtime_funcs.count(fn->getName().str()) > 0;
+    if (!visiting.insert(fn).second) return true;   // recursão: já em análise
+
+    for (auto& bb : *fn) {
+        for (auto& inst : bb) {
+            if (auto* store = llvm::dyn_cast<llvm::StoreInst>(&inst)) {
+                auto* base = llvm::getUnderlyingObject(store->getPointerOperand());
+                if (!llvm::isa<llvm::AllocaInst>(base)) return false;
+            } else if (auto* call = llvm::dyn_cast<llvm::CallBase>(&inst)) {
+                if (!is_parallel_safe(call->getCalledFunction(), visiting)) return false;
+            } else if (inst.mayWriteToMemory()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Converte o Value apontado por `ptr` no tipo de parâmetro `ty` de uma função do usuário
+llvm::Value* unbox_value(IRGenerationContext& ctx, llvm::Value* ptr, llvm::Type* ty) {
+    auto& B = ctx.get_builder();
+    auto* ValueTy = ir_utils::get_value_struct(ctx);
+    auto* I32 = llvm::Type::getInt32Ty(ctx.get_context());
+    auto* I64 = llvm::Type::getInt64Ty(ctx.get_context());
+    auto* F64 = llvm::Type::getDoubleTy(ctx.get_context());
+
+    if (ty == ValueTy) return B.CreateLoad(ValueTy, ptr);
+
+    auto* tag = B.CreateLoad(I32, B.CreateStructGEP(ValueTy, ptr, 0), "cb.tag");
+    auto* raw = B.CreateLoad(I64, B.CreateStructGEP(ValueTy, ptr, 1), "cb.raw");
+    auto* is_float = B.CreateICmpEQ(tag, llvm::ConstantInt::get(I32, 2));   // TAG_FLOAT
+
+    if (ty->isIntegerTy(1)) return B.CreateICmpNE(raw, llvm::ConstantInt::get(I64, 0));
+    if (ty->isIntegerTy()) {
+        auto* from_float = B.CreateFPToSI(B.CreateBitCast(raw, F64), ty);
+        return B.CreateSelect(is_float, from_float, B.CreateSExtOrTrunc(raw, ty));
+    }
+    if (ty->isFloatingPointTy()) {
+        llvm::Value* as_float = B.CreateBitCast(raw, F64);
+        llvm::Value* from_int = B.CreateSIToFP(raw, F64);
+        llvm::Value* d = B.CreateSelect(is_float, as_float, from_int);
+        return ty == F64 ? d : B.CreateFPTrunc(d, ty);
+    }
+    if (ty->isPointerTy()) return B.CreateIntToPtr(raw, ty);
+    return llvm::UndefValue::get(ty);
 }
 
-llvm::Value* lower_method_call(IRGenerationContext& ctx, llvm::Value* selfAlloca, const std::string& method, const std::vector<llvm::Value*>& argv) {
+// Gera (uma vez por função) `void fn.nv.callback(Value* out, Value* a, Value* b)`,
+// a ponte entre os métodos do runtime e a assinatura nativa de `fn`
+llvm::Function* get_callback_adapter(IRGenerationContext& ctx, llvm::Function* fn) {
+    auto& M = ctx.get_module();
+    auto& C = ctx.get_context();
     auto& B = ctx.get_builder();
+    std::string name = fn->getName().str() + ".nv.callback";
+    if (auto* existing = M.getFunction(name)) return existing;
+
     auto* ValueTy = ir_utils::get_value_struct(ctx);
     auto* ValuePtr = ir_utils::get_value_ptr(ctx);
+    auto* adapter_ty = llvm::FunctionType::get(llvm::Type::getVoidTy(C), {ValuePtr, ValuePtr, ValuePtr}, false);
+    auto* adapter = llvm::Function::Create(adapter_ty, llvm::Function::InternalLinkage, name, M);
+
+    // Preservar o estado da função em geração
+    llvm::Function* prev_func = ctx.get_current_function();
+    llvm::BasicBlock* prev_block = B.GetInsertBlock();
+    llvm::DebugLoc prev_loc = B.getCurrentDebugLocation();
+
+    ctx.set_current_function(adapter);
+    B.SetCurrentDebugLocation(llvm::DebugLoc());
+    B.SetInsertPoint(llvm::BasicBlock::Create(C, "entry", adapter));
+
+    auto arg = adapter->arg_begin();
+    llvm::Value* out = &*arg++;
+    llvm::Value* sources[2] = {&*arg, &*(arg + 1)};
+
+    auto* fty = fn->getFunctionType();
+    std::vector<llvm::Value*> call_args;
+    for (unsigned i = 0; i < fty->getNumParams(); ++i) {
+        call_args.push_back(i < 2 ? unbox_value(ctx, sources[i], fty->getParamType(i))
+                                  : llvm::UndefValue::get(fty->getParamType(i)));
+    }
+    llvm::Value* result = B.CreateCall(fn, call_args);
+    if (result->getType()->isVoidTy()) {
+        B.CreateStore(llvm::Constant::getNullValue(ValueTy), out);
+    } else {
+        B.CreateStore(B.CreateLoad(ValueTy, box_value(ctx, result)), out);
+    }
+    B.CreateRetVoid();
+
+    ctx.set_current_function(prev_func);
+    if (prev_block) B.SetInsertPoint(prev_block);
+    B.SetCurrentDebugLocation(prev_loc);
+    return adapter;
+}
+
+// Função do runtime que implementa um método sem argumentos extras ou de um argumento
+const char* vector_method_runtime_name(BuiltinId method) {
+    switch (method) {
+        case BuiltinId::VectorSort:  return "vector_sort_method";
+        case BuiltinId::VectorSum:   return "vector_sum_method";
+        case BuiltinId::VectorMin:   return "vector_min_method";
+        case BuiltinId::VectorMax:   return "vector_max_method";
+        case BuiltinId::VectorDot:   return "vector_dot_method";
+        case BuiltinId::VectorScale: return "vector_scale_method";
+        case BuiltinId::VectorAdd:   return "vector_add_method";
+        default:                     return nullptr;
+    }
+}
 
-    // Load self to get prototype
-    llvm::Value* selfVal = B.CreateLoad(ValueTy, selfAlloca);
-    llvm::Value* proto = B.CreateExtractValue(selfVal, 2);
+llvm::Value* lower_method_call(IRGenerationContext& ctx, llvm::Value* selfAlloca, BuiltinId method, const std::vector<llvm::Value*>& argv) {
+    auto& B = ctx.get_builder();
+    auto* ValueTy = ir_utils::get_value_struct(ctx);
+    auto* ValuePtr = ir_utils::get_value_ptr(ctx);
 
+    switch (method) {
     // String methods (explicit signatures)
-    if (method == "toUpperCase") {
+    case BuiltinId::StringToUpperCase: {
         auto* fn = ctx.ensure_runtime_func("string_to_upper_case", {ValuePtr, ValuePtr});
         auto* out = ctx.create_alloca(ValueTy, "out");
         B.CreateCall(fn, {out, selfAlloca});
         return B.CreateLoad(ValueTy, out);
-    } else if (method == "replace") {
+    }
+    case BuiltinId::StringReplace: {
         if (argv.size() < 2) return nullptr;
         auto* fn = ctx.ensure_runtime_func("string_replace", {ValuePtr, ValuePtr, ValuePtr, ValuePtr});
         auto* out = ctx.create_alloca(ValueTy, "out");
@@ -202,7 +437,8 @@ llvm::Value* lower_method_call(IRGenerationContext& ctx, llvm::Value* selfAlloca
         llvm::Value* a1 = box_value(ctx, argv[1]);
         B.CreateCall(fn, {out, selfAlloca, a0, a1});
         return B.CreateLoad(ValueTy, out);
-    } else if (method == "includes") {
+    }
+    case BuiltinId::StringIncludes: {
         if (argv.empty()) return nullptr;
         auto* fn = ctx.ensure_runtime_func("string_includes", {ValuePtr, ValuePtr, ValueTy});
         auto* out = ctx.create_alloca(ValueTy, "out");
@@ -212,19 +448,21 @@ llvm::Value* lower_method_call(IRGenerationContext& ctx, llvm::Value* selfAlloca
     }
 
     // Vector methods (explicit signatures)
-    if (method == "push") {
+    case BuiltinId::VectorPush: {
         if (argv.empty()) return nullptr;
         auto* fn = ctx.ensure_runtime_func("vector_push_method", {ValuePtr, ValuePtr, ValuePtr});
         auto* out = ctx.create_alloca(ValueTy, "out");
         llvm::Value* valPtr = box_value(ctx, argv[0]);
         B.CreateCall(fn, {out, selfAlloca, valPtr});
         return B.CreateLoad(ValueTy, out);
-    } else if (method == "pop") {
+    }
+    case BuiltinId::VectorPop: {
         auto* fn = ctx.ensure_runtime_func("vector_pop_method", {ValuePtr, ValuePtr});
         auto* out = ctx.create_alloca(ValueTy, "out");
         B.CreateCall(fn, {out, selfAlloca});
         return B.CreateLoad(ValueTy, out);
-    } else if (method == "get") {
+    }
+    case BuiltinId::VectorGet: {
         if (argv.empty()) return nullptr;
         auto* fn = ctx.ensure_runtime_func("vector_get_method", {ValuePtr, ValuePtr, llvm::Type::getInt32Ty(ctx.get_context())});
         auto* out = ctx.create_alloca(ValueTy, "out");
@@ -232,7 +470,8 @@ llvm::Value* lower_method_call(IRGenerationContext& ctx, llvm::Value* selfAlloca
         llvm::Value* idx = argv[0]->getType()->isIntegerTy(32) ? argv[0] : B.CreateSExtOrTrunc(argv[0], I32);
         B.CreateCall(fn, {out, selfAlloca, idx});
         return B.CreateLoad(ValueTy, out);
-    } else if (method == "set") {
+    }
+    case BuiltinId::VectorSet: {
         if (argv.size() < 2) return nullptr;
         auto* fn = ctx.ensure_runtime_func("vector_set_method", {ValuePtr, llvm::Type::getInt32Ty(ctx.get_context()), ValuePtr});
         auto* I32 = llvm::Type::getInt32Ty(ctx.get_context());
@@ -242,7 +481,57 @@ llvm::Value* lower_method_call(IRGenerationContext& ctx, llvm::Value* selfAlloca
         return nullptr;
     }
 
-    return nullptr;
+    // Métodos data-parallel: map/filter/reduce recebem uma função do usuário
+    case BuiltinId::VectorMap:
+    case BuiltinId::VectorFilter:
+    case BuiltinId::VectorReduce: {
+        size_t arity = method == BuiltinId::VectorReduce ? 2 : 1;
+        if (argv.size() < arity) return nullptr;
+        auto* callback = llvm::dyn_cast_or_null<llvm::Function>(argv[0]);
+        if (!callback) return nullptr;
+
+        auto* I32 = llvm::Type::getInt32Ty(ctx.get_context());
+        auto* I8P = ir_utils::get_i8_ptr(ctx);
+        auto* adapter = B.CreateBitCast(get_callback_adapter(ctx, callback), I8P);
+        auto* out = ctx.create_alloca(ValueTy, "out");
+
+        if (method == BuiltinId::VectorReduce) {
+            // reduce é sempre serial: o callback não precisa ser associativo
+            auto* fn = ctx.ensure_runtime_func("vector_reduce_method", {ValuePtr, ValuePtr, I8P, ValuePtr});
+            llvm::Value* init = box_value(ctx, argv[1]);
+            B.CreateCall(fn, {out, selfAlloca, adapter, init});
+        } else {
+            std::unordered_set<llvm::Function*> visiting;
+            auto* parallel = llvm::ConstantInt::get(I32, is_parallel_safe(callback, visiting) ? 1 : 0);
+            auto* fn = ctx.ensure_runtime_func(method == BuiltinId::VectorMap ? "vector_map_method" : "vector_filter_method",
+                                               {ValuePtr, ValuePtr, I8P, I32});
+            B.CreateCall(fn, {out, selfAlloca, adapter, parallel});
+        }
+        return B.CreateLoad(ValueTy, out);
+    }
+    case BuiltinId::VectorSort:
+    case BuiltinId::VectorSum:
+    case BuiltinId::VectorMin:
+    case BuiltinId::VectorMax: {
+        auto* fn = ctx.ensure_runtime_func(vector_method_runtime_name(method), {ValuePtr, ValuePtr});
+        auto* out = ctx.create_alloca(ValueTy, "out");
+        B.CreateCall(fn, {out, selfAlloca});
+        return B.CreateLoad(ValueTy, out);
+    }
+    // Operações numéricas sobre os kernels SIMD do runtime (simd.c)
+    case BuiltinId::VectorDot:
+    case BuiltinId::VectorScale:
+    case BuiltinId::VectorAdd: {
+        if (argv.empty() || !argv[0]) return nullptr;
+        auto* fn = ctx.ensure_runtime_func(vector_method_runtime_name(method), {ValuePtr, ValuePtr, ValuePtr});
+        auto* out = ctx.create_alloca(ValueTy, "out");
+        B.CreateCall(fn, {out, selfAlloca, box_value(ctx, argv[0])});
+        return B.CreateLoad(ValueTy, out);
+    }
+
+    default:
+        return nullptr;
+    }
 }
 
 } // anonymous namespace
@@ -251,10 +540,12 @@ void CallExprNode::codegen(IRGenerationContext& ctx) {
     ctx.set_debug_location(position.get());
     auto& B = ctx.get_builder();
 
-    // === 1. BUILTIN CALLS (write, read, json.load) ===
-    if (auto* id = dynamic_cast<IdentifierNode*>(caller.get())) {
-        std::string name = id->symbol;
-        if (auto* result = try_lower_builtin(ctx, name, args)) {
+    // Resolvido pelo checker; chamadas que não passaram por ele resolvem aqui
+    BuiltinId id = resolve_builtin();
+
+    // === 1. BUILTIN CALLS (write, read, read_lines) ===
+    if (caller->kind == NodeType::Identifier) {
+        if (auto* result = try_lower_builtin(ctx, id, args)) {
             ctx.push_value(result);
             return;
         }
@@ -266,55 +557,28 @@ void CallExprNode::codegen(IRGenerationContext& ctx) {
         mem->object->codegen(ctx);
         llvm::Value* obj = ctx.pop_value();
 
-        // Extrai o nome do método (ex: "load")
-        std::string method;
-        if (auto* id = dynamic_cast<IdentifierNode*>(mem->property.get())) {
-            method = id->symbol;
-        } else {
+        if (!dynamic_cast<IdentifierNode*>(mem->property.get())) {
             ctx.push_value(nullptr);
             return;
         }
 
-        // === ESPECIAL: json.load("file.json") ===
-        if (method == "load") {
-            // Verifica se o objeto é o identifier "json"
-            if (auto* objId = dynamic_cast<IdentifierNode*>(mem->object.get())) {
-                if (objId->symbol == "json") {
-                    if (args.empty()) {
-                        ctx.push_value(nullptr);
-                        return;
-                    }
-
-                    // Avalia o argumento (filename)
-                    args[0]->codegen(ctx);
-                    llvm::Value* filename = ctx.pop_value();
-                    auto* I8P = ir_utils::get_i8_ptr(ctx);
-
-                    if (!filename->getType()->isPointerTy()) {
-                        filename = ctx.get_builder().CreateGlobalStringPtr(""); // fallback
-                    } else if (filename->getType() != I8P) {
-                        filename = ctx.get_builder().CreateBitCast(filename, I8P);
-                    }
-
-                    // Chama void json_load(Value*, const char*) e carrega o Value
-                    auto* ValueTy = ir_utils::get_value_struct(ctx);
-                    auto* ValuePtr = ir_utils::get_value_ptr(ctx);
-                    auto* fn = ctx.ensure_runtime_func(
-                        "json_load",
-                        {ValuePtr, I8P},
-                        llvm::Type::getVoidTy(ctx.get_context())
-                    );
-                    auto* outAlloca = ctx.create_alloca(ValueTy, "json_out");
-                    ctx.get_builder().CreateCall(fn, {outAlloca, filename});
-                    llvm::Value* loaded = ctx.get_builder().CreateLoad(ValueTy, outAlloca);
-                    ctx.push_value(loaded);
+        // === ESPECIAL: métodos de json, csv e snapshot ===
+        if (auto* objId = dynamic_cast<IdentifierNode*>(mem->object.get())) {
+            switch (builtin_object_id(objId->symbol_id)) {
+                case BuiltinObject::Json:
+                    ctx.push_value(lower_json_call(ctx, id, args));
                     return;
-                }
+                case BuiltinObject::Csv:
+                    ctx.push_value(lower_csv_call(ctx, id, args));
+                    return;
+                case BuiltinObject::Snapshot:
+                    ctx.push_value(lower_snapshot_call(ctx, id, args));
+                    return;
+                case BuiltinObject::None:
+                    break;
             }
         }
 
-        // === FIM DO ESPECIAL json.load ===
-
         // === MÉTODOS NORMAIS (push, pop, etc) ===
         auto* selfAlloca = box_value(ctx, obj);
 
@@ -324,7 +588,7 @@ void CallExprNode::codegen(IRGenerationContext& ctx) {
             argv.push_back(ctx.pop_value());
         }
 
-        if (auto* result = lower_method_call(ctx, selfAlloca, method, argv)) {
+        if (auto* result = lower_method_call(ctx, selfAlloca, id, argv)) {
             ctx.push_value(result);
             return;
         }
@@ -1,9 +1,10 @@
 #include "frontend/ast/expressions/identifier_node.hpp"
 #include "backend/codegen/ir_context.hpp"
 #include "backend/codegen/ir_utils.hpp"
+#include "frontend/lexer/source_manager.hpp"
 #include <llvm/Support/raw_ostream.h>
 #include <filesystem>
-#include <fstream>
+#include <optional>
 #include <algorithm>
 #include <cmath>
 #include <sstream>
@@ -41,24 +42,18 @@ namespace {
             return;
         }
         
-        // Ler linhas do arquivo para contexto
-        std::vector<std::string> lines;
-        std::ifstream file(abs_filename);
-        if (file.is_open()) {
-            std::string line;
-            while (std::getline(file, line)) {
-                lines.push_back(line);
-            }
-            file.close();
-        }
+        // Contexto vem do buffer já mapeado no SourceManager
+        const SourceManager& sources = SourceManager::instance();
+        std::optional<FileId> file = sources.find(abs_filename);
+        size_t line_count = file ? sources.line_count(*file) : 0;
         
         std::cerr << ANSI_BOLD << abs_filename << ":" << pos->line << ":" << pos->col[0] << ": "
                   << ANSI_RED << "ERROR" << ANSI_RESET << ANSI_BOLD << ": "
                   << message << ANSI_RESET << "\n";
         
         // Mostrar contexto (mesmo formato do checker)
-        if (pos->line > 0 && pos->line - 1 < lines.size()) {
-            std::string line_content = lines[pos->line - 1];
+        if (pos->line > 0 && pos->line <= line_count) {
+            std::string line_content(sources.line(*file, pos->line));
             std::replace(line_content.begin(), line_content.end(), '\n', ' ');
             std::cerr << " " << pos->line << " |   " << line_content << "\n";
             
@@ -81,10 +76,10 @@ namespace {
 void IdentifierNode::codegen(nv::IRGenerationContext& context) {
     context.set_debug_location(position.get());
     
-    auto symbol_opt = context.get_symbol_info(symbol);
-    if (!symbol_opt) {
-        // Intrínseco: 'json' é um objeto especial da linguagem
-        if (symbol == "json") {
+    const nv::SymbolInfo* symbol_info = context.get_symbol_info(symbol_id);
+    if (!symbol_info) {
+        // Intrínsecos: 'json', 'csv' e 'snapshot' são objetos especiais da linguagem
+        if (symbol == "json" || symbol == "csv" || symbol == "snapshot") {
             auto* I8P = nv::ir_utils::get_i8_ptr(context);
             auto* nullJson = llvm::Constant::getNullValue(I8P);
             context.push_value(nullJson);
@@ -107,8 +102,7 @@ void IdentifierNode::codegen(nv::IRGenerationContext& context) {
                 false,  // não é alocação local
                 false   // não é constante
             );
-            context.get_symbol_table().define_symbol(symbol, info);
-            symbol_opt = info;
+            symbol_info = &context.get_symbol_table().define_symbol(symbol_id, info);
         } else {
             // Modo incremental: o símbolo pode ter sido definido em um fragmento anterior.
             // Por enquanto, vamos apenas retornar nullptr para variáveis externas para evitar segfaults
@@ -118,7 +112,7 @@ void IdentifierNode::codegen(nv::IRGenerationContext& context) {
         }
     }
 
-    const nv::SymbolInfo& info = symbol_opt.value();
+    const nv::SymbolInfo& info = *symbol_info;
 
     // Se info.value for nullptr, significa que foi registrado por import mas ainda não foi criado
     // Neste caso, tentar buscar a variável global ou função diretamente no módulo
@@ -137,7 +131,7 @@ void IdentifierNode::codegen(nv::IRGenerationContext& context) {
             updated_info.value = global_var;
             updated_info.llvm_type = nv::ir_utils::get_value_struct(context);
             updated_info.is_constant = false;
-            context.get_symbol_table().define_symbol(symbol, updated_info);
+            context.get_symbol_table().define_symbol(symbol_id, updated_info);
             actual_value = global_var;
             
             // No REPL, variáveis globais podem não ter initializer inicialmente
@@ -148,7 +142,7 @@ void IdentifierNode::codegen(nv::IRGenerationContext& context) {
             updated_info.value = function;
             updated_info.llvm_type = function->getType();
             updated_info.is_constant = true;  // funções são constantes
-            context.get_symbol_table().define_symbol(symbol, updated_info);
+            context.get_symbol_table().define_symbol(symbol_id, updated_info);
             actual_value = function;
         } else {
             // Variable/function not yet created - este erro já deve ter sido reportado pelo checker
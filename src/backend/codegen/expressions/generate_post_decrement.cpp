@@ -16,9 +16,9 @@ void PostDecrementExprNode::codegen(nv::IRGenerationContext& ctx) {
 
     if (auto* id = dynamic_cast<IdentifierNode*>(operand.get())) {
         // Identificador simples - usar código original
-        auto info_opt = ctx.get_symbol_table().lookup_symbol(id->symbol);
-        if (!info_opt.has_value()) { ctx.push_value(nullptr); return; }
-        auto info = info_opt.value();
+        const auto* info_ptr = ctx.get_symbol_table().lookup_symbol(id->symbol_id);
+        if (!info_ptr) { ctx.push_value(nullptr); return; }
+        const auto& info = *info_ptr;
         llvm::Value* addr = info.value;
         llvm::Type* elemTy = info.llvm_type;
 
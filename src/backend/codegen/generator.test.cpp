@@ -153,6 +153,11 @@ int main(int argc, char* argv[]) {
             }
         }
 
+        // _exit não passa pelo teardown do stdio: esvaziar a saída buferizada do runtime
+        llvm::FunctionCallee flush_fn = Mod.getOrInsertFunction(
+            "nv_flush_all", llvm::FunctionType::get(llvm::Type::getVoidTy(Context), false));
+        context.get_builder().CreateCall(flush_fn);
+
         // declare _exit(int);
         auto* exit_ty = llvm::FunctionType::get(llvm::Type::getVoidTy(Context), {i32_ty}, false);
         llvm::FunctionCallee exit_fn = Mod.getOrInsertFunction("_exit", exit_ty);
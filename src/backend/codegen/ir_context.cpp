@@ -51,19 +51,22 @@ std::shared_ptr<Type> IRGenerationContext::resolve_type(std::shared_ptr<Type> nv
         if (resolved->kind == Kind::TYPE_VAR) {
             // Em produção, isso deveria ser um erro, mas para compatibilidade
             // retornamos int como fallback
-            return std::make_shared<Int>();
+            return int_type();
         }
         
         return resolved;
     }
     
+    // Tipos internados não têm variáveis para resolver
+    if (nv_type->type_id) return nv_type;
+
     // Para tipos compostos, resolver recursivamente
     switch (nv_type->kind) {
         case Kind::ARRAY: {
             auto array_type = std::static_pointer_cast<Array>(nv_type);
             if (array_type && array_type->element_type) {
                 auto resolved_elem = resolve_type(array_type->element_type);
-                return std::make_shared<Array>(resolved_elem, array_type->size);
+                return make_array_type(resolved_elem, array_type->size);
             }
             return nv_type;
         }
@@ -78,7 +81,7 @@ std::shared_ptr<Type> IRGenerationContext::resolve_type(std::shared_ptr<Type> nv
                 for (const auto& elem : tuple_type->element_type) {
                     resolved_elems.push_back(resolve_type(elem));
                 }
-                return std::make_shared<Tuple>(resolved_elems);
+                return make_tuple_type(resolved_elems);
             }
             return nv_type;
         }
@@ -90,7 +93,7 @@ std::shared_ptr<Type> IRGenerationContext::resolve_type(std::shared_ptr<Type> nv
                     resolved_params.push_back(resolve_type(param));
                 }
                 auto resolved_ret = resolve_type(def_type->returntype);
-                return std::make_shared<Def>(resolved_params, resolved_ret);
+                return make_def_type(resolved_params, resolved_ret);
             }
             return nv_type;
         }
@@ -227,12 +230,12 @@ llvm::AllocaInst* IRGenerationContext::create_and_register_variable(
 }
 
 llvm::Value* IRGenerationContext::load_symbol(const std::string& name) {
-    auto info_opt = symbol_table.lookup_symbol(name);
-    if (!info_opt.has_value()) {
+    const SymbolInfo* info_ptr = symbol_table.lookup_symbol(name);
+    if (!info_ptr) {
         return nullptr;
     }
     
-    auto info = info_opt.value();
+    const SymbolInfo& info = *info_ptr;
     
     // Se for uma alocação, carrega o valor
     if (info.is_allocated && llvm::isa<llvm::AllocaInst>(info.value)) {
@@ -244,12 +247,12 @@ llvm::Value* IRGenerationContext::load_symbol(const std::string& name) {
 }
 
 bool IRGenerationContext::store_symbol(const std::string& name, llvm::Value* value) {
-    auto info_opt = symbol_table.lookup_symbol(name);
-    if (!info_opt.has_value()) {
+    const SymbolInfo* info_ptr = symbol_table.lookup_symbol(name);
+    if (!info_ptr) {
         return false;
     }
     
-    auto info = info_opt.value();
+    const SymbolInfo& info = *info_ptr;
     
     // Se for uma alocação, armazena o valor
     if (info.is_allocated && llvm::isa<llvm::AllocaInst>(info.value)) {
@@ -262,10 +265,14 @@ bool IRGenerationContext::store_symbol(const std::string& name, llvm::Value* val
     return symbol_table.update_symbol(name, new_info);
 }
 
-std::optional<SymbolInfo> IRGenerationContext::get_symbol_info(const std::string& name) {
+const SymbolInfo* IRGenerationContext::get_symbol_info(const std::string& name) {
     return symbol_table.lookup_symbol(name);
 }
 
+const SymbolInfo* IRGenerationContext::get_symbol_info(SymbolId symbol) {
+    return symbol_table.lookup_symbol(symbol);
+}
+
 void IRGenerationContext::register_global_init(llvm::GlobalVariable* global, llvm::Value* init_value, const std::string& symbol_name) {
     std::fprintf(stderr, "[register_global_init] registering symbol=%s global=%p init_value=%p\n", symbol_name.c_str(), (void*)global, (void*)init_value);
     pending_global_inits.push_back({global, init_value, symbol_name});
@@ -122,7 +122,7 @@ static llvm::Value* extract_int_from_value(IRGenerationContext& context, llvm::V
     return value32;
 }
 
-llvm::Value* create_comparison(IRGenerationContext& context, llvm::Value* lhs, llvm::Value* rhs, const std::string& op) {
+llvm::Value* create_comparison(IRGenerationContext& context, llvm::Value* lhs, llvm::Value* rhs, BinaryOp op) {
     if (!lhs || !rhs) return nullptr;
     auto& builder = context.get_builder();
     auto* valueStruct = get_value_struct(context);
@@ -148,12 +148,15 @@ llvm::Value* create_comparison(IRGenerationContext& context, llvm::Value* lhs, l
             auto* strcmpFn = llvm::cast<llvm::Function>(context.get_module().getOrInsertFunction("strcmp", strcmpTy).getCallee());
             auto* cmpRes = builder.CreateCall(strcmpFn, { lhs, rhs }, "strcmp");
             auto* zero = llvm::ConstantInt::get(i32, 0);
-            if (op == "==") return builder.CreateICmpEQ(cmpRes, zero, "cmpeq");
-            if (op == "!=") return builder.CreateICmpNE(cmpRes, zero, "cmpne");
-            if (op == "<")  return builder.CreateICmpSLT(cmpRes, zero, "cmplt");
-            if (op == ">")  return builder.CreateICmpSGT(cmpRes, zero, "cmpgt");
-            if (op == "<=") return builder.CreateICmpSLE(cmpRes, zero, "cmple");
-            if (op == ">=") return builder.CreateICmpSGE(cmpRes, zero, "cmpge");
+            switch (op) {
+                case BinaryOp::Eq: return builder.CreateICmpEQ(cmpRes, zero, "cmpeq");
+                case BinaryOp::Ne: return builder.CreateICmpNE(cmpRes, zero, "cmpne");
+                case BinaryOp::Lt: return builder.CreateICmpSLT(cmpRes, zero, "cmplt");
+                case BinaryOp::Gt: return builder.CreateICmpSGT(cmpRes, zero, "cmpgt");
+                case BinaryOp::Le: return builder.CreateICmpSLE(cmpRes, zero, "cmple");
+                case BinaryOp::Ge: return builder.CreateICmpSGE(cmpRes, zero, "cmpge");
+                default: break;
+            }
         }
     }
 
@@ -172,23 +175,25 @@ llvm::Value* create_comparison(IRGenerationContext& context, llvm::Value* lhs, l
     bool is_float = final_type->isFloatingPointTy();
     bool is_int = final_type->isIntegerTy() || final_type->isPointerTy();
 
-    if (op == "==") return is_float
-        ? builder.CreateFCmpOEQ(lhs, rhs, "cmpeq") : builder.CreateICmpEQ(lhs, rhs, "cmpeq");
-    if (op == "!=") return is_float
-        ? builder.CreateFCmpONE(lhs, rhs, "cmpne") : builder.CreateICmpNE(lhs, rhs, "cmpne");
-    if (op == "<") return is_float
-        ? builder.CreateFCmpOLT(lhs, rhs, "cmplt") : builder.CreateICmpSLT(lhs, rhs, "cmplt");
-    if (op == ">") return is_float
-        ? builder.CreateFCmpOGT(lhs, rhs, "cmpgt") : builder.CreateICmpSGT(lhs, rhs, "cmpgt");
-    if (op == "<=") return is_float
-        ? builder.CreateFCmpOLE(lhs, rhs, "cmple") : builder.CreateICmpSLE(lhs, rhs, "cmple");
-    if (op == ">=") return is_float
-        ? builder.CreateFCmpOGE(lhs, rhs, "cmpge") : builder.CreateICmpSGE(lhs, rhs, "cmpge");
-
-    return nullptr;
+    switch (op) {
+        case BinaryOp::Eq: return is_float
+            ? builder.CreateFCmpOEQ(lhs, rhs, "cmpeq") : builder.CreateICmpEQ(lhs, rhs, "cmpeq");
+        case BinaryOp::Ne: return is_float
+            ? builder.CreateFCmpONE(lhs, rhs, "cmpne") : builder.CreateICmpNE(lhs, rhs, "cmpne");
+        case BinaryOp::Lt: return is_float
+            ? builder.CreateFCmpOLT(lhs, rhs, "cmplt") : builder.CreateICmpSLT(lhs, rhs, "cmplt");
+        case BinaryOp::Gt: return is_float
+            ? builder.CreateFCmpOGT(lhs, rhs, "cmpgt") : builder.CreateICmpSGT(lhs, rhs, "cmpgt");
+        case BinaryOp::Le: return is_float
+            ? builder.CreateFCmpOLE(lhs, rhs, "cmple") : builder.CreateICmpSLE(lhs, rhs, "cmple");
+        case BinaryOp::Ge: return is_float
+            ? builder.CreateFCmpOGE(lhs, rhs, "cmpge") : builder.CreateICmpSGE(lhs, rhs, "cmpge");
+        default:
+            return nullptr;
+    }
 }
 
-llvm::Value* create_binary_op(IRGenerationContext& context, llvm::Value* lhs, llvm::Value* rhs, const std::string& op) {
+llvm::Value* create_binary_op(IRGenerationContext& context, llvm::Value* lhs, llvm::Value* rhs, BinaryOp op) {
     if (!lhs || !rhs) return nullptr;
     auto& builder = context.get_builder();
     auto* valueStruct = get_value_struct(context);
@@ -206,7 +211,7 @@ llvm::Value* create_binary_op(IRGenerationContext& context, llvm::Value* lhs, ll
     auto* lhs_type = lhs->getType();
     auto* rhs_type = rhs->getType();
 
-    if (op == "**") {
+    if (op == BinaryOp::Pow) {
         llvm::Type* f64 = get_f64(context);
         if (!lhs_type->isFloatingPointTy()) lhs = builder.CreateSIToFP(lhs, f64);
         else if (lhs_type != f64) lhs = builder.CreateFPExt(lhs, f64);
@@ -216,7 +221,7 @@ llvm::Value* create_binary_op(IRGenerationContext& context, llvm::Value* lhs, ll
         return builder.CreateCall(pow_decl, { lhs, rhs }, "pow");
     }
 
-    if (op == "+") {
+    if (op == BinaryOp::Add) {
         auto* i8p = llvm::PointerType::getUnqual(get_i8(context));
         bool lhs_is_str = (lhs_type == i8p);
         bool rhs_is_str = (rhs_type == i8p);
@@ -227,7 +232,7 @@ llvm::Value* create_binary_op(IRGenerationContext& context, llvm::Value* lhs, ll
         }
     }
 
-    if ((op == "*") && ([&](){
+    if ((op == BinaryOp::Mul) && ([&](){
         auto* i8ptr = llvm::PointerType::getUnqual(get_i8(context));
         bool lhs_is_str = (lhs_type == i8ptr);
         bool rhs_is_str = (rhs_type == i8ptr);
@@ -269,12 +274,14 @@ llvm::Value* create_binary_op(IRGenerationContext& context, llvm::Value* lhs, ll
         }
     }
 
-    if (op == "+") return lhs_type->isFloatingPointTy() ? builder.CreateFAdd(lhs, rhs, "add") : builder.CreateAdd(lhs, rhs, "add");
-    if (op == "-") return lhs_type->isFloatingPointTy() ? builder.CreateFSub(lhs, rhs, "sub") : builder.CreateSub(lhs, rhs, "sub");
-    if (op == "*") return lhs_type->isFloatingPointTy() ? builder.CreateFMul(lhs, rhs, "mul") : builder.CreateMul(lhs, rhs, "mul");
-    if (op == "/") return lhs_type->isFloatingPointTy() ? builder.CreateFDiv(lhs, rhs, "div") : builder.CreateSDiv(lhs, rhs, "div");
-    if (op == "//") {
-        if (lhs_type->isFloatingPointTy()) {
+    bool is_float = lhs_type->isFloatingPointTy();
+    switch (op) {
+        case BinaryOp::Add: return is_float ? builder.CreateFAdd(lhs, rhs, "add") : builder.CreateAdd(lhs, rhs, "add");
+        case BinaryOp::Sub: return is_float ? builder.CreateFSub(lhs, rhs, "sub") : builder.CreateSub(lhs, rhs, "sub");
+        case BinaryOp::Mul: return is_float ? builder.CreateFMul(lhs, rhs, "mul") : builder.CreateMul(lhs, rhs, "mul");
+        case BinaryOp::Div: return is_float ? builder.CreateFDiv(lhs, rhs, "div") : builder.CreateSDiv(lhs, rhs, "div");
+        case BinaryOp::FloorDiv: {
+            if (!is_float) return builder.CreateSDiv(lhs, rhs, "idiv");
             auto* f64 = get_f64(context);
             if (lhs_type != f64) lhs = builder.CreateFPExt(lhs, f64);
             if (rhs_type != f64) rhs = builder.CreateFPExt(rhs, f64);
@@ -282,13 +289,11 @@ llvm::Value* create_binary_op(IRGenerationContext& context, llvm::Value* lhs, ll
             auto* floorFn = llvm::cast<llvm::Function>(context.get_module().getOrInsertFunction("floor", floorTy).getCallee());
             auto* divv = builder.CreateFDiv(lhs, rhs);
             return builder.CreateCall(floorFn, { divv });
-        } else {
-            return builder.CreateSDiv(lhs, rhs, "idiv");
         }
+        case BinaryOp::Mod: return is_float ? builder.CreateFRem(lhs, rhs, "mod") : builder.CreateSRem(lhs, rhs, "mod");
+        default:
+            return nullptr;
     }
-    if (op == "%") return lhs_type->isFloatingPointTy() ? builder.CreateFRem(lhs, rhs, "mod") : builder.CreateSRem(lhs, rhs, "mod");
-
-    return nullptr;
 }
 
 llvm::Value* create_unary_op(IRGenerationContext& context, llvm::Value* operand, const std::string& op) {
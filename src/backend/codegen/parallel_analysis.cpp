@@ -0,0 +1,523 @@
+#include "backend/codegen/parallel_analysis.hpp"
+#include "backend/codegen/ir_utils.hpp"
+#include <unordered_map>
+#include <unordered_set>
+
+namespace nv {
+
+namespace {
+
+// Compara duas expressões estruturalmente (usado no padrão `if e < r { r = e }`)
+bool same_expr(const Expr* a, const Expr* b) {
+    if (!a || !b) return a == b;
+    if (a->kind != b->kind) return false;
+    switch (a->kind) {
+        case NodeType::Identifier:
+            return static_cast<const IdentifierNode*>(a)->symbol == static_cast<const IdentifierNode*>(b)->symbol;
+        case NodeType::NumericLiteral:
+            return static_cast<const NumericLiteralNode*>(a)->value == static_cast<const NumericLiteralNode*>(b)->value;
+        case NodeType::AccessExpression: {
+            auto* x = static_cast<const AccessExprNode*>(a);
+            auto* y = static_cast<const AccessExprNode*>(b);
+            return same_expr(x->expr.get(), y->expr.get()) && same_expr(x->index.get(), y->index.get());
+        }
+        case NodeType::BinaryExpression: {
+            auto* x = static_cast<const BinaryExprNode*>(a);
+            auto* y = static_cast<const BinaryExprNode*>(b);
+            return x->op == y->op && same_expr(x->left.get(), y->left.get()) && same_expr(x->right.get(), y->right.get());
+        }
+        case NodeType::UnaryMinusExpression:
+            return same_expr(static_cast<const UnaryMinusExprNode*>(a)->operand.get(),
+                             static_cast<const UnaryMinusExprNode*>(b)->operand.get());
+        default:
+            return false;
+    }
+}
+
+bool mentions(const Expr* e, const std::string& name) {
+    if (!e) return false;
+    switch (e->kind) {
+        case NodeType::Identifier:
+            return static_cast<const IdentifierNode*>(e)->symbol == name;
+        case NodeType::AccessExpression: {
+            auto* acc = static_cast<const AccessExprNode*>(e);
+            return mentions(acc->expr.get(), name) || mentions(acc->index.get(), name);
+        }
+        case NodeType::BinaryExpression: {
+            auto* bin = static_cast<const BinaryExprNode*>(e);
+            return mentions(bin->left.get(), name) || mentions(bin->right.get(), name);
+        }
+        case NodeType::UnaryMinusExpression:
+            return mentions(static_cast<const UnaryMinusExprNode*>(e)->operand.get(), name);
+        case NodeType::LogicalNotExpression:
+            return mentions(static_cast<const LogicalNotExprNode*>(e)->operand.get(), name);
+        default:
+            return false;
+    }
+}
+
+class LoopIndependenceAnalyzer {
+public:
+    LoopIndependenceAnalyzer(const ForStmtNode& loop, IRGenerationContext& ctx)
+        : loop(loop), ctx(ctx) {}
+
+    ParallelLoopPlan run();
+
+private:
+    const ForStmtNode& loop;
+    IRGenerationContext& ctx;
+
+    std::unordered_set<std::string> inductions;
+    std::vector<std::unordered_set<std::string>> scopes;   // nomes declarados dentro do corpo
+    int loop_depth = 0;
+    std::string failure;
+
+    std::vector<std::string> capture_order;
+    std::unordered_set<std::string> captured;
+    std::unordered_map<std::string, int> plain_reads;       // usos fora de c[i]
+    std::unordered_set<std::string> arbitrary_reads;        // c[j] com j != indução
+    std::unordered_set<std::string> nested_reads;           // c[x][y]
+    std::vector<std::string> written_order;
+    std::unordered_set<std::string> written;                // c[i] = ...
+    std::vector<ReductionInfo> reductions;
+
+    void fail(const std::string& why) {
+        if (failure.empty()) failure = why;
+    }
+
+    bool is_local(const std::string& name) const {
+        for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
+            if (it->count(name)) return true;
+        }
+        return false;
+    }
+
+    bool is_induction(const std::string& name) const {
+        return inductions.count(name) && !is_local(name);
+    }
+
+    bool is_induction_expr(const Expr* e) const {
+        auto* id = dynamic_cast<const IdentifierNode*>(e);
+        return id && is_induction(id->symbol);
+    }
+
+    void declare(const std::string& name) {
+        if (!scopes.empty()) scopes.back().insert(name);
+    }
+
+    // Registra uma variável externa; locais da função são capturados por endereço
+    void capture(const std::string& name) {
+        if (captured.count(name)) return;
+        auto info = ctx.get_symbol_table().lookup_symbol(name);
+        if (!info || !info->value) return;
+        auto* v = info->value;
+        if (llvm::isa<llvm::GlobalValue>(v) || llvm::isa<llvm::Constant>(v)) return;
+        if (!llvm::isa<llvm::AllocaInst>(v)) {
+            fail("'" + name + "' não pode ser capturada pelo corpo paralelo");
+            return;
+        }
+        captured.insert(name);
+        capture_order.push_back(name);
+    }
+
+    bool is_outer(const std::string& name) const {
+        return !is_local(name) && !is_induction(name);
+    }
+
+    void read(const std::string& name) {
+        if (!is_outer(name)) return;
+        plain_reads[name]++;
+        capture(name);
+    }
+
+    void add_reduction(const std::string& name, ReductionKind kind) {
+        for (auto& r : reductions) {
+            if (r.symbol == name) {
+                if (r.kind != kind) fail("'" + name + "' acumula com operações de redução diferentes");
+                return;
+            }
+        }
+        reductions.push_back({name, kind});
+        capture(name);
+    }
+
+    void visit_block(const CodeBlock& block);
+    void visit_stmt(const Stmt* stmt);
+    void visit_expr(const Expr* expr);
+    void visit_access_read(const AccessExprNode* acc);
+    void visit_assignment(const AssignmentExprNode* asg);
+    void visit_step(const Expr* operand, const char* op);
+    bool match_min_max(const IfStatementNode* node);
+    void validate();
+    std::string describe() const;
+};
+
+void LoopIndependenceAnalyzer::visit_block(const CodeBlock& block) {
+    scopes.emplace_back();
+    for (auto& stmt : block) {
+        visit_stmt(stmt.get());
+    }
+    scopes.pop_back();
+}
+
+void LoopIndependenceAnalyzer::visit_stmt(const Stmt* stmt) {
+    if (!stmt || !failure.empty()) return;
+    switch (stmt->kind) {
+        case NodeType::DeclarationStatement: {
+            auto* decl = static_cast<const DeclarationStmtNode*>(stmt);
+            visit_expr(decl->value.get());
+            if (auto* id = dynamic_cast<const IdentifierNode*>(decl->target.get())) {
+                declare(id->symbol);
+            }
+            return;
+        }
+        case NodeType::IfStatement: {
+            auto* node = static_cast<const IfStatementNode*>(stmt);
+            if (match_min_max(node)) return;
+            visit_expr(node->condition.get());
+            visit_block(node->consequent);
+            visit_block(node->alternate);
+            return;
+        }
+        case NodeType::ForStatement: {
+            auto* node = static_cast<const ForStmtNode*>(stmt);
+            visit_expr(node->range_start.get());
+            visit_expr(node->range_end.get());
+            visit_expr(node->iterable.get());
+            scopes.emplace_back();
+            for (auto& b : node->bindings) {
+                if (auto* id = dynamic_cast<const IdentifierNode*>(b.get())) declare(id->symbol);
+            }
+            loop_depth++;
+            visit_block(node->body);
+            loop_depth--;
+            scopes.pop_back();
+            visit_block(node->else_block);
+            return;
+        }
+        case NodeType::WhileStatement: {
+            auto* node = static_cast<const WhileStmtNode*>(stmt);
+            visit_expr(node->condition.get());
+            loop_depth++;
+            visit_block(node->body);
+            loop_depth--;
+            return;
+        }
+        case NodeType::LoopStatement: {
+            auto* node = static_cast<const LoopStmtNode*>(stmt);
+            loop_depth++;
+            visit_block(node->body);
+            loop_depth--;
+            return;
+        }
+        case NodeType::BreakStatement:
+            if (loop_depth == 0) fail("'break' encerra o loop antes do fim do intervalo");
+            return;
+        case NodeType::ContinueStatement:
+            return;
+        case NodeType::ReturnStatement:
+            fail("'return' dentro do corpo");
+            return;
+        case NodeType::MatchStatement:
+        case NodeType::DefStatement:
+        case NodeType::ImportStatement:
+            fail("comando não suportado no corpo paralelo");
+            return;
+        default:
+            if (auto* expr = dynamic_cast<const Expr*>(stmt)) visit_expr(expr);
+            return;
+    }
+}
+
+void LoopIndependenceAnalyzer::visit_expr(const Expr* expr) {
+    if (!expr || !failure.empty()) return;
+    switch (expr->kind) {
+        case NodeType::NumericLiteral:
+        case NodeType::BooleanLiteral:
+        case NodeType::StringLiteral:
+            return;
+        case NodeType::Identifier:
+            read(static_cast<const IdentifierNode*>(expr)->symbol);
+            return;
+        case NodeType::BinaryExpression: {
+            auto* bin = static_cast<const BinaryExprNode*>(expr);
+            visit_expr(bin->left.get());
+            visit_expr(bin->right.get());
+            return;
+        }
+        case NodeType::LogicalNotExpression:
+            visit_expr(static_cast<const LogicalNotExprNode*>(expr)->operand.get());
+            return;
+        case NodeType::UnaryMinusExpression:
+            visit_expr(static_cast<const UnaryMinusExprNode*>(expr)->operand.get());
+            return;
+        case NodeType::ConditionalExpression: {
+            auto* cond = static_cast<const ConditionalExprNode*>(expr);
+            visit_expr(cond->condition.get());
+            visit_expr(cond->true_expr.get());
+            visit_expr(cond->false_expr.get());
+            return;
+        }
+        case NodeType::ArrayExpression:
+            for (auto& e : static_cast<const ArrayExprNode*>(expr)->elements) visit_expr(e.get());
+            return;
+        case NodeType::VectorExpression:
+            for (auto& e : static_cast<const VectorExprNode*>(expr)->elements) visit_expr(e.get());
+            return;
+        case NodeType::TupleExpression:
+            for (auto& e : static_cast<const TupleExprNode*>(expr)->elements) visit_expr(e.get());
+            return;
+        case NodeType::AccessExpression:
+            visit_access_read(static_cast<const AccessExprNode*>(expr));
+            return;
+        case NodeType::AssignmentExpression:
+            visit_assignment(static_cast<const AssignmentExprNode*>(expr));
+            return;
+        case NodeType::IncrementExpression:
+            visit_step(static_cast<const IncrementExprNode*>(expr)->operand.get(), "++");
+            return;
+        case NodeType::DecrementExpression:
+            visit_step(static_cast<const DecrementExprNode*>(expr)->operand.get(), "--");
+            return;
+        case NodeType::PostIncrementExpression:
+            visit_step(static_cast<const PostIncrementExprNode*>(expr)->operand.get(), "++");
+            return;
+        case NodeType::PostDecrementExpression:
+            visit_step(static_cast<const PostDecrementExprNode*>(expr)->operand.get(), "--");
+            return;
+        case NodeType::CallExpression: {
+            auto* call = static_cast<const CallExprNode*>(expr);
+            std::string callee = "função";
+            if (auto* id = dynamic_cast<const IdentifierNode*>(call->caller.get())) callee = id->symbol;
+            fail("chamada de '" + callee + "' pode ter efeitos colaterais");
+            return;
+        }
+        default:
+            fail("expressão não suportada no corpo paralelo");
+            return;
+    }
+}
+
+void LoopIndependenceAnalyzer::visit_access_read(const AccessExprNode* acc) {
+    visit_expr(acc->index.get());
+    auto* base = acc->expr.get();
+    if (auto* id = dynamic_cast<const IdentifierNode*>(base)) {
+        if (!is_outer(id->symbol)) return;
+        if (!is_induction_expr(acc->index.get())) arbitrary_reads.insert(id->symbol);
+        capture(id->symbol);
+        return;
+    }
+    if (auto* inner = dynamic_cast<const AccessExprNode*>(base)) {
+        visit_access_read(inner);
+        const Expr* root = inner;
+        while (auto* a = dynamic_cast<const AccessExprNode*>(root)) root = a->expr.get();
+        if (auto* id = dynamic_cast<const IdentifierNode*>(root)) {
+            if (is_outer(id->symbol)) nested_reads.insert(id->symbol);
+        }
+        return;
+    }
+    visit_expr(base);
+}
+
+void LoopIndependenceAnalyzer::visit_assignment(const AssignmentExprNode* asg) {
+    visit_expr(asg->value.get());
+    if (!failure.empty()) return;
+
+    if (auto* id = dynamic_cast<const IdentifierNode*>(asg->target.get())) {
+        const std::string& name = id->symbol;
+        BinaryOp compound = compound_assign_op(asg->op);
+        bool simple = compound == BinaryOp::Unknown;
+        if (is_induction(name)) {
+            fail("o corpo atribui à variável de indução '" + name + "'");
+        } else if (is_local(name)) {
+            return;
+        } else if (simple && !ctx.get_symbol_table().exists(name)) {
+            // Atribuição a nome novo cria uma local do corpo
+            declare(name);
+        } else if (compound == BinaryOp::Add || compound == BinaryOp::Sub) {
+            add_reduction(name, ReductionKind::Sum);
+        } else {
+            fail("escrita em '" + name + "' cria dependência entre iterações");
+        }
+        return;
+    }
+
+    if (auto* acc = dynamic_cast<const AccessExprNode*>(asg->target.get())) {
+        visit_expr(acc->index.get());
+        auto* base = dynamic_cast<const IdentifierNode*>(acc->expr.get());
+        if (!base) {
+            fail("escrita indexada aninhada não pode ser provada disjunta");
+            return;
+        }
+        if (!is_outer(base->symbol)) return;
+        if (!is_induction_expr(acc->index.get())) {
+            fail("escrita em '" + base->symbol + "[...]' fora do índice da indução pode colidir entre iterações");
+            return;
+        }
+        if (!written.count(base->symbol)) {
+            written.insert(base->symbol);
+            written_order.push_back(base->symbol);
+        }
+        capture(base->symbol);
+        return;
+    }
+
+    fail("alvo de atribuição não suportado no corpo paralelo");
+}
+
+void LoopIndependenceAnalyzer::visit_step(const Expr* operand, const char* op) {
+    auto* id = dynamic_cast<const IdentifierNode*>(operand);
+    if (!id) {
+        fail(std::string("'") + op + "' sobre expressão não suportado no corpo paralelo");
+        return;
+    }
+    if (is_local(id->symbol)) return;
+    fail(std::string("'") + op + "' em '" + id->symbol + "' cria dependência entre iterações");
+}
+
+// Reconhece `if e < r { r = e }` (min) e `if e > r { r = e }` (max), em qualquer ordem dos operandos
+bool LoopIndependenceAnalyzer::match_min_max(const IfStatementNode* node) {
+    if (!node->alternate.empty() || node->consequent.size() != 1) return false;
+    auto* asg = dynamic_cast<const AssignmentExprNode*>(node->consequent[0].get());
+    auto* cmp = dynamic_cast<const BinaryExprNode*>(node->condition.get());
+    if (!asg || !cmp || compound_assign_op(asg->op) != BinaryOp::Unknown) return false;
+    auto* target = dynamic_cast<const IdentifierNode*>(asg->target.get());
+    if (!target || !is_outer(target->symbol)) return false;
+    if (!ctx.get_symbol_table().exists(target->symbol)) return false;
+
+    bool less = cmp->opcode == BinaryOp::Lt || cmp->opcode == BinaryOp::Le;
+    bool greater = cmp->opcode == BinaryOp::Gt || cmp->opcode == BinaryOp::Ge;
+    if (!less && !greater) return false;
+
+    const std::string& r = target->symbol;
+    const Expr* other = nullptr;
+    bool r_on_right = false;
+    if (auto* rid = dynamic_cast<const IdentifierNode*>(cmp->right.get()); rid && rid->symbol == r) {
+        other = cmp->left.get();
+        r_on_right = true;
+    } else if (auto* lid = dynamic_cast<const IdentifierNode*>(cmp->left.get()); lid && lid->symbol == r) {
+        other = cmp->right.get();
+    } else {
+        return false;
+    }
+    if (mentions(other, r) || !same_expr(other, asg->value.get())) return false;
+
+    // e < r  => min ; e > r => max ; r > e => min ; r < e => max
+    bool is_min = r_on_right ? less : greater;
+    visit_expr(other);
+    add_reduction(r, is_min ? ReductionKind::Min : ReductionKind::Max);
+    return true;
+}
+
+void LoopIndependenceAnalyzer::validate() {
+    auto* I32 = llvm::Type::getInt32Ty(ctx.get_context());
+    auto* F64 = llvm::Type::getDoubleTy(ctx.get_context());
+    auto* ValueTy = ir_utils::get_value_struct(ctx);
+
+    for (auto& r : reductions) {
+        auto info = ctx.get_symbol_table().lookup_symbol(r.symbol);
+        if (!info || !llvm::isa_and_nonnull<llvm::AllocaInst>(info->value)) {
+            fail("redução sobre '" + r.symbol + "' exige uma variável local");
+            return;
+        }
+        if (info->llvm_type != I32 && info->llvm_type != F64) {
+            fail("redução sobre '" + r.symbol + "' exige int ou float");
+            return;
+        }
+        if (plain_reads.count(r.symbol) || written.count(r.symbol) || arbitrary_reads.count(r.symbol)) {
+            fail("'" + r.symbol + "' é lida fora da redução");
+            return;
+        }
+    }
+
+    for (auto& c : written_order) {
+        auto info = ctx.get_symbol_table().lookup_symbol(c);
+        if (!info || !info->value || info->llvm_type != ValueTy) {
+            fail("'" + c + "' não é um array ou vector");
+            return;
+        }
+        if (plain_reads.count(c)) {
+            fail("'" + c + "' é usado por inteiro enquanto é escrito em [i]");
+            return;
+        }
+        if (arbitrary_reads.count(c)) {
+            fail("'" + c + "' é lido fora de [i] enquanto é escrito em [i]");
+            return;
+        }
+        if (!nested_reads.empty()) {
+            fail("leitura indexada aninhada de '" + *nested_reads.begin() + "' pode compartilhar armazenamento com '" + c + "'");
+            return;
+        }
+    }
+
+    if (reductions.empty() && written_order.empty()) {
+        fail("o corpo não escreve em containers nem acumula reduções");
+    }
+}
+
+std::string LoopIndependenceAnalyzer::describe() const {
+    std::string out = "iterações independentes";
+    for (auto& c : written_order) out += "; escrita disjunta em " + c + "[i]";
+    for (auto& r : reductions) {
+        const char* kind = r.kind == ReductionKind::Sum ? "soma" : (r.kind == ReductionKind::Min ? "mínimo" : "máximo");
+        out += "; redução (" + std::string(kind) + ") em '" + r.symbol + "'";
+    }
+    return out;
+}
+
+ParallelLoopPlan LoopIndependenceAnalyzer::run() {
+    ParallelLoopPlan plan;
+
+    if (!loop.range_start || !loop.range_end) {
+        plan.reason = "apenas loops de intervalo (a..b) são paralelizados";
+        return plan;
+    }
+    if (ctx.in_parallel_region()) {
+        plan.reason = "loop aninhado em uma região já paralela";
+        return plan;
+    }
+    for (auto& b : loop.bindings) {
+        auto* id = dynamic_cast<const IdentifierNode*>(b.get());
+        if (!id) {
+            plan.reason = "binding do loop não é um identificador";
+            return plan;
+        }
+        // O segundo binding reutiliza uma variável existente, se houver: escrita compartilhada
+        if (inductions.size() == 1 && ctx.get_symbol_table().exists(id->symbol)) {
+            plan.reason = "binding '" + id->symbol + "' reutiliza uma variável externa";
+            return plan;
+        }
+        inductions.insert(id->symbol);
+    }
+    if (!loop.else_block.empty()) {
+        plan.reason = "loop com bloco 'else'";
+        return plan;
+    }
+
+    // Os limites são avaliados uma vez, antes da região paralela
+    visit_block(loop.body);
+    if (failure.empty()) validate();
+
+    if (!failure.empty()) {
+        plan.reason = failure;
+        return plan;
+    }
+
+    plan.parallel = true;
+    plan.reason = describe();
+    plan.captures = capture_order;
+    plan.reductions = reductions;
+    plan.indexed_writes = written_order;
+    for (auto& c : capture_order) {
+        if (arbitrary_reads.count(c)) plan.indexed_reads.push_back(c);
+    }
+    return plan;
+}
+
+} // namespace
+
+ParallelLoopPlan analyze_parallel_loop(const ForStmtNode& loop, IRGenerationContext& ctx) {
+    return LoopIndependenceAnalyzer(loop, ctx).run();
+}
+
+} // namespace nv
@@ -143,8 +143,8 @@ void DeclarationStmtNode::codegen(nv::IRGenerationContext& context) {
         
         // Garantir que o GlobalVariable está registrado na tabela de símbolos
         // (pode ter sido criado por import mas não registrado ainda, ou vice-versa)
-        auto existing_info = context.get_symbol_table().lookup_symbol(symbol);
-        if (!existing_info.has_value() || existing_info.value().value != global) {
+        const auto* existing_info = context.get_symbol_table().lookup_symbol(symbol);
+        if (!existing_info || existing_info->value != global) {
             // Registrar na tabela de símbolos se não estiver ou se for diferente
             nv::SymbolInfo info(
                 global,
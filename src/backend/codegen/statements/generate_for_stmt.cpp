@@ -1,7 +1,729 @@
 #include "frontend/ast/statements/for_stmt_node.hpp"
 #include "backend/codegen/ir_context.hpp"
 #include "backend/codegen/ir_utils.hpp"
+#include "backend/codegen/parallel_analysis.hpp"
 #include "frontend/ast/expressions/identifier_node.hpp"
+#include "frontend/ast/expressions/member_expr_node.hpp"
+#include "frontend/ast/expressions/access_expr_node.hpp"
+
+namespace {
+
+// Espelha NV_PARALLEL_MAX_CHUNKS (nv_runtime.h): um slot de redução parcial por chunk
+constexpr uint64_t MAX_PARALLEL_CHUNKS = 1024;
+
+/**
+ * Gera um `for` de intervalo provado independente como chamada a nv_parallel_for.
+ * O corpo é extraído para `void for.par.body(i32 lo, i32 hi, i32 chunk, i8* env)`;
+ * `env` guarda o endereço de cada local capturada e dos vetores de parciais.
+ * Capturas são copiadas para locais privadas (containers continuam apontando para
+ * o mesmo armazenamento); reduções acumulam numa cópia privada e são combinadas
+ * em ordem de chunk depois do loop.
+ */
+void emit_parallel_range_loop(
+    ForStmtNode& loop,
+    nv::IRGenerationContext& ctx,
+    const nv::ParallelLoopPlan& plan,
+    IdentifierNode* id0,
+    IdentifierNode* id1,
+    llvm::Value* start_v,
+    llvm::Value* end_v
+) {
+    auto& C = ctx.get_context();
+    auto& M = ctx.get_module();
+    auto& b = ctx.get_builder();
+    auto* i32 = llvm::Type::getInt32Ty(C);
+    auto* i8p = nv::ir_utils::get_i8_ptr(ctx);
+    auto* ValuePtr = nv::ir_utils::get_value_ptr(ctx);
+
+    auto lookup = [&](const std::string& name) -> const nv::SymbolInfo& {
+        return *ctx.get_symbol_table().lookup_symbol(name);
+    };
+    auto find_reduction = [&](const std::string& name) -> const nv::ReductionInfo* {
+        for (auto& r : plan.reductions) {
+            if (r.symbol == name) return &r;
+        }
+        return nullptr;
+    };
+
+    // Intervalo semiaberto [lo, hi)
+    llvm::Value* lo = start_v;
+    llvm::Value* hi = loop.range_inclusive
+        ? b.CreateAdd(end_v, llvm::ConstantInt::get(i32, 1), "par.hi")
+        : end_v;
+    auto* non_empty = b.CreateICmpSLT(lo, hi, "par.nonempty");
+
+    auto* chunks_fn = ctx.ensure_runtime_func("nv_parallel_chunks", {i32, i32}, i32);
+    llvm::Value* chunks = b.CreateCall(chunks_fn, {lo, hi}, "par.chunks");
+
+    // Containers escritos em [i] não podem compartilhar armazenamento com os lidos
+    // em outros índices; se compartilharem, executa em um único chunk
+    if (!plan.indexed_reads.empty()) {
+        auto* same_fn = ctx.ensure_runtime_func("nv_same_storage", {ValuePtr, ValuePtr}, i32);
+        llvm::Value* aliased = llvm::ConstantInt::getFalse(C);
+        for (auto& w : plan.indexed_writes) {
+            for (auto& r : plan.indexed_reads) {
+                auto* same = b.CreateCall(same_fn, {lookup(w).value, lookup(r).value});
+                aliased = b.CreateOr(aliased, b.CreateICmpNE(same, llvm::ConstantInt::get(i32, 0)));
+            }
+        }
+        chunks = b.CreateSelect(aliased, llvm::ConstantInt::get(i32, 1), chunks, "par.chunks.checked");
+    }
+
+    // Reservar capacidade antes do despacho: escritas concorrentes nunca realocam.
+    // O size é ajustado depois do loop pelo maior índice escrito em cada chunk
+    auto* reserve_fn = ctx.ensure_runtime_func("nv_parallel_reserve", {ValuePtr, i32});
+    auto* reserve_size = b.CreateSelect(non_empty, hi, llvm::ConstantInt::get(i32, 0));
+    for (auto& w : plan.indexed_writes) {
+        b.CreateCall(reserve_fn, {lookup(w).value, reserve_size});
+    }
+
+    // Ambiente: endereços das capturas, vetores de parciais e, por container
+    // escrito, o vetor com 1 + maior índice escrito em cada chunk
+    struct Reduction {
+        const nv::ReductionInfo* red;
+        nv::SymbolInfo info;
+        llvm::Value* partials;
+        unsigned slot;
+    };
+    struct WriteEnd {
+        std::string container;
+        llvm::Value* ends;
+        unsigned slot;
+    };
+    std::vector<Reduction> reductions;
+    std::vector<WriteEnd> write_ends;
+    auto* ends_ty = llvm::ArrayType::get(i32, MAX_PARALLEL_CHUNKS);
+    const unsigned env_size = static_cast<unsigned>(
+        plan.captures.size() + plan.reductions.size() + plan.indexed_writes.size());
+    auto* env_ty = llvm::ArrayType::get(i8p, env_size == 0 ? 1 : env_size);
+    auto* env = ctx.create_alloca(env_ty, "par.env");
+
+    unsigned slot = 0;
+    for (auto& name : plan.captures) {
+        auto* field = b.CreateInBoundsGEP(env_ty, env, {b.getInt32(0), b.getInt32(slot++)});
+        b.CreateStore(b.CreateBitCast(lookup(name).value, i8p), field);
+    }
+    for (auto& red : plan.reductions) {
+        const auto& info = lookup(red.symbol);
+        auto* partials = ctx.create_alloca(llvm::ArrayType::get(info.llvm_type, MAX_PARALLEL_CHUNKS), red.symbol + ".partials");
+        auto* field = b.CreateInBoundsGEP(env_ty, env, {b.getInt32(0), b.getInt32(slot)});
+        b.CreateStore(b.CreateBitCast(partials, i8p), field);
+        reductions.push_back({&red, info, partials, slot++});
+    }
+    for (auto& name : plan.indexed_writes) {
+        auto* ends = ctx.create_alloca(ends_ty, name + ".written");
+        auto* field = b.CreateInBoundsGEP(env_ty, env, {b.getInt32(0), b.getInt32(slot)});
+        b.CreateStore(b.CreateBitCast(ends, i8p), field);
+        write_ends.push_back({name, ends, slot++});
+    }
+
+    // === Corpo extraído ===
+    llvm::Function* prev_func = ctx.get_current_function();
+    llvm::BasicBlock* prev_block = b.GetInsertBlock();
+    llvm::DIScope* prev_scope = ctx.get_debug_scope();
+    llvm::DebugLoc prev_loc = b.getCurrentDebugLocation();
+
+    auto* body_ty = llvm::FunctionType::get(llvm::Type::getVoidTy(C), {i32, i32, i32, i8p}, false);
+    auto* body_fn = llvm::Function::Create(body_ty, llvm::Function::InternalLinkage, "for.par.body", M);
+
+    b.SetCurrentDebugLocation(llvm::DebugLoc());
+    if (auto* dib = ctx.get_debug_builder()) {
+        llvm::DIFile* file = ctx.get_debug_file();
+        unsigned line = loop.position ? static_cast<unsigned>(loop.position->line) : 0u;
+        auto* sub_ty = dib->createSubroutineType(dib->getOrCreateTypeArray({}));
+        auto* subp = dib->createFunction(
+            file, body_fn->getName(), llvm::StringRef(), file, line, sub_ty, line,
+            llvm::DINode::FlagArtificial,
+            llvm::DISubprogram::SPFlagDefinition | llvm::DISubprogram::SPFlagLocalToUnit
+        );
+        body_fn->setSubprogram(subp);
+        ctx.set_debug_scope(subp);
+    }
+
+    ctx.set_current_function(body_fn);
+    ctx.set_in_parallel_region(true);
+    auto* entry = llvm::BasicBlock::Create(C, "entry", body_fn);
+    b.SetInsertPoint(entry);
+    ctx.set_debug_location(loop.position.get());
+
+    auto arg = body_fn->arg_begin();
+    llvm::Argument* lo_arg = &*arg++;
+    llvm::Argument* hi_arg = &*arg++;
+    llvm::Argument* chunk_arg = &*arg++;
+    llvm::Argument* env_arg = &*arg;
+    lo_arg->setName("lo");
+    hi_arg->setName("hi");
+    chunk_arg->setName("chunk");
+    env_arg->setName("env");
+
+    ctx.enter_scope();
+    auto* env_in = b.CreateBitCast(env_arg, llvm::PointerType::getUnqual(env_ty));
+    std::vector<llvm::AllocaInst*> private_reductions(reductions.size(), nullptr);
+    slot = 0;
+    for (auto& name : plan.captures) {
+        auto info = lookup(name);
+        auto* field = b.CreateInBoundsGEP(env_ty, env_in, {b.getInt32(0), b.getInt32(slot++)});
+        auto* shared = b.CreateBitCast(b.CreateLoad(i8p, field), llvm::PointerType::getUnqual(info.llvm_type));
+        auto* local = ctx.create_and_register_variable(name, info.llvm_type, info.nv_type, info.is_constant);
+
+        auto* red = find_reduction(name);
+        if (red && red->kind == nv::ReductionKind::Sum) {
+            b.CreateStore(llvm::Constant::getNullValue(info.llvm_type), local);
+        } else {
+            // min/max partem do valor atual: a combinação é idempotente
+            b.CreateStore(b.CreateLoad(info.llvm_type, shared), local);
+        }
+        for (size_t k = 0; k < reductions.size(); ++k) {
+            if (reductions[k].red == red) private_reductions[k] = local;
+        }
+    }
+
+    std::vector<llvm::AllocaInst*> private_ends;
+    for (auto& w : write_ends) {
+        auto* end = ctx.create_alloca(i32, w.container + ".end");
+        b.CreateStore(llvm::ConstantInt::get(i32, 0), end);
+        ctx.set_parallel_write_end(w.container, end);
+        private_ends.push_back(end);
+    }
+
+    auto* i_alloca = ctx.create_and_register_variable(id0->symbol, i32, nullptr, false);
+    b.CreateStore(lo_arg, i_alloca);
+    llvm::AllocaInst* val_alloca = id1 ? ctx.create_and_register_variable(id1->symbol, i32, nullptr, false) : nullptr;
+
+    auto* header_bb = llvm::BasicBlock::Create(C, "par.header", body_fn);
+    auto* body_bb = llvm::BasicBlock::Create(C, "par.body", body_fn);
+    auto* step_bb = llvm::BasicBlock::Create(C, "par.step", body_fn);
+    auto* exit_bb = llvm::BasicBlock::Create(C, "par.exit", body_fn);
+    ctx.get_control_flow().enter_loop("for.parallel", header_bb, body_bb, step_bb, exit_bb);
+    b.CreateBr(header_bb);
+
+    b.SetInsertPoint(header_bb);
+    auto* i_val = b.CreateLoad(i32, i_alloca, id0->symbol + "_val");
+    b.CreateCondBr(b.CreateICmpSLT(i_val, hi_arg, "parcond"), body_bb, exit_bb);
+
+    b.SetInsertPoint(body_bb);
+    if (val_alloca) {
+        b.CreateStore(b.CreateLoad(i32, i_alloca), val_alloca);
+    }
+    ctx.enter_scope();
+    for (auto& stmt : loop.body) {
+        if (stmt) stmt->codegen(ctx);
+    }
+    ctx.exit_scope();
+    if (!b.GetInsertBlock()->getTerminator()) {
+        b.CreateBr(step_bb);
+    }
+
+    b.SetInsertPoint(step_bb);
+    b.CreateStore(b.CreateAdd(b.CreateLoad(i32, i_alloca), llvm::ConstantInt::get(i32, 1), "inc"), i_alloca);
+    b.CreateBr(header_bb);
+
+    b.SetInsertPoint(exit_bb);
+    ctx.get_control_flow().exit_loop();
+    // Publica as parciais deste chunk
+    for (size_t k = 0; k < reductions.size(); ++k) {
+        auto& r = reductions[k];
+        auto* field = b.CreateInBoundsGEP(env_ty, env_in, {b.getInt32(0), b.getInt32(r.slot)});
+        auto* partials = b.CreateBitCast(b.CreateLoad(i8p, field), llvm::PointerType::getUnqual(r.info.llvm_type));
+        auto* dst = b.CreateInBoundsGEP(r.info.llvm_type, partials, {chunk_arg});
+        b.CreateStore(b.CreateLoad(r.info.llvm_type, private_reductions[k]), dst);
+    }
+    for (size_t k = 0; k < write_ends.size(); ++k) {
+        auto* field = b.CreateInBoundsGEP(env_ty, env_in, {b.getInt32(0), b.getInt32(write_ends[k].slot)});
+        auto* ends = b.CreateBitCast(b.CreateLoad(i8p, field), llvm::PointerType::getUnqual(i32));
+        b.CreateStore(b.CreateLoad(i32, private_ends[k]), b.CreateInBoundsGEP(i32, ends, {chunk_arg}));
+    }
+    b.CreateRetVoid();
+    ctx.exit_scope();
+
+    // Restaura o estado da função original
+    ctx.clear_parallel_write_ends();
+    ctx.set_in_parallel_region(false);
+    ctx.set_current_function(prev_func);
+    b.SetInsertPoint(prev_block);
+    ctx.set_debug_scope(prev_scope);
+    b.SetCurrentDebugLocation(prev_loc);
+
+    // === Despacho ===
+    auto* for_fn = ctx.ensure_runtime_func("nv_parallel_for", {i32, i32, i32, i8p, i8p});
+    b.CreateCall(for_fn, {lo, hi, chunks, b.CreateBitCast(body_fn, i8p), b.CreateBitCast(env, i8p)});
+
+    // size = max(size anterior, maior índice escrito + 1)
+    auto* commit_fn = ctx.ensure_runtime_func("nv_parallel_commit", {ValuePtr, llvm::PointerType::getUnqual(i32), i32});
+    for (auto& w : write_ends) {
+        auto* ends = b.CreateInBoundsGEP(ends_ty, w.ends, {b.getInt32(0), b.getInt32(0)});
+        b.CreateCall(commit_fn, {lookup(w.container).value, ends, chunks});
+    }
+
+    // Valores finais dos bindings, como na versão serial
+    auto* i_final = ctx.create_and_register_variable(id0->symbol, i32, nullptr, false);
+    b.CreateStore(b.CreateSelect(non_empty, hi, lo), i_final);
+    if (id1) {
+        auto* v_final = ctx.create_and_register_variable(id1->symbol, i32, nullptr, false);
+        auto* last = b.CreateSub(hi, llvm::ConstantInt::get(i32, 1));
+        b.CreateStore(b.CreateSelect(non_empty, last, llvm::ConstantInt::get(i32, 0)), v_final);
+    }
+
+    // === Combinação das reduções, em ordem de chunk (resultado determinístico) ===
+    if (reductions.empty()) return;
+
+    auto* func = ctx.get_current_function();
+    auto* c_alloca = ctx.create_alloca(i32, "par.chunk");
+    b.CreateStore(llvm::ConstantInt::get(i32, 0), c_alloca);
+    auto* comb_header = llvm::BasicBlock::Create(C, "par.combine.header", func);
+    auto* comb_body = llvm::BasicBlock::Create(C, "par.combine.body", func);
+    auto* comb_exit = llvm::BasicBlock::Create(C, "par.combine.exit", func);
+    b.CreateBr(comb_header);
+
+    b.SetInsertPoint(comb_header);
+    auto* c_val = b.CreateLoad(i32, c_alloca);
+    b.CreateCondBr(b.CreateICmpSLT(c_val, chunks), comb_body, comb_exit);
+
+    b.SetInsertPoint(comb_body);
+    for (auto& r : reductions) {
+        auto* ty = r.info.llvm_type;
+        bool is_float = ty->isFloatingPointTy();
+        auto* partial = b.CreateLoad(ty, b.CreateInBoundsGEP(llvm::ArrayType::get(ty, MAX_PARALLEL_CHUNKS), r.partials, {b.getInt32(0), c_val}));
+        auto* current = b.CreateLoad(ty, r.info.value);
+        llvm::Value* combined = nullptr;
+        switch (r.red->kind) {
+            case nv::ReductionKind::Sum:
+                combined = is_float ? b.CreateFAdd(current, partial) : b.CreateAdd(current, partial);
+                break;
+            case nv::ReductionKind::Min: {
+                auto* lt = is_float ? b.CreateFCmpOLT(partial, current) : b.CreateICmpSLT(partial, current);
+                combined = b.CreateSelect(lt, partial, current);
+                break;
+            }
+            case nv::ReductionKind::Max: {
+                auto* gt = is_float ? b.CreateFCmpOGT(partial, current) : b.CreateICmpSGT(partial, current);
+                combined = b.CreateSelect(gt, partial, current);
+                break;
+            }
+        }
+        b.CreateStore(combined, r.info.value);
+    }
+    b.CreateStore(b.CreateAdd(c_val, llvm::ConstantInt::get(i32, 1)), c_alloca);
+    b.CreateBr(comb_header);
+
+    b.SetInsertPoint(comb_exit);
+}
+
+/**
+ * Redução `for i in a..b { acc += c[i] }` (ou `acc += c[i] * d[i]`) com `acc`
+ * local i32 e containers runtime: vira uma chamada aos kernels SIMD.
+ */
+struct SimdReduction {
+    std::string acc;
+    std::string lhs;
+    std::string rhs;   // vazio para soma; segundo container para produto escalar
+};
+
+// Nome do container em `c[i]`, ou vazio se não for esse formato
+std::string indexed_by(const Expr* e, const std::string& index) {
+    if (!e || e->kind != NodeType::AccessExpression) return {};
+    auto* acc = static_cast<const AccessExprNode*>(e);
+    auto* base = dynamic_cast<const IdentifierNode*>(acc->expr.get());
+    auto* idx = dynamic_cast<const IdentifierNode*>(acc->index.get());
+    if (!base || !idx || idx->symbol != index) return {};
+    return base->symbol;
+}
+
+std::optional<SimdReduction> match_simd_reduction(const ForStmtNode& loop, nv::IRGenerationContext& ctx) {
+    if (loop.iterable || !loop.range_start || !loop.range_end) return std::nullopt;
+    if (loop.bindings.size() != 1 || !loop.else_block.empty() || loop.body.size() != 1) return std::nullopt;
+    auto* index = dynamic_cast<const IdentifierNode*>(loop.bindings[0].get());
+    if (!index || !loop.body[0] || loop.body[0]->kind != NodeType::AssignmentExpression) return std::nullopt;
+
+    auto* asg = static_cast<const AssignmentExprNode*>(loop.body[0].get());
+    auto* target = dynamic_cast<const IdentifierNode*>(asg->target.get());
+    if (!target) return std::nullopt;
+
+    // `acc += v` ou `acc = acc + v`
+    const Expr* term = nullptr;
+    BinaryOp compound = compound_assign_op(asg->op);
+    if (compound == BinaryOp::Add) {
+        term = asg->value.get();
+    } else if (compound == BinaryOp::Unknown && asg->value && asg->value->kind == NodeType::BinaryExpression) {
+        auto* sum = static_cast<const BinaryExprNode*>(asg->value.get());
+        auto* left = dynamic_cast<const IdentifierNode*>(sum->left.get());
+        if (sum->opcode == BinaryOp::Add && left && left->symbol == target->symbol) term = sum->right.get();
+    }
+    if (!term) return std::nullopt;
+
+    SimdReduction red{target->symbol, indexed_by(term, index->symbol), {}};
+    if (red.lhs.empty()) {
+        if (term->kind != NodeType::BinaryExpression) return std::nullopt;
+        auto* mul = static_cast<const BinaryExprNode*>(term);
+        if (mul->opcode != BinaryOp::Mul) return std::nullopt;
+        red.lhs = indexed_by(mul->left.get(), index->symbol);
+        red.rhs = indexed_by(mul->right.get(), index->symbol);
+        if (red.lhs.empty() || red.rhs.empty()) return std::nullopt;
+    }
+
+    // O índice não pode ser o acumulador nem um dos containers
+    if (red.acc == index->symbol || red.lhs == index->symbol || red.rhs == index->symbol) return std::nullopt;
+    if (red.acc == red.lhs || red.acc == red.rhs) return std::nullopt;
+
+    auto& symbols = ctx.get_symbol_table();
+    const auto* acc = symbols.lookup_symbol(red.acc);
+    if (!acc || acc->is_constant || !acc->value || !acc->llvm_type || !acc->llvm_type->isIntegerTy(32)) return std::nullopt;
+    auto* ValueTy = nv::ir_utils::get_value_struct(ctx);
+    for (auto* name : {&red.lhs, &red.rhs}) {
+        if (name->empty()) continue;
+        const auto* info = symbols.lookup_symbol(*name);
+        if (!info || !info->value || info->llvm_type != ValueTy) return std::nullopt;
+    }
+    return red;
+}
+
+/**
+ * Emite a redução reconhecida. Elementos são lidos pelo campo `value` e somados
+ * módulo 2^32, exatamente como o loop escalar (que trunca cada `c[i]` para i32);
+ * índices fora do container contam 0, como em array_get_index_v.
+ */
+void emit_simd_reduction(
+    nv::IRGenerationContext& ctx,
+    const SimdReduction& red,
+    IdentifierNode* id0,
+    bool inclusive,
+    llvm::Value* start_v,
+    llvm::Value* end_v
+) {
+    auto& b = ctx.get_builder();
+    auto* i32 = llvm::Type::getInt32Ty(ctx.get_context());
+    auto* ValuePtr = nv::ir_utils::get_value_ptr(ctx);
+    auto& symbols = ctx.get_symbol_table();
+
+    llvm::Value* lo = start_v;
+    llvm::Value* hi = inclusive ? b.CreateAdd(end_v, llvm::ConstantInt::get(i32, 1), "simd.hi") : end_v;
+
+    const auto& lhs = *symbols.lookup_symbol(red.lhs);
+    llvm::Value* total = nullptr;
+    if (red.rhs.empty()) {
+        auto* fn = ctx.ensure_runtime_func("nv_simd_sum_values", {ValuePtr, i32, i32}, i32);
+        total = b.CreateCall(fn, {lhs.value, lo, hi}, "simd.sum");
+    } else {
+        const auto& rhs = *symbols.lookup_symbol(red.rhs);
+        auto* fn = ctx.ensure_runtime_func("nv_simd_dot_values", {ValuePtr, ValuePtr, i32, i32}, i32);
+        total = b.CreateCall(fn, {lhs.value, rhs.value, lo, hi}, "simd.dot");
+    }
+
+    const auto& acc = *symbols.lookup_symbol(red.acc);
+    b.CreateStore(b.CreateAdd(b.CreateLoad(i32, acc.value), total), acc.value);
+
+    // Valor final da indução, como na versão serial
+    auto* i_final = ctx.create_and_register_variable(id0->symbol, i32, nullptr, false);
+    b.CreateStore(b.CreateSelect(b.CreateICmpSLT(lo, hi), hi, lo), i_final);
+}
+
+/**
+ * `for linha in read_lines()` e `for registro in json.stream(arquivo)`: o
+ * binding é uma view em um buffer do runtime, válida só até a próxima
+ * leitura. Ele só é materializado (strdup / registro com cópia própria) se
+ * puder sobreviver à iteração; a view (ou um campo dela, `r.x` / `r["x"]`)
+ * é segura apenas como operando de operador binário (comparação e
+ * concatenação copiam) e como argumento de write. Qualquer outro uso, nó
+ * desconhecido ou chamada que não seja write no corpo conta como escape.
+ */
+bool is_read_lines_call(const Expr* e) {
+    if (!e || e->kind != NodeType::CallExpression) return false;
+    auto* call = static_cast<const CallExprNode*>(e);
+    return call->resolve_builtin() == BuiltinId::ReadLines && call->args.empty();
+}
+
+bool is_json_stream_call(const Expr* e) {
+    if (!e || e->kind != NodeType::CallExpression) return false;
+    auto* call = static_cast<const CallExprNode*>(e);
+    return call->resolve_builtin() == BuiltinId::JsonStream && call->args.size() == 1;
+}
+
+bool is_ident(const Expr* e, const std::string& name) {
+    auto* id = dynamic_cast<const IdentifierNode*>(e);
+    return id && id->symbol == name;
+}
+
+bool view_escapes(const Expr* e, const std::string& name);
+
+// `name`, `name.campo` ou `name[i]` (encadeados), com índices que não escapam
+bool is_view(const Expr* e, const std::string& name) {
+    if (is_ident(e, name)) return true;
+    if (auto* mem = dynamic_cast<const MemberExprNode*>(e)) {
+        return is_view(mem->object.get(), name);
+    }
+    if (auto* acc = dynamic_cast<const AccessExprNode*>(e)) {
+        return is_view(acc->expr.get(), name) && !view_escapes(acc->index.get(), name);
+    }
+    return false;
+}
+
+bool view_escapes(const CodeBlock& block, const std::string& name) {
+    for (auto& stmt : block) {
+        const Stmt* st = stmt.get();
+        if (!st) continue;
+        switch (st->kind) {
+            case NodeType::DeclarationStatement:
+                if (view_escapes(static_cast<const DeclarationStmtNode*>(st)->value.get(), name)) return true;
+                break;
+            case NodeType::IfStatement: {
+                auto* node = static_cast<const IfStatementNode*>(st);
+                if (view_escapes(node->condition.get(), name) ||
+                    view_escapes(node->consequent, name) ||
+                    view_escapes(node->alternate, name)) return true;
+                break;
+            }
+            case NodeType::WhileStatement: {
+                auto* node = static_cast<const WhileStmtNode*>(st);
+                if (view_escapes(node->condition.get(), name) || view_escapes(node->body, name)) return true;
+                break;
+            }
+            case NodeType::LoopStatement:
+                if (view_escapes(static_cast<const LoopStmtNode*>(st)->body, name)) return true;
+                break;
+            case NodeType::ForStatement: {
+                auto* node = static_cast<const ForStmtNode*>(st);
+                if (view_escapes(node->range_start.get(), name) ||
+                    view_escapes(node->range_end.get(), name) ||
+                    view_escapes(node->iterable.get(), name) ||
+                    view_escapes(node->body, name) ||
+                    view_escapes(node->else_block, name)) return true;
+                break;
+            }
+            case NodeType::ReturnStatement:
+                if (view_escapes(static_cast<const ReturnStmtNode*>(st)->value.get(), name)) return true;
+                break;
+            case NodeType::BreakStatement:
+            case NodeType::ContinueStatement:
+                break;
+            default: {
+                auto* expr = dynamic_cast<const Expr*>(st);
+                if (!expr || view_escapes(expr, name)) return true;
+                break;
+            }
+        }
+    }
+    return false;
+}
+
+bool view_escapes(const Expr* e, const std::string& name) {
+    if (!e) return false;
+    switch (e->kind) {
+        case NodeType::NumericLiteral:
+        case NodeType::BooleanLiteral:
+        case NodeType::StringLiteral:
+            return false;
+        case NodeType::Identifier:
+            return is_ident(e, name);
+        case NodeType::BinaryExpression: {
+            auto* bin = static_cast<const BinaryExprNode*>(e);
+            for (auto* operand : {bin->left.get(), bin->right.get()}) {
+                if (!is_view(operand, name) && view_escapes(operand, name)) return true;
+            }
+            return false;
+        }
+        case NodeType::LogicalNotExpression:
+            return view_escapes(static_cast<const LogicalNotExprNode*>(e)->operand.get(), name);
+        case NodeType::UnaryMinusExpression:
+            return view_escapes(static_cast<const UnaryMinusExprNode*>(e)->operand.get(), name);
+        case NodeType::ConditionalExpression: {
+            auto* cond = static_cast<const ConditionalExprNode*>(e);
+            return view_escapes(cond->condition.get(), name) ||
+                   view_escapes(cond->true_expr.get(), name) ||
+                   view_escapes(cond->false_expr.get(), name);
+        }
+        case NodeType::AssignmentExpression: {
+            auto* asg = static_cast<const AssignmentExprNode*>(e);
+            return view_escapes(asg->target.get(), name) || view_escapes(asg->value.get(), name);
+        }
+        case NodeType::CallExpression: {
+            auto* call = static_cast<const CallExprNode*>(e);
+            // Qualquer chamada além de `write` pode ler stdin (direta ou
+            // indiretamente) e mover ou sobrescrever o buffer da view
+            if (call->resolve_builtin() != BuiltinId::Write) return true;
+            for (auto& arg : call->args) {
+                if (is_view(arg.get(), name)) continue;
+                if (view_escapes(arg.get(), name)) return true;
+            }
+            return false;
+        }
+        default:
+            return true;
+    }
+}
+
+/**
+ * Saída comum dos loops sob demanda: o bloco `else` roda se nenhuma
+ * iteração aconteceu; o builder termina em `after_bb`.
+ */
+void emit_streaming_exit(
+    ForStmtNode& loop,
+    nv::IRGenerationContext& ctx,
+    llvm::Value* executed,
+    llvm::BasicBlock* after_bb,
+    llvm::BasicBlock* else_bb
+) {
+    auto& b = ctx.get_builder();
+    if (else_bb) {
+        auto* ran = b.CreateLoad(llvm::Type::getInt1Ty(ctx.get_context()), executed);
+        b.CreateCondBr(ran, after_bb, else_bb);
+        b.SetInsertPoint(else_bb);
+        ctx.enter_scope();
+        for (auto& stmt : loop.else_block) {
+            if (stmt) stmt->codegen(ctx);
+        }
+        ctx.exit_scope();
+        b.CreateBr(after_bb);
+    } else {
+        b.CreateBr(after_bb);
+    }
+    b.SetInsertPoint(after_bb);
+}
+
+/**
+ * Gera `for linha in read_lines()` como leitura sob demanda: cada iteração
+ * chama nv_in_next_line em vez de materializar todas as linhas num vetor.
+ */
+void emit_read_lines_loop(
+    ForStmtNode& loop,
+    nv::IRGenerationContext& ctx,
+    IdentifierNode* binding,
+    llvm::Value* executed,
+    llvm::BasicBlock* after_bb,
+    llvm::BasicBlock* else_bb
+) {
+    auto& C = ctx.get_context();
+    auto& b = ctx.get_builder();
+    auto* func = ctx.get_current_function();
+    auto* i32 = llvm::Type::getInt32Ty(C);
+    auto* i8p = nv::ir_utils::get_i8_ptr(ctx);
+
+    // Variável externa reaproveitada sobrevive ao loop: sempre recebe cópia
+    const auto* existing = ctx.get_symbol_table().lookup_symbol(binding->symbol_id);
+    bool reuse = existing && existing->value && existing->llvm_type == i8p;
+    bool materialize = reuse || view_escapes(loop.body, binding->symbol);
+    llvm::Value* line_var = reuse
+        ? existing->value
+        : (llvm::Value*)ctx.create_and_register_variable(binding->symbol, i8p, nullptr, false);
+
+    auto* slot = ctx.create_alloca(i8p, "line.view");
+    auto* next_fn = ctx.ensure_runtime_func("nv_in_next_line", {llvm::PointerType::getUnqual(i8p)}, i32);
+
+    auto* header_bb = llvm::BasicBlock::Create(C, "for.lines.header", func);
+    auto* body_bb   = llvm::BasicBlock::Create(C, "for.lines.body",   func);
+    auto* exit_bb   = llvm::BasicBlock::Create(C, "for.lines.exit",   func);
+    b.CreateBr(header_bb);
+
+    b.SetInsertPoint(header_bb);
+    auto* got = b.CreateCall(next_fn, {slot}, "line.ok");
+    b.CreateCondBr(b.CreateICmpNE(got, llvm::ConstantInt::get(i32, 0)), body_bb, exit_bb);
+
+    ctx.get_control_flow().enter_loop("for.lines", header_bb, body_bb, header_bb, exit_bb);
+
+    b.SetInsertPoint(body_bb);
+    llvm::Value* line = b.CreateLoad(i8p, slot, "line");
+    if (materialize) {
+        auto* strdup_fn = ctx.ensure_runtime_func("strdup", {i8p}, i8p);
+        line = b.CreateCall(strdup_fn, {line}, "line.copy");
+    }
+    b.CreateStore(line, line_var);
+    b.CreateStore(llvm::ConstantInt::getTrue(C), executed);
+
+    ctx.enter_scope();
+    for (auto& stmt : loop.body) {
+        if (stmt) stmt->codegen(ctx);
+    }
+    ctx.exit_scope();
+    if (!b.GetInsertBlock()->getTerminator()) {
+        b.CreateBr(header_bb);
+    }
+
+    b.SetInsertPoint(exit_bb);
+    ctx.get_control_flow().exit_loop();
+    emit_streaming_exit(loop, ctx, executed, after_bb, else_bb);
+}
+
+/**
+ * Gera `for registro in json.stream(arquivo)`: cada iteração chama
+ * json_stream_next, que reaproveita o buffer de leitura como arena do
+ * registro; `keep` pede uma cópia própria quando o registro escapa.
+ */
+void emit_json_stream_loop(
+    ForStmtNode& loop,
+    nv::IRGenerationContext& ctx,
+    const CallExprNode& call,
+    IdentifierNode* binding,
+    llvm::Value* executed,
+    llvm::BasicBlock* after_bb,
+    llvm::BasicBlock* else_bb
+) {
+    auto& C = ctx.get_context();
+    auto& b = ctx.get_builder();
+    auto* func = ctx.get_current_function();
+    auto* i32 = llvm::Type::getInt32Ty(C);
+    auto* i8p = nv::ir_utils::get_i8_ptr(ctx);
+    auto* ValueTy = nv::ir_utils::get_value_struct(ctx);
+    auto* ValuePtr = nv::ir_utils::get_value_ptr(ctx);
+
+    call.args[0]->codegen(ctx);
+    llvm::Value* filename = ctx.pop_value();
+    if (!filename || !filename->getType()->isPointerTy()) {
+        filename = b.CreateGlobalStringPtr("");
+    } else if (filename->getType() != i8p) {
+        filename = b.CreateBitCast(filename, i8p);
+    }
+
+    const auto* existing = ctx.get_symbol_table().lookup_symbol(binding->symbol_id);
+    bool reuse = existing && existing->value && existing->llvm_type == ValueTy;
+    bool keep = reuse || view_escapes(loop.body, binding->symbol);
+    llvm::Value* record_var = reuse
+        ? existing->value
+        : (llvm::Value*)ctx.create_and_register_variable(binding->symbol, ValueTy, nullptr, false);
+
+    auto* open_fn = ctx.ensure_runtime_func("json_stream_open", {i8p}, i8p);
+    auto* next_fn = ctx.ensure_runtime_func("json_stream_next", {i8p, ValuePtr, i32}, i32);
+    auto* close_fn = ctx.ensure_runtime_func("json_stream_close", {i8p});
+    auto* stream = b.CreateCall(open_fn, {filename}, "json.stream");
+    auto* slot = ctx.create_alloca(ValueTy, "json.record");
+
+    auto* header_bb = llvm::BasicBlock::Create(C, "for.json.header", func);
+    auto* body_bb   = llvm::BasicBlock::Create(C, "for.json.body",   func);
+    auto* exit_bb   = llvm::BasicBlock::Create(C, "for.json.exit",   func);
+    b.CreateBr(header_bb);
+
+    b.SetInsertPoint(header_bb);
+    auto* got = b.CreateCall(next_fn, {stream, slot, llvm::ConstantInt::get(i32, keep ? 1 : 0)}, "json.ok");
+    b.CreateCondBr(b.CreateICmpNE(got, llvm::ConstantInt::get(i32, 0)), body_bb, exit_bb);
+
+    ctx.get_control_flow().enter_loop("for.json", header_bb, body_bb, header_bb, exit_bb);
+    // `return` no corpo (mesmo dentro de loops aninhados) fecha o stream antes de sair
+    ctx.get_control_flow().push_cleanup(func, close_fn, stream);
+
+    b.SetInsertPoint(body_bb);
+    b.CreateStore(b.CreateLoad(ValueTy, slot, "record"), record_var);
+    b.CreateStore(llvm::ConstantInt::getTrue(C), executed);
+
+    ctx.enter_scope();
+    for (auto& stmt : loop.body) {
+        if (stmt) stmt->codegen(ctx);
+    }
+    ctx.exit_scope();
+    if (!b.GetInsertBlock()->getTerminator()) {
+        b.CreateBr(header_bb);
+    }
+
+    // Fim dos registros e `break` saem por aqui; `return` fecha pelo cleanup
+    b.SetInsertPoint(exit_bb);
+    ctx.get_control_flow().pop_cleanup();
+    ctx.get_control_flow().exit_loop();
+    b.CreateCall(close_fn, {stream});
+    if (!keep) {
+        // O último registro foi liberado junto com a arena
+        b.CreateStore(llvm::Constant::getNullValue(ValueTy), record_var);
+    }
+    emit_streaming_exit(loop, ctx, executed, after_bb, else_bb);
+}
+
+} // namespace
 
 void ForStmtNode::codegen(nv::IRGenerationContext& ctx) {
     ctx.set_debug_location(position.get());
@@ -28,12 +750,44 @@ void ForStmtNode::codegen(nv::IRGenerationContext& ctx) {
     auto* executed = ctx.create_and_register_variable("__for_executed", llvm::Type::getInt1Ty(ctx.get_context()), nullptr, false);
     b.CreateStore(llvm::ConstantInt::getFalse(ctx.get_context()), executed);
 
+    // Paralelização automática: só loops de intervalo com iterações provadamente independentes
+    // Reduções simples viram kernels SIMD (têm prioridade sobre o pool de threads)
+    auto simd_reduction = match_simd_reduction(*this, ctx);
+    nv::ParallelLoopPlan parallel_plan;
+    if (simd_reduction) {
+        if (ctx.is_auto_parallel()) {
+            ctx.record_parallel_loop(position.get(), false, "redução substituída por kernel SIMD");
+        }
+    } else if (ctx.is_auto_parallel()) {
+        parallel_plan = nv::analyze_parallel_loop(*this, ctx);
+        ctx.record_parallel_loop(position.get(), parallel_plan.parallel, parallel_plan.reason);
+    }
+
     // Blocos comuns
     auto* after_bb  = llvm::BasicBlock::Create(ctx.get_context(), "for.after",  func);
     auto* else_bb   = else_block.empty() ? nullptr : llvm::BasicBlock::Create(ctx.get_context(), "for.else", func);
 
     // Caso 1: Iterable nativo (array view: { i32 len, i32* data })
     if (iterable) {
+        if (is_read_lines_call(iterable.get()) && bindings.size() == 1) {
+            if (auto* line_id = dynamic_cast<IdentifierNode*>(bindings[0].get())) {
+                emit_read_lines_loop(*this, ctx, line_id, executed, after_bb, else_bb);
+                if (dib && dif && position) {
+                    ctx.set_debug_scope(old_scope);
+                }
+                return;
+            }
+        }
+        if (is_json_stream_call(iterable.get()) && bindings.size() == 1) {
+            if (auto* record_id = dynamic_cast<IdentifierNode*>(bindings[0].get())) {
+                auto& call = static_cast<const CallExprNode&>(*iterable);
+                emit_json_stream_loop(*this, ctx, call, record_id, executed, after_bb, else_bb);
+                if (dib && dif && position) {
+                    ctx.set_debug_scope(old_scope);
+                }
+                return;
+            }
+        }
         iterable->codegen(ctx);
         auto* iter_val = ctx.pop_value();
         if (!iter_val) {
@@ -275,8 +1029,8 @@ void ForStmtNode::codegen(nv::IRGenerationContext& ctx) {
                     auto* fieldVal = b.CreateLoad(valueStruct, fieldPtr);
                     
                     // Armazenar no binding correspondente
-                    auto sym = ctx.get_symbol_table().lookup_symbol(elemBindings[fi]->symbol);
-                    llvm::Value* dst = sym.has_value() ? sym->value : (llvm::Value*)ctx.create_and_register_variable(elemBindings[fi]->symbol, valueStruct, nullptr, false);
+                    const auto* sym = ctx.get_symbol_table().lookup_symbol(elemBindings[fi]->symbol_id);
+                    llvm::Value* dst = sym ? sym->value : (llvm::Value*)ctx.create_and_register_variable(elemBindings[fi]->symbol, valueStruct, nullptr, false);
                     b.CreateStore(fieldVal, dst);
                 }
             } else if (elemTy->isStructTy()) {
@@ -284,8 +1038,8 @@ void ForStmtNode::codegen(nv::IRGenerationContext& ctx) {
                 if (elemBindings.size() == 1) {
                     auto* tmp = ctx.create_alloca(elemTy, "el.tmp");
                     b.CreateStore(elemVal, tmp);
-                    auto sym = ctx.get_symbol_table().lookup_symbol(elemBindings[0]->symbol);
-                    llvm::Value* dst = sym.has_value() ? sym->value : (llvm::Value*)ctx.create_and_register_variable(elemBindings[0]->symbol, elemTy, nullptr, false);
+                    const auto* sym = ctx.get_symbol_table().lookup_symbol(elemBindings[0]->symbol_id);
+                    llvm::Value* dst = sym ? sym->value : (llvm::Value*)ctx.create_and_register_variable(elemBindings[0]->symbol, elemTy, nullptr, false);
                     auto* loaded = b.CreateLoad(elemTy, tmp);
                     b.CreateStore(loaded, dst);
                 } else {
@@ -296,14 +1050,14 @@ void ForStmtNode::codegen(nv::IRGenerationContext& ctx) {
                         auto* fieldPtr = b.CreateStructGEP(sEl, tmp, (unsigned)fi);
                         auto* fTy = sEl->getElementType((unsigned)fi);
                         auto* fVal = b.CreateLoad(fTy, fieldPtr);
-                        auto sym = ctx.get_symbol_table().lookup_symbol(elemBindings[fi]->symbol);
-                        llvm::Value* dst = sym.has_value() ? sym->value : (llvm::Value*)ctx.create_and_register_variable(elemBindings[fi]->symbol, fTy, nullptr, false);
+                        const auto* sym = ctx.get_symbol_table().lookup_symbol(elemBindings[fi]->symbol_id);
+                        llvm::Value* dst = sym ? sym->value : (llvm::Value*)ctx.create_and_register_variable(elemBindings[fi]->symbol, fTy, nullptr, false);
                         b.CreateStore(fVal, dst);
                     }
                 }
             } else {
-                auto symElem = ctx.get_symbol_table().lookup_symbol(elemBindings[0]->symbol);
-                llvm::Value* elemAlloca = symElem.has_value() ? symElem->value : (llvm::Value*)ctx.create_and_register_variable(elemBindings[0]->symbol, elemTy, nullptr, false);
+                const auto* symElem = ctx.get_symbol_table().lookup_symbol(elemBindings[0]->symbol_id);
+                llvm::Value* elemAlloca = symElem ? symElem->value : (llvm::Value*)ctx.create_and_register_variable(elemBindings[0]->symbol, elemTy, nullptr, false);
                 b.CreateStore(elemVal, elemAlloca);
             }
         }
@@ -395,6 +1149,26 @@ void ForStmtNode::codegen(nv::IRGenerationContext& ctx) {
         throw std::runtime_error("for statement range bounds must be convertible to i32");
     }
 
+    if (simd_reduction) {
+        emit_simd_reduction(ctx, *simd_reduction, id0, range_inclusive, start_v, end_v);
+        b.CreateBr(after_bb);
+        if (dib && dif && position) {
+            ctx.set_debug_scope(old_scope);
+        }
+        b.SetInsertPoint(after_bb);
+        return;
+    }
+
+    if (parallel_plan.parallel) {
+        emit_parallel_range_loop(*this, ctx, parallel_plan, id0, id1, start_v, end_v);
+        b.CreateBr(after_bb);
+        if (dib && dif && position) {
+            ctx.set_debug_scope(old_scope);
+        }
+        b.SetInsertPoint(after_bb);
+        return;
+    }
+
     auto* header_bb = llvm::BasicBlock::Create(ctx.get_context(), "for.header", func);
     auto* body_bb   = llvm::BasicBlock::Create(ctx.get_context(), "for.body",   func);
     auto* step_bb   = llvm::BasicBlock::Create(ctx.get_context(), "for.step",   func);
@@ -416,8 +1190,9 @@ void ForStmtNode::codegen(nv::IRGenerationContext& ctx) {
 
     b.SetInsertPoint(body_bb);
     if (id1) {
-        auto* val_alloca = ctx.get_symbol_table().lookup_symbol(id1->symbol).has_value()
-            ? ctx.get_symbol_table().lookup_symbol(id1->symbol)->value
+        const auto* val_info = ctx.get_symbol_table().lookup_symbol(id1->symbol_id);
+        auto* val_alloca = val_info
+            ? val_info->value
             : (llvm::Value*)ctx.create_and_register_variable(id1->symbol, i32, nullptr, false);
         auto* cur = b.CreateLoad(i32, i_alloca);
         b.CreateStore(cur, val_alloca);
@@ -16,7 +16,7 @@ void ImportStmtNode::codegen(nv::IRGenerationContext& ctx) {
         std::string original_name = item.name;  // Nome original no módulo exportado
         
         // Verificar se já está registrado na tabela de símbolos (usando o alias/nome usado)
-        auto existing_info = ctx.get_symbol_table().lookup_symbol(var_name);
+        const auto* existing_info = ctx.get_symbol_table().lookup_symbol(var_name);
         
         // IMPORTANTE: Buscar pelo nome original no módulo, não pelo alias
         // A função/variável foi criada com o nome original, não com o alias
@@ -29,7 +29,7 @@ void ImportStmtNode::codegen(nv::IRGenerationContext& ctx) {
             // Variável global já existe (criada pela declaração real com o nome original)
             // Registrar na tabela de símbolos com o alias/nome usado (var_name)
             // Isso permite que o código use o alias para acessar a variável original
-            if (existing_info.has_value() && existing_info.value().value == existing_global) {
+            if (existing_info && existing_info->value == existing_global) {
                 // Já está registrado corretamente, não fazer nada
                 continue;
             }
@@ -48,7 +48,7 @@ void ImportStmtNode::codegen(nv::IRGenerationContext& ctx) {
             // Função já existe (criada pela declaração real com o nome original)
             // Registrar na tabela de símbolos com o alias/nome usado (var_name)
             // Isso permite que o código use o alias para acessar a função original
-            if (existing_info.has_value() && existing_info.value().value == existing_function) {
+            if (existing_info && existing_info->value == existing_function) {
                 // Já está registrado corretamente, não fazer nada
                 continue;
             }
@@ -66,7 +66,7 @@ void ImportStmtNode::codegen(nv::IRGenerationContext& ctx) {
         }
         
         // Variável/função ainda não foi criada
-        if (existing_info.has_value() && existing_info.value().value != nullptr) {
+        if (existing_info && existing_info->value != nullptr) {
             // Já está registrado com um valor não-null, não sobrescrever
             continue;
         }
@@ -81,7 +81,7 @@ void ImportStmtNode::codegen(nv::IRGenerationContext& ctx) {
         // Registrar na tabela de símbolos com nullptr temporário apenas se não estiver registrado
         // Quando a declaração real for processada, ela será criada com o nome original (original_name)
         // Então precisamos buscar pelo nome original quando tentarmos resolver o alias
-        if (!existing_info.has_value()) {
+        if (!existing_info) {
             // Não sabemos ainda se é variável ou função, então usamos ValueTy como tipo padrão
             // Será atualizado quando a declaração real for processada
             // IMPORTANTE: Armazenamos o nome original para poder buscar depois
@@ -15,13 +15,10 @@ static llvm::Value* build_match_condition(nv::IRGenerationContext& ctx, Expr* pa
 
     // OR pattern: compose recursively
     if (auto* bin = dynamic_cast<BinaryExprNode*>(pattern)) {
-        if (bin->op == "||") {
-            auto* lhs_clone = static_cast<Expr*>(bin->left->clone());
-            auto* rhs_clone = static_cast<Expr*>(bin->right->clone());
-            auto* lhs_cond = build_match_condition(ctx, lhs_clone, target_val);
-            auto* rhs_cond = build_match_condition(ctx, rhs_clone, target_val);
-            delete lhs_clone;
-            delete rhs_clone;
+        if (bin->opcode == BinaryOp::Or) {
+            // Os lados do padrão são só lidos: gerar direto sobre eles, sem cópia
+            auto* lhs_cond = build_match_condition(ctx, bin->left.get(), target_val);
+            auto* rhs_cond = build_match_condition(ctx, bin->right.get(), target_val);
             if (!lhs_cond || !rhs_cond) return nullptr;
             return b.CreateOr(lhs_cond, rhs_cond, "match.or");
         }
@@ -219,7 +216,7 @@ static llvm::Value* build_match_condition(nv::IRGenerationContext& ctx, Expr* pa
     }
     
     // Caso padrão: usar create_comparison que já trata outros casos (int/float, string/string, etc)
-    return nv::ir_utils::create_comparison(ctx, target_val, v, "==");
+    return nv::ir_utils::create_comparison(ctx, target_val, v, BinaryOp::Eq);
 }
 
 void MatchStmtNode::codegen(nv::IRGenerationContext& ctx) {
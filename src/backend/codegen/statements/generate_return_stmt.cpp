@@ -45,9 +45,12 @@ void ReturnStmtNode::codegen(nv::IRGenerationContext& ctx) {
                 }
             }
             
+            // O valor já foi calculado: agora os recursos de loops abertos podem ser liberados
+            ctx.get_control_flow().emit_cleanups(ctx.get_builder(), ctx.get_current_function());
             nv::ir_utils::create_return(ctx, v);
             return;
         }
     }
+    ctx.get_control_flow().emit_cleanups(ctx.get_builder(), ctx.get_current_function());
     nv::ir_utils::create_return(ctx, nullptr);
 }
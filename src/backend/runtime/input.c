@@ -0,0 +1,105 @@
+#include "backend/runtime/nv_runtime.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* ============================================================= */
+/*                    ENTRADA BUFERIZADA (STDIN)                 */
+/* ============================================================= */
+
+// stdin é lido em blocos grandes com read(2) e as linhas são separadas com
+// memchr. nv_in_next_line devolve uma view dentro do próprio buffer (o '\n'
+// vira '\0'), válida até a próxima leitura; nv_read e nv_read_lines copiam.
+
+#define NV_IN_BUFFER_SIZE (64 * 1024)
+
+static char* in_buf = NULL;
+static size_t in_cap = 0;
+static size_t in_start = 0;   // início da próxima linha
+static size_t in_end = 0;     // fim dos dados válidos
+static int in_eof = 0;
+
+// Lê mais dados mantendo a linha parcial no início do buffer; 0 em EOF/erro
+static int refill(void) {
+    if (in_start > 0) {
+        memmove(in_buf, in_buf + in_start, in_end - in_start);
+        in_end -= in_start;
+        in_start = 0;
+    }
+    // Linha maior que o buffer: dobra (sempre sobra 1 byte para o '\0')
+    if (in_end + 1 >= in_cap) {
+        size_t cap = in_cap ? in_cap * 2 : NV_IN_BUFFER_SIZE;
+        char* grown = (char*)realloc(in_buf, cap);
+        if (!grown) {
+            fprintf(stderr, "FATAL: realloc failed in nv_in_next_line\n");
+            exit(1);
+        }
+        in_buf = grown;
+        in_cap = cap;
+    }
+
+    // Um prompt escrito sem '\n' precisa aparecer antes de bloquear
+    nv_out_flush();
+
+    for (;;) {
+        ssize_t n = read(STDIN_FILENO, in_buf + in_end, in_cap - in_end - 1);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            in_eof = 1;
+            return 0;
+        }
+        in_end += (size_t)n;
+        return 1;
+    }
+}
+
+int32_t nv_in_next_line(char** line) {
+    size_t scanned = 0;   // bytes da linha atual já verificados sem '\n'
+    for (;;) {
+        if (in_buf && in_end > in_start + scanned) {
+            char* from = in_buf + in_start + scanned;
+            char* nl = (char*)memchr(from, '\n', in_end - in_start - scanned);
+            if (nl) {
+                *nl = '\0';
+                *line = in_buf + in_start;
+                in_start = (size_t)(nl - in_buf) + 1;
+                return 1;
+            }
+            scanned = in_end - in_start;
+        }
+        if (in_eof || !refill()) {
+            if (in_end == in_start) return 0;
+            // Última linha sem '\n'
+            in_buf[in_end] = '\0';
+            *line = in_buf + in_start;
+            in_start = in_end;
+            return 1;
+        }
+    }
+}
+
+char* nv_read(void) {
+    char* line;
+    if (!nv_in_next_line(&line)) return NULL;
+    size_t len = strlen(line);
+    char* copy = (char*)malloc(len + 1);
+    if (!copy) {
+        fprintf(stderr, "FATAL: malloc failed in nv_read\n");
+        exit(1);
+    }
+    memcpy(copy, line, len + 1);
+    return copy;
+}
+
+void nv_read_lines(Value* out) {
+    create_vector(out, 0);
+    Vector* vec = (Vector*)(intptr_t)out->value;
+    char* line;
+    while (nv_in_next_line(&line)) {
+        Value s;
+        create_str(&s, line);
+        vector_push_impl(vec, s);
+    }
+}
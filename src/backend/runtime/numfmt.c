@@ -0,0 +1,375 @@
+#include "backend/runtime/nv_runtime.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================= */
+/*                    FORMATAÇÃO NUMÉRICA                        */
+/* ============================================================= */
+
+// Inteiros: dois dígitos por divisão, via tabela de pares.
+// Doubles: Grisu2 (Florian Loitsch, "Printing Floating-Point Numbers Quickly
+// and Accurately with Integers"), sempre round-trip e com a menor quantidade
+// de dígitos na imensa maioria dos casos; independente de locale.
+
+static const char digit_pairs[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+int nv_format_uint64(uint64_t u, char* buf) {
+    char tmp[20];
+    int pos = 20;
+    while (u >= 100) {
+        unsigned r = (unsigned)(u % 100);
+        u /= 100;
+        tmp[--pos] = digit_pairs[r * 2 + 1];
+        tmp[--pos] = digit_pairs[r * 2];
+    }
+    if (u >= 10) {
+        tmp[--pos] = digit_pairs[u * 2 + 1];
+        tmp[--pos] = digit_pairs[u * 2];
+    } else {
+        tmp[--pos] = (char)('0' + u);
+    }
+    int len = 20 - pos;
+    memcpy(buf, tmp + pos, (size_t)len);
+    buf[len] = '\0';
+    return len;
+}
+
+int nv_format_int64(int64_t v, char* buf) {
+    if (v < 0) {
+        buf[0] = '-';
+        return 1 + nv_format_uint64((uint64_t)0 - (uint64_t)v, buf + 1);
+    }
+    return nv_format_uint64((uint64_t)v, buf);
+}
+
+/* --- Grisu2 --- */
+
+typedef struct {
+    uint64_t f;
+    int e;
+} DiyFp;
+
+#define DP_SIGNIFICAND_MASK 0x000FFFFFFFFFFFFFULL
+#define DP_HIDDEN_BIT       0x0010000000000000ULL
+#define DP_EXPONENT_BIAS    1075   // 1023 + 52
+#define DIY_SIGNIFICAND_SIZE 64
+
+// 10^k normalizado (f * 2^e) para k = -348, -340, ..., 340
+static const uint64_t cached_powers_f[] = {
+    0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL,
+    0xcf42894a5dce35eaULL, 0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL,
+    0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL, 0xbe5691ef416bd60cULL,
+    0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+    0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL,
+    0xc21094364dfb5637ULL, 0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL,
+    0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL, 0xb23867fb2a35b28eULL,
+    0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+    0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL,
+    0xb5b5ada8aaff80b8ULL, 0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL,
+    0x964e858c91ba2655ULL, 0xdff9772470297ebdULL, 0xa6dfbd9fb8e5b88fULL,
+    0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+    0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL,
+    0xaa242499697392d3ULL, 0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL,
+    0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL, 0x9c40000000000000ULL,
+    0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+    0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL,
+    0x9f4f2726179a2245ULL, 0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL,
+    0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL, 0x924d692ca61be758ULL,
+    0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+    0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL,
+    0x952ab45cfa97a0b3ULL, 0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL,
+    0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL, 0x88fcf317f22241e2ULL,
+    0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+    0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL,
+    0x8bab8eefb6409c1aULL, 0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL,
+    0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL, 0x80444b5e7aa7cf85ULL,
+    0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+    0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL,
+};
+
+static const int16_t cached_powers_e[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+    -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+    -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+    -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+    -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+    109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+    641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+    907, 933, 960, 986, 1013, 1039, 1066,
+};
+
+static const uint64_t pow10_u64[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+    10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+
+static DiyFp diy_mul(DiyFp x, DiyFp y) {
+    const uint64_t M32 = 0xFFFFFFFFULL;
+    uint64_t a = x.f >> 32, b = x.f & M32;
+    uint64_t c = y.f >> 32, d = y.f & M32;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t tmp = (bd >> 32) + (ad & M32) + (bc & M32);
+    tmp += 1ULL << 31;   // arredonda
+    DiyFp r = {ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), x.e + y.e + 64};
+    return r;
+}
+
+static DiyFp diy_normalize(DiyFp v) {
+    int shift = __builtin_clzll(v.f);
+    v.f <<= shift;
+    v.e -= shift;
+    return v;
+}
+
+static DiyFp diy_from_double(double d) {
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof bits);
+    int biased_e = (int)((bits >> 52) & 0x7FF);
+    uint64_t significand = bits & DP_SIGNIFICAND_MASK;
+    DiyFp r;
+    if (biased_e != 0) {
+        r.f = significand | DP_HIDDEN_BIT;
+        r.e = biased_e - DP_EXPONENT_BIAS;
+    } else {
+        r.f = significand;
+        r.e = 1 - DP_EXPONENT_BIAS;
+    }
+    return r;
+}
+
+// Fronteiras m- e m+ (pontos médios até os doubles vizinhos), com o mesmo expoente
+static void normalized_boundaries(DiyFp v, DiyFp* minus, DiyFp* plus) {
+    DiyFp pl = {(v.f << 1) + 1, v.e - 1};
+    while (!(pl.f & (DP_HIDDEN_BIT << 1))) {
+        pl.f <<= 1;
+        pl.e--;
+    }
+    pl.f <<= DIY_SIGNIFICAND_SIZE - 52 - 2;
+    pl.e -= DIY_SIGNIFICAND_SIZE - 52 - 2;
+
+    DiyFp mi;
+    if (v.f == DP_HIDDEN_BIT) {
+        mi.f = (v.f << 2) - 1;
+        mi.e = v.e - 2;
+    } else {
+        mi.f = (v.f << 1) - 1;
+        mi.e = v.e - 1;
+    }
+    mi.f <<= mi.e - pl.e;
+    mi.e = pl.e;
+
+    *plus = pl;
+    *minus = mi;
+}
+
+static DiyFp cached_power(int e, int* K) {
+    double dk = (-61 - e) * 0.30102999566398114 + 347;   // log10(2)
+    int k = (int)dk;
+    if (dk - k > 0.0) k++;
+    unsigned index = (unsigned)((k >> 3) + 1);
+    *K = -(-348 + (int)(index << 3));
+    DiyFp r = {cached_powers_f[index], cached_powers_e[index]};
+    return r;
+}
+
+static int count_digits32(uint32_t n) {
+    int d = 1;
+    while (n >= 10) {
+        n /= 10;
+        d++;
+    }
+    return d;
+}
+
+static void grisu_round(char* buffer, int len, uint64_t delta, uint64_t rest, uint64_t ten_kappa, uint64_t wp_w) {
+    while (rest < wp_w && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w)) {
+        buffer[len - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+static void digit_gen(DiyFp W, DiyFp Mp, uint64_t delta, char* buffer, int* len, int* K) {
+    DiyFp one = {1ULL << -Mp.e, Mp.e};
+    uint64_t wp_w = Mp.f - W.f;
+    uint32_t p1 = (uint32_t)(Mp.f >> -one.e);
+    uint64_t p2 = Mp.f & (one.f - 1);
+    int kappa = count_digits32(p1);
+    *len = 0;
+
+    while (kappa > 0) {
+        uint32_t div = (uint32_t)pow10_u64[kappa - 1];
+        uint32_t d = p1 / div;
+        p1 %= div;
+        if (d || *len) buffer[(*len)++] = (char)('0' + d);
+        kappa--;
+        uint64_t tmp = ((uint64_t)p1 << -one.e) + p2;
+        if (tmp <= delta) {
+            *K += kappa;
+            grisu_round(buffer, *len, delta, tmp, pow10_u64[kappa] << -one.e, wp_w);
+            return;
+        }
+    }
+
+    for (;;) {
+        p2 *= 10;
+        delta *= 10;
+        char d = (char)(p2 >> -one.e);
+        if (d || *len) buffer[(*len)++] = (char)('0' + d);
+        p2 &= one.f - 1;
+        kappa--;
+        if (p2 < delta) {
+            *K += kappa;
+            int index = -kappa;
+            grisu_round(buffer, *len, delta, p2, one.f, wp_w * (index < 20 ? pow10_u64[index] : 0));
+            return;
+        }
+    }
+}
+
+// Dígitos de `d` (> 0, finito) em buffer, com d ~= digits * 10^K
+static void grisu2(double d, char* buffer, int* len, int* K) {
+    DiyFp v = diy_from_double(d);
+    DiyFp w_m, w_p;
+    normalized_boundaries(v, &w_m, &w_p);
+
+    DiyFp c_mk = cached_power(w_p.e, K);
+    DiyFp W = diy_mul(diy_normalize(v), c_mk);
+    DiyFp Wp = diy_mul(w_p, c_mk);
+    DiyFp Wm = diy_mul(w_m, c_mk);
+    Wm.f++;
+    Wp.f--;
+    digit_gen(W, Wp, Wp.f - Wm.f, buffer, len, K);
+}
+
+// Confere se digits * 10^K volta exatamente para d (sem ponto decimal: independe de locale)
+static int roundtrips(double d, const char* digits, int len, int K) {
+    char tmp[48];
+    memcpy(tmp, digits, (size_t)len);
+    tmp[len] = 'e';
+    nv_format_int64(K, tmp + len + 1);
+    return strtod(tmp, NULL) == d;
+}
+
+// Grisu2 às vezes produz um dígito a mais (ex.: 1e23 -> 9.999999999999999e22).
+// Para saídas longas tenta os candidatos com um dígito a menos (truncado e
+// arredondado para cima) e fica com o que faz round-trip
+static int shorten(double d, char* digits, int len, int* K) {
+    char down[24], up[24];
+    int n = len - 1;
+    memcpy(down, digits, (size_t)n);
+    memcpy(up, digits, (size_t)n);
+
+    int up_len = n, up_K = *K + 1;
+    int i = n - 1;
+    while (i >= 0 && up[i] == '9') up[i--] = '0';
+    if (i >= 0) {
+        up[i]++;
+    } else {
+        up[0] = '1';   // 99..9 -> 100..0
+        up_len = 1;
+        up_K += n;
+    }
+
+    int prefer_up = digits[n] >= '5';
+    const char* first = prefer_up ? up : down;
+    const char* second = prefer_up ? down : up;
+    int first_len = prefer_up ? up_len : n, second_len = prefer_up ? n : up_len;
+    int first_K = prefer_up ? up_K : *K + 1, second_K = prefer_up ? *K + 1 : up_K;
+
+    const char* pick = NULL;
+    int pick_len = 0, pick_K = 0;
+    if (roundtrips(d, first, first_len, first_K)) {
+        pick = first; pick_len = first_len; pick_K = first_K;
+    } else if (roundtrips(d, second, second_len, second_K)) {
+        pick = second; pick_len = second_len; pick_K = second_K;
+    }
+    if (!pick) return len;
+
+    // Zeros à direita viram expoente
+    while (pick_len > 1 && pick[pick_len - 1] == '0') {
+        pick_len--;
+        pick_K++;
+    }
+    memmove(digits, pick, (size_t)pick_len);
+    *K = pick_K;
+    return pick_len;
+}
+
+// Saída no estilo de %.17g: científica para expoentes < -4 ou >= 17, sem ".0" em inteiros
+static int prettify(char* buf, const char* digits, int len, int k) {
+    int kk = len + k;   // posição do ponto decimal
+    int exp10 = kk - 1;
+    int n = 0;
+
+    if (exp10 < -4 || exp10 >= 17) {
+        buf[n++] = digits[0];
+        if (len > 1) {
+            buf[n++] = '.';
+            memcpy(buf + n, digits + 1, (size_t)(len - 1));
+            n += len - 1;
+        }
+        buf[n++] = 'e';
+        buf[n++] = exp10 < 0 ? '-' : '+';
+        unsigned e = (unsigned)(exp10 < 0 ? -exp10 : exp10);
+        if (e >= 100) {
+            buf[n++] = (char)('0' + e / 100);
+            e %= 100;
+        }
+        buf[n++] = digit_pairs[e * 2];
+        buf[n++] = digit_pairs[e * 2 + 1];
+    } else if (kk <= 0) {
+        buf[n++] = '0';
+        buf[n++] = '.';
+        memset(buf + n, '0', (size_t)-kk);
+        n += -kk;
+        memcpy(buf + n, digits, (size_t)len);
+        n += len;
+    } else if (kk < len) {
+        memcpy(buf + n, digits, (size_t)kk);
+        n += kk;
+        buf[n++] = '.';
+        memcpy(buf + n, digits + kk, (size_t)(len - kk));
+        n += len - kk;
+    } else {
+        memcpy(buf + n, digits, (size_t)len);
+        n += len;
+        memset(buf + n, '0', (size_t)(kk - len));
+        n += kk - len;
+    }
+    buf[n] = '\0';
+    return n;
+}
+
+int nv_format_double(double d, char* buf) {
+    int n = 0;
+    if (signbit(d)) buf[n++] = '-';
+    if (isnan(d)) {
+        memcpy(buf + n, "nan", 4);
+        return n + 3;
+    }
+    if (isinf(d)) {
+        memcpy(buf + n, "inf", 4);
+        return n + 3;
+    }
+    if (d == 0.0) {
+        buf[n++] = '0';
+        buf[n] = '\0';
+        return n;
+    }
+
+    char digits[24];
+    int len, K;
+    grisu2(fabs(d), digits, &len, &K);
+    if (len >= 16) len = shorten(fabs(d), digits, len, &K);
+    return n + prettify(buf + n, digits, len, K);
+}
@@ -0,0 +1,163 @@
+#include <cfloat>
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "test_support.hpp"
+
+extern "C" {
+#include "backend/runtime/prototypes.h"
+#include "backend/runtime/nv_runtime.h"
+}
+
+using namespace nv::test;
+
+namespace {
+    std::string format_double(double d) {
+        char buf[NV_FORMAT_BUFFER_SIZE];
+        int len = nv_format_double(d, buf);
+        return static_cast<int>(std::strlen(buf)) == len ? std::string(buf) : "<comprimento errado>";
+    }
+
+    std::string format_int(int64_t v) {
+        char buf[NV_FORMAT_BUFFER_SIZE];
+        int len = nv_format_int64(v, buf);
+        return static_cast<int>(std::strlen(buf)) == len ? std::string(buf) : "<comprimento errado>";
+    }
+
+    double from_bits(uint64_t bits) {
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        return d;
+    }
+
+    // Dígitos significativos da saída (sem sinal, ponto, zeros à esquerda e expoente)
+    int significant_digits(const std::string& s) {
+        std::string mantissa = s.substr(0, s.find('e'));
+        std::string digits;
+        for (char ch : mantissa) {
+            if (ch >= '0' && ch <= '9') digits += ch;
+        }
+        size_t first = digits.find_first_not_of('0');
+        if (first == std::string::npos) return 1;
+        size_t last = digits.find_last_not_of('0');
+        // Zeros à direita só contam depois do ponto decimal
+        if (mantissa.find('.') == std::string::npos) return static_cast<int>(last - first + 1);
+        return static_cast<int>(digits.size() - first);
+    }
+
+    void test_int() {
+        std::cout << "nv_format_int64\n";
+        check(format_int(0) == "0" && format_int(7) == "7" && format_int(-7) == "-7", "um dígito");
+        check(format_int(INT64_MAX) == "9223372036854775807", "INT64_MAX");
+        check(format_int(INT64_MIN) == "-9223372036854775808", "INT64_MIN");
+        char ubuf[NV_FORMAT_BUFFER_SIZE];
+        check(nv_format_uint64(UINT64_MAX, ubuf) == 20 && std::string(ubuf) == "18446744073709551615", "UINT64_MAX");
+
+        // Potências de 10 e vizinhas: cada quantidade de dígitos, par e ímpar
+        bool ok = true;
+        std::mt19937_64 rng(30);
+        std::vector<int64_t> values;
+        for (int64_t p = 1; p <= INT64_MAX / 10; p *= 10) {
+            for (int64_t v : {p - 1, p, p + 1, 10 * p - 1}) {
+                values.push_back(v);
+                values.push_back(-v);
+            }
+        }
+        for (int i = 0; i < 200000; i++) {
+            values.push_back(static_cast<int64_t>(rng()) >> (rng() % 64));
+        }
+        for (int64_t v : values) {
+            char expected[32];
+            std::snprintf(expected, sizeof(expected), "%" PRId64, v);
+            if (format_int(v) != expected) {
+                if (ok) std::cout << "    " << expected << " -> " << format_int(v) << "\n";
+                ok = false;
+            }
+        }
+        check(ok, "igual a printf em potências de 10 e valores aleatórios");
+    }
+
+    void test_double_exact() {
+        std::cout << "nv_format_double: saídas exatas\n";
+        const std::pair<double, const char*> cases[] = {
+            {0.1, "0.1"},
+            {0.3, "0.3"},
+            {1.0, "1"},
+            {-2.5, "-2.5"},
+            {100.0, "100"},
+            {123456.789, "123456.789"},
+            {0.0001, "0.0001"},
+            {1e-5, "1e-05"},
+            {1e-7, "1e-07"},
+            {1e16, "10000000000000000"},
+            {1e17, "1e+17"},
+            {1e21, "1e+21"},
+            {1e23, "1e+23"},
+            {1.0 / 3.0, "0.3333333333333333"},
+            {5e-324, "5e-324"},
+            {DBL_MIN, "2.2250738585072014e-308"},
+            {DBL_MAX, "1.7976931348623157e+308"},
+            {0.0, "0"},
+            {-0.0, "-0"},
+            {HUGE_VAL, "inf"},
+            {-HUGE_VAL, "-inf"},
+            {std::nan(""), "nan"},
+        };
+        for (const auto& [d, expected] : cases) {
+            std::string got = format_double(d);
+            check(got == expected, std::string(expected) + (got == expected ? "" : " (veio " + got + ")"));
+        }
+    }
+
+    // strtod(format(x)) == x para padrões de bits aleatórios (todos os
+    // expoentes, subnormais incluídos) e para decimais curtos, que devem sair
+    // com no máximo a quantidade de dígitos com que foram escritos
+    void test_double_round_trip() {
+        std::cout << "nv_format_double: round-trip\n";
+        std::mt19937_64 rng(30);
+        bool round_trip = true;
+        for (int i = 0; i < 1000000; i++) {
+            double d = from_bits(rng());
+            if (!std::isfinite(d)) continue;
+            std::string s = format_double(d);
+            if (std::strtod(s.c_str(), nullptr) != d) {
+                if (round_trip) std::cout << "    " << s << "\n";
+                round_trip = false;
+            }
+        }
+        check(round_trip, "1000000 padrões de bits aleatórios");
+
+        bool short_round_trip = true, shortest = true;
+        for (int i = 0; i < 300000; i++) {
+            int precision = 1 + static_cast<int>(rng() % 15);
+            int exponent = static_cast<int>(rng() % 600) - 300;
+            char text[64];
+            std::snprintf(text, sizeof(text), "%.*ge%d", precision,
+                          static_cast<double>(rng() % 1000000000000000ULL) / 1e15 + 1.0, exponent);
+            double d = std::strtod(text, nullptr);
+            std::string s = format_double(d);
+            if (std::strtod(s.c_str(), nullptr) != d) short_round_trip = false;
+            if (significant_digits(s) > precision) {
+                if (shortest) std::cout << "    " << text << " -> " << s << "\n";
+                shortest = false;
+            }
+        }
+        check(short_round_trip, "decimais de até 15 dígitos voltam iguais");
+        check(shortest, "decimais de até 15 dígitos não ganham dígitos");
+    }
+}
+
+int main() {
+    std::cout << "Iniciando teste de formatação numérica...\n";
+    test_int();
+    test_double_exact();
+    test_double_round_trip();
+    return finish("formatação numérica");
+}
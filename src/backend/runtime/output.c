@@ -0,0 +1,91 @@
+#include "backend/runtime/nv_runtime.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* ============================================================= */
+/*                    SAÍDA BUFERIZADA (STDOUT)                  */
+/* ============================================================= */
+
+// O programa gerado termina com _exit, que não passa pelo teardown do
+// stdio; por isso toda a saída do runtime passa por este buffer, que é
+// esvaziado quando enche, em nv_flush_all (antes de _exit) e, se stdout
+// for um terminal, a cada nova linha. Os caminhos fatais do runtime saem
+// com exit(1): nv_flush_all fica registrada com atexit no primeiro uso do
+// buffer para que a saída anterior ao erro não se perca.
+
+#define NV_OUT_BUFFER_SIZE (64 * 1024)
+
+static char out_buffer[NV_OUT_BUFFER_SIZE];
+static size_t out_len = 0;
+static int out_tty = -1;   // -1 = ainda não consultado
+static int out_at_exit = 0;
+
+static void write_fd(const char* data, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(STDOUT_FILENO, data, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return;   // stdout fechado (ex.: pipe encerrado): descarta, como o stdio
+        }
+        data += n;
+        len -= (size_t)n;
+    }
+}
+
+static int stdout_is_tty(void) {
+    if (out_tty < 0) {
+        out_tty = isatty(STDOUT_FILENO) ? 1 : 0;
+    }
+    return out_tty;
+}
+
+static void out_register_exit(void) {
+    out_at_exit = 1;
+    atexit(nv_flush_all);
+}
+
+void nv_out_flush(void) {
+    if (out_len == 0) return;
+    write_fd(out_buffer, out_len);
+    out_len = 0;
+}
+
+void nv_out_write(const char* data, size_t len) {
+    if (!data || len == 0) return;
+    if (out_len + len > NV_OUT_BUFFER_SIZE) {
+        nv_out_flush();
+        // Blocos maiores que o buffer vão direto para o descritor
+        if (len >= NV_OUT_BUFFER_SIZE) {
+            write_fd(data, len);
+            return;
+        }
+    }
+    if (!out_at_exit) out_register_exit();
+    memcpy(out_buffer + out_len, data, len);
+    out_len += len;
+}
+
+void nv_out_puts(const char* s) {
+    if (s) nv_out_write(s, strlen(s));
+}
+
+void nv_out_putc(char c) {
+    if (out_len == NV_OUT_BUFFER_SIZE) nv_out_flush();
+    if (!out_at_exit) out_register_exit();
+    out_buffer[out_len++] = c;
+}
+
+void nv_out_newline(void) {
+    nv_out_putc('\n');
+    if (stdout_is_tty()) nv_out_flush();
+}
+
+void nv_flush_all(void) {
+    // Código que ainda usa stdio (printers customizados, depuração) sai na ordem
+    fflush(stdout);
+    nv_out_flush();
+    fflush(NULL);
+}
@@ -0,0 +1,251 @@
+#include "backend/runtime/nv_runtime.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* ============================================================= */
+/*                    POOL DE THREADS (LOOPS PARALELOS)          */
+/* ============================================================= */
+
+// Abaixo disso o custo de acordar as workers supera o ganho
+#define NV_PARALLEL_MIN_ITERS 4096
+// Chunks por thread: balanceia iterações de custo irregular
+#define NV_PARALLEL_CHUNKS_PER_THREAD 4
+#define NV_PARALLEL_MAX_THREADS 256
+
+typedef struct {
+    nv_parallel_body body;
+    void* env;
+    int32_t lo;
+    int32_t hi;
+    int32_t chunks;
+    int32_t chunk_size;
+    int32_t next_chunk;     // próximo chunk a ser reivindicado
+    int32_t pending;        // chunks ainda não concluídos
+} ParallelJob;
+
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t dispatch_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t job_ready = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t job_done = PTHREAD_COND_INITIALIZER;
+static pthread_once_t pool_once = PTHREAD_ONCE_INIT;
+
+static ParallelJob* current_job = NULL;
+static unsigned long job_generation = 0;
+static int pool_threads = 1;   // inclui a thread chamadora
+
+// Executa chunks do job atual até não restar nenhum; chamada com pool_lock travado
+static void run_chunks_locked(ParallelJob* job) {
+    while (job->next_chunk < job->chunks) {
+        int32_t c = job->next_chunk++;
+        pthread_mutex_unlock(&pool_lock);
+
+        int64_t lo = (int64_t)job->lo + (int64_t)c * job->chunk_size;
+        int64_t hi = lo + job->chunk_size;
+        if (hi > job->hi) hi = job->hi;
+        if (lo > hi) lo = hi;
+        job->body((int32_t)lo, (int32_t)hi, c, job->env);
+
+        pthread_mutex_lock(&pool_lock);
+        if (--job->pending == 0) {
+            pthread_cond_broadcast(&job_done);
+        }
+    }
+}
+
+static void* worker_main(void* arg) {
+    (void)arg;
+    unsigned long seen = 0;
+    pthread_mutex_lock(&pool_lock);
+    for (;;) {
+        while (job_generation == seen) {
+            pthread_cond_wait(&job_ready, &pool_lock);
+        }
+        seen = job_generation;
+        if (current_job) {
+            run_chunks_locked(current_job);
+        }
+    }
+    return NULL;
+}
+
+static void pool_init(void) {
+    long n = 0;
+    const char* env = getenv("NV_NUM_THREADS");
+    if (env && *env) {
+        n = strtol(env, NULL, 10);
+    }
+    if (n <= 0) {
+        n = sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (n < 1) n = 1;
+    if (n > NV_PARALLEL_MAX_THREADS) n = NV_PARALLEL_MAX_THREADS;
+
+    pool_threads = 1;
+    for (long i = 1; i < n; i++) {
+        pthread_t tid;
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+        int rc = pthread_create(&tid, &attr, worker_main, NULL);
+        pthread_attr_destroy(&attr);
+        if (rc != 0) break;   // segue com as threads que conseguiu criar
+        pool_threads++;
+    }
+}
+
+int32_t nv_parallel_chunks(int32_t lo, int32_t hi) {
+    if (hi <= lo) return 1;
+    int64_t iters = (int64_t)hi - (int64_t)lo;
+    if (iters < NV_PARALLEL_MIN_ITERS) return 1;
+
+    pthread_once(&pool_once, pool_init);
+    if (pool_threads <= 1) return 1;
+
+    int64_t chunks = (int64_t)pool_threads * NV_PARALLEL_CHUNKS_PER_THREAD;
+    int64_t max_chunks = iters / (NV_PARALLEL_MIN_ITERS / NV_PARALLEL_CHUNKS_PER_THREAD);
+    if (chunks > max_chunks) chunks = max_chunks;
+    if (chunks > NV_PARALLEL_MAX_CHUNKS) chunks = NV_PARALLEL_MAX_CHUNKS;
+    if (chunks < 1) chunks = 1;
+    return (int32_t)chunks;
+}
+
+void nv_parallel_for(int32_t lo, int32_t hi, int32_t chunks, nv_parallel_body body, void* env) {
+    if (!body) return;
+    if (hi <= lo) {
+        // Nenhuma iteração, mas o chunk 0 ainda publica a identidade das reduções
+        body(lo, lo, 0, env);
+        return;
+    }
+    // Caminho serial: um chunk só, ou pool ocupado (chamada reentrante)
+    if (chunks <= 1 || pthread_mutex_trylock(&dispatch_lock) != 0) {
+        int64_t iters = (int64_t)hi - (int64_t)lo;
+        if (chunks < 1) chunks = 1;
+        int32_t size = (int32_t)((iters + chunks - 1) / chunks);
+        for (int32_t c = 0; c < chunks; c++) {
+            int64_t clo = (int64_t)lo + (int64_t)c * size;
+            int64_t chi = clo + size;
+            if (chi > hi) chi = hi;
+            if (clo > hi) clo = hi;
+            body((int32_t)clo, (int32_t)chi, c, env);
+        }
+        return;
+    }
+
+    int64_t iters = (int64_t)hi - (int64_t)lo;
+    ParallelJob job;
+    job.body = body;
+    job.env = env;
+    job.lo = lo;
+    job.hi = hi;
+    job.chunks = chunks;
+    job.chunk_size = (int32_t)((iters + chunks - 1) / chunks);
+    job.next_chunk = 0;
+    job.pending = chunks;
+
+    // Chunks que ficariam vazios pelo arredondamento ainda rodam (lo == hi),
+    // para que todo slot de redução parcial seja escrito
+    pthread_mutex_lock(&pool_lock);
+    current_job = &job;
+    job_generation++;
+    pthread_cond_broadcast(&job_ready);
+
+    run_chunks_locked(&job);
+    while (job.pending > 0) {
+        pthread_cond_wait(&job_done, &pool_lock);
+    }
+    current_job = NULL;
+    pthread_mutex_unlock(&pool_lock);
+
+    pthread_mutex_unlock(&dispatch_lock);
+}
+
+// Campos de armazenamento de um array/vector; 0 para outros tipos
+static int parallel_storage(Value* self, Value*** elements, int** size, int** capacity) {
+    if (!self) return 0;
+    if (self->type == TAG_ARRAY) {
+        Array* arr = (Array*)(intptr_t)self->value;
+        if (!arr) return 0;
+        *elements = &arr->elements;
+        *size = &arr->size;
+        *capacity = &arr->capacity;
+        return 1;
+    }
+    if (self->type == TAG_VECTOR) {
+        Vector* vec = (Vector*)(intptr_t)self->value;
+        if (!vec) return 0;
+        *elements = &vec->elements;
+        *size = &vec->size;
+        *capacity = &vec->capacity;
+        return 1;
+    }
+    return 0;
+}
+
+void nv_parallel_reserve(Value* self, int32_t size) {
+    Value** elements;
+    int* cur_size;
+    int* capacity;
+    if (size <= 0 || !parallel_storage(self, &elements, &cur_size, &capacity)) return;
+
+    // Cresce antes do despacho: escritas concorrentes em [i] nunca realocam.
+    // O size só muda em nv_parallel_commit, com o maior índice de fato escrito.
+    if (size > *capacity) {
+        Value* grown = (Value*)realloc(*elements, sizeof(Value) * size);
+        if (!grown) {
+            fprintf(stderr, "FATAL: realloc failed in nv_parallel_reserve\n");
+            exit(1);
+        }
+        *elements = grown;
+        *capacity = size;
+    }
+    // Lacunas deixadas por escritas condicionais ficam nulas
+    if (size > *cur_size) {
+        memset(*elements + *cur_size, 0, sizeof(Value) * (size - *cur_size));
+    }
+}
+
+void nv_parallel_store(Value* self, int32_t index, const Value* value) {
+    Value** elements;
+    int* size;
+    int* capacity;
+    if (!value || index < 0 || !parallel_storage(self, &elements, &size, &capacity)) return;
+    if (self->type == TAG_ARRAY) {
+        array_set_reserved((Array*)(intptr_t)self->value, index, *value);
+    } else if (index < *capacity) {
+        (*elements)[index] = *value;
+    }
+}
+
+void nv_parallel_load(Value* out, Value* self, int32_t index) {
+    Value** elements;
+    int* size;
+    int* capacity;
+    if (!out) return;
+    if (index < 0 || !parallel_storage(self, &elements, &size, &capacity) || index >= *capacity) {
+        memset(out, 0, sizeof(Value));
+        return;
+    }
+    *out = (*elements)[index];
+}
+
+void nv_parallel_commit(Value* self, const int32_t* written_end, int32_t chunks) {
+    Value** elements;
+    int* size;
+    int* capacity;
+    if (!written_end || !parallel_storage(self, &elements, &size, &capacity)) return;
+    int32_t end = *size;
+    for (int32_t c = 0; c < chunks; c++) {
+        if (written_end[c] > end) end = written_end[c];
+    }
+    *size = end;
+}
+
+int32_t nv_same_storage(Value* a, Value* b) {
+    if (!a || !b) return 0;
+    if (a->type != TAG_ARRAY && a->type != TAG_VECTOR) return 0;
+    if (b->type != TAG_ARRAY && b->type != TAG_VECTOR) return 0;
+    return a->value == b->value;
+}
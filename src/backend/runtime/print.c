@@ -12,295 +12,313 @@ extern void* vector_prototype;
 extern void* map_prototype;
 
 /* ============================================================= */
-/*                     PRINT RECURSIVO SEGURO                    */
+/*                     PRINT ITERATIVO SEGURO                    */
 /* ============================================================= */
 
-/* Conjunto simples de ponteiros visitados (hash set básico) */
-#define MAX_VISITED 256
-static uintptr_t visited[MAX_VISITED];
-static int visited_count = 0;
+// Containers abertos ficam numa pilha explícita (sem recursão, então
+// estruturas profundas não estouram a pilha de C). Um container que já está
+// aberto no caminho atual é um ciclo; ele fica num conjunto de ponteiros com
+// endereçamento aberto, então a detecção é O(1) e não tem limite de tamanho.
+// Containers compartilhados fora do caminho atual são impressos normalmente.
+//
+// Limites (0 = sem limite): profundidade de containers aninhados e elementos
+// por container. Além deles o conteúdo vira "..." / "... (+N more)".
+
+#define NV_PRINT_DEFAULT_DEPTH 64
+#define NV_PRINT_INLINE_FRAMES 32
+#define NV_PRINT_INLINE_SET 64
+
+static int print_limits_loaded = 0;
+static int32_t print_max_depth = NV_PRINT_DEFAULT_DEPTH;
+static int32_t print_max_width = 0;
+
+static void load_print_limits(void) {
+    if (print_limits_loaded) return;
+    print_limits_loaded = 1;
+    const char* depth = getenv("NV_PRINT_DEPTH");
+    const char* width = getenv("NV_PRINT_WIDTH");
+    if (depth && *depth) print_max_depth = (int32_t)atoi(depth);
+    if (width && *width) print_max_width = (int32_t)atoi(width);
+}
+
+void nv_print_set_limits(int32_t max_depth, int32_t max_width) {
+    print_limits_loaded = 1;
+    print_max_depth = max_depth > 0 ? max_depth : 0;
+    print_max_width = max_width > 0 ? max_width : 0;
+}
+
+typedef enum {
+    FRAME_ARRAY,
+    FRAME_VECTOR,
+    FRAME_MAP,
+    FRAME_TUPLE,
+    FRAME_STRUCT
+} FrameKind;
+
+typedef struct {
+    FrameKind kind;
+    uintptr_t ptr;              // identidade do container (conjunto de abertos)
+    const Value* items;
+    char* const* keys;          // chaves do map ou nomes dos campos do struct
+    int count;
+    int next;                   // próximo índice a visitar
+    int printed;                // elementos já impressos
+} PrintFrame;
+
+// Estado de uma chamada: buffers embutidos cobrem o caso comum sem malloc, e
+// nada é estático, então printers customizados podem chamar nv_write
+typedef struct {
+    PrintFrame* frames;
+    int depth;
+    int frames_cap;
+    uintptr_t* open;            // conjunto de containers abertos (0 = vazio)
+    int open_len;
+    int open_cap;
+    PrintFrame inline_frames[NV_PRINT_INLINE_FRAMES];
+    uintptr_t inline_open[NV_PRINT_INLINE_SET];
+} Printer;
+
+static size_t ptr_hash(uintptr_t p, int cap) {
+    uint64_t x = (uint64_t)p * 0x9E3779B97F4A7C15ULL;
+    return (size_t)(x >> 32) & (size_t)(cap - 1);
+}
 
-static int is_visited(uintptr_t ptr) {
-    for (int i = 0; i < visited_count; ++i) {
-        if (visited[i] == ptr) return 1;
+static void open_insert_raw(uintptr_t* set, int cap, uintptr_t p) {
+    size_t i = ptr_hash(p, cap);
+    while (set[i]) i = (i + 1) & (size_t)(cap - 1);
+    set[i] = p;
+}
+
+static int open_contains(const Printer* pr, uintptr_t p) {
+    size_t i = ptr_hash(p, pr->open_cap);
+    while (pr->open[i]) {
+        if (pr->open[i] == p) return 1;
+        i = (i + 1) & (size_t)(pr->open_cap - 1);
     }
     return 0;
 }
 
-static void mark_visited(uintptr_t ptr) {
-    if (visited_count < MAX_VISITED) {
-        visited[visited_count++] = ptr;
+static void open_insert(Printer* pr, uintptr_t p) {
+    if ((pr->open_len + 1) * 2 > pr->open_cap) {
+        int cap = pr->open_cap * 2;
+        uintptr_t* set = (uintptr_t*)calloc((size_t)cap, sizeof(uintptr_t));
+        if (!set) {
+            fprintf(stderr, "FATAL: malloc failed in nv_write\n");
+            exit(1);
+        }
+        for (int i = 0; i < pr->open_cap; ++i) {
+            if (pr->open[i]) open_insert_raw(set, cap, pr->open[i]);
+        }
+        if (pr->open != pr->inline_open) free(pr->open);
+        pr->open = set;
+        pr->open_cap = cap;
+    }
+    open_insert_raw(pr->open, pr->open_cap, p);
+    pr->open_len++;
+}
+
+// Remoção com deslocamento para trás (mantém as sequências de sondagem sem lápides)
+static void open_remove(Printer* pr, uintptr_t p) {
+    size_t mask = (size_t)(pr->open_cap - 1);
+    size_t i = ptr_hash(p, pr->open_cap);
+    while (pr->open[i] != p) {
+        if (!pr->open[i]) return;
+        i = (i + 1) & mask;
+    }
+    pr->open[i] = 0;
+    pr->open_len--;
+    for (size_t j = (i + 1) & mask; pr->open[j]; j = (j + 1) & mask) {
+        size_t home = ptr_hash(pr->open[j], pr->open_cap);
+        // Move o item de j para o buraco em i se `home` não está em (i, j]
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            pr->open[i] = pr->open[j];
+            pr->open[j] = 0;
+            i = j;
+        }
     }
 }
 
-static void print_indent(int depth) {
-    for (int i = 0; i < depth; ++i) fputs("  ", stdout);
+static void printer_init(Printer* pr) {
+    pr->frames = pr->inline_frames;
+    pr->frames_cap = NV_PRINT_INLINE_FRAMES;
+    pr->depth = 0;
+    memset(pr->inline_open, 0, sizeof(pr->inline_open));
+    pr->open = pr->inline_open;
+    pr->open_cap = NV_PRINT_INLINE_SET;
+    pr->open_len = 0;
 }
 
-static void nv_print_value_recursive(Value v, int depth);
+static void printer_free(Printer* pr) {
+    if (pr->frames != pr->inline_frames) free(pr->frames);
+    if (pr->open != pr->inline_open) free(pr->open);
+}
 
 /* Normalize type tag based on prototype and type_info, with better type tracking */
 static inline Value normalize_value(Value v) {
     // Garantir tipo correto usando ensure_value_type
     ensure_value_type(&v);
-    
+
     // Normalizar baseado em prototype se necessário
     if (v.prototype == string_prototype && v.type != TAG_STR) v.type = TAG_STR;
     if (v.prototype == array_prototype  && v.type != TAG_ARRAY) v.type = TAG_ARRAY;
     if (v.prototype == vector_prototype && v.type != TAG_VECTOR) v.type = TAG_VECTOR;
     if (v.prototype == map_prototype    && v.type != TAG_MAP) v.type = TAG_MAP;
-    
+
     return v;
 }
 
-/* --- Imprime array --- */
-static void print_array(Array* a, int depth) {
-    if (!a) {
-        fputs("null", stdout);
-        return;
-    }
-
-    uintptr_t ptr = (uintptr_t)a;
-    if (is_visited(ptr)) {
-        fputs("<array[cycle]>", stdout);
-        return;
-    }
-    mark_visited(ptr);
-
-    fputs("{", stdout);
-    for (int i = 0; i < a->size; ++i) {
-        if (i > 0) fputs(", ", stdout);
-        if (depth < 3) {  // limite de profundidade
-            nv_print_value_recursive(a->elements[i], depth + 1);
-        } else {
-            fputs("...", stdout);
+static void print_string(const char* s, int depth) {
+    if (!s) {
+        nv_out_puts("(null)");
+    } else if (depth == 0) {
+        /* Top-level string: print raw, no quotes */
+        nv_out_puts(s);
+    } else {
+        /* Nested in container: print with quotes and escaping */
+        nv_out_puts("\"");
+        for (const char* p = s; *p; ++p) {
+            if (*p == '"') nv_out_puts("\\\"");
+            else if (*p == '\n') nv_out_puts("\\n");
+            else if (*p == '\t') nv_out_puts("\\t");
+            else if (*p >= 32 && *p <= 126) nv_out_putc(*p);
+            else nv_out_puts("?");
         }
+        nv_out_puts("\"");
     }
-    fputs("}", stdout);
 }
 
-/* --- Imprime vector --- */
-static void print_vector(Vector* vec, int depth) {
-    if (!vec) {
-        fputs("null", stdout);
-        return;
-    }
-
-    uintptr_t ptr = (uintptr_t)vec;
-    if (is_visited(ptr)) {
-        fputs("<vector[cycle]>", stdout);
-        return;
+static const char* frame_open(FrameKind kind) {
+    switch (kind) {
+        case FRAME_VECTOR: return "[";
+        case FRAME_TUPLE:  return "(";
+        default:           return "{";
     }
-    mark_visited(ptr);
-
-    fputs("[", stdout);
-    for (int i = 0; i < vec->size; ++i) {
-        if (i > 0) fputs(", ", stdout);
-        if (depth < 3) {
-            nv_print_value_recursive(vec->elements[i], depth + 1);
-        } else {
-            fputs("...", stdout);
-        }
-    }
-    fputs("]", stdout);
 }
 
-/* --- Imprime map --- */
-static void print_map(Map* m, int depth) {
-    if (!m) {
-        fputs("null", stdout);
-        return;
-    }
-
-    uintptr_t ptr = (uintptr_t)m;
-    if (is_visited(ptr)) {
-        fputs("<map[cycle]>", stdout);
-        return;
-    }
-    mark_visited(ptr);
-
-    fputs("{", stdout);
-    int first = 1;
-    for (int i = 0; i < m->size; ++i) {
-        if (!m->keys[i]) continue;
-        if (!first) fputs(", ", stdout);
-        first = 0;
-
-        char* key = m->keys[i];
-        fputs("\"", stdout);
-        fputs(key, stdout);
-        fputs("\": ", stdout);
-
-        if (depth < 3) {
-            nv_print_value_recursive(m->values[i], depth + 1);
-        } else {
-            fputs("...", stdout);
-        }
+static const char* frame_close(FrameKind kind) {
+    switch (kind) {
+        case FRAME_VECTOR: return "]";
+        case FRAME_TUPLE:  return ")";
+        default:           return "}";
     }
-    fputs("}", stdout);
 }
 
-/* --- Imprime tuple --- */
-static void print_tuple(Tuple* t, int depth) {
-    if (!t) {
-        fputs("null", stdout);
-        return;
+static const char* frame_cycle(FrameKind kind) {
+    switch (kind) {
+        case FRAME_ARRAY:  return "<array[cycle]>";
+        case FRAME_VECTOR: return "<vector[cycle]>";
+        case FRAME_MAP:    return "<map[cycle]>";
+        case FRAME_TUPLE:  return "<tuple[cycle]>";
+        default:           return "[cycle]>";
     }
-
-    uintptr_t ptr = (uintptr_t)t;
-    if (is_visited(ptr)) {
-        fputs("<tuple[cycle]>", stdout);
-        return;
-    }
-    mark_visited(ptr);
-
-    fputs("(", stdout);
-    for (int i = 0; i < t->field_count; ++i) {
-        if (i > 0) fputs(", ", stdout);
-        if (depth < 3) {
-            nv_print_value_recursive(t->fields[i], depth + 1);
-        } else {
-            fputs("...", stdout);
-        }
-    }
-    fputs(")", stdout);
 }
 
-/* --- Imprime tipo customizado struct-like --- */
-static void print_custom_struct(const Value* v, int depth) {
-    TypeInfo* info = get_value_type_info(v);
-    if (!info || !info->field_names || info->field_count == 0) {
-        fputs("<custom>", stdout);
+// Abre um container: marcador de ciclo/profundidade ou um novo frame na pilha
+static void push_container(Printer* pr, FrameKind kind, const void* ptr, const Value* items,
+                           char* const* keys, int count, const char* type_name) {
+    if (!ptr) {
+        nv_out_puts("null");
         return;
     }
-    
-    Value* fields = (Value*)(intptr_t)v->value;
-    if (!fields) {
-        fputs("null", stdout);
+    if (open_contains(pr, (uintptr_t)ptr)) {
+        if (kind == FRAME_STRUCT) {
+            nv_out_puts("<");
+            nv_out_puts(type_name);
+        }
+        nv_out_puts(frame_cycle(kind));
         return;
     }
-    
-    uintptr_t ptr = (uintptr_t)fields;
-    if (is_visited(ptr)) {
-        fprintf(stdout, "<%s[cycle]>", info->type_name);
+    if (kind == FRAME_STRUCT) nv_out_puts(type_name);
+    nv_out_puts(frame_open(kind));
+    if (print_max_depth > 0 && pr->depth >= print_max_depth) {
+        if (count > 0) nv_out_puts("...");
+        nv_out_puts(frame_close(kind));
         return;
     }
-    mark_visited(ptr);
-    
-    fprintf(stdout, "%s{", info->type_name);
-    int first = 1;
-    for (int i = 0; i < info->field_count; ++i) {
-        if (!first) fputs(", ", stdout);
-        first = 0;
-        
-        if (info->field_names[i]) {
-            fputs(info->field_names[i], stdout);
-            fputs(": ", stdout);
-        } else {
-            char buf[32];
-            snprintf(buf, sizeof(buf), "field%d", i);
-            fputs(buf, stdout);
-            fputs(": ", stdout);
-        }
-        
-        if (depth < 3) {
-            nv_print_value_recursive(fields[i], depth + 1);
-        } else {
-            fputs("...", stdout);
+
+    if (pr->depth == pr->frames_cap) {
+        int cap = pr->frames_cap * 2;
+        PrintFrame* frames = (PrintFrame*)malloc(sizeof(PrintFrame) * (size_t)cap);
+        if (!frames) {
+            fprintf(stderr, "FATAL: malloc failed in nv_write\n");
+            exit(1);
         }
+        memcpy(frames, pr->frames, sizeof(PrintFrame) * (size_t)pr->depth);
+        if (pr->frames != pr->inline_frames) free(pr->frames);
+        pr->frames = frames;
+        pr->frames_cap = cap;
     }
-    fputs("}", stdout);
+    open_insert(pr, (uintptr_t)ptr);
+    pr->frames[pr->depth++] = (PrintFrame){kind, (uintptr_t)ptr, items, keys, count, 0, 0};
 }
 
-/* --- Função principal recursiva com melhor rastreio de tipos --- */
-static void nv_print_value_recursive(Value v, int depth) {
+// Imprime escalares direto; containers viram frames (impressos pelo laço de print_value)
+static void emit_value(Printer* pr, Value v) {
     // IMPORTANTE: Preservar o tipo original antes de normalizar
     // Se o tipo já está definido como TAG_FLOAT, não permitir que seja alterado
     int32_t original_type = v.type;
-    
+
     // Normalizar e garantir tipo correto
     v = normalize_value(v);
-    
+
     // Garantir que o tipo está correto antes de imprimir
     ensure_value_type(&v);
-    
+
     // Obter tipo validado
     int32_t type = get_value_type(&v);
-    
+
     // IMPORTANTE: Se o tipo original era TAG_FLOAT, preservá-lo
     // Isso evita que ensure_value_type altere incorretamente o tipo
     if (original_type == TAG_FLOAT) {
         type = TAG_FLOAT;
         v.type = TAG_FLOAT;
     }
-    
+
     switch (type) {
         case TAG_INT: {
-            char buf[32];
-            snprintf(buf, sizeof(buf), "%ld", v.value);
-            fputs(buf, stdout);
-            break;
+            char buf[NV_FORMAT_BUFFER_SIZE];
+            nv_out_write(buf, (size_t)nv_format_int64(v.value, buf));
+            return;
         }
 
         case TAG_FLOAT: {
             double d;
             memcpy(&d, &v.value, sizeof(double));
-            char buf[64];
-            gcvt(d, 17, buf);
-            fputs(buf, stdout);
-            break;
+            char buf[NV_FORMAT_BUFFER_SIZE];
+            nv_out_write(buf, (size_t)nv_format_double(d, buf));
+            return;
         }
 
         case TAG_BOOL:
-            fputs(v.value ? "true" : "false", stdout);
-            break;
+            nv_out_puts(v.value ? "true" : "false");
+            return;
 
-        case TAG_STR: {
-            char* s = (char*)(intptr_t)v.value;
-            if (!s) {
-                fputs("(null)", stdout);
-            } else {
-                if (depth == 0) {
-                    /* Top-level string: print raw, no quotes */
-                    fputs(s, stdout);
-                } else {
-                    /* Nested in container: print with quotes and escaping */
-                    fputs("\"", stdout);
-                    for (char* p = s; *p; ++p) {
-                        if (*p == '"') fputs("\\\"", stdout);
-                        else if (*p == '\n') fputs("\\n", stdout);
-                        else if (*p == '\t') fputs("\\t", stdout);
-                        else if (*p >= 32 && *p <= 126) fputc(*p, stdout);
-                        else fputs("?", stdout);
-                    }
-                    fputs("\"", stdout);
-                }
-            }
-            break;
-        }
+        case TAG_STR:
+            print_string((const char*)(intptr_t)v.value, pr->depth);
+            return;
 
         case TAG_ARRAY: {
             Array* a = (Array*)(intptr_t)v.value;
-            print_array(a, depth);
-            break;
+            push_container(pr, FRAME_ARRAY, a, a ? a->elements : NULL, NULL, a ? a->size : 0, NULL);
+            return;
         }
 
         case TAG_VECTOR: {
             Vector* vec = (Vector*)(intptr_t)v.value;
-            print_vector(vec, depth);
-            break;
+            push_container(pr, FRAME_VECTOR, vec, vec ? vec->elements : NULL, NULL, vec ? vec->size : 0, NULL);
+            return;
         }
 
         case TAG_MAP: {
             Map* m = (Map*)(intptr_t)v.value;
-            print_map(m, depth);
-            break;
+            push_container(pr, FRAME_MAP, m, m ? m->values : NULL, m ? m->keys : NULL, m ? m->size : 0, NULL);
+            return;
         }
 
         case TAG_TUPLE: {
             Tuple* t = (Tuple*)(intptr_t)v.value;
-            print_tuple(t, depth);
-            break;
+            push_container(pr, FRAME_TUPLE, t, t ? t->fields : NULL, NULL, t ? t->field_count : 0, NULL);
+            return;
         }
 
         case TAG_CUSTOM:
@@ -311,55 +329,98 @@ static void nv_print_value_recursive(Value v, int depth) {
                 if (info) {
                     // Se tem printer customizado, usar
                     if (info->printer) {
+                        // Printers customizados escrevem via stdio: manter a ordem
+                        nv_out_flush();
                         info->printer(&v);
-                        break;
+                        fflush(stdout);
+                        return;
                     }
                     // Se é struct-like, imprimir como struct
                     if (info->field_names && info->field_count > 0) {
-                        print_custom_struct(&v, depth);
-                        break;
+                        Value* fields = (Value*)(intptr_t)v.value;
+                        push_container(pr, FRAME_STRUCT, fields, fields, info->field_names,
+                                       info->field_count, info->type_name);
+                        return;
                     }
                 }
                 // Fallback: imprimir nome do tipo
                 const char* type_name = get_type_name(type);
-                fprintf(stdout, "<%s>", type_name);
-                break;
+                nv_out_puts("<");
+                nv_out_puts(type_name);
+                nv_out_puts(">");
+                return;
             }
-            
+
             /* Last-chance: try prototype-based guess */
             if (v.prototype == string_prototype) {
-                char* s = (char*)(intptr_t)v.value;
-                if (!s) {
-                    fputs("(null)", stdout);
-                } else if (depth == 0) {
-                    /* Top-level string: print raw, no quotes */
-                    fputs(s, stdout);
-                } else {
-                    /* Nested in container: print with quotes and escaping */
-                    fputs("\"", stdout);
-                    for (char* p = s; *p; ++p) {
-                        if (*p == '"') fputs("\\\"", stdout);
-                        else if (*p == '\n') fputs("\\n", stdout);
-                        else if (*p == '\t') fputs("\\t", stdout);
-                        else if (*p >= 32 && *p <= 126) fputc(*p, stdout);
-                        else fputs("?", stdout);
-                    }
-                    fputs("\"", stdout);
-                }
-            } else if (v.prototype == array_prototype) {
-                print_array((Array*)(intptr_t)v.value, depth);
-            } else if (v.prototype == vector_prototype) {
-                print_vector((Vector*)(intptr_t)v.value, depth);
+                print_string((const char*)(intptr_t)v.value, pr->depth);
+            } else if (v.prototype == array_prototype || v.prototype == vector_prototype) {
+                // Array e Vector têm o mesmo layout
+                Vector* vec = (Vector*)(intptr_t)v.value;
+                push_container(pr, v.prototype == array_prototype ? FRAME_ARRAY : FRAME_VECTOR, vec,
+                               vec ? vec->elements : NULL, NULL, vec ? vec->size : 0, NULL);
             } else if (v.prototype == map_prototype) {
-                print_map((Map*)(intptr_t)v.value, depth);
+                Map* m = (Map*)(intptr_t)v.value;
+                push_container(pr, FRAME_MAP, m, m ? m->values : NULL, m ? m->keys : NULL, m ? m->size : 0, NULL);
             } else {
                 // Tipo desconhecido - mostrar informações de debug
                 const char* type_name = get_type_name(type);
-                fprintf(stdout, "<unknown:%s>", type_name);
+                nv_out_puts("<unknown:");
+                nv_out_puts(type_name);
+                nv_out_puts(">");
             }
-            break;
+            return;
+        }
+    }
+}
+
+static void print_value(Value v) {
+    load_print_limits();
+    Printer pr;
+    printer_init(&pr);
+    emit_value(&pr, v);
+
+    while (pr.depth > 0) {
+        PrintFrame* f = &pr.frames[pr.depth - 1];
+        // Chaves nulas de map são puladas
+        while (f->kind == FRAME_MAP && f->next < f->count && !f->keys[f->next]) f->next++;
+
+        if (f->next < f->count && (print_max_width == 0 || f->printed < print_max_width)) {
+            int i = f->next++;
+            if (f->printed++ > 0) nv_out_puts(", ");
+            if (f->kind == FRAME_MAP) {
+                nv_out_puts("\"");
+                nv_out_puts(f->keys[i]);
+                nv_out_puts("\": ");
+            } else if (f->kind == FRAME_STRUCT) {
+                if (f->keys[i]) {
+                    nv_out_puts(f->keys[i]);
+                } else {
+                    char buf[32];
+                    snprintf(buf, sizeof(buf), "field%d", i);
+                    nv_out_puts(buf);
+                }
+                nv_out_puts(": ");
+            }
+            // Pode empilhar um frame novo (f deixa de ser o topo)
+            emit_value(&pr, f->items[i]);
+            continue;
+        }
+
+        int rest = 0;
+        for (int i = f->next; i < f->count; ++i) {
+            if (f->kind != FRAME_MAP || f->keys[i]) rest++;
+        }
+        if (rest > 0) {
+            char buf[48];
+            snprintf(buf, sizeof(buf), "%s... (+%d more)", f->printed > 0 ? ", " : "", rest);
+            nv_out_puts(buf);
         }
+        nv_out_puts(frame_close(f->kind));
+        open_remove(&pr, f->ptr);
+        pr.depth--;
     }
+    printer_free(&pr);
 }
 
 /* ============================================================= */
@@ -368,27 +429,23 @@ static void nv_print_value_recursive(Value v, int depth) {
 
 __attribute__((force_align_arg_pointer))
 void nv_write(Value* v) {
-    visited_count = 0;  // reset a cada chamada
     if (v) {
         // Garantir tipo correto antes de imprimir
         ensure_value_type(v);
-        nv_print_value_recursive(*v, 0);
+        print_value(*v);
     } else {
-        fputs("null", stdout);
+        nv_out_puts("null");
     }
-    fputs("\n", stdout);
-    fflush(NULL); /* garante flush completo antes de _exit */
+    nv_out_newline();
 }
 
 __attribute__((force_align_arg_pointer))
 void nv_write_no_nl(Value* v) {
-    visited_count = 0;  // reset a cada chamada
     if (v) {
         // Garantir tipo correto antes de imprimir
         ensure_value_type(v);
-        nv_print_value_recursive(*v, 0);
+        print_value(*v);
     } else {
-        fputs("null", stdout);
+        nv_out_puts("null");
     }
-    fflush(NULL);
 }
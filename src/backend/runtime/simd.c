@@ -0,0 +1,730 @@
+#include "backend/runtime/nv_runtime.h"
+#include <pthread.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NV_SIMD_X86 1
+#endif
+
+/* ============================================================= */
+/*                    KERNELS SIMD (DESPACHO POR CPUID)          */
+/* ============================================================= */
+
+// Cada nível implementa a mesma tabela de kernels; o melhor suportado pela
+// CPU é escolhido uma única vez (NV_SIMD limita o nível: scalar, sse4.2,
+// avx2, avx512). Somas em ponto flutuante usam vários acumuladores, então
+// o arredondamento pode diferir da soma sequencial no último bit.
+
+typedef struct {
+    const char* name;
+    double (*sum_f64)(const double* x, int64_t n);
+    int64_t (*sum_i64)(const int64_t* x, int64_t n);
+    double (*dot_f64)(const double* a, const double* b, int64_t n);
+    double (*min_f64)(const double* x, int64_t n);
+    double (*max_f64)(const double* x, int64_t n);
+    void (*scale_f64)(double* out, const double* x, double k, int64_t n);
+    void (*add_f64)(double* out, const double* a, const double* b, int64_t n);
+    // Sobre o campo `value` de Values consecutivos (acesso com stride)
+    uint64_t (*sum_values)(const Value* e, int64_t n);
+    uint32_t (*dot_values)(const Value* a, const Value* b, int64_t n);
+    // Estágio 1 do parser JSON: máscaras de `nblocks` blocos de 64 bytes
+    void (*json_classify)(const uint8_t* data, size_t nblocks, NvJsonBlock* out);
+    // Separadores do loader CSV, mesmo formato de blocos
+    void (*csv_classify)(const uint8_t* data, size_t nblocks, uint8_t delim, NvCsvBlock* out);
+} SimdKernels;
+
+/* --- Escalar (referência e fallback) --- */
+
+static double sum_f64_scalar(const double* x, int64_t n) {
+    double s = 0.0;
+    for (int64_t i = 0; i < n; i++) s += x[i];
+    return s;
+}
+
+static int64_t sum_i64_scalar(const int64_t* x, int64_t n) {
+    uint64_t s = 0;
+    for (int64_t i = 0; i < n; i++) s += (uint64_t)x[i];
+    return (int64_t)s;
+}
+
+static double dot_f64_scalar(const double* a, const double* b, int64_t n) {
+    double s = 0.0;
+    for (int64_t i = 0; i < n; i++) s += a[i] * b[i];
+    return s;
+}
+
+static double min_f64_scalar(const double* x, int64_t n) {
+    double m = x[0];
+    for (int64_t i = 1; i < n; i++) if (x[i] < m) m = x[i];
+    return m;
+}
+
+static double max_f64_scalar(const double* x, int64_t n) {
+    double m = x[0];
+    for (int64_t i = 1; i < n; i++) if (x[i] > m) m = x[i];
+    return m;
+}
+
+static void scale_f64_scalar(double* out, const double* x, double k, int64_t n) {
+    for (int64_t i = 0; i < n; i++) out[i] = x[i] * k;
+}
+
+static void add_f64_scalar(double* out, const double* a, const double* b, int64_t n) {
+    for (int64_t i = 0; i < n; i++) out[i] = a[i] + b[i];
+}
+
+static uint64_t sum_values_scalar(const Value* e, int64_t n) {
+    uint64_t s = 0;
+    for (int64_t i = 0; i < n; i++) s += (uint64_t)e[i].value;
+    return s;
+}
+
+static uint32_t dot_values_scalar(const Value* a, const Value* b, int64_t n) {
+    uint32_t s = 0;
+    for (int64_t i = 0; i < n; i++) s += (uint32_t)a[i].value * (uint32_t)b[i].value;
+    return s;
+}
+
+static void json_classify_block_scalar(const uint8_t* block, NvJsonBlock* out) {
+    NvJsonBlock m = {0, 0, 0, 0, 0, 0};
+    for (int i = 0; i < 64; i++) {
+        uint64_t bit = 1ULL << i;
+        uint8_t ch = block[i];
+        switch (ch) {
+            case '"': m.quote |= bit; break;
+            case '\\': m.backslash |= bit; break;
+            case '{': case '}': case '[': case ']': case ':': case ',': m.op |= bit; break;
+            case ' ': case '\t': case '\n': case '\r': m.space |= bit; break;
+            default: break;
+        }
+        if (ch < 0x20) m.control |= bit;
+        if (ch >= 0x80) m.high |= bit;
+    }
+    *out = m;
+}
+
+static void json_classify_scalar(const uint8_t* data, size_t nblocks, NvJsonBlock* out) {
+    for (size_t b = 0; b < nblocks; b++) json_classify_block_scalar(data + 64 * b, out + b);
+}
+
+static void csv_classify_scalar(const uint8_t* data, size_t nblocks, uint8_t delim, NvCsvBlock* out) {
+    for (size_t b = 0; b < nblocks; b++) {
+        const uint8_t* block = data + 64 * b;
+        NvCsvBlock m = {0, 0, 0};
+        for (int i = 0; i < 64; i++) {
+            uint64_t bit = 1ULL << i;
+            if (block[i] == delim) m.delim |= bit;
+            if (block[i] == '\n') m.newline |= bit;
+            if (block[i] == '"') m.quote |= bit;
+        }
+        out[b] = m;
+    }
+}
+
+static const SimdKernels scalar_kernels = {
+    "scalar",
+    sum_f64_scalar, sum_i64_scalar, dot_f64_scalar, min_f64_scalar, max_f64_scalar,
+    scale_f64_scalar, add_f64_scalar, sum_values_scalar, dot_values_scalar,
+    json_classify_scalar, csv_classify_scalar
+};
+
+#ifdef NV_SIMD_X86
+
+// Endereço do campo `value` do i-ésimo Value (base das leituras com stride)
+#define VALUE_FIELD(e, i) ((const char*)(e) + (size_t)(i) * sizeof(Value) + offsetof(Value, value))
+
+/* --- SSE4.2: 2 lanes de 64 bits --- */
+
+__attribute__((target("sse4.2")))
+static double sum_f64_sse(const double* x, int64_t n) {
+    __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 = _mm_add_pd(s0, _mm_loadu_pd(x + i));
+        s1 = _mm_add_pd(s1, _mm_loadu_pd(x + i + 2));
+    }
+    s0 = _mm_add_pd(s0, s1);
+    double lanes[2];
+    _mm_storeu_pd(lanes, s0);
+    double s = lanes[0] + lanes[1];
+    for (; i < n; i++) s += x[i];
+    return s;
+}
+
+__attribute__((target("sse4.2")))
+static int64_t sum_i64_sse(const int64_t* x, int64_t n) {
+    __m128i s = _mm_setzero_si128();
+    int64_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        s = _mm_add_epi64(s, _mm_loadu_si128((const __m128i*)(x + i)));
+    }
+    uint64_t r = (uint64_t)_mm_extract_epi64(s, 0) + (uint64_t)_mm_extract_epi64(s, 1);
+    for (; i < n; i++) r += (uint64_t)x[i];
+    return (int64_t)r;
+}
+
+__attribute__((target("sse4.2")))
+static double dot_f64_sse(const double* a, const double* b, int64_t n) {
+    __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+    }
+    s0 = _mm_add_pd(s0, s1);
+    double lanes[2];
+    _mm_storeu_pd(lanes, s0);
+    double s = lanes[0] + lanes[1];
+    for (; i < n; i++) s += a[i] * b[i];
+    return s;
+}
+
+__attribute__((target("sse4.2")))
+static double min_f64_sse(const double* x, int64_t n) {
+    if (n < 2) return x[0];
+    __m128d m = _mm_loadu_pd(x);
+    int64_t i = 2;
+    for (; i + 2 <= n; i += 2) m = _mm_min_pd(m, _mm_loadu_pd(x + i));
+    double lanes[2];
+    _mm_storeu_pd(lanes, m);
+    double r = lanes[0] < lanes[1] ? lanes[0] : lanes[1];
+    for (; i < n; i++) if (x[i] < r) r = x[i];
+    return r;
+}
+
+__attribute__((target("sse4.2")))
+static double max_f64_sse(const double* x, int64_t n) {
+    if (n < 2) return x[0];
+    __m128d m = _mm_loadu_pd(x);
+    int64_t i = 2;
+    for (; i + 2 <= n; i += 2) m = _mm_max_pd(m, _mm_loadu_pd(x + i));
+    double lanes[2];
+    _mm_storeu_pd(lanes, m);
+    double r = lanes[0] > lanes[1] ? lanes[0] : lanes[1];
+    for (; i < n; i++) if (x[i] > r) r = x[i];
+    return r;
+}
+
+__attribute__((target("sse4.2")))
+static void scale_f64_sse(double* out, const double* x, double k, int64_t n) {
+    __m128d vk = _mm_set1_pd(k);
+    int64_t i = 0;
+    for (; i + 2 <= n; i += 2) _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(x + i), vk));
+    for (; i < n; i++) out[i] = x[i] * k;
+}
+
+__attribute__((target("sse4.2")))
+static void add_f64_sse(double* out, const double* a, const double* b, int64_t n) {
+    int64_t i = 0;
+    for (; i + 2 <= n; i += 2) _mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    for (; i < n; i++) out[i] = a[i] + b[i];
+}
+
+__attribute__((target("sse4.2")))
+static uint64_t sum_values_sse(const Value* e, int64_t n) {
+    __m128i s = _mm_setzero_si128();
+    int64_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        s = _mm_add_epi64(s, _mm_set_epi64x(e[i + 1].value, e[i].value));
+    }
+    uint64_t r = (uint64_t)_mm_extract_epi64(s, 0) + (uint64_t)_mm_extract_epi64(s, 1);
+    for (; i < n; i++) r += (uint64_t)e[i].value;
+    return r;
+}
+
+__attribute__((target("sse4.2")))
+static uint32_t dot_values_sse(const Value* a, const Value* b, int64_t n) {
+    // _mm_mul_epu32 multiplica os 32 bits baixos: exato módulo 2^32
+    __m128i s = _mm_setzero_si128();
+    int64_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128i va = _mm_set_epi64x(a[i + 1].value, a[i].value);
+        __m128i vb = _mm_set_epi64x(b[i + 1].value, b[i].value);
+        s = _mm_add_epi64(s, _mm_mul_epu32(va, vb));
+    }
+    uint32_t r = (uint32_t)_mm_extract_epi64(s, 0) + (uint32_t)_mm_extract_epi64(s, 1);
+    for (; i < n; i++) r += (uint32_t)a[i].value * (uint32_t)b[i].value;
+    return r;
+}
+
+// Operadores e espaços são classificados por duas consultas de 16 entradas
+// (nibble baixo e nibble alto, via pshufb): o byte pertence à classe quando
+// as duas entradas têm um bit em comum. Bits 0-2: , : []{}  bits 3-4: espaços
+#define JSON_LO_NIBBLE 0x08, 0, 0, 0, 0, 0, 0, 0, 0, 0x10, 0x12, 0x04, 0x01, 0x14, 0, 0
+#define JSON_HI_NIBBLE 0x10, 0, 0x09, 0x02, 0, 0x04, 0, 0x04, 0, 0, 0, 0, 0, 0, 0, 0
+#define JSON_OP_BITS 0x07
+#define JSON_SPACE_BITS 0x18
+
+// Máscara de 16 bits de um bloco de 16 bytes
+__attribute__((target("sse4.2")))
+static void json_classify16_sse(__m128i x, uint64_t shift, NvJsonBlock* m) {
+#define EQ(c) _mm_cmpeq_epi8(x, _mm_set1_epi8(c))
+    const __m128i lo_tbl = _mm_setr_epi8(JSON_LO_NIBBLE);
+    const __m128i hi_tbl = _mm_setr_epi8(JSON_HI_NIBBLE);
+    __m128i lo = _mm_and_si128(x, _mm_set1_epi8(0x0F));
+    __m128i hi = _mm_and_si128(_mm_srli_epi16(x, 4), _mm_set1_epi8(0x0F));
+    __m128i cls = _mm_and_si128(_mm_shuffle_epi8(lo_tbl, lo), _mm_shuffle_epi8(hi_tbl, hi));
+    __m128i zero = _mm_setzero_si128();
+    __m128i not_op = _mm_cmpeq_epi8(_mm_and_si128(cls, _mm_set1_epi8(JSON_OP_BITS)), zero);
+    __m128i not_ws = _mm_cmpeq_epi8(_mm_and_si128(cls, _mm_set1_epi8(JSON_SPACE_BITS)), zero);
+    // x <= 0x1F sem sinal
+    __m128i ctl = _mm_cmpeq_epi8(_mm_max_epu8(x, _mm_set1_epi8(0x1F)), _mm_set1_epi8(0x1F));
+    m->quote     |= (uint64_t)(uint16_t)_mm_movemask_epi8(EQ('"')) << shift;
+    m->backslash |= (uint64_t)(uint16_t)_mm_movemask_epi8(EQ('\\')) << shift;
+    m->op        |= (uint64_t)(uint16_t)~_mm_movemask_epi8(not_op) << shift;
+    m->space     |= (uint64_t)(uint16_t)~_mm_movemask_epi8(not_ws) << shift;
+    m->control   |= (uint64_t)(uint16_t)_mm_movemask_epi8(ctl) << shift;
+    m->high      |= (uint64_t)(uint16_t)_mm_movemask_epi8(x) << shift;
+#undef EQ
+}
+
+__attribute__((target("sse4.2")))
+static void json_classify_sse(const uint8_t* data, size_t nblocks, NvJsonBlock* out) {
+    for (size_t b = 0; b < nblocks; b++) {
+        const uint8_t* block = data + 64 * b;
+        NvJsonBlock m = {0, 0, 0, 0, 0, 0};
+        for (int i = 0; i < 4; i++) {
+            json_classify16_sse(_mm_loadu_si128((const __m128i*)(block + 16 * i)), (uint64_t)(16 * i), &m);
+        }
+        out[b] = m;
+    }
+}
+
+__attribute__((target("sse4.2")))
+static void csv_classify_sse(const uint8_t* data, size_t nblocks, uint8_t delim, NvCsvBlock* out) {
+    const __m128i d = _mm_set1_epi8((char)delim);
+    const __m128i nl = _mm_set1_epi8('\n');
+    const __m128i q = _mm_set1_epi8('"');
+    for (size_t b = 0; b < nblocks; b++) {
+        const uint8_t* block = data + 64 * b;
+        NvCsvBlock m = {0, 0, 0};
+        for (int i = 0; i < 4; i++) {
+            __m128i x = _mm_loadu_si128((const __m128i*)(block + 16 * i));
+            m.delim   |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, d)) << (16 * i);
+            m.newline |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, nl)) << (16 * i);
+            m.quote   |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, q)) << (16 * i);
+        }
+        out[b] = m;
+    }
+}
+
+static const SimdKernels sse_kernels = {
+    "sse4.2",
+    sum_f64_sse, sum_i64_sse, dot_f64_sse, min_f64_sse, max_f64_sse,
+    scale_f64_sse, add_f64_sse, sum_values_sse, dot_values_sse,
+    json_classify_sse, csv_classify_sse
+};
+
+/* --- AVX2: 4 lanes de 64 bits, gather para Values --- */
+
+__attribute__((target("avx2")))
+static double hsum256_pd(__m256d v) {
+    __m128d lo = _mm256_castpd256_pd128(v);
+    __m128d hi = _mm256_extractf128_pd(v, 1);
+    lo = _mm_add_pd(lo, hi);
+    return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+}
+
+__attribute__((target("avx2")))
+static uint64_t hsum256_epi64(__m256i v) {
+    __m128i s = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    return (uint64_t)_mm_extract_epi64(s, 0) + (uint64_t)_mm_extract_epi64(s, 1);
+}
+
+__attribute__((target("avx2")))
+static double sum_f64_avx2(const double* x, int64_t n) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        s0 = _mm256_add_pd(s0, _mm256_loadu_pd(x + i));
+        s1 = _mm256_add_pd(s1, _mm256_loadu_pd(x + i + 4));
+    }
+    double s = hsum256_pd(_mm256_add_pd(s0, s1));
+    for (; i < n; i++) s += x[i];
+    return s;
+}
+
+__attribute__((target("avx2")))
+static int64_t sum_i64_avx2(const int64_t* x, int64_t n) {
+    __m256i s = _mm256_setzero_si256();
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s = _mm256_add_epi64(s, _mm256_loadu_si256((const __m256i*)(x + i)));
+    }
+    uint64_t r = hsum256_epi64(s);
+    for (; i < n; i++) r += (uint64_t)x[i];
+    return (int64_t)r;
+}
+
+__attribute__((target("avx2")))
+static double dot_f64_avx2(const double* a, const double* b, int64_t n) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        s0 = _mm256_add_pd(s0, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        s1 = _mm256_add_pd(s1, _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+    }
+    double s = hsum256_pd(_mm256_add_pd(s0, s1));
+    for (; i < n; i++) s += a[i] * b[i];
+    return s;
+}
+
+__attribute__((target("avx2")))
+static double min_f64_avx2(const double* x, int64_t n) {
+    if (n < 4) return min_f64_scalar(x, n);
+    __m256d m = _mm256_loadu_pd(x);
+    int64_t i = 4;
+    for (; i + 4 <= n; i += 4) m = _mm256_min_pd(m, _mm256_loadu_pd(x + i));
+    double lanes[4];
+    _mm256_storeu_pd(lanes, m);
+    double r = min_f64_scalar(lanes, 4);
+    for (; i < n; i++) if (x[i] < r) r = x[i];
+    return r;
+}
+
+__attribute__((target("avx2")))
+static double max_f64_avx2(const double* x, int64_t n) {
+    if (n < 4) return max_f64_scalar(x, n);
+    __m256d m = _mm256_loadu_pd(x);
+    int64_t i = 4;
+    for (; i + 4 <= n; i += 4) m = _mm256_max_pd(m, _mm256_loadu_pd(x + i));
+    double lanes[4];
+    _mm256_storeu_pd(lanes, m);
+    double r = max_f64_scalar(lanes, 4);
+    for (; i < n; i++) if (x[i] > r) r = x[i];
+    return r;
+}
+
+__attribute__((target("avx2")))
+static void scale_f64_avx2(double* out, const double* x, double k, int64_t n) {
+    __m256d vk = _mm256_set1_pd(k);
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(x + i), vk));
+    for (; i < n; i++) out[i] = x[i] * k;
+}
+
+__attribute__((target("avx2")))
+static void add_f64_avx2(double* out, const double* a, const double* b, int64_t n) {
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    for (; i < n; i++) out[i] = a[i] + b[i];
+}
+
+__attribute__((target("avx2")))
+static uint64_t sum_values_avx2(const Value* e, int64_t n) {
+    const long long S = (long long)sizeof(Value);
+    const __m256i offsets = _mm256_set_epi64x(3 * S, 2 * S, S, 0);
+    __m256i s = _mm256_setzero_si256();
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s = _mm256_add_epi64(s, _mm256_i64gather_epi64((const long long*)VALUE_FIELD(e, i), offsets, 1));
+    }
+    uint64_t r = hsum256_epi64(s);
+    for (; i < n; i++) r += (uint64_t)e[i].value;
+    return r;
+}
+
+__attribute__((target("avx2")))
+static uint32_t dot_values_avx2(const Value* a, const Value* b, int64_t n) {
+    const long long S = (long long)sizeof(Value);
+    const __m256i offsets = _mm256_set_epi64x(3 * S, 2 * S, S, 0);
+    __m256i s = _mm256_setzero_si256();
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i va = _mm256_i64gather_epi64((const long long*)VALUE_FIELD(a, i), offsets, 1);
+        __m256i vb = _mm256_i64gather_epi64((const long long*)VALUE_FIELD(b, i), offsets, 1);
+        s = _mm256_add_epi64(s, _mm256_mul_epu32(va, vb));
+    }
+    uint32_t r = (uint32_t)hsum256_epi64(s);
+    for (; i < n; i++) r += (uint32_t)a[i].value * (uint32_t)b[i].value;
+    return r;
+}
+
+__attribute__((target("avx2")))
+static void json_classify32_avx2(__m256i x, uint64_t shift, NvJsonBlock* m) {
+#define EQ(c) _mm256_cmpeq_epi8(x, _mm256_set1_epi8(c))
+    const __m256i lo_tbl = _mm256_setr_epi8(JSON_LO_NIBBLE, JSON_LO_NIBBLE);
+    const __m256i hi_tbl = _mm256_setr_epi8(JSON_HI_NIBBLE, JSON_HI_NIBBLE);
+    __m256i lo = _mm256_and_si256(x, _mm256_set1_epi8(0x0F));
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), _mm256_set1_epi8(0x0F));
+    __m256i cls = _mm256_and_si256(_mm256_shuffle_epi8(lo_tbl, lo), _mm256_shuffle_epi8(hi_tbl, hi));
+    __m256i zero = _mm256_setzero_si256();
+    __m256i not_op = _mm256_cmpeq_epi8(_mm256_and_si256(cls, _mm256_set1_epi8(JSON_OP_BITS)), zero);
+    __m256i not_ws = _mm256_cmpeq_epi8(_mm256_and_si256(cls, _mm256_set1_epi8(JSON_SPACE_BITS)), zero);
+    __m256i ctl = _mm256_cmpeq_epi8(_mm256_max_epu8(x, _mm256_set1_epi8(0x1F)), _mm256_set1_epi8(0x1F));
+    m->quote     |= (uint64_t)(uint32_t)_mm256_movemask_epi8(EQ('"')) << shift;
+    m->backslash |= (uint64_t)(uint32_t)_mm256_movemask_epi8(EQ('\\')) << shift;
+    m->op        |= (uint64_t)(uint32_t)~_mm256_movemask_epi8(not_op) << shift;
+    m->space     |= (uint64_t)(uint32_t)~_mm256_movemask_epi8(not_ws) << shift;
+    m->control   |= (uint64_t)(uint32_t)_mm256_movemask_epi8(ctl) << shift;
+    m->high      |= (uint64_t)(uint32_t)_mm256_movemask_epi8(x) << shift;
+#undef EQ
+}
+
+__attribute__((target("avx2")))
+static void json_classify_avx2(const uint8_t* data, size_t nblocks, NvJsonBlock* out) {
+    for (size_t b = 0; b < nblocks; b++) {
+        const uint8_t* block = data + 64 * b;
+        NvJsonBlock m = {0, 0, 0, 0, 0, 0};
+        json_classify32_avx2(_mm256_loadu_si256((const __m256i*)block), 0, &m);
+        json_classify32_avx2(_mm256_loadu_si256((const __m256i*)(block + 32)), 32, &m);
+        out[b] = m;
+    }
+}
+
+__attribute__((target("avx2")))
+static void csv_classify_avx2(const uint8_t* data, size_t nblocks, uint8_t delim, NvCsvBlock* out) {
+    const __m256i d = _mm256_set1_epi8((char)delim);
+    const __m256i nl = _mm256_set1_epi8('\n');
+    const __m256i q = _mm256_set1_epi8('"');
+    for (size_t b = 0; b < nblocks; b++) {
+        const uint8_t* block = data + 64 * b;
+        __m256i lo = _mm256_loadu_si256((const __m256i*)block);
+        __m256i hi = _mm256_loadu_si256((const __m256i*)(block + 32));
+#define MASK64(v) ((uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, v)) | \
+                   ((uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, v)) << 32))
+        out[b].delim = MASK64(d);
+        out[b].newline = MASK64(nl);
+        out[b].quote = MASK64(q);
+#undef MASK64
+    }
+}
+
+static const SimdKernels avx2_kernels = {
+    "avx2",
+    sum_f64_avx2, sum_i64_avx2, dot_f64_avx2, min_f64_avx2, max_f64_avx2,
+    scale_f64_avx2, add_f64_avx2, sum_values_avx2, dot_values_avx2,
+    json_classify_avx2, csv_classify_avx2
+};
+
+/* --- AVX-512F: 8 lanes de 64 bits --- */
+
+__attribute__((target("avx512f")))
+static double sum_f64_avx512(const double* x, int64_t n) {
+    __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+    int64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        s0 = _mm512_add_pd(s0, _mm512_loadu_pd(x + i));
+        s1 = _mm512_add_pd(s1, _mm512_loadu_pd(x + i + 8));
+    }
+    double s = _mm512_reduce_add_pd(_mm512_add_pd(s0, s1));
+    for (; i < n; i++) s += x[i];
+    return s;
+}
+
+__attribute__((target("avx512f")))
+static int64_t sum_i64_avx512(const int64_t* x, int64_t n) {
+    __m512i s = _mm512_setzero_si512();
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) s = _mm512_add_epi64(s, _mm512_loadu_si512((const void*)(x + i)));
+    uint64_t r = (uint64_t)_mm512_reduce_add_epi64(s);
+    for (; i < n; i++) r += (uint64_t)x[i];
+    return (int64_t)r;
+}
+
+__attribute__((target("avx512f")))
+static double dot_f64_avx512(const double* a, const double* b, int64_t n) {
+    __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+    int64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        s0 = _mm512_add_pd(s0, _mm512_mul_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+        s1 = _mm512_add_pd(s1, _mm512_mul_pd(_mm512_loadu_pd(a + i + 8), _mm512_loadu_pd(b + i + 8)));
+    }
+    double s = _mm512_reduce_add_pd(_mm512_add_pd(s0, s1));
+    for (; i < n; i++) s += a[i] * b[i];
+    return s;
+}
+
+__attribute__((target("avx512f")))
+static double min_f64_avx512(const double* x, int64_t n) {
+    if (n < 8) return min_f64_scalar(x, n);
+    __m512d m = _mm512_loadu_pd(x);
+    int64_t i = 8;
+    for (; i + 8 <= n; i += 8) m = _mm512_min_pd(m, _mm512_loadu_pd(x + i));
+    double r = _mm512_reduce_min_pd(m);
+    for (; i < n; i++) if (x[i] < r) r = x[i];
+    return r;
+}
+
+__attribute__((target("avx512f")))
+static double max_f64_avx512(const double* x, int64_t n) {
+    if (n < 8) return max_f64_scalar(x, n);
+    __m512d m = _mm512_loadu_pd(x);
+    int64_t i = 8;
+    for (; i + 8 <= n; i += 8) m = _mm512_max_pd(m, _mm512_loadu_pd(x + i));
+    double r = _mm512_reduce_max_pd(m);
+    for (; i < n; i++) if (x[i] > r) r = x[i];
+    return r;
+}
+
+__attribute__((target("avx512f")))
+static void scale_f64_avx512(double* out, const double* x, double k, int64_t n) {
+    __m512d vk = _mm512_set1_pd(k);
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) _mm512_storeu_pd(out + i, _mm512_mul_pd(_mm512_loadu_pd(x + i), vk));
+    for (; i < n; i++) out[i] = x[i] * k;
+}
+
+__attribute__((target("avx512f")))
+static void add_f64_avx512(double* out, const double* a, const double* b, int64_t n) {
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) _mm512_storeu_pd(out + i, _mm512_add_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+    for (; i < n; i++) out[i] = a[i] + b[i];
+}
+
+__attribute__((target("avx512f")))
+static uint64_t sum_values_avx512(const Value* e, int64_t n) {
+    const long long S = (long long)sizeof(Value);
+    const __m512i offsets = _mm512_set_epi64(7 * S, 6 * S, 5 * S, 4 * S, 3 * S, 2 * S, S, 0);
+    __m512i s = _mm512_setzero_si512();
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        s = _mm512_add_epi64(s, _mm512_i64gather_epi64(offsets, (const void*)VALUE_FIELD(e, i), 1));
+    }
+    uint64_t r = (uint64_t)_mm512_reduce_add_epi64(s);
+    for (; i < n; i++) r += (uint64_t)e[i].value;
+    return r;
+}
+
+__attribute__((target("avx512f")))
+static uint32_t dot_values_avx512(const Value* a, const Value* b, int64_t n) {
+    const long long S = (long long)sizeof(Value);
+    const __m512i offsets = _mm512_set_epi64(7 * S, 6 * S, 5 * S, 4 * S, 3 * S, 2 * S, S, 0);
+    __m512i s = _mm512_setzero_si512();
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i va = _mm512_i64gather_epi64(offsets, (const void*)VALUE_FIELD(a, i), 1);
+        __m512i vb = _mm512_i64gather_epi64(offsets, (const void*)VALUE_FIELD(b, i), 1);
+        s = _mm512_add_epi64(s, _mm512_mul_epu32(va, vb));
+    }
+    uint32_t r = (uint32_t)_mm512_reduce_add_epi64(s);
+    for (; i < n; i++) r += (uint32_t)a[i].value * (uint32_t)b[i].value;
+    return r;
+}
+
+static const SimdKernels avx512_kernels = {
+    "avx512",
+    sum_f64_avx512, sum_i64_avx512, dot_f64_avx512, min_f64_avx512, max_f64_avx512,
+    scale_f64_avx512, add_f64_avx512, sum_values_avx512, dot_values_avx512,
+    // Comparações de bytes exigiriam AVX-512BW; AVX-512F implica AVX2
+    json_classify_avx2, csv_classify_avx2
+};
+
+#endif /* NV_SIMD_X86 */
+
+/* --- Despacho --- */
+
+static const SimdKernels* active_kernels = &scalar_kernels;
+static pthread_once_t simd_once = PTHREAD_ONCE_INIT;
+
+static void simd_init(void) {
+#ifdef NV_SIMD_X86
+    // NV_SIMD define o nível máximo permitido (útil para comparar kernels)
+    int cap = 3;
+    const char* env = getenv("NV_SIMD");
+    if (env && *env) {
+        if (strcmp(env, "scalar") == 0) cap = 0;
+        else if (strcmp(env, "sse4.2") == 0) cap = 1;
+        else if (strcmp(env, "avx2") == 0) cap = 2;
+    }
+    __builtin_cpu_init();
+    if (cap >= 3 && __builtin_cpu_supports("avx512f")) {
+        active_kernels = &avx512_kernels;
+    } else if (cap >= 2 && __builtin_cpu_supports("avx2")) {
+        active_kernels = &avx2_kernels;
+    } else if (cap >= 1 && __builtin_cpu_supports("sse4.2")) {
+        active_kernels = &sse_kernels;
+    }
+#endif
+}
+
+static const SimdKernels* kernels(void) {
+    pthread_once(&simd_once, simd_init);
+    return active_kernels;
+}
+
+const char* nv_simd_level(void) {
+    return kernels()->name;
+}
+
+double nv_simd_sum_f64(const double* x, int64_t n) {
+    return n > 0 ? kernels()->sum_f64(x, n) : 0.0;
+}
+
+void nv_simd_json_classify(const uint8_t* data, size_t nblocks, NvJsonBlock* out) {
+    kernels()->json_classify(data, nblocks, out);
+}
+
+void nv_simd_csv_classify(const uint8_t* data, size_t nblocks, uint8_t delim, NvCsvBlock* out) {
+    kernels()->csv_classify(data, nblocks, delim, out);
+}
+
+int64_t nv_simd_sum_i64(const int64_t* x, int64_t n) {
+    return n > 0 ? kernels()->sum_i64(x, n) : 0;
+}
+
+double nv_simd_dot_f64(const double* a, const double* b, int64_t n) {
+    return n > 0 ? kernels()->dot_f64(a, b, n) : 0.0;
+}
+
+double nv_simd_min_f64(const double* x, int64_t n) {
+    return n > 0 ? kernels()->min_f64(x, n) : 0.0;
+}
+
+double nv_simd_max_f64(const double* x, int64_t n) {
+    return n > 0 ? kernels()->max_f64(x, n) : 0.0;
+}
+
+void nv_simd_scale_f64(double* out, const double* x, double k, int64_t n) {
+    if (n > 0) kernels()->scale_f64(out, x, k, n);
+}
+
+void nv_simd_add_f64(double* out, const double* a, const double* b, int64_t n) {
+    if (n > 0) kernels()->add_f64(out, a, b, n);
+}
+
+/* --- Reduções sobre arrays/vectors de Values --- */
+
+// Elementos de um array/vector; índices fora do intervalo valem 0, como em array_get_index_v
+static int simd_elements(Value* self, Value** elements, int* size) {
+    if (!self) return 0;
+    if (self->type == TAG_ARRAY) {
+        Array* arr = (Array*)(intptr_t)self->value;
+        if (!arr) return 0;
+        *elements = arr->elements;
+        *size = arr->size;
+        return 1;
+    }
+    if (self->type == TAG_VECTOR) {
+        Vector* vec = (Vector*)(intptr_t)self->value;
+        if (!vec) return 0;
+        *elements = vec->elements;
+        *size = vec->size;
+        return 1;
+    }
+    return 0;
+}
+
+int32_t nv_simd_sum_values(Value* self, int32_t lo, int32_t hi) {
+    Value* e;
+    int n;
+    if (!simd_elements(self, &e, &n)) return 0;
+    if (lo < 0) lo = 0;
+    if (hi > n) hi = n;
+    if (hi <= lo) return 0;
+    return (int32_t)(uint32_t)kernels()->sum_values(e + lo, (int64_t)hi - lo);
+}
+
+int32_t nv_simd_dot_values(Value* a, Value* b, int32_t lo, int32_t hi) {
+    Value *ea, *eb;
+    int na, nb;
+    if (!simd_elements(a, &ea, &na) || !simd_elements(b, &eb, &nb)) return 0;
+    if (lo < 0) lo = 0;
+    if (hi > na) hi = na;
+    if (hi > nb) hi = nb;
+    if (hi <= lo) return 0;
+    return (int32_t)kernels()->dot_values(ea + lo, eb + lo, (int64_t)hi - lo);
+}
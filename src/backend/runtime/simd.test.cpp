@@ -0,0 +1,147 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+#include "test_support.hpp"
+
+extern "C" {
+#include "backend/runtime/prototypes.h"
+#include "backend/runtime/nv_runtime.h"
+}
+
+using namespace nv::test;
+
+namespace {
+    // Valores inteiros e meios: somas e produtos são exatos em double, então
+    // qualquer ordem de acumulação dá o mesmo resultado que o loop escalar
+    double sample(int i, int salt) {
+        return ((i * 37 + salt) % 101) - 50 + ((i + salt) % 2 ? 0.5 : 0.0);
+    }
+
+    // Todos os tamanhos até alguns vetores de 512 bits, com e sem alinhamento
+    void test_f64() {
+        bool sum = true, dot = true, min = true, max = true, scale = true, add = true, i64 = true;
+        for (int offset = 0; offset < 2; offset++) {
+            for (int n = 0; n <= 70; n++) {
+                std::vector<double> abuf(n + 1), bbuf(n + 1), out(n + 1);
+                std::vector<int64_t> qbuf(n + 1);
+                double* a = abuf.data() + offset;
+                double* b = bbuf.data() + offset;
+                int64_t* q = qbuf.data() + offset;
+                for (int i = 0; i < n; i++) {
+                    a[i] = sample(i, n);
+                    b[i] = sample(i, 7 * n + 3);
+                    q[i] = (static_cast<int64_t>(i) - 30) * 1000000007LL;
+                }
+
+                double s = 0, d = 0, lo = n ? a[0] : 0, hi = n ? a[0] : 0;
+                int64_t qs = 0;
+                for (int i = 0; i < n; i++) {
+                    s += a[i];
+                    d += a[i] * b[i];
+                    lo = a[i] < lo ? a[i] : lo;
+                    hi = a[i] > hi ? a[i] : hi;
+                    qs += q[i];
+                }
+                sum &= nv_simd_sum_f64(a, n) == s;
+                dot &= nv_simd_dot_f64(a, b, n) == d;
+                min &= nv_simd_min_f64(a, n) == lo;
+                max &= nv_simd_max_f64(a, n) == hi;
+                i64 &= nv_simd_sum_i64(q, n) == qs;
+
+                nv_simd_scale_f64(out.data() + offset, a, -2.5, n);
+                for (int i = 0; i < n; i++) scale &= out[i + offset] == a[i] * -2.5;
+                nv_simd_add_f64(out.data() + offset, a, b, n);
+                for (int i = 0; i < n; i++) add &= out[i + offset] == a[i] + b[i];
+            }
+        }
+        check(sum, "sum f64");
+        check(i64, "sum i64");
+        check(dot, "dot f64");
+        check(min && max, "min/max f64");
+        check(scale, "scale f64");
+        check(add, "add f64 (elemento a elemento)");
+    }
+
+    Value int_vector(int n, int64_t mul, int64_t add) {
+        Value vec;
+        create_vector(&vec, 0);
+        for (int i = 0; i < n; i++) {
+            Value v;
+            create_int(&v, static_cast<int32_t>(i * mul + add));
+            vector_push_impl((Vector*)(intptr_t)vec.value, v);
+        }
+        return vec;
+    }
+
+    // Reduções geradas pelo compilador: soma e produto módulo 2^32, como o loop em i32
+    void test_values() {
+        const int n = 203;
+        Value a = int_vector(n, 48271, -7);
+        Value b = int_vector(n, 104729, 11);
+        Value* ea = ((Vector*)(intptr_t)a.value)->elements;
+        Value* eb = ((Vector*)(intptr_t)b.value)->elements;
+
+        bool sum = true, dot = true;
+        for (int lo = 0; lo < 9; lo++) {
+            for (int hi = lo; hi <= n; hi += (hi < 40 ? 1 : 17)) {
+                uint32_t s = 0, d = 0;
+                for (int i = lo; i < hi; i++) {
+                    s += static_cast<uint32_t>(ea[i].value);
+                    d += static_cast<uint32_t>(ea[i].value) * static_cast<uint32_t>(eb[i].value);
+                }
+                sum &= nv_simd_sum_values(&a, lo, hi) == static_cast<int32_t>(s);
+                dot &= nv_simd_dot_values(&a, &b, lo, hi) == static_cast<int32_t>(d);
+            }
+        }
+        check(sum, "sum de Values int (com overflow em i32)");
+        check(dot, "dot de Values int (com overflow em i32)");
+
+        uint32_t all = 0;
+        for (int i = 0; i < n; i++) all += static_cast<uint32_t>(ea[i].value);
+        Value arr;
+        create_array(&arr, n);
+        for (int i = 0; i < n; i++) ((Array*)(intptr_t)arr.value)->elements[i] = ea[i];
+        Value number;
+        create_int(&number, 5);
+        check(nv_simd_sum_values(&a, -10, n + 10) == static_cast<int32_t>(all) &&
+              nv_simd_sum_values(&arr, 0, n) == static_cast<int32_t>(all) &&
+              nv_simd_sum_values(&a, 50, 10) == 0 && nv_simd_sum_values(&number, 0, 1) == 0,
+              "intervalo limitado ao tamanho, arrays e valores que não são containers");
+    }
+
+    void run_level(const char* level) {
+        std::cout << "nível " << nv_simd_level() << " (NV_SIMD=" << level << ")\n";
+        test_f64();
+        test_values();
+    }
+}
+
+int main() {
+    std::cout << "Iniciando teste dos kernels SIMD...\n";
+    // O nível é escolhido uma vez por processo: cada um roda em um filho
+    int failed_levels = 0;
+    for (const char* level : {"scalar", "sse4.2", "avx2", "avx512"}) {
+        std::cout.flush();
+        pid_t pid = fork();
+        if (pid == 0) {
+            setenv("NV_SIMD", level, 1);
+            run_level(level);
+            std::cout.flush();
+            _exit(failures > 0 ? 1 : 0);
+        }
+        int status = 0;
+        if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            failed_levels++;
+        }
+    }
+
+    if (failed_levels > 0) {
+        std::cerr << "\n" << failed_levels << " nível(is) com falhas.\n";
+        return 1;
+    }
+    std::cout << "\nTeste dos kernels SIMD concluído com sucesso.\n";
+    return 0;
+}
@@ -58,7 +58,7 @@ int32_t register_custom_type(TypeInfo* type_info) {
 
 // Obter informações de um tipo por ID
 TypeInfo* get_type_info(int32_t type_id) {
-    if (type_id < TAG_INT || type_id > TAG_CUSTOM) {
+    if (type_id < TAG_INT) {
         return NULL;
     }
     
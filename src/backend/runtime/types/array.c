@@ -55,6 +55,12 @@ void array_set_index(Array* arr, int index, Value value) {
     }
 }
 
+void array_set_reserved(Array* arr, int index, Value value) {
+    if (index >= 0 && index < arr->capacity) {
+        arr->elements[index] = value_clone(value);
+    }
+}
+
 void array_get_index_v(Value* out, Value* self, int index) {
     if (!out) return;
     if (!self) { out->type = 0; out->value = 0; out->prototype = NULL; return; }
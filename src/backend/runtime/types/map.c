@@ -52,7 +52,7 @@ Value map_get_impl(Map* m, const char* key) {
     return (Value){0};
 }
 
-void map_set_impl(Map* m, const char* key, Value val) {
+static void map_put(Map* m, const char* key, Value val, int copy_key) {
     for (int i = 0; i < m->size; ++i) {
         if (strcmp(m->keys[i], key) == 0) {
             m->values[i] = val;
@@ -64,7 +64,15 @@ void map_set_impl(Map* m, const char* key, Value val) {
         m->keys = (char**)realloc(m->keys, sizeof(char*) * m->capacity);
         m->values = (Value*)realloc(m->values, sizeof(Value) * m->capacity);
     }
-    m->keys[m->size] = strdup(key);
+    m->keys[m->size] = copy_key ? strdup(key) : (char*)key;
     m->values[m->size] = val;
     ++m->size;
-}
\ No newline at end of file
+}
+
+void map_set_impl(Map* m, const char* key, Value val) {
+    map_put(m, key, val, 1);
+}
+
+void map_set_borrowed(Map* m, const char* key, Value val) {
+    map_put(m, key, val, 0);
+}
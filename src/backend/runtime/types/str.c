@@ -26,6 +26,14 @@ void create_str(Value* out, const char* s) {
     out->flags = 0;
 }
 
+void create_str_borrowed(Value* out, const char* s) {
+    out->type = TAG_STR;
+    out->value = (int64_t)(intptr_t)(s ? s : "");
+    out->prototype = string_prototype;
+    out->type_info = NULL;
+    out->flags = 0;
+}
+
 void string_to_upper_case(Value* out, Value* self) {
     char* src = (char*)(intptr_t)self->value;
     size_t len = strlen(src);
@@ -0,0 +1,502 @@
+#include "backend/runtime/nv_runtime.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================= */
+/*          MÉTODOS DATA-PARALLEL DE VECTOR (map/filter/...)     */
+/* ============================================================= */
+
+// Os métodos aceitam vector e array. A divisão em chunks vem de
+// nv_parallel_chunks: entradas pequenas rodam em um único chunk, na
+// thread chamadora; entradas grandes viram blocos de alguns milhares de
+// Values (cabem na L2) distribuídos pelo pool de threads.
+
+static int value_elements(Value* self, Value** elements, int* size) {
+    if (!self) return 0;
+    if (self->type == TAG_VECTOR) {
+        Vector* vec = (Vector*)(intptr_t)self->value;
+        if (!vec) return 0;
+        *elements = vec->elements;
+        *size = vec->size;
+        return 1;
+    }
+    if (self->type == TAG_ARRAY) {
+        Array* arr = (Array*)(intptr_t)self->value;
+        if (!arr) return 0;
+        *elements = arr->elements;
+        *size = arr->size;
+        return 1;
+    }
+    return 0;
+}
+
+static void set_null(Value* out) {
+    out->type = 0;
+    out->value = 0;
+    out->prototype = NULL;
+    out->type_info = NULL;
+    out->flags = 0;
+}
+
+static double value_as_double(const Value* v) {
+    if (v->type == TAG_FLOAT) {
+        double d;
+        memcpy(&d, &v->value, sizeof(double));
+        return d;
+    }
+    return (double)v->value;
+}
+
+static int value_truthy(const Value* v) {
+    if (v->type == TAG_FLOAT) return value_as_double(v) != 0.0;
+    if (v->type == TAG_STR) return v->value != 0 && *(const char*)(intptr_t)v->value != '\0';
+    return v->value != 0;
+}
+
+static int is_numeric(const Value* v) {
+    return v->type == TAG_INT || v->type == TAG_FLOAT || v->type == TAG_BOOL;
+}
+
+static int chunk_count(int n, int32_t parallel) {
+    return parallel ? nv_parallel_chunks(0, n) : 1;
+}
+
+/* --- Comparadores especializados por tag --- */
+
+static int cmp_int(const void* a, const void* b) {
+    int64_t x = ((const Value*)a)->value;
+    int64_t y = ((const Value*)b)->value;
+    return (x > y) - (x < y);
+}
+
+static int cmp_num(const void* a, const void* b) {
+    double x = value_as_double((const Value*)a);
+    double y = value_as_double((const Value*)b);
+    return (x > y) - (x < y);
+}
+
+static int cmp_str(const void* a, const void* b) {
+    const char* x = (const char*)(intptr_t)((const Value*)a)->value;
+    const char* y = (const char*)(intptr_t)((const Value*)b)->value;
+    return strcmp(x ? x : "", y ? y : "");
+}
+
+// Ordem total para vetores heterogêneos: números < strings < demais (por tag)
+static int cmp_mixed(const void* a, const void* b) {
+    const Value* x = (const Value*)a;
+    const Value* y = (const Value*)b;
+    int nx = is_numeric(x), ny = is_numeric(y);
+    if (nx && ny) return cmp_num(a, b);
+    if (nx != ny) return nx ? -1 : 1;
+    if (x->type == TAG_STR && y->type == TAG_STR) return cmp_str(a, b);
+    if (x->type != y->type) {
+        if (x->type == TAG_STR) return -1;
+        if (y->type == TAG_STR) return 1;
+        return (x->type > y->type) - (x->type < y->type);
+    }
+    return (x->value > y->value) - (x->value < y->value);
+}
+
+typedef int (*value_cmp)(const void*, const void*);
+
+static value_cmp pick_comparator(const Value* elements, int n) {
+    int all_int = 1, all_num = 1, all_str = 1;
+    for (int i = 0; i < n && (all_int || all_num || all_str); i++) {
+        int32_t t = elements[i].type;
+        if (t != TAG_INT) all_int = 0;
+        if (t != TAG_INT && t != TAG_FLOAT) all_num = 0;
+        if (t != TAG_STR) all_str = 0;
+    }
+    if (all_int) return cmp_int;
+    if (all_num) return cmp_num;
+    if (all_str) return cmp_str;
+    return cmp_mixed;
+}
+
+/* --- map --- */
+
+typedef struct {
+    Value* src;
+    Value* dst;
+    nv_value_fn fn;
+} MapJob;
+
+static void map_chunk(int32_t lo, int32_t hi, int32_t chunk, void* env) {
+    (void)chunk;
+    MapJob* job = (MapJob*)env;
+    for (int32_t i = lo; i < hi; i++) {
+        job->fn(&job->dst[i], &job->src[i], NULL);
+    }
+}
+
+void vector_map_method(Value* out, Value* self, nv_value_fn fn, int32_t parallel) {
+    Value* elements;
+    int n;
+    if (!fn || !value_elements(self, &elements, &n)) { set_null(out); return; }
+
+    Value result;
+    create_vector(&result, n);
+    Vector* dst = (Vector*)(intptr_t)result.value;
+    dst->size = n;
+
+    MapJob job = {elements, dst->elements, fn};
+    nv_parallel_for(0, n, chunk_count(n, parallel), map_chunk, &job);
+    *out = result;
+}
+
+/* --- filter --- */
+
+typedef struct {
+    Value* src;
+    unsigned char* keep;
+    nv_value_fn fn;
+} FilterJob;
+
+static void filter_chunk(int32_t lo, int32_t hi, int32_t chunk, void* env) {
+    (void)chunk;
+    FilterJob* job = (FilterJob*)env;
+    Value r;
+    for (int32_t i = lo; i < hi; i++) {
+        set_null(&r);
+        job->fn(&r, &job->src[i], NULL);
+        job->keep[i] = (unsigned char)value_truthy(&r);
+    }
+}
+
+void vector_filter_method(Value* out, Value* self, nv_value_fn fn, int32_t parallel) {
+    Value* elements;
+    int n;
+    if (!fn || !value_elements(self, &elements, &n)) { set_null(out); return; }
+
+    unsigned char* keep = (unsigned char*)malloc(n > 0 ? (size_t)n : 1);
+    if (!keep) {
+        fprintf(stderr, "FATAL: malloc failed in vector_filter_method\n");
+        exit(1);
+    }
+    // Predicado em paralelo; compactação serial preserva a ordem
+    FilterJob job = {elements, keep, fn};
+    nv_parallel_for(0, n, chunk_count(n, parallel), filter_chunk, &job);
+
+    int kept = 0;
+    for (int i = 0; i < n; i++) kept += keep[i];
+
+    Value result;
+    create_vector(&result, kept);
+    Vector* dst = (Vector*)(intptr_t)result.value;
+    for (int i = 0; i < n; i++) {
+        if (keep[i]) dst->elements[dst->size++] = elements[i];
+    }
+    free(keep);
+    *out = result;
+}
+
+/* --- reduce --- */
+
+// Fold serial da esquerda para a direita: `fn` do usuário não precisa ser
+// associativa nem ter o acumulador do mesmo tipo dos elementos. As reduções
+// associativas conhecidas (sum/min/max) têm métodos próprios e paralelos.
+void vector_reduce_method(Value* out, Value* self, nv_value_fn fn, const Value* init) {
+    Value* elements;
+    int n;
+    if (!fn || !init || !value_elements(self, &elements, &n)) { set_null(out); return; }
+
+    Value acc = *init;
+    for (int i = 0; i < n; i++) {
+        Value next;
+        set_null(&next);
+        fn(&next, &acc, &elements[i]);
+        acc = next;
+    }
+    *out = acc;
+}
+
+/* --- sum / min / max --- */
+
+typedef struct {
+    Value* src;
+    int64_t* int_sums;
+    double* float_sums;
+    unsigned char* saw_float;
+} SumJob;
+
+static void sum_chunk(int32_t lo, int32_t hi, int32_t chunk, void* env) {
+    SumJob* job = (SumJob*)env;
+    int64_t isum = 0;
+    double fsum = 0.0;
+    unsigned char saw_float = 0;
+    for (int32_t i = lo; i < hi; i++) {
+        const Value* v = &job->src[i];
+        if (v->type == TAG_FLOAT) {
+            fsum += value_as_double(v);
+            saw_float = 1;
+        } else if (v->type == TAG_INT || v->type == TAG_BOOL) {
+            isum += v->value;
+        }
+    }
+    job->int_sums[chunk] = isum;
+    job->float_sums[chunk] = fsum;
+    job->saw_float[chunk] = saw_float;
+}
+
+void vector_sum_method(Value* out, Value* self) {
+    Value* elements;
+    int n;
+    if (!value_elements(self, &elements, &n)) { set_null(out); return; }
+
+    int32_t chunks = nv_parallel_chunks(0, n);
+    int64_t int_sums[NV_PARALLEL_MAX_CHUNKS];
+    double float_sums[NV_PARALLEL_MAX_CHUNKS];
+    unsigned char saw_float[NV_PARALLEL_MAX_CHUNKS];
+
+    SumJob job = {elements, int_sums, float_sums, saw_float};
+    nv_parallel_for(0, n, chunks, sum_chunk, &job);
+
+    int64_t isum = 0;
+    double fsum = 0.0;
+    int any_float = 0;
+    for (int32_t c = 0; c < chunks; c++) {
+        isum += int_sums[c];
+        fsum += float_sums[c];
+        any_float |= saw_float[c];
+    }
+    if (any_float) {
+        create_float(out, fsum + (double)isum);
+    } else {
+        create_int(out, (int32_t)isum);
+    }
+}
+
+typedef struct {
+    Value* src;
+    int32_t* best;
+    int sign;       // -1 = min, 1 = max
+} ExtremeJob;
+
+static void extreme_chunk(int32_t lo, int32_t hi, int32_t chunk, void* env) {
+    ExtremeJob* job = (ExtremeJob*)env;
+    int32_t best = lo < hi ? lo : -1;
+    for (int32_t i = lo + 1; i < hi; i++) {
+        if (cmp_mixed(&job->src[i], &job->src[best]) * job->sign > 0) best = i;
+    }
+    job->best[chunk] = best;
+}
+
+static void vector_extreme(Value* out, Value* self, int sign) {
+    Value* elements;
+    int n;
+    if (!value_elements(self, &elements, &n) || n == 0) { set_null(out); return; }
+
+    int32_t chunks = nv_parallel_chunks(0, n);
+    int32_t best[NV_PARALLEL_MAX_CHUNKS];
+    ExtremeJob job = {elements, best, sign};
+    nv_parallel_for(0, n, chunks, extreme_chunk, &job);
+
+    // Em caso de empate vence o primeiro índice, como no laço serial
+    int32_t winner = -1;
+    for (int32_t c = 0; c < chunks; c++) {
+        if (best[c] < 0) continue;
+        if (winner < 0 || cmp_mixed(&elements[best[c]], &elements[winner]) * sign > 0) winner = best[c];
+    }
+    *out = elements[winner];
+}
+
+void vector_min_method(Value* out, Value* self) {
+    vector_extreme(out, self, -1);
+}
+
+void vector_max_method(Value* out, Value* self) {
+    vector_extreme(out, self, 1);
+}
+
+/* --- sort --- */
+
+typedef struct {
+    Value* data;
+    Value* tmp;
+    int n;
+    int run;            // tamanho das sequências já ordenadas
+    value_cmp cmp;
+} SortJob;
+
+static void sort_chunk(int32_t lo, int32_t hi, int32_t chunk, void* env) {
+    (void)chunk;
+    SortJob* job = (SortJob*)env;
+    if (hi - lo > 1) qsort(job->data + lo, (size_t)(hi - lo), sizeof(Value), job->cmp);
+}
+
+// Cada iteração funde o par de sequências [2k*run, 2k*run + 2*run) de data em tmp
+static void merge_pairs(int32_t lo, int32_t hi, int32_t chunk, void* env) {
+    (void)chunk;
+    SortJob* job = (SortJob*)env;
+    for (int32_t k = lo; k < hi; k++) {
+        int64_t start = (int64_t)k * 2 * job->run;
+        int64_t mid = start + job->run;
+        int64_t end = mid + job->run;
+        if (mid > job->n) mid = job->n;
+        if (end > job->n) end = job->n;
+
+        int64_t i = start, j = mid, o = start;
+        while (i < mid && j < end) {
+            // Empate fica com a sequência da esquerda (fusão estável)
+            if (job->cmp(&job->data[j], &job->data[i]) < 0) job->tmp[o++] = job->data[j++];
+            else job->tmp[o++] = job->data[i++];
+        }
+        while (i < mid) job->tmp[o++] = job->data[i++];
+        while (j < end) job->tmp[o++] = job->data[j++];
+    }
+}
+
+// Devolve uma cópia ordenada; o receptor não é alterado
+void vector_sort_method(Value* out, Value* self) {
+    Value* source;
+    int n;
+    if (!value_elements(self, &source, &n)) { set_null(out); return; }
+
+    Value result;
+    create_vector(&result, n);
+    Vector* dst = (Vector*)(intptr_t)result.value;
+    if (n > 0) memcpy(dst->elements, source, sizeof(Value) * n);
+    dst->size = n;
+    *out = result;
+    if (n < 2) return;
+
+    Value* elements = dst->elements;
+    value_cmp cmp = pick_comparator(elements, n);
+    int32_t chunks = nv_parallel_chunks(0, n);
+    if (chunks <= 1) {
+        qsort(elements, (size_t)n, sizeof(Value), cmp);
+        return;
+    }
+
+    Value* tmp = (Value*)malloc(sizeof(Value) * n);
+    if (!tmp) {
+        // Sem memória para o buffer de fusão: ordena serialmente
+        qsort(elements, (size_t)n, sizeof(Value), cmp);
+        return;
+    }
+
+    // Sequências iniciais ordenadas em paralelo, depois fusões em pares até restar uma
+    int run = (n + chunks - 1) / chunks;
+    SortJob job = {elements, tmp, n, run, cmp};
+    nv_parallel_for(0, n, chunks, sort_chunk, &job);
+
+    while (job.run < n) {
+        int32_t pairs = (int32_t)(((int64_t)n + 2LL * job.run - 1) / (2LL * job.run));
+        int32_t merge_chunks = pairs < chunks ? pairs : chunks;
+        nv_parallel_for(0, pairs, merge_chunks, merge_pairs, &job);
+        Value* swap = job.data;
+        job.data = job.tmp;
+        job.tmp = swap;
+        job.run *= 2;
+    }
+    if (job.data != elements) {
+        memcpy(elements, job.data, sizeof(Value) * n);
+        free(job.data);
+    } else {
+        free(job.tmp);
+    }
+}
+
+/* --- dot / scale / add (kernels SIMD) --- */
+
+static int all_int(const Value* elements, int n) {
+    for (int i = 0; i < n; i++) {
+        if (elements[i].type != TAG_INT) return 0;
+    }
+    return 1;
+}
+
+// Copia os elementos para um buffer de double; NULL se houver elemento não numérico
+static double* unpack_f64(const Value* elements, int n, const char* where) {
+    for (int i = 0; i < n; i++) {
+        if (!is_numeric(&elements[i])) return NULL;
+    }
+    double* buf = (double*)malloc(sizeof(double) * (n > 0 ? n : 1));
+    if (!buf) {
+        fprintf(stderr, "FATAL: malloc failed in %s\n", where);
+        exit(1);
+    }
+    for (int i = 0; i < n; i++) buf[i] = value_as_double(&elements[i]);
+    return buf;
+}
+
+static Value pack_f64(const double* buf, int n) {
+    Value result;
+    create_vector(&result, n);
+    Vector* dst = (Vector*)(intptr_t)result.value;
+    for (int i = 0; i < n; i++) create_float(&dst->elements[i], buf[i]);
+    dst->size = n;
+    return result;
+}
+
+void vector_dot_method(Value* out, Value* self, const Value* other) {
+    Value *a, *b;
+    int na, nb;
+    if (!value_elements(self, &a, &na) || !value_elements((Value*)other, &b, &nb)) { set_null(out); return; }
+    int n = na < nb ? na : nb;
+
+    if (all_int(a, n) && all_int(b, n)) {
+        create_int(out, nv_simd_dot_values(self, (Value*)other, 0, n));
+        return;
+    }
+    double* x = unpack_f64(a, n, "vector_dot_method");
+    double* y = x ? unpack_f64(b, n, "vector_dot_method") : NULL;
+    if (!x || !y) {
+        free(x);
+        set_null(out);
+        return;
+    }
+    create_float(out, nv_simd_dot_f64(x, y, n));
+    free(x);
+    free(y);
+}
+
+void vector_scale_method(Value* out, Value* self, const Value* k) {
+    Value* a;
+    int n;
+    if (!k || !is_numeric(k) || !value_elements(self, &a, &n)) { set_null(out); return; }
+
+    if (k->type != TAG_FLOAT && all_int(a, n)) {
+        Value result;
+        create_vector(&result, n);
+        Vector* dst = (Vector*)(intptr_t)result.value;
+        for (int i = 0; i < n; i++) create_int(&dst->elements[i], (int32_t)(a[i].value * k->value));
+        dst->size = n;
+        *out = result;
+        return;
+    }
+    double* x = unpack_f64(a, n, "vector_scale_method");
+    if (!x) { set_null(out); return; }
+    nv_simd_scale_f64(x, x, value_as_double(k), n);
+    *out = pack_f64(x, n);
+    free(x);
+}
+
+void vector_add_method(Value* out, Value* self, const Value* other) {
+    Value *a, *b;
+    int na, nb;
+    if (!value_elements(self, &a, &na) || !value_elements((Value*)other, &b, &nb)) { set_null(out); return; }
+    int n = na < nb ? na : nb;
+
+    if (all_int(a, n) && all_int(b, n)) {
+        Value result;
+        create_vector(&result, n);
+        Vector* dst = (Vector*)(intptr_t)result.value;
+        for (int i = 0; i < n; i++) create_int(&dst->elements[i], (int32_t)(a[i].value + b[i].value));
+        dst->size = n;
+        *out = result;
+        return;
+    }
+    double* x = unpack_f64(a, n, "vector_add_method");
+    double* y = x ? unpack_f64(b, n, "vector_add_method") : NULL;
+    if (!x || !y) {
+        free(x);
+        set_null(out);
+        return;
+    }
+    nv_simd_add_f64(x, x, y, n);
+    *out = pack_f64(x, n);
+    free(x);
+    free(y);
+}
@@ -214,6 +214,7 @@ TypeInfo* get_value_type_info(const Value* v) {
 
 // Imprimir informações de tipo (para debug)
 void print_type_info(const Value* v) {
+    nv_out_flush();   // printf abaixo não pode passar à frente da saída buferizada
     if (!v) {
         printf("Value: NULL\n");
         return;
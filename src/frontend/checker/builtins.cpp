@@ -9,22 +9,76 @@ namespace nv {
     const std::vector<BuiltinFunction> BUILTIN_FUNCTIONS = {
         // write: aceita 0 ou 1 argumento de qualquer tipo e retorna void (polimórfico)
         // Aceita varargs: 0 ou 1 argumento
-        BuiltinFunction("write", {}, std::make_shared<Void>(), true, true, 0, 1),
+        BuiltinFunction("write", {}, void_type(), true, true, 0, 1),
         
         // read: aceita 0 ou 1 argumento (prompt opcional), retorna string
-        BuiltinFunction("read", {}, std::make_shared<String>(), false, true, 0, 1),
+        BuiltinFunction("read", {}, string_type(), false, true, 0, 1),
+        
+        // read_lines: sem argumentos, retorna as linhas restantes de stdin
+        // (em `for linha in read_lines()` as linhas são lidas sob demanda)
+        BuiltinFunction("read_lines", {}, std::make_shared<Vector>()),
+    };
+
+    // Métodos do objeto `json` (lowering especial em generate_call_expr/generate_for_stmt).
+    // Parâmetro nulo aceita qualquer tipo; retorno nulo é dinâmico (Value do runtime).
+    // Argumentos opcionais usam min/max como nos builtins com varargs.
+    const std::vector<BuiltinFunction> JSON_METHODS = {
+        // load(arquivo): documento inteiro
+        BuiltinFunction("load", {string_type()}, nullptr),
+        // stream(arquivo): registros de NDJSON ou de um array de topo
+        BuiltinFunction("stream", {string_type()}, std::make_shared<Vector>()),
+        // stringify(valor[, indent]): texto JSON; indent > 0 ativa pretty-printing
+        BuiltinFunction("stringify", {nullptr, int_type()}, string_type(),
+                        true, true, 1, 2),
+        // dump(valor, arquivo[, indent]): escreve direto no arquivo ("-" = stdout)
+        BuiltinFunction("dump", {nullptr, string_type(), int_type()},
+                        bool_type(), true, true, 2, 3),
     };
     
+    // Métodos do objeto `csv` (lowering especial em generate_call_expr)
+    const std::vector<BuiltinFunction> CSV_METHODS = {
+        // load(arquivo[, opções]): map coluna -> vector com o tipo inferido da coluna
+        BuiltinFunction("load", {string_type(), nullptr},
+                        make_map_type(string_type(), std::make_shared<Vector>()),
+                        true, true, 1, 2),
+    };
+
+    // Métodos do objeto `snapshot` (formato binário do runtime)
+    const std::vector<BuiltinFunction> SNAPSHOT_METHODS = {
+        // save(valor, arquivo): grava o grafo inteiro; false em erro de I/O
+        BuiltinFunction("save", {nullptr, string_type()}, bool_type()),
+        // load(arquivo[, chave]): raiz ou só a entrada `chave` do map raiz
+        BuiltinFunction("load", {string_type(), string_type()}, nullptr,
+                        true, true, 1, 2),
+    };
+
+    const std::vector<BuiltinFunction>* builtin_object_methods(const std::string& name) {
+        if (name == "json") return &JSON_METHODS;
+        if (name == "csv") return &CSV_METHODS;
+        if (name == "snapshot") return &SNAPSHOT_METHODS;
+        return nullptr;
+    }
+
     // Variáveis globais builtin (não são funções, mas objetos especiais)
     void register_builtin_variables(Checker& checker) {
-        // json: objeto especial para operações JSON
-        // No runtime, json é tratado como um objeto especial (Value*)
-        // No checker, registramos como um tipo genérico que pode ter métodos chamados nele
-        // Usamos um tipo especial que permite chamadas de método (como json.load)
-        // Por simplicidade, registramos como um tipo que pode ser usado em expressões
-        // O codegen trata json especialmente, então não precisamos de tipo muito específico aqui
-        auto json_type = checker.unify_ctx.new_type_var();
-        checker.scope->put_key("json", json_type, true);
+        // json/csv/snapshot: objetos especiais cujos métodos o codegen trata diretamente.
+        // No checker são variáveis de tipo com um Namespace de métodos, então
+        // `json.load(f)` passa pela checagem normal de member/call.
+        for (const char* name : {"json", "csv", "snapshot"}) {
+            auto object_type = checker.unify_ctx.new_type_var();
+            object_type->prototype = std::make_shared<Namespace>();
+            for (const auto& method : *builtin_object_methods(name)) {
+                std::vector<std::shared_ptr<Type>> params;
+                for (const auto& param : method.param_types) {
+                    params.push_back(param ? param : checker.unify_ctx.new_type_var());
+                }
+                auto ret = method.return_type ? method.return_type : checker.unify_ctx.new_type_var();
+                // Generalizado: cada chamada instancia variáveis novas (check_member_expr)
+                auto method_type = checker.unify_ctx.generalize(std::make_shared<Def>(params, ret), {});
+                object_type->prototype->put_key(method.name, method_type, true);
+            }
+            checker.scope.put_key(name, object_type, true);
+        }
     }
     
     bool builtin_accepts_args(const BuiltinFunction& builtin, size_t arg_count) {
@@ -56,11 +110,11 @@ namespace nv {
                 func_type = checker.unify_ctx.generalize(func_type, free_vars);
             } else {
                 // Tipo não polimórfico - usar tipos especificados
-                func_type = std::make_shared<Def>(builtin.param_types, builtin.return_type);
+                func_type = make_def_type(builtin.param_types, builtin.return_type);
             }
             
             // Registrar no escopo global como constante
-            checker.scope->put_key(builtin.name, func_type, true);
+            checker.scope.put_key(builtin.name, func_type, true);
         }
         
         // Registrar variáveis globais builtin
@@ -14,14 +14,12 @@
 #include <memory>
 #include <unordered_set>
 #include <algorithm>
-#include <fstream>
 #include <cmath>
 #include <iostream>
 #include <algorithm>
 #include <filesystem>
 #include <sstream>
 
-constexpr size_t MAX_LINE_LENGTH = 1024;
 constexpr const char* ANSI_BOLD = "\x1b[1m";
 constexpr const char* ANSI_RESET = "\x1b[0m";
 constexpr const char* ANSI_RED = "\x1b[31m";
@@ -65,14 +63,11 @@ namespace {
 nv::Checker::Checker() {
     err = false;  // Inicializar flag de erro
     reported_errors.clear();  // Inicializar conjunto de erros reportados
-    auto globalnamespace = std::make_shared<Namespace>();
-    namespaces.push_back(globalnamespace);
-    scope = globalnamespace;
-    types["int"] = std::make_shared<nv::Int>();
-    types["string"] = std::make_shared<nv::String>();
-    types["float"] = std::make_shared<nv::Float>();
-    types["bool"] = std::make_shared<nv::Boolean>();
-    types["void"] = std::make_shared<nv::Void>();
+    types["int"] = nv::int_type();
+    types["string"] = nv::string_type();
+    types["float"] = nv::float_type();
+    types["bool"] = nv::bool_type();
+    types["void"] = nv::void_type();
     
     // Registrar funções builtin do runtime
     register_builtins(*this);
@@ -111,7 +106,7 @@ std::shared_ptr<nv::Type>& nv::Checker::gettyptr(std::string ty){
                 if (size > 0) {
                     // Obter tipo base
                     auto& base_type = gettyptr(base_type_str);
-                    auto arr_type = std::make_shared<nv::Array>(base_type, size);
+                    auto arr_type = nv::make_array_type(base_type, size);
                     types[ty] = arr_type;
                     return types[ty];
                 }
@@ -132,56 +127,30 @@ std::shared_ptr<nv::Type>& nv::Checker::gettyptr(std::string ty){
     return types["void"];
 }
 void nv::Checker::push_scope() {
-    auto ns = std::make_shared<Namespace>(scope);
-    namespaces.push_back(ns);
-    scope = ns;
+    scope.push_scope();
 }
 
 void nv::Checker::pop_scope() {
-    namespaces.pop_back();
-    scope = namespaces[namespaces.size() - 1];
+    scope.pop_scope();
 }
 
 std::unordered_set<int> nv::Checker::get_free_vars_in_env() {
     std::unordered_set<int> free_vars;
     
     // Coletar variáveis livres de todas as variáveis no ambiente atual
-    // O método collect_free_vars do Namespace já coleta recursivamente
-    // de todos os escopos pais através da cadeia de parent, então
-    // precisamos apenas chamar no escopo atual
-    if (scope) {
-        scope->collect_free_vars(free_vars);
-    }
+    // (a tabela de escopos guarda todos os níveis abertos)
+    scope.collect_free_vars(free_vars);
     
     return free_vars;
 }
 
-void nv::Checker::read_lines(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        // Se não conseguir abrir, apenas limpar linhas (erro será reportado sem contexto)
-        lines.clear();
-        line_count = 0;
-        return;
-    }
-
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.size() > MAX_LINE_LENGTH) {
-            // Linha muito longa, truncar
-            line = line.substr(0, MAX_LINE_LENGTH);
-        }
-        lines.push_back(line);
-    }
-    line_count = lines.size();
-}
-
 void nv::Checker::print_error_context(const PositionData* pos) {
-    if (!pos || lines.empty() || pos->line == 0 || pos->line - 1 >= line_count) {
+    const SourceManager& sources = SourceManager::instance();
+    if (!pos || !source_file || pos->line == 0 || pos->line > sources.line_count(*source_file)) {
         return;
     }
 
-    std::string line_content = lines[pos->line - 1];
+    std::string line_content(sources.line(*source_file, pos->line));
     std::replace(line_content.begin(), line_content.end(), '\n', ' ');
 
     std::cerr << " " << pos->line << " |   " << line_content << "\n";
@@ -199,7 +168,16 @@ void nv::Checker::print_error_context(const PositionData* pos) {
 
 void nv::Checker::set_source_file(const std::string& filename) {
     current_filename = filename;
-    read_lines(filename);
+    // Normalmente o ModuleManager ou o lexer já registrou o arquivo; senão
+    // mapeia agora (nomes virtuais ficam sem contexto)
+    source_file = SourceManager::instance().find(filename);
+    if (!source_file) {
+        try {
+            source_file = SourceManager::instance().load_file(filename);
+        } catch (const std::runtime_error&) {
+            source_file.reset();
+        }
+    }
 }
 
 void nv::Checker::error(Node* node, const std::string& message) {
@@ -55,7 +55,7 @@ int main(int argc, char* argv[]) {
                                 // Para declarações, obter tipo do namespace após verificação
                                 try {
                                     auto* id = static_cast<IdentifierNode*>(decl->target.get());
-                                    auto& type = checker.scope->get_key(id->symbol);
+                                    auto& type = checker.scope.get_key(id->symbol_id);
                                     // Resolver tipo (pode ser polimórfico ou ter variáveis de tipo)
                                     inferred_type = checker.unify_ctx.resolve(type);
                                     // Se ainda for polimórfico após resolução, tentar instanciar
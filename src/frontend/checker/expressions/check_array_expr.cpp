@@ -53,7 +53,7 @@ std::shared_ptr<nv::Type> check_array_expr(nv::Checker* ch, Node* node) {
         first_type = ch->unify_ctx.resolve(first_type);
         // Verificar se não é variável de tipo não resolvida
         if (first_type->kind != nv::Kind::TYPE_VAR) {
-            return std::make_shared<nv::Array>(first_type, arr->elements.size());
+            return nv::make_array_type(first_type, arr->elements.size());
         }
     }
     
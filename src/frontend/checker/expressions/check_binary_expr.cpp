@@ -32,7 +32,7 @@ std::shared_ptr<nv::Type> check_binary_expr(nv::Checker* ch, Node* node) {
     bool right_is_string = right_type->kind == nv::Kind::STRING;
     
     // Caso especial: multiplicação de string por inteiro (repetição)
-    if (bin->op == "*") {
+    if (bin->opcode == BinaryOp::Mul) {
         if ((left_is_string && right_is_int) || (left_is_int && right_is_string)) {
             // string * int ou int * string retorna string
             return ch->gettyptr("string");
@@ -59,20 +59,19 @@ std::shared_ptr<nv::Type> check_binary_expr(nv::Checker* ch, Node* node) {
     left_type = ch->unify_ctx.resolve(left_type);
     
     // Determinar tipo de retorno baseado no operador
-    if (bin->op == "+" || bin->op == "-" || bin->op == "*" || bin->op == "/" || bin->op == "%") {
-        // Operadores aritméticos retornam o tipo dos operandos (promovido se necessário)
-        // Se havia int e float, o resultado já é float
-        // Se era string * int, já retornamos string acima
-        return left_type;
-    } else if (bin->op == "==" || bin->op == "!=" || bin->op == "<" || 
-               bin->op == ">" || bin->op == "<=" || bin->op == ">=") {
-        // Operadores de comparação retornam bool
-        return ch->gettyptr("bool");
-    } else if (bin->op == "&&" || bin->op == "||") {
-        // Operadores lógicos retornam bool
-        ch->unify_ctx.unify(left_type, ch->gettyptr("bool"));
-        return ch->gettyptr("bool");
+    switch (bin->opcode) {
+        case BinaryOp::Eq: case BinaryOp::Ne: case BinaryOp::Lt:
+        case BinaryOp::Gt: case BinaryOp::Le: case BinaryOp::Ge:
+            // Operadores de comparação retornam bool
+            return ch->gettyptr("bool");
+        case BinaryOp::And: case BinaryOp::Or:
+            // Operadores lógicos retornam bool
+            ch->unify_ctx.unify(left_type, ch->gettyptr("bool"));
+            return ch->gettyptr("bool");
+        default:
+            // Operadores aritméticos retornam o tipo dos operandos (promovido se necessário)
+            // Se havia int e float, o resultado já é float
+            // Se era string * int, já retornamos string acima
+            return left_type;
     }
-    
-    return left_type;
 }
@@ -8,6 +8,8 @@
 
 std::shared_ptr<nv::Type>& check_call_expr(nv::Checker* ch, Node* node) {
     const auto* call = static_cast<CallExprNode*>(node);
+    // Fixa o builtin/método chamado para o codegen despachar por id
+    call->resolve_builtin();
     
     // Verificar o caller (função sendo chamada) usando infer_expr
     // Isso já verifica identificadores corretamente
@@ -84,6 +86,28 @@ std::shared_ptr<nv::Type>& check_call_expr(nv::Checker* ch, Node* node) {
                     return ch->gettyptr("void");
                 }
             }
+        } else if (call->caller->kind == NodeType::MemberExpression) {
+            // Métodos de json/csv/snapshot com argumentos opcionais (ex.: json.stringify(v, 2))
+            auto* mem = static_cast<MemberExprNode*>(call->caller.get());
+            auto* obj = dynamic_cast<IdentifierNode*>(mem->object.get());
+            auto* prop = dynamic_cast<IdentifierNode*>(mem->property.get());
+            const auto* methods = obj ? nv::builtin_object_methods(obj->symbol) : nullptr;
+            if (methods && prop) {
+                func_name = obj->symbol + "." + prop->symbol;
+                auto it = std::find_if(methods->begin(), methods->end(),
+                    [prop](const nv::BuiltinFunction& b) { return b.name == prop->symbol; });
+                if (it != methods->end() && it->accepts_varargs) {
+                    is_builtin_varargs = true;
+                    if (!nv::builtin_accepts_args(*it, call->args.size())) {
+                        std::ostringstream oss;
+                        oss << "Function '" << func_name << "' argument count mismatch: "
+                            << it->min_args << " to " << it->max_args
+                            << " expected, got " << call->args.size();
+                        ch->error(const_cast<Node*>(node), oss.str());
+                        return ch->gettyptr("void");
+                    }
+                }
+            }
         }
         
         // Verificar número de argumentos
@@ -62,7 +62,7 @@ std::shared_ptr<nv::Type>& check_list_comp_expr(nv::Checker* ch, Node* node) {
                 map->key_type,
                 map->value_type
             };
-            element_type = std::make_shared<nv::Tuple>(tuple_types);
+            element_type = nv::make_tuple_type(tuple_types);
         } else {
             // Tuple - usar tipo genérico
             int next_id = ch->unify_ctx.get_next_var_id();
@@ -72,7 +72,7 @@ std::shared_ptr<nv::Type>& check_list_comp_expr(nv::Checker* ch, Node* node) {
         // Adicionar target ao escopo
         if (target->kind == NodeType::Identifier) {
             auto* id = static_cast<IdentifierNode*>(target.get());
-            ch->scope->put_key(id->symbol, element_type, false);
+            ch->scope.put_key(id->symbol_id, element_type, false);
         }
     }
     
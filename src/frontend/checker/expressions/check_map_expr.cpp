@@ -72,6 +72,6 @@ std::shared_ptr<nv::Type>& check_map_expr(nv::Checker* ch, Node* node) {
     value_type = ch->unify_ctx.resolve(value_type);
     
     // Criar e retornar tipo Map
-    temp_result = std::make_shared<nv::Map>(key_type, value_type);
+    temp_result = nv::make_map_type(key_type, value_type);
     return temp_result;
 }
@@ -35,6 +35,13 @@ std::shared_ptr<nv::Type>& check_member_expr(nv::Checker* ch, Node* node) {
     // Verificar se o tipo tem o método/membro
     auto method_type = object_type->get_method(prop_name);
     if (method_type) {
+        // Métodos polimórficos (ex.: json.stringify) ganham variáveis novas a cada uso
+        if (method_type->kind == nv::Kind::POLY_TYPE) {
+            auto poly = std::static_pointer_cast<nv::PolyType>(method_type);
+            int next_id = ch->unify_ctx.get_next_var_id();
+            temp_result = poly->instantiate(next_id);
+            return temp_result;
+        }
         temp_result = method_type;
         return temp_result;
     }
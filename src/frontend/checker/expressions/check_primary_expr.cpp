@@ -64,10 +64,9 @@ std::shared_ptr<nv::Type>& check_primary_expr(nv::Checker* ch, Node* node) {
             return temp_result;
         case NodeType::Identifier: {
             const auto* id = static_cast<IdentifierNode*>(node);
-            // Verificar se o identificador existe antes de tentar acessá-lo
-            // Usar try-catch apenas para detectar, mas converter para error() imediatamente
-            try {
-                auto& var_type = ch->scope->get_key(id->symbol);
+            // Busca direta pelo id internado; nome inexistente vira error() sem exceção
+            if (auto* found = ch->scope.find(id->symbol_id)) {
+                auto& var_type = *found;
                 // Se for tipo polimórfico, instanciar
                 if (var_type->kind == nv::Kind::POLY_TYPE) {
                     auto poly = std::static_pointer_cast<nv::PolyType>(var_type);
@@ -76,7 +75,7 @@ std::shared_ptr<nv::Type>& check_primary_expr(nv::Checker* ch, Node* node) {
                     return temp_result;
                 }
                 return var_type;
-            } catch (std::runtime_error&) {
+            } else {
                 // Identificador não encontrado - reportar erro formatado (mesmo formato do parser)
                 // Nunca propagar runtime_error, apenas usar error() do checker
                 
@@ -0,0 +1,294 @@
+#include "frontend/checker/interface.hpp"
+#include "frontend/lexer/source_manager.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+    // "NVI\0" no início do arquivo; mudar o layout exige incrementar kVersion
+    constexpr uint32_t kMagic = 0x0049564e;
+    constexpr uint32_t kVersion = 1;
+    // Tipos mais aninhados que isso só aparecem em arquivo corrompido
+    constexpr int kMaxDepth = 256;
+
+    class Writer {
+    public:
+        std::string out;
+        bool ok = true;
+
+        template <typename T>
+        void put(T value) {
+            char bytes[sizeof(T)];
+            std::memcpy(bytes, &value, sizeof(T));
+            out.append(bytes, sizeof(T));
+        }
+
+        void put_string(const std::string& s) {
+            put<uint32_t>(static_cast<uint32_t>(s.size()));
+            out += s;
+        }
+
+        void put_type(const std::shared_ptr<nv::Type>& type) {
+            if (!type) { ok = false; return; }
+            auto t = type;
+            if (t->kind == nv::Kind::TYPE_VAR) {
+                t = static_cast<nv::TypeVar*>(t.get())->resolve();
+            }
+            put<uint8_t>(static_cast<uint8_t>(t->kind));
+            switch (t->kind) {
+                case nv::Kind::STRING:
+                case nv::Kind::INT:
+                case nv::Kind::FLOAT:
+                case nv::Kind::BOOL:
+                case nv::Kind::VOID:
+                case nv::Kind::VECTOR:
+                    return;
+                case nv::Kind::DEF: {
+                    auto* def = static_cast<nv::Def*>(t.get());
+                    put<uint32_t>(static_cast<uint32_t>(def->paramstype.size()));
+                    for (const auto& param : def->paramstype) put_type(param);
+                    put_type(def->returntype);
+                    return;
+                }
+                case nv::Kind::ARRAY: {
+                    auto* arr = static_cast<nv::Array*>(t.get());
+                    put<uint64_t>(arr->size);
+                    put_type(arr->element_type);
+                    return;
+                }
+                case nv::Kind::TUPLE: {
+                    auto* tup = static_cast<nv::Tuple*>(t.get());
+                    put<uint32_t>(static_cast<uint32_t>(tup->element_type.size()));
+                    for (const auto& elem : tup->element_type) put_type(elem);
+                    return;
+                }
+                case nv::Kind::MAP: {
+                    auto* map = static_cast<nv::Map*>(t.get());
+                    put_type(map->key_type);
+                    put_type(map->value_type);
+                    return;
+                }
+                case nv::Kind::TYPE_VAR:
+                    // Variável livre (resolve devolveu o representante)
+                    put<int32_t>(static_cast<nv::TypeVar*>(t.get())->id);
+                    return;
+                case nv::Kind::POLY_TYPE: {
+                    auto* poly = static_cast<nv::PolyType*>(t.get());
+                    put<uint32_t>(static_cast<uint32_t>(poly->bound_vars.size()));
+                    for (int var : poly->bound_vars) put<int32_t>(var);
+                    put_type(poly->body);
+                    return;
+                }
+                default:
+                    ok = false;
+                    return;
+            }
+        }
+    };
+
+    class Reader {
+    public:
+        Reader(std::string_view data, const nv::FreshTypeVar& fresh_var) : data(data), fresh_var(fresh_var) {}
+
+        bool ok = true;
+
+        template <typename T>
+        T get() {
+            T value{};
+            if (data.size() - pos < sizeof(T)) { ok = false; return value; }
+            std::memcpy(&value, data.data() + pos, sizeof(T));
+            pos += sizeof(T);
+            return value;
+        }
+
+        std::string get_string() {
+            uint32_t size = get<uint32_t>();
+            if (!ok || data.size() - pos < size) { ok = false; return {}; }
+            std::string s(data.substr(pos, size));
+            pos += size;
+            return s;
+        }
+
+        // Contagem de elementos; cada um ocupa ao menos um byte
+        uint32_t get_count() {
+            uint32_t n = get<uint32_t>();
+            if (n > data.size() - pos) ok = false;
+            return ok ? n : 0;
+        }
+
+        std::shared_ptr<nv::Type> get_type(int depth = 0) {
+            if (!ok || depth > kMaxDepth) { ok = false; return nullptr; }
+            uint8_t tag = get<uint8_t>();
+            if (!ok || tag >= nv::Kind::ERROR) { ok = false; return nullptr; }
+            switch (static_cast<nv::Kind>(tag)) {
+                case nv::Kind::STRING: return nv::string_type();
+                case nv::Kind::INT: return nv::int_type();
+                case nv::Kind::FLOAT: return nv::float_type();
+                case nv::Kind::BOOL: return nv::bool_type();
+                case nv::Kind::VOID: return nv::void_type();
+                case nv::Kind::VECTOR: return std::make_shared<nv::Vector>();
+                case nv::Kind::DEF: {
+                    uint32_t n = get_count();
+                    std::vector<std::shared_ptr<nv::Type>> params;
+                    params.reserve(n);
+                    for (uint32_t i = 0; i < n && ok; ++i) params.push_back(get_type(depth + 1));
+                    auto ret = get_type(depth + 1);
+                    return ok ? nv::make_def_type(params, ret) : nullptr;
+                }
+                case nv::Kind::ARRAY: {
+                    auto size = static_cast<size_t>(get<uint64_t>());
+                    auto elem = get_type(depth + 1);
+                    return ok ? nv::make_array_type(elem, size) : nullptr;
+                }
+                case nv::Kind::TUPLE: {
+                    uint32_t n = get_count();
+                    std::vector<std::shared_ptr<nv::Type>> elems;
+                    elems.reserve(n);
+                    for (uint32_t i = 0; i < n && ok; ++i) elems.push_back(get_type(depth + 1));
+                    return ok ? nv::make_tuple_type(elems) : nullptr;
+                }
+                case nv::Kind::MAP: {
+                    auto key = get_type(depth + 1);
+                    auto value = get_type(depth + 1);
+                    return ok ? nv::make_map_type(key, value) : nullptr;
+                }
+                case nv::Kind::TYPE_VAR:
+                    return var(get<int32_t>());
+                case nv::Kind::POLY_TYPE: {
+                    uint32_t n = get_count();
+                    std::unordered_set<int> bound;
+                    for (uint32_t i = 0; i < n && ok; ++i) {
+                        // Variáveis quantificadas também ganham ids novos, para
+                        // não colidir com as livres do contexto de quem importa
+                        auto tv = var(get<int32_t>());
+                        if (tv) bound.insert(static_cast<nv::TypeVar*>(tv.get())->id);
+                    }
+                    auto body = get_type(depth + 1);
+                    return ok ? std::make_shared<nv::PolyType>(bound, body) : nullptr;
+                }
+                default:
+                    ok = false;
+                    return nullptr;
+            }
+        }
+
+        bool at_end() const { return pos == data.size(); }
+
+    private:
+        std::string_view data;
+        size_t pos = 0;
+        const nv::FreshTypeVar& fresh_var;
+        std::unordered_map<int32_t, std::shared_ptr<nv::Type>> vars;  // id no arquivo -> variável nova
+
+        std::shared_ptr<nv::Type> var(int32_t id) {
+            if (!ok) return nullptr;
+            auto& slot = vars[id];
+            if (!slot) slot = fresh_var();
+            return slot;
+        }
+    };
+}
+
+const nv::InterfaceExport* nv::ModuleInterface::find(const std::string& name) const {
+    for (const auto& e : exports) {
+        if (e.name == name) return &e;
+    }
+    return nullptr;
+}
+
+uint64_t nv::hash_source(std::string_view source) {
+    // FNV-1a de 64 bits
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : source) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string nv::interface_path(const std::string& source_path) {
+    return std::filesystem::path(source_path).replace_extension(".nvi").string();
+}
+
+bool nv::write_interface(const std::string& path, const ModuleInterface& iface) {
+    Writer w;
+    w.put<uint32_t>(kMagic);
+    w.put<uint32_t>(kVersion);
+    w.put<uint64_t>(iface.source_hash);
+    w.put<uint32_t>(static_cast<uint32_t>(iface.dependencies.size()));
+    for (const auto& dep : iface.dependencies) {
+        w.put_string(dep.path);
+        w.put<uint64_t>(dep.hash);
+    }
+    w.put<uint32_t>(static_cast<uint32_t>(iface.exports.size()));
+    for (const auto& e : iface.exports) {
+        w.put_string(e.name);
+        w.put<uint8_t>(e.constant ? 1 : 0);
+        w.put_type(e.type);
+    }
+    if (!w.ok) return false;
+
+    // Escreve num temporário e renomeia, para quem lê nunca ver um arquivo pela metade
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+        file.write(w.out.data(), static_cast<std::streamsize>(w.out.size()));
+        if (!file) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+
+std::optional<nv::ModuleInterface> nv::read_interface(const std::string& path, const FreshTypeVar& fresh_var) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return std::nullopt;
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    Reader r(data, fresh_var);
+    if (r.get<uint32_t>() != kMagic || r.get<uint32_t>() != kVersion || !r.ok) return std::nullopt;
+
+    ModuleInterface iface;
+    iface.source_hash = r.get<uint64_t>();
+    uint32_t deps = r.get_count();
+    for (uint32_t i = 0; i < deps && r.ok; ++i) {
+        std::string dep_path = r.get_string();
+        uint64_t dep_hash = r.get<uint64_t>();
+        iface.dependencies.push_back({std::move(dep_path), dep_hash});
+    }
+    uint32_t exports = r.get_count();
+    for (uint32_t i = 0; i < exports && r.ok; ++i) {
+        std::string name = r.get_string();
+        bool constant = r.get<uint8_t>() != 0;
+        auto type = r.get_type();
+        iface.exports.push_back({std::move(name), std::move(type), constant});
+    }
+    if (!r.ok || !r.at_end()) return std::nullopt;
+    return iface;
+}
+
+std::optional<nv::ModuleInterface> nv::load_current_interface(const std::string& source_path,
+                                                              uint64_t source_hash,
+                                                              const FreshTypeVar& fresh_var) {
+    auto iface = read_interface(interface_path(source_path), fresh_var);
+    if (!iface || iface->source_hash != source_hash) return std::nullopt;
+
+    // Os tipos exportados também dependem dos módulos importados pelo módulo
+    auto& sources = SourceManager::instance();
+    for (const auto& dep : iface->dependencies) {
+        try {
+            if (hash_source(sources.buffer(sources.load_file(dep.path))) != dep.hash) return std::nullopt;
+        } catch (const std::runtime_error&) {
+            return std::nullopt;
+        }
+    }
+    return iface;
+}
@@ -0,0 +1,153 @@
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include "frontend/checker/interface.hpp"
+#include "test_support.hpp"
+
+namespace fs = std::filesystem;
+using namespace nv::test;
+
+namespace {
+    fs::path dir;
+    int next_var = 1000;
+    const nv::FreshTypeVar fresh = [] { return std::make_shared<nv::TypeVar>(next_var++); };
+
+    std::string type_string(const nv::ModuleInterface& iface, const std::string& name) {
+        auto* e = iface.find(name);
+        return e && e->type ? e->type->toString() : "<ausente>";
+    }
+
+    // Um export de cada forma de tipo serializável
+    nv::ModuleInterface sample_interface() {
+        nv::ModuleInterface iface;
+        iface.source_hash = nv::hash_source("def f() {}");
+        iface.dependencies.push_back({(dir / "dep.nv").string(), nv::hash_source("dep")});
+
+        auto var = std::make_shared<nv::TypeVar>(5);
+        auto free_var = std::make_shared<nv::TypeVar>(9);
+        iface.exports.push_back({"k", nv::int_type(), true});
+        iface.exports.push_back({"f", nv::make_def_type({nv::float_type(), nv::string_type()}, nv::bool_type()), false});
+        iface.exports.push_back({"a", nv::make_array_type(nv::int_type(), 3), false});
+        iface.exports.push_back({"t", nv::make_tuple_type({nv::int_type(), nv::void_type()}), false});
+        iface.exports.push_back({"m", nv::make_map_type(nv::string_type(), nv::float_type()), false});
+        iface.exports.push_back({"v", std::make_shared<nv::Vector>(), false});
+        iface.exports.push_back({"id", std::make_shared<nv::PolyType>(
+            std::unordered_set<int>{5}, nv::make_def_type({var, nv::int_type()}, var)), false});
+        iface.exports.push_back({"livre", nv::make_def_type({free_var}, free_var), false});
+        return iface;
+    }
+
+    void test_round_trip() {
+        std::cout << "write_interface / read_interface\n";
+        auto path = (dir / "mod.nvi").string();
+        check(nv::write_interface(path, sample_interface()), "interface gravada");
+        check(!fs::exists(path + ".tmp"), "temporário renomeado");
+
+        next_var = 1000;
+        auto iface = nv::read_interface(path, fresh);
+        check(iface.has_value(), "interface lida");
+        if (!iface) return;
+        check(iface->source_hash == nv::hash_source("def f() {}") && iface->dependencies.size() == 1 &&
+              iface->dependencies[0].hash == nv::hash_source("dep"), "hash do fonte e dependências");
+        check(iface->exports.size() == 8 && iface->find("k")->constant && !iface->find("f")->constant,
+              "exports e constantes");
+        check(type_string(*iface, "f") ==
+              nv::make_def_type({nv::float_type(), nv::string_type()}, nv::bool_type())->toString(), "função");
+        check(type_string(*iface, "a") == nv::make_array_type(nv::int_type(), 3)->toString(), "array");
+        check(type_string(*iface, "t") == nv::make_tuple_type({nv::int_type(), nv::void_type()})->toString(), "tupla");
+        check(type_string(*iface, "m") == nv::make_map_type(nv::string_type(), nv::float_type())->toString(), "map");
+        check(type_string(*iface, "v") == "vector" && iface->find("v")->type->get_method("map"), "vector com métodos");
+        // Variáveis ganham ids novos de `fresh`, na ordem em que aparecem
+        check(type_string(*iface, "id") == "∀'t1000. def('t1000, int): 't1000", "esquema polimórfico");
+        check(type_string(*iface, "livre") == "def('t1001): 't1001", "variável livre");
+    }
+
+    void test_stale() {
+        std::cout << "load_current_interface com fonte ou dependência alterados\n";
+        write_file(dir / "dep.nv", "dep");
+        auto source = (dir / "mod.nv").string();
+        nv::write_interface(nv::interface_path(source), sample_interface());
+        check(nv::interface_path(source) == (dir / "mod.nvi").string(), "caminho .nvi ao lado do fonte");
+
+        check(nv::load_current_interface(source, nv::hash_source("def f() {}"), fresh).has_value(),
+              "fonte e dependência inalterados");
+        check(!nv::load_current_interface(source, nv::hash_source("def f() { 1 }"), fresh),
+              "fonte alterado invalida a interface");
+
+        auto iface = sample_interface();
+        iface.dependencies[0].path = write_file(dir / "dep2.nv", "dep editado");
+        nv::write_interface(nv::interface_path(source), iface);
+        check(!nv::load_current_interface(source, iface.source_hash, fresh), "dependência alterada invalida a interface");
+
+        iface.dependencies[0].path = (dir / "removida.nv").string();
+        nv::write_interface(nv::interface_path(source), iface);
+        check(!nv::load_current_interface(source, iface.source_hash, fresh), "dependência removida invalida a interface");
+
+        fs::remove(nv::interface_path(source));
+        check(!nv::load_current_interface(source, iface.source_hash, fresh), "sem .nvi");
+    }
+
+    // Arquivos corrompidos viram nullopt (o chamador volta ao fonte), nunca falha de memória
+    void test_corrupt() {
+        std::cout << "read_interface com arquivo corrompido\n";
+        auto path = (dir / "good.nvi").string();
+        nv::write_interface(path, sample_interface());
+        std::string good = read_file(path);
+        auto bad = (dir / "bad.nvi").string();
+
+        check(!nv::read_interface((dir / "nao_existe.nvi").string(), fresh), "arquivo inexistente");
+        check(!nv::read_interface(write_file(bad, ""), fresh), "arquivo vazio");
+        check(!nv::read_interface(write_file(bad, "NVJ" + good.substr(3)), fresh), "magic errado");
+        std::string version = good;
+        version[4] = static_cast<char>(version[4] + 1);
+        check(!nv::read_interface(write_file(bad, version), fresh), "versão diferente");
+        check(!nv::read_interface(write_file(bad, good + "x"), fresh), "bytes sobrando no fim");
+
+        bool truncated = true;
+        for (size_t len = 0; len < good.size(); len++) {
+            if (nv::read_interface(write_file(bad, good.substr(0, len)), fresh)) truncated = false;
+        }
+        check(truncated, "todo truncamento é rejeitado");
+
+        // Tag de Kind fora do enum e tipos aninhados demais
+        nv::ModuleInterface deep;
+        auto t = nv::int_type();
+        for (int i = 0; i < 300; i++) t = nv::make_array_type(t, 1);
+        deep.exports.push_back({"x", t, false});
+        nv::write_interface(bad, deep);
+        check(!nv::read_interface(bad, fresh), "aninhamento acima do limite");
+        nv::ModuleInterface single;
+        single.exports.push_back({"x", nv::int_type(), false});
+        nv::write_interface(bad, single);
+        std::string kind = read_file(bad);
+        kind[kind.size() - 1] = static_cast<char>(0xff);
+        check(!nv::read_interface(write_file(bad, kind), fresh), "tag de tipo inválida");
+
+        srand(50);
+        for (int i = 0; i < 20000; i++) {
+            std::string mutated = good;
+            for (int k = 0, flips = 1 + rand() % 4; k < flips; k++) {
+                mutated[rand() % mutated.size()] = static_cast<char>(rand());
+            }
+            write_file(bad, mutated);
+            nv::read_interface(bad, fresh);
+        }
+        check(true, "20000 arquivos com bytes trocados sem falha de memória");
+    }
+}
+
+int main() {
+    dir = temp_dir("narval_interface_test");
+
+    std::cout << "Iniciando teste de interfaces (.nvi)...\n";
+    try {
+        test_round_trip();
+        test_stale();
+        test_corrupt();
+    } catch (const std::exception& e) {
+        std::cerr << "Erro durante teste de interfaces: " << e.what() << "\n";
+        failures++;
+    }
+    fs::remove_all(dir);
+    return finish("interfaces");
+}
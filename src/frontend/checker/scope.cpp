@@ -0,0 +1,36 @@
+#include "frontend/checker/scope.hpp"
+#include "frontend/checker/type.hpp"
+#include <stdexcept>
+
+std::shared_ptr<nv::Type>* nv::Scope::find(SymbolId k) {
+    auto* binding = table.find(k);
+    return binding ? &binding->value : nullptr;
+}
+
+std::shared_ptr<nv::Type>& nv::Scope::get_key(SymbolId k) {
+    if (auto* type = find(k)) return *type;
+    throw std::runtime_error(std::string("Key '") + symbol_name(k) + "' not found.");
+}
+
+std::shared_ptr<nv::Type>& nv::Scope::get_key(const std::string& k) {
+    return get_key(intern_symbol(k));
+}
+
+void nv::Scope::put_key(SymbolId k, const std::shared_ptr<nv::Type>& v, bool islocked) {
+    auto* local = table.find_local(k);
+    if (local && local->constant) {
+        throw std::runtime_error(std::string("'") + symbol_name(k) + "' can not be changed.");
+    }
+    table.define(k, v, islocked);
+}
+
+void nv::Scope::put_key(const std::string& k, const std::shared_ptr<nv::Type>& v, bool islocked) {
+    put_key(intern_symbol(k), v, islocked);
+}
+
+void nv::Scope::collect_free_vars(std::unordered_set<int>& free_vars) const {
+    // PolyType::collect_free_vars já ignora as variáveis quantificadas
+    table.for_each([&](const auto& binding) {
+        if (binding.value) binding.value->collect_free_vars(free_vars);
+    });
+}
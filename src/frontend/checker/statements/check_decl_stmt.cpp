@@ -10,7 +10,7 @@ namespace {
     std::unique_ptr<Expr> convert_array_to_vector(ArrayExprNode* arr_node) {
         std::vector<std::unique_ptr<Expr>> elements;
         for (auto& elem : arr_node->elements) {
-            elements.push_back(std::unique_ptr<Expr>(static_cast<Expr*>(elem->clone())));
+            elements.push_back(std::move(elem));
         }
         auto vec_node = std::make_unique<VectorExprNode>(std::move(elements));
         if (arr_node->position) {
@@ -23,7 +23,7 @@ namespace {
     std::unique_ptr<Expr> convert_vector_to_array(VectorExprNode* vec_node) {
         std::vector<std::unique_ptr<Expr>> elements;
         for (auto& elem : vec_node->elements) {
-            elements.push_back(std::unique_ptr<Expr>(static_cast<Expr*>(elem->clone())));
+            elements.push_back(std::move(elem));
         }
         auto arr_node = std::make_unique<ArrayExprNode>(std::move(elements));
         if (vec_node->position) {
@@ -48,10 +48,10 @@ std::shared_ptr<nv::Type>& check_decl_stmt(nv::Checker* ch, Node* node) {
         auto free_in_env = ch->get_free_vars_in_env();
         auto generalized = ch->unify_ctx.generalize(inferred_type, free_in_env);
         
-        ch->scope->put_key(name->symbol, generalized, decl->constant);
+        ch->scope.put_key(name->symbol_id, generalized, decl->constant);
         
         // Retornar referência ao tipo no namespace
-        return ch->scope->get_key(name->symbol);
+        return ch->scope.get_key(name->symbol_id);
     } else {
         // Tipo explícito - usar verificação tradicional com unificação
         
@@ -110,7 +110,7 @@ std::shared_ptr<nv::Type>& check_decl_stmt(nv::Checker* ch, Node* node) {
         
         // Resolver tipo após unificação
         dtype = ch->unify_ctx.resolve(dtype);
-        ch->scope->put_key(name->symbol, dtype, decl->constant);
-        return ch->scope->get_key(name->symbol);
+        ch->scope.put_key(name->symbol_id, dtype, decl->constant);
+        return ch->scope.get_key(name->symbol_id);
     }
 }
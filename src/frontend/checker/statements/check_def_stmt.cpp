@@ -49,7 +49,7 @@ std::shared_ptr<nv::Type>& check_def_stmt(nv::Checker* ch, Node* node) {
         }
         
         // Adicionar parâmetro ao escopo
-        ch->scope->put_key(param_name, param_type, false);
+        ch->scope.put_key(param_name, param_type, false);
         param_types.push_back(param_type);
     }
     
@@ -83,13 +83,13 @@ std::shared_ptr<nv::Type>& check_def_stmt(nv::Checker* ch, Node* node) {
     auto generalized_return = ch->unify_ctx.generalize(return_type, free_vars);
     
     // Criar tipo de função (usar Def ao invés de Function)
-    auto func_type = std::make_shared<nv::Def>(param_types, generalized_return);
+    auto func_type = nv::make_def_type(param_types, generalized_return);
     
     // Generalizar tipo de função
     auto generalized_func = ch->unify_ctx.generalize(func_type, free_vars);
     
     // Registrar função no escopo
-    ch->scope->put_key(def_stmt->name, generalized_func, false);
+    ch->scope.put_key(def_stmt->name, generalized_func, false);
     
-    return ch->scope->get_key(def_stmt->name);
+    return ch->scope.get_key(def_stmt->name);
 }
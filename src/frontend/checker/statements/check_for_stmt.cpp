@@ -1,10 +1,17 @@
 #include "frontend/checker/statements/check_for_stmt.hpp"
 #include "frontend/ast/statements/for_stmt_node.hpp"
 #include "frontend/ast/expressions/identifier_node.hpp"
+#include "frontend/ast/expressions/call_expr_node.hpp"
 #include "frontend/ast/expressions/range_expr_node.hpp"
 #include "frontend/checker/unification.hpp"
 #include <stdexcept>
 
+// `for linha in read_lines()`: elementos são sempre strings (lidas sob demanda)
+static bool is_read_lines_call(Node* iterable) {
+    if (!iterable || iterable->kind != NodeType::CallExpression) return false;
+    return static_cast<CallExprNode*>(iterable)->resolve_builtin() == BuiltinId::ReadLines;
+}
+
 std::shared_ptr<nv::Type>& check_for_stmt(nv::Checker* ch, Node* node) {
     auto* for_stmt = static_cast<ForStmtNode*>(node);
     
@@ -48,7 +55,7 @@ std::shared_ptr<nv::Type>& check_for_stmt(nv::Checker* ch, Node* node) {
             for (auto& binding : for_stmt->bindings) {
                 if (binding->kind == NodeType::Identifier) {
                     auto* id = static_cast<IdentifierNode*>(binding.get());
-                    ch->scope->put_key(id->symbol, start_type, false);
+                    ch->scope.put_key(id->symbol_id, start_type, false);
                 }
             }
         } else if (for_stmt->iterable) {
@@ -75,6 +82,8 @@ std::shared_ptr<nv::Type>& check_for_stmt(nv::Checker* ch, Node* node) {
             if (iterable_type->kind == nv::Kind::ARRAY) {
                 auto* arr = static_cast<nv::Array*>(iterable_type.get());
                 element_type = arr->element_type;
+            } else if (iterable_type->kind == nv::Kind::VECTOR && is_read_lines_call(for_stmt->iterable.get())) {
+                element_type = ch->gettyptr("string");
             } else if (iterable_type->kind == nv::Kind::VECTOR) {
                 // Vector pode ter elementos heterogêneos, usar tipo genérico
                 int next_id = ch->unify_ctx.get_next_var_id();
@@ -88,7 +97,7 @@ std::shared_ptr<nv::Type>& check_for_stmt(nv::Checker* ch, Node* node) {
                     map->key_type,
                     map->value_type
                 };
-                element_type = std::make_shared<nv::Tuple>(tuple_types);
+                element_type = nv::make_tuple_type(tuple_types);
             } else if (iterable_type->kind == nv::Kind::TUPLE) {
                 // Para Tuple, usar tipo genérico já que pode ter múltiplos elementos
                 int next_id = ch->unify_ctx.get_next_var_id();
@@ -99,7 +108,7 @@ std::shared_ptr<nv::Type>& check_for_stmt(nv::Checker* ch, Node* node) {
             for (auto& binding : for_stmt->bindings) {
                 if (binding->kind == NodeType::Identifier) {
                     auto* id = static_cast<IdentifierNode*>(binding.get());
-                    ch->scope->put_key(id->symbol, element_type, false);
+                    ch->scope.put_key(id->symbol_id, element_type, false);
                 }
             }
         } else {
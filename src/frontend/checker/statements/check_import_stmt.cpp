@@ -9,8 +9,9 @@
 #include "frontend/parser/parser.hpp"
 #include "frontend/checker/checker.hpp"
 #include "frontend/checker/checker_meth.hpp"
+#include "frontend/checker/interface.hpp"
 #include <filesystem>
-#include <fstream>
+#include <optional>
 #include <regex>
 #include <set>
 #include <sstream>
@@ -148,16 +149,10 @@ namespace {
         ch->reported_errors.insert(error_key_ptr);
         
         if (import_line > 0) {
-            // Ler as linhas do arquivo para mostrar contexto
-            std::ifstream file(import_filename);
-            std::vector<std::string> file_lines;
-            if (file.is_open()) {
-                std::string line;
-                while (std::getline(file, line)) {
-                    file_lines.push_back(line);
-                }
-                file.close();
-            }
+            // Contexto vem do buffer já mapeado no SourceManager (sem reler o arquivo)
+            const SourceManager& sources = SourceManager::instance();
+            std::optional<FileId> import_file = sources.find(import_filename);
+            size_t file_line_count = import_file ? sources.line_count(*import_file) : 0;
             
             size_t module_string_length = import_stmt->module_path.length() + 2; // +2 para as aspas
 
@@ -166,8 +161,8 @@ namespace {
                       << message << ANSI_RESET << "\n";
             
             // Mostrar contexto do erro (linha do import)
-            if (import_line > 0 && import_line <= file_lines.size()) {
-                std::string line_content = file_lines[import_line - 1];
+            if (import_line > 0 && import_line <= file_line_count) {
+                std::string line_content(sources.line(*import_file, import_line));
                 std::replace(line_content.begin(), line_content.end(), '\n', ' ');
                 std::cerr << " " << import_line << " |   " << line_content << "\n";
                 
@@ -235,12 +230,43 @@ namespace {
     
     // Verifica se um identificador existe no escopo atual ou em escopos pais
     bool identifier_exists(nv::Checker* checker, const std::string& symbol) {
-        try {
-            checker->scope->get_key(symbol);
-            return true;
-        } catch (std::runtime_error&) {
-            return false;
+        return checker->scope.find(intern_symbol(symbol)) != nullptr;
+    }
+
+    // Funções exportadas são constantes; variáveis não
+    bool is_constant_export(const std::shared_ptr<nv::Type>& type) {
+        if (type->kind == nv::Kind::POLY_TYPE) {
+            return std::static_pointer_cast<nv::PolyType>(type)->body->kind == nv::Kind::DEF;
+        }
+        return type->kind == nv::Kind::DEF;
+    }
+
+    // Registra o módulo importado e as dependências dele entre as do checker
+    void record_dependency(nv::Checker* ch, const std::string& path, uint64_t hash,
+                           const std::vector<nv::InterfaceDependency>& transitive) {
+        auto add = [ch](const nv::InterfaceDependency& dep) {
+            for (const auto& known : ch->module_dependencies) {
+                if (known.path == dep.path) return;
+            }
+            ch->module_dependencies.push_back(dep);
+        };
+        add({path, hash});
+        for (const auto& dep : transitive) add(dep);
+    }
+
+    // Interface com todos os símbolos exportados; sem ela (algum nome sem tipo
+    // no escopo do módulo) o próximo import volta a verificar o fonte
+    void emit_interface(nv::Checker& module_checker, const std::string& full_path, uint64_t hash,
+                        const std::set<std::string>& exported_symbols) {
+        nv::ModuleInterface iface;
+        iface.source_hash = hash;
+        iface.dependencies = module_checker.module_dependencies;
+        for (const auto& name : exported_symbols) {
+            auto* type = module_checker.scope.find(intern_symbol(name));
+            if (!type || !*type) return;
+            iface.exports.push_back({name, *type, is_constant_export(*type)});
         }
+        nv::write_interface(nv::interface_path(full_path), iface);
     }
 }
 
@@ -274,9 +300,7 @@ std::shared_ptr<nv::Type>& check_import_stmt(nv::Checker* ch, Node* node) {
         bool all_registered = true;
         for (const auto& item : import_stmt->imports) {
             std::string scope_name = item.alias.empty() ? item.name : item.alias;
-            try {
-                ch->scope->get_key(scope_name);
-            } catch (std::runtime_error&) {
+            if (!identifier_exists(ch, scope_name)) {
                 all_registered = false;
                 break;
             }
@@ -324,19 +348,38 @@ std::shared_ptr<nv::Type>& check_import_stmt(nv::Checker* ch, Node* node) {
     
     // Carregar o módulo e verificar se os símbolos importados existem
     try {
-        // Ler o arquivo
-        std::ifstream file(full_path);
-        if (!file.is_open()) {
+        // O ModuleManager já mapeou o arquivo; load_file devolve o mesmo buffer
+        FileId module_file;
+        try {
+            module_file = SourceManager::instance().load_file(full_path);
+        } catch (const std::runtime_error&) {
             std::ostringstream oss;
             oss << "Failed to open file " << ANSI_BOLD << ANSI_WHITE << module_path << ANSI_RESET;
             report_import_error(ch, import_stmt, oss.str());
             return ch->gettyptr("void");
         }
-        std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-        file.close();
         
+        // Módulo inalterado desde a última verificação: tipos vêm da interface (.nvi)
+        uint64_t module_hash = nv::hash_source(SourceManager::instance().buffer(module_file));
+        auto fresh_var = [ch]() { return ch->unify_ctx.new_type_var(); };
+        if (auto iface = nv::load_current_interface(full_path, module_hash, fresh_var)) {
+            record_dependency(ch, full_path, module_hash, iface->dependencies);
+            for (const auto& item : import_stmt->imports) {
+                const auto* exported = iface->find(item.name);
+                if (!exported) {
+                    std::ostringstream oss;
+                    oss << "Identifier '" << item.name << "' not found.";
+                    report_import_error(ch, import_stmt, oss.str(), &item);
+                    continue;
+                }
+                std::string scope_name = item.alias.empty() ? item.name : item.alias;
+                ch->scope.put_key(scope_name, exported->type, exported->constant);
+            }
+            return ch->gettyptr("void");
+        }
+
         // Fazer parsing do módulo
-        Lexer lexer(source, full_path);
+        Lexer lexer(module_file);
         auto tokens = lexer.tokenize();
         auto import_infos = lexer.get_import_infos();
         
@@ -364,6 +407,9 @@ std::shared_ptr<nv::Type>& check_import_stmt(nv::Checker* ch, Node* node) {
             // O erro já foi reportado pelo checker do módulo
             return ch->gettyptr("void");
         }
+
+        record_dependency(ch, full_path, module_hash, module_checker.module_dependencies);
+        emit_interface(module_checker, full_path, module_hash, exported_symbols);
         
         // Verificar se cada símbolo importado existe no módulo e registrar no escopo
         for (const auto& item : import_stmt->imports) {
@@ -380,15 +426,10 @@ std::shared_ptr<nv::Type>& check_import_stmt(nv::Checker* ch, Node* node) {
             bool symbol_found = false;
             
             try {
-                auto& scope_type = module_checker.scope->get_key(item.name);
+                auto& scope_type = module_checker.scope.get_key(item.name);
                 symbol_type = scope_type;
                 // Verificar se é função (constante) ou variável
-                if (scope_type->kind == nv::Kind::POLY_TYPE) {
-                    auto poly = std::static_pointer_cast<nv::PolyType>(scope_type);
-                    is_constant = (poly->body->kind == nv::Kind::DEF);
-                } else {
-                    is_constant = (scope_type->kind == nv::Kind::DEF);
-                }
+                is_constant = is_constant_export(scope_type);
                 symbol_found = true;
             } catch (std::runtime_error&) {
                 // Se não encontrou no escopo, procurar no AST como fallback
@@ -428,7 +469,7 @@ std::shared_ptr<nv::Type>& check_import_stmt(nv::Checker* ch, Node* node) {
                             auto return_type = module_checker.gettyptr(def->return_type);
                             
                             // Criar tipo de função
-                            symbol_type = std::make_shared<nv::Def>(param_types, return_type);
+                            symbol_type = nv::make_def_type(param_types, return_type);
                             
                             is_constant = true;  // Funções são constantes
                             symbol_found = true;
@@ -466,7 +507,7 @@ std::shared_ptr<nv::Type>& check_import_stmt(nv::Checker* ch, Node* node) {
             std::string scope_name = item.alias.empty() ? item.name : item.alias;
             
             // Registrar o símbolo no escopo atual usando o alias (ou nome original)
-            ch->scope->put_key(scope_name, symbol_type, is_constant);
+            ch->scope.put_key(scope_name, symbol_type, is_constant);
         }
         
         // Verificação de conflitos removida:
@@ -14,12 +14,7 @@
 namespace {
     // Helper: verifica se um identifier existe no escopo atual ou em escopos pais
     bool identifier_exists(nv::Checker* checker, const std::string& symbol) {
-        try {
-            checker->scope->get_key(symbol);
-            return true;
-        } catch (std::runtime_error&) {
-            return false;
-        }
+        return checker->scope.find(intern_symbol(symbol)) != nullptr;
     }
     
     // Converte AssignmentExpression em DeclarationStmtNode quando o identifier não existe
@@ -43,12 +38,9 @@ namespace {
         }
         
         // Identifier não existe - converter para declaração mutável com inferência automática
-        // Criar novo IdentifierNode para o target (clonar)
-        auto new_target = std::unique_ptr<Expr>(static_cast<Expr*>(id_node->clone()));
-        
-        // Clonar o value
-        auto new_value = assign_node->value ? 
-            std::unique_ptr<Expr>(static_cast<Expr*>(assign_node->value->clone())) : nullptr;
+        // O assignment é substituído pela declaração, então target e value são movidos
+        auto new_target = std::move(assign_node->target);
+        auto new_value = std::move(assign_node->value);
         
         // Criar DeclarationStmtNode com tipo "automatic" (inferência automática) e não constante (mutável)
         auto decl_node = std::make_unique<DeclarationStmtNode>(
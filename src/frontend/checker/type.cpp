@@ -3,12 +3,20 @@
 #include "frontend/ast/ast.hpp"
 #include <functional>
 #include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 std::shared_ptr<nv::Type> nv::Type::get_method(const std::string& name) const {
     if (!prototype) return nullptr;
     return prototype->get_key(name);
 }
 
+std::shared_ptr<nv::Type> nv::Vector::get_method(const std::string& name) const {
+    if (!prototype) const_cast<Vector*>(this)->init_prototype();
+    return Type::get_method(name);
+}
+
 std::string nv::Def::toString() {
     std::string s = "def(";
     for (size_t i = 0; i < paramstype.size(); ++i) {
@@ -22,6 +30,7 @@ std::string nv::Def::toString() {
 bool nv::Def::equals(const nv::Type &other) const {
     if (this->kind != other.kind) return false;
     if (other.kind != Kind::DEF) return false;
+    if (type_id && other.type_id) return type_id == other.type_id;
 
     auto other_def = dynamic_cast<const Def*>(&other);
     if (!other_def) return false;
@@ -40,6 +49,7 @@ bool nv::Def::equals(const nv::Type &other) const {
 
 bool nv::Array::equals(const nv::Type& other) const {
     if (other.kind != nv::Kind::ARRAY) return false;
+    if (type_id && other.type_id) return type_id == other.type_id;
     auto other_array = dynamic_cast<const Array*>(&other);
     if (!other_array) return false;
     return size == other_array->size && element_type->equals(*other_array->element_type);
@@ -47,6 +57,7 @@ bool nv::Array::equals(const nv::Type& other) const {
 
 bool nv::Tuple::equals(const nv::Type& other) const {
     if (other.kind != nv::Kind::TUPLE) return false;
+    if (type_id && other.type_id) return type_id == other.type_id;
     auto other_tuple = dynamic_cast<const Tuple*>(&other);
     if (!other_tuple) return false;
     if (size != other_tuple->size) return false;
@@ -58,6 +69,154 @@ bool nv::Tuple::equals(const nv::Type& other) const {
 }
 
 
+//--- TABELA DE TIPOS
+
+namespace {
+    // Chave estrutural de um tipo: o kind, os campos escalares e os ids dos
+    // filhos (que já precisam estar internados)
+    using TypeKey = std::vector<uint32_t>;
+
+    struct TypeKeyHash {
+        size_t operator()(const TypeKey& key) const {
+            uint64_t h = 1469598103934665603ull;
+            for (uint32_t v : key) {
+                h ^= v;
+                h *= 1099511628211ull;
+            }
+            return static_cast<size_t>(h);
+        }
+    };
+
+    class TypeTable {
+    public:
+        static TypeTable& instance() {
+            static TypeTable table;
+            return table;
+        }
+
+        // Tipo já internado com essa chave, ou nullptr
+        std::shared_ptr<nv::Type> find(const TypeKey& key) {
+            std::lock_guard<std::recursive_mutex> lock(mutex);
+            auto it = by_key.find(key);
+            return it == by_key.end() ? nullptr : types[it->second - 1];
+        }
+
+        // Registra `type` sob `key`; se outro tipo igual chegou antes, devolve ele
+        std::shared_ptr<nv::Type> insert(TypeKey key, std::shared_ptr<nv::Type> type) {
+            std::lock_guard<std::recursive_mutex> lock(mutex);
+            auto [it, inserted] = by_key.emplace(std::move(key), static_cast<nv::TypeId>(types.size() + 1));
+            if (!inserted) return types[it->second - 1];
+            type->type_id = it->second;
+            types.push_back(type);
+            return type;
+        }
+
+    private:
+        // Recursivo: construir um tipo pode criar outros (prototypes)
+        std::recursive_mutex mutex;
+        std::unordered_map<TypeKey, nv::TypeId, TypeKeyHash> by_key;
+        std::vector<std::shared_ptr<nv::Type>> types; // types[id - 1]
+    };
+
+    TypeKey scalar_key(nv::Kind kind) {
+        return {static_cast<uint32_t>(kind)};
+    }
+
+    template <typename T>
+    std::shared_ptr<nv::Type> singleton(nv::Kind kind) {
+        static const std::shared_ptr<nv::Type> type = TypeTable::instance().insert(scalar_key(kind), std::make_shared<T>());
+        return type;
+    }
+
+    bool all_interned(const std::vector<std::shared_ptr<nv::Type>>& types) {
+        for (const auto& t : types) {
+            if (!t || !t->type_id) return false;
+        }
+        return true;
+    }
+}
+
+namespace nv {
+    std::shared_ptr<Type> int_type() { return singleton<Int>(Kind::INT); }
+    std::shared_ptr<Type> float_type() { return singleton<Float>(Kind::FLOAT); }
+    std::shared_ptr<Type> string_type() { return singleton<String>(Kind::STRING); }
+    std::shared_ptr<Type> bool_type() { return singleton<Boolean>(Kind::BOOL); }
+    std::shared_ptr<Type> void_type() { return singleton<Void>(Kind::VOID); }
+
+    std::shared_ptr<Type> make_array_type(const std::shared_ptr<Type>& elem, size_t size) {
+        if (!elem || !elem->type_id) return std::make_shared<Array>(elem, size);
+        TypeKey key = {static_cast<uint32_t>(Kind::ARRAY), elem->type_id,
+                       static_cast<uint32_t>(size), static_cast<uint32_t>(static_cast<uint64_t>(size) >> 32)};
+        auto& table = TypeTable::instance();
+        if (auto found = table.find(key)) return found;
+        return table.insert(std::move(key), std::make_shared<Array>(elem, size));
+    }
+
+    std::shared_ptr<Type> make_tuple_type(const std::vector<std::shared_ptr<Type>>& elems) {
+        if (!all_interned(elems)) return std::make_shared<Tuple>(elems);
+        TypeKey key = {static_cast<uint32_t>(Kind::TUPLE)};
+        for (const auto& e : elems) key.push_back(e->type_id);
+        auto& table = TypeTable::instance();
+        if (auto found = table.find(key)) return found;
+        return table.insert(std::move(key), std::make_shared<Tuple>(elems));
+    }
+
+    std::shared_ptr<Type> make_map_type(const std::shared_ptr<Type>& key_type, const std::shared_ptr<Type>& value_type) {
+        if (!key_type || !value_type || !key_type->type_id || !value_type->type_id) {
+            return std::make_shared<Map>(key_type, value_type);
+        }
+        TypeKey key = {static_cast<uint32_t>(Kind::MAP), key_type->type_id, value_type->type_id};
+        auto& table = TypeTable::instance();
+        if (auto found = table.find(key)) return found;
+        return table.insert(std::move(key), std::make_shared<Map>(key_type, value_type));
+    }
+
+    std::shared_ptr<Type> make_def_type(const std::vector<std::shared_ptr<Type>>& params, const std::shared_ptr<Type>& ret) {
+        if (!ret || !ret->type_id || !all_interned(params)) return std::make_shared<Def>(params, ret);
+        TypeKey key = {static_cast<uint32_t>(Kind::DEF), ret->type_id};
+        for (const auto& p : params) key.push_back(p->type_id);
+        auto& table = TypeTable::instance();
+        if (auto found = table.find(key)) return found;
+        return table.insert(std::move(key), std::make_shared<Def>(params, ret));
+    }
+
+    std::shared_ptr<Type> intern_type(const std::shared_ptr<Type>& t) {
+        if (!t || t->type_id) return t;
+        switch (t->kind) {
+            case Kind::INT: return int_type();
+            case Kind::FLOAT: return float_type();
+            case Kind::STRING: return string_type();
+            case Kind::BOOL: return bool_type();
+            case Kind::VOID: return void_type();
+            case Kind::ARRAY: {
+                auto a = std::static_pointer_cast<Array>(t);
+                return make_array_type(intern_type(a->element_type), a->size);
+            }
+            case Kind::TUPLE: {
+                auto tu = std::static_pointer_cast<Tuple>(t);
+                std::vector<std::shared_ptr<Type>> elems;
+                elems.reserve(tu->element_type.size());
+                for (const auto& e : tu->element_type) elems.push_back(intern_type(e));
+                return make_tuple_type(elems);
+            }
+            case Kind::MAP: {
+                auto m = std::static_pointer_cast<Map>(t);
+                return make_map_type(intern_type(m->key_type), intern_type(m->value_type));
+            }
+            case Kind::DEF: {
+                auto d = std::static_pointer_cast<Def>(t);
+                std::vector<std::shared_ptr<Type>> params;
+                params.reserve(d->paramstype.size());
+                for (const auto& p : d->paramstype) params.push_back(intern_type(p));
+                return make_def_type(params, intern_type(d->returntype));
+            }
+            default:
+                // Variáveis, esquemas e vectors com prototype próprio ficam de fora
+                return t;
+        }
+    }
+}
+
 //--- PROTOTYPES
 
 namespace nv { 
@@ -109,6 +268,22 @@ namespace nv {
         std::vector<std::shared_ptr<nv::Type>> pop_params = {};
         auto pop_type = std::make_shared<nv::Def>(pop_params, pop_return_type);
         prototype->put_key("pop", pop_type, true);
+
+        // Métodos data-parallel (runtime: vector_parallel.c). O callback é uma função
+        // do usuário; map/filter/sort devolvem um novo vector com prototype próprio
+        auto result_vector = std::make_shared<nv::Vector>(nv::Vector::Deferred{});
+        prototype->put_key("map", make_native_def({std::make_shared<nv::TypeVar>(-3)}, result_vector), true);
+        prototype->put_key("filter", make_native_def({std::make_shared<nv::TypeVar>(-4)}, result_vector), true);
+        prototype->put_key("reduce", make_native_def(
+            {std::make_shared<nv::TypeVar>(-5), std::make_shared<nv::TypeVar>(-6)},
+            std::make_shared<nv::TypeVar>(-7)), true);
+        prototype->put_key("sort", make_native_def({}, result_vector), true);
+        prototype->put_key("sum", make_native_def({}, std::make_shared<nv::TypeVar>(-8)), true);
+        prototype->put_key("min", make_native_def({}, std::make_shared<nv::TypeVar>(-9)), true);
+        prototype->put_key("max", make_native_def({}, std::make_shared<nv::TypeVar>(-10)), true);
+        prototype->put_key("dot", make_native_def({std::make_shared<nv::TypeVar>(-11)}, std::make_shared<nv::TypeVar>(-12)), true);
+        prototype->put_key("scale", make_native_def({std::make_shared<nv::TypeVar>(-13)}, result_vector), true);
+        prototype->put_key("add", make_native_def({std::make_shared<nv::TypeVar>(-14)}, result_vector), true);
     }
 
     void Tuple::init_prototype() {
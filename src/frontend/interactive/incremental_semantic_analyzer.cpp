@@ -65,7 +65,7 @@ IncrementalAnalysisResult IncrementalSemanticAnalyzer::analyze(const ExecutionUn
     // 4) Extract inferred types for defined symbols from checker scope.
     for (const auto& def : unit.defined_symbols()) {
         try {
-            auto& ty = checker_.scope->get_key(def);
+            auto& ty = checker_.scope.get_key(def);
             out.defined_symbol_types.emplace(def, ty);
         } catch (...) {
             // Leave missing types absent.
@@ -131,6 +131,10 @@ void InteractiveOrchestrator::reset() {
     engine_ = std::make_unique<Engine>();
 }
 
+void InteractiveOrchestrator::wait_for_tier_up() {
+    engine_->jit.wait_for_tier_up();
+}
+
 SessionManager& InteractiveOrchestrator::session_manager() {
     return engine_->session;
 }
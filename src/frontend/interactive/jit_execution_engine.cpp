@@ -1,5 +1,7 @@
 #include "frontend/interactive/jit_execution_engine.hpp"
 
+#include <cstdlib>
+#include <cstring>
 #include <stdexcept>
 
 #include <mutex>
@@ -7,11 +9,25 @@
 #include <string>
 #include <variant>
 
+#include <llvm/Analysis/CGSCCPassManager.h>
+#include <llvm/Analysis/LoopAnalysisManager.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/ExecutionEngine/Orc/CompileOnDemandLayer.h>
+#include <llvm/ExecutionEngine/Orc/CompileUtils.h>
+#include <llvm/ExecutionEngine/Orc/IndirectionUtils.h>
 #include <llvm/ExecutionEngine/Orc/LLJIT.h>
 #include <llvm/ExecutionEngine/Orc/Core.h>
 #include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/IR/MDBuilder.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/PassManager.h>
+#include <llvm/Passes/PassBuilder.h>
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Target/TargetMachine.h>
+#include <llvm/Transforms/Utils/Cloning.h>
 
 // Runtime initialization
 extern "C" {
@@ -22,14 +38,140 @@ extern "C" {
     void create_bool(void*, int);
     void nv_write(void*);
     void nv_write_no_nl(void*);
+    void nv_flush_all(void);
     void* nv_read(void);
+    int nv_in_next_line(char**);
+    void nv_read_lines(void*);
     void ensure_value_type(void*, int);
     void* nv_get_global_value(const char*);  // Nova função para buscar valores globais por nome
 }
 
 namespace narval::frontend::interactive {
 
-JitExecutionEngine::JitExecutionEngine() {
+namespace {
+
+#if LLVM_VERSION_MAJOR >= 18
+constexpr auto kBaselineCodeGen = llvm::CodeGenOptLevel::None;
+constexpr auto kOptimizedCodeGen = llvm::CodeGenOptLevel::Aggressive;
+#else
+constexpr auto kBaselineCodeGen = llvm::CodeGenOpt::None;
+constexpr auto kOptimizedCodeGen = llvm::CodeGenOpt::Aggressive;
+#endif
+
+// Module flag set on tier-1 modules; TieredCompiler picks the codegen level from it.
+constexpr const char* kTierFlag = "nv.jit.tier";
+constexpr const char* kBaselineSuffix = ".nv.t0";
+constexpr const char* kOptimizedSuffix = ".nv.t1";
+
+bool is_optimized_tier(const llvm::Module& module) {
+    auto* flag = llvm::mdconst::extract_or_null<llvm::ConstantInt>(module.getModuleFlag(kTierFlag));
+    return flag && flag->getZExtValue() == 1;
+}
+
+// Compiles tier-0 modules without codegen optimization (FastISel on x86/ARM)
+// and tier-1 modules at the aggressive level. A TargetMachine is created per
+// module, so the compiler can be shared by the REPL thread and the tier-up
+// thread.
+class TieredCompiler : public llvm::orc::IRCompileLayer::IRCompiler {
+public:
+    explicit TieredCompiler(llvm::orc::JITTargetMachineBuilder jtmb)
+        : IRCompiler(llvm::orc::irManglingOptionsFromTargetOptions(jtmb.getOptions()))
+        , jtmb_(std::move(jtmb)) {}
+
+    llvm::Expected<std::unique_ptr<llvm::MemoryBuffer>> operator()(llvm::Module& module) override {
+        auto jtmb = jtmb_;
+        jtmb.setCodeGenOptLevel(is_optimized_tier(module) ? kOptimizedCodeGen : kBaselineCodeGen);
+        auto tm = jtmb.createTargetMachine();
+        if (!tm) return tm.takeError();
+        return llvm::orc::SimpleCompiler(**tm)(module);
+    }
+
+private:
+    llvm::orc::JITTargetMachineBuilder jtmb_;
+};
+
+bool supports_stubs(const llvm::Triple& triple) {
+    return triple.getArch() == llvm::Triple::x86_64 || triple.getArch() == llvm::Triple::aarch64;
+}
+
+// User `def`s: external definitions that are not compiler-generated entry
+// points (nv.interactive.unit.*, nv.global.init.*) or reserved names.
+bool is_tierable(const llvm::Function& fn) {
+    if (fn.isDeclaration() || !fn.hasExternalLinkage()) return false;
+    const auto name = fn.getName();
+    return !name.starts_with("nv.") && !name.starts_with("__") && !name.starts_with("llvm.");
+}
+
+// Turns a clone of the fragment into a module that defines only `name`
+// (renamed to `opt_name`). Other functions become available_externally so
+// the optimizer can still inline them, while calls that survive bind to the
+// tier-0 definitions (or stubs) already in the JITDylib. Mutable globals
+// become declarations: there must be a single instance of each.
+void extract_for_tier_up(llvm::Module& module, const std::string& name, const std::string& opt_name) {
+    for (auto& fn : module) {
+        if (fn.isDeclaration() || fn.getName() == name) continue;
+        fn.setComdat(nullptr);
+        fn.setLinkage(llvm::GlobalValue::AvailableExternallyLinkage);
+    }
+
+    std::vector<llvm::GlobalVariable*> intrinsic_globals;
+    for (auto& gv : module.globals()) {
+        if (gv.isDeclaration()) continue;
+        if (gv.getName().starts_with("llvm.")) {
+            intrinsic_globals.push_back(&gv);  // global_ctors/used: already run/kept by tier 0
+            continue;
+        }
+        gv.setComdat(nullptr);
+        if (gv.isConstant()) {
+            gv.setLinkage(llvm::GlobalValue::AvailableExternallyLinkage);
+        } else {
+            gv.setInitializer(nullptr);
+            gv.setLinkage(llvm::GlobalValue::ExternalLinkage);
+        }
+    }
+    for (auto* gv : intrinsic_globals) gv->eraseFromParent();
+
+    module.getFunction(name)->setName(opt_name);
+    module.addModuleFlag(llvm::Module::Override, kTierFlag, 1);
+}
+
+void optimize_module(llvm::Module& module, llvm::TargetMachine& tm) {
+    llvm::LoopAnalysisManager lam;
+    llvm::FunctionAnalysisManager fam;
+    llvm::CGSCCAnalysisManager cgam;
+    llvm::ModuleAnalysisManager mam;
+
+    llvm::PassBuilder pb(&tm);
+    pb.registerModuleAnalyses(mam);
+    pb.registerCGSCCAnalyses(cgam);
+    pb.registerFunctionAnalyses(fam);
+    pb.registerLoopAnalyses(lam);
+    pb.crossRegisterProxies(lam, fam, cgam, mam);
+
+    auto mpm = pb.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O2);
+    mpm.run(module, mam);
+}
+
+} // namespace
+
+JitExecutionEngine::Options JitExecutionEngine::Options::from_env() {
+    Options options;
+    if (const char* env = std::getenv("NV_JIT_TIERING")) {
+        options.tiering = std::strcmp(env, "0") != 0;
+    }
+    if (const char* env = std::getenv("NV_JIT_HOT_THRESHOLD")) {
+        long long threshold = std::atoll(env);
+        if (threshold > 0) options.hot_threshold = static_cast<uint64_t>(threshold);
+    }
+    if (const char* env = std::getenv("NV_JIT_LAZY")) {
+        options.lazy = std::strcmp(env, "0") != 0;
+    }
+    return options;
+}
+
+JitExecutionEngine::JitExecutionEngine() : JitExecutionEngine(Options::from_env()) {}
+
+JitExecutionEngine::JitExecutionEngine(const Options& options) : options_(options) {
     llvm::InitializeNativeTarget();
     llvm::InitializeNativeTargetAsmPrinter();
     llvm::InitializeNativeTargetAsmParser();
@@ -37,12 +179,32 @@ JitExecutionEngine::JitExecutionEngine() {
     // Initialize Narval runtime before any JIT execution
     init_type_registry();
 
-    auto jit_or_err = llvm::orc::LLJITBuilder().create();
+    llvm::orc::LLLazyJITBuilder builder;
+    if (options_.tiering) {
+        auto jtmb = llvm::orc::JITTargetMachineBuilder::detectHost();
+        if (!jtmb) {
+            throw std::runtime_error("failed to detect host target: " + llvm::toString(jtmb.takeError()));
+        }
+        if (supports_stubs(jtmb->getTargetTriple())) {
+            jtmb->setCodeGenOptLevel(kBaselineCodeGen);
+            builder.setJITTargetMachineBuilder(std::move(*jtmb));
+            builder.setCompileFunctionCreator([](llvm::orc::JITTargetMachineBuilder jtmb)
+                -> llvm::Expected<std::unique_ptr<llvm::orc::IRCompileLayer::IRCompiler>> {
+                return std::make_unique<TieredCompiler>(std::move(jtmb));
+            });
+        } else {
+            options_.tiering = false;
+        }
+    }
+
+    auto jit_or_err = builder.create();
     if (!jit_or_err) {
         auto err = jit_or_err.takeError();
         throw std::runtime_error("failed to create LLJIT: " + llvm::toString(std::move(err)));
     }
     jit_ = std::move(*jit_or_err);
+    // One partition per requested function: a `def` is compiled on its first call.
+    jit_->setPartitionFunction(llvm::orc::CompileOnDemandLayer::compileRequested);
 
     auto gen = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
         jit_->getDataLayout().getGlobalPrefix());
@@ -79,7 +241,10 @@ JitExecutionEngine::JitExecutionEngine() {
         {"create_bool", reinterpret_cast<void*>(&::create_bool)},
         {"nv_write", reinterpret_cast<void*>(&::nv_write)},
         {"nv_write_no_nl", reinterpret_cast<void*>(&::nv_write_no_nl)},
+        {"nv_flush_all", reinterpret_cast<void*>(&::nv_flush_all)},
         {"nv_read", reinterpret_cast<void*>(&::nv_read)},
+        {"nv_in_next_line", reinterpret_cast<void*>(&::nv_in_next_line)},
+        {"nv_read_lines", reinterpret_cast<void*>(&::nv_read_lines)},
         {"ensure_value_type", reinterpret_cast<void*>(&::ensure_value_type)},
         {"init_type_registry", reinterpret_cast<void*>(&::init_type_registry)},
         {nullptr, nullptr}
@@ -98,9 +263,22 @@ JitExecutionEngine::JitExecutionEngine() {
             }
         }
     }
+
+    if (options_.tiering) {
+        stubs_ = llvm::orc::createLocalIndirectStubsManagerBuilder(jit_->getTargetTriple())();
+        promote_ = std::make_unique<llvm::orc::SymbolLinkagePromoter>();
+        tier_thread_ = std::thread([this] { tier_up_worker(); });
+    }
 }
 
-JitExecutionEngine::~JitExecutionEngine() = default;
+JitExecutionEngine::~JitExecutionEngine() {
+    {
+        std::lock_guard<std::mutex> lock(tier_mutex_);
+        tier_stop_ = true;
+    }
+    tier_cv_.notify_all();
+    if (tier_thread_.joinable()) tier_thread_.join();
+}
 
 llvm::orc::ResourceTrackerSP JitExecutionEngine::add_module(
     std::unique_ptr<llvm::Module> module,
@@ -108,20 +286,233 @@ llvm::orc::ResourceTrackerSP JitExecutionEngine::add_module(
 ) {
     if (!module || !tsc) return nullptr;
 
-    auto tracker = jit_->getMainJITDylib().createResourceTracker();
-    if (auto err = jit_->addIRModule(tracker, llvm::orc::ThreadSafeModule(std::move(module), std::move(*tsc)))) {
+    auto& dylib = jit_->getMainJITDylib();
+    auto tracker = dylib.createResourceTracker();
+    if (module->getDataLayout().isDefault()) {
+        module->setDataLayout(jit_->getDataLayout());
+    }
+    const auto add_fragment = [&](llvm::orc::ThreadSafeModule tsm) {
+        return options_.lazy ? jit_->getCompileOnDemandLayer().add(tracker, std::move(tsm))
+                             : jit_->addIRModule(tracker, std::move(tsm));
+    };
+
+    std::vector<std::string> names;
+    if (options_.tiering) {
+        for (auto& fn : *module) {
+            if (is_tierable(fn)) names.push_back(fn.getName().str());
+        }
+    }
+
+    if (names.empty()) {
+        if (auto err = add_fragment(llvm::orc::ThreadSafeModule(std::move(module), std::move(*tsc)))) {
+            throw std::runtime_error("failed to add module");
+        }
+        return tracker;
+    }
+
+    // Internal symbols get unique external names so the tier-1 copy of a
+    // function can reference the tier-0 instances instead of duplicating them.
+    (*promote_)(*module);
+    auto source = std::make_shared<llvm::orc::ThreadSafeModule>(llvm::CloneModule(*module), *tsc);
+
+    std::vector<size_t> ids;
+    {
+        std::lock_guard<std::mutex> lock(tier_mutex_);
+        for (const auto& name : names) {
+            auto fn = std::make_unique<TieredFunction>();
+            fn->name = name;
+            fn->tracker = tracker;
+            fn->source = source;
+            ids.push_back(tiered_.size());
+            tiered_.push_back(std::move(fn));
+        }
+    }
+    instrument_module(*module, names, ids);
+
+    // The original names are owned by stubs; their pointers are filled in
+    // once the tier-0 bodies have addresses.
+    llvm::orc::SymbolMap stub_symbols;
+    for (const auto& name : names) {
+        if (auto err = stubs_->createStub(name, llvm::orc::ExecutorAddr(), llvm::JITSymbolFlags::Exported)) {
+            throw std::runtime_error("failed to create stub for '" + name + "': " + llvm::toString(std::move(err)));
+        }
+        auto stub = stubs_->findStub(name, false);
+        stub_symbols[jit_->mangleAndIntern(name)] = llvm::orc::ExecutorSymbolDef(
+            stub.getAddress(), llvm::JITSymbolFlags::Exported | llvm::JITSymbolFlags::Callable);
+    }
+    if (auto err = dylib.define(llvm::orc::absoluteSymbols(std::move(stub_symbols)), tracker)) {
+        throw std::runtime_error("failed to define stubs: " + llvm::toString(std::move(err)));
+    }
+
+    if (auto err = add_fragment(llvm::orc::ThreadSafeModule(std::move(module), std::move(*tsc)))) {
         throw std::runtime_error("failed to add module");
     }
+    // In lazy mode the lookup only yields the body's compile-on-demand stub;
+    // the body itself is compiled on its first call.
+    for (const auto& name : names) {
+        auto body = jit_->lookup(name + kBaselineSuffix);
+        if (!body) {
+            throw std::runtime_error("failed to compile '" + name + "': " + llvm::toString(body.takeError()));
+        }
+        if (auto err = stubs_->updatePointer(name, *body)) {
+            throw std::runtime_error("failed to bind stub for '" + name + "': " + llvm::toString(std::move(err)));
+        }
+    }
     return tracker;
 }
 
 void JitExecutionEngine::remove_module(const llvm::orc::ResourceTrackerSP& tracker) {
     if (!tracker) return;
+    {
+        // A tier-up still in flight for this fragment must not touch the
+        // stubs afterwards: the names may be redefined by a later fragment.
+        std::lock_guard<std::mutex> lock(tier_mutex_);
+        for (auto& fn : tiered_) {
+            if (fn->alive && fn->tracker == tracker) {
+                fn->alive = false;
+                fn->tracker = nullptr;
+                fn->source = nullptr;
+            }
+        }
+    }
     if (auto err = tracker->remove()) {
         throw std::runtime_error("failed to remove module");
     }
 }
 
+// Splits each tierable function into a stub (the original name, resolved
+// through the JITDylib) and a tier-0 body `<name>.nv.t0` whose prologue bumps
+// the function's call counter and reports it once it reaches the threshold.
+void JitExecutionEngine::instrument_module(
+    llvm::Module& module,
+    const std::vector<std::string>& names,
+    const std::vector<size_t>& ids
+) {
+    auto& ctx = module.getContext();
+    auto* i64 = llvm::Type::getInt64Ty(ctx);
+    auto* ptr = llvm::PointerType::getUnqual(llvm::Type::getInt8Ty(ctx));
+    auto* hook_ty = llvm::FunctionType::get(llvm::Type::getVoidTy(ctx), {ptr, i64}, false);
+    auto* hook = llvm::ConstantExpr::getIntToPtr(
+        llvm::ConstantInt::get(i64, reinterpret_cast<uintptr_t>(&JitExecutionEngine::on_hot_function)), ptr);
+    auto* self = llvm::ConstantExpr::getIntToPtr(llvm::ConstantInt::get(i64, reinterpret_cast<uintptr_t>(this)), ptr);
+    auto* cold = llvm::MDBuilder(ctx).createBranchWeights(1, 1u << 20);
+
+    for (size_t i = 0; i < names.size(); ++i) {
+        auto* body = module.getFunction(names[i]);
+        body->setName(names[i] + kBaselineSuffix);
+        auto* stub = llvm::Function::Create(body->getFunctionType(), llvm::Function::ExternalLinkage, names[i], module);
+        body->replaceAllUsesWith(stub);
+
+        // Counter code goes after the entry allocas so they stay static.
+        auto* entry = &body->getEntryBlock();
+        auto it = entry->begin();
+        while (llvm::isa<llvm::AllocaInst>(*it) || llvm::isa<llvm::DbgInfoIntrinsic>(*it)) ++it;
+        auto* rest = entry->splitBasicBlock(it, "nv.tier.body");
+        entry->getTerminator()->eraseFromParent();
+        auto* report = llvm::BasicBlock::Create(ctx, "nv.tier.hot", body, rest);
+
+        llvm::IRBuilder<> b(entry);
+        auto* counter = llvm::ConstantExpr::getIntToPtr(
+            llvm::ConstantInt::get(i64, reinterpret_cast<uintptr_t>(&tiered_[ids[i]]->calls)), ptr);
+        auto* calls = b.CreateAtomicRMW(
+            llvm::AtomicRMWInst::Add, counter, b.getInt64(1), llvm::MaybeAlign(8), llvm::AtomicOrdering::Monotonic);
+        auto* hot = b.CreateICmpEQ(calls, b.getInt64(options_.hot_threshold - 1));
+        b.CreateCondBr(hot, report, rest, cold);
+
+        b.SetInsertPoint(report);
+        b.CreateCall(hook_ty, hook, {self, b.getInt64(ids[i])});
+        b.CreateBr(rest);
+    }
+}
+
+void JitExecutionEngine::on_hot_function(JitExecutionEngine* self, uint64_t id) {
+    {
+        std::lock_guard<std::mutex> lock(self->tier_mutex_);
+        self->tier_queue_.push_back(static_cast<size_t>(id));
+    }
+    self->tier_cv_.notify_one();
+}
+
+void JitExecutionEngine::tier_up_worker() {
+    auto jtmb = llvm::orc::JITTargetMachineBuilder::detectHost();
+    std::unique_ptr<llvm::TargetMachine> tm;
+    if (jtmb) {
+        jtmb->setCodeGenOptLevel(kOptimizedCodeGen);
+        if (auto created = jtmb->createTargetMachine()) {
+            tm = std::move(*created);
+        } else {
+            llvm::consumeError(created.takeError());
+        }
+    } else {
+        llvm::consumeError(jtmb.takeError());
+    }
+
+    std::unique_lock<std::mutex> lock(tier_mutex_);
+    for (;;) {
+        tier_cv_.wait(lock, [this] { return tier_stop_ || !tier_queue_.empty(); });
+        if (tier_stop_) return;
+        size_t id = tier_queue_.front();
+        tier_queue_.pop_front();
+        tier_busy_ = true;
+        lock.unlock();
+
+        // Without a TargetMachine the queue is drained and tier 0 stays in place.
+        if (tm) tier_up(id, *tm);
+
+        lock.lock();
+        tier_busy_ = false;
+        if (tier_queue_.empty()) tier_idle_cv_.notify_all();
+    }
+}
+
+// Recompiles one hot function at O2 and swaps its stub. Failures are not
+// reported: the tier-0 body is still correct, only slower.
+void JitExecutionEngine::tier_up(size_t id, llvm::TargetMachine& tm) {
+    std::string name;
+    llvm::orc::ResourceTrackerSP tracker;
+    std::shared_ptr<llvm::orc::ThreadSafeModule> source;
+    {
+        std::lock_guard<std::mutex> lock(tier_mutex_);
+        auto& fn = *tiered_[id];
+        if (!fn.alive || !fn.source) return;
+        name = fn.name;
+        tracker = fn.tracker;
+        source = fn.source;
+    }
+
+    const std::string opt_name = name + kOptimizedSuffix;
+    auto optimized = source->withModuleDo([&](llvm::Module& module) {
+        auto clone = llvm::CloneModule(module);
+        extract_for_tier_up(*clone, name, opt_name);
+        optimize_module(*clone, tm);
+        return llvm::orc::ThreadSafeModule(std::move(clone), source->getContext());
+    });
+
+    if (auto err = jit_->addIRModule(tracker, std::move(optimized))) {
+        llvm::consumeError(std::move(err));  // fragment removed meanwhile
+        return;
+    }
+    auto addr = jit_->lookup(opt_name);
+    if (!addr) {
+        llvm::consumeError(addr.takeError());
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(tier_mutex_);
+    auto& fn = *tiered_[id];
+    if (!fn.alive) return;
+    if (auto err = stubs_->updatePointer(name, *addr)) {
+        llvm::consumeError(std::move(err));
+        return;
+    }
+    fn.source = nullptr;
+}
+
+void JitExecutionEngine::wait_for_tier_up() {
+    std::unique_lock<std::mutex> lock(tier_mutex_);
+    tier_idle_cv_.wait(lock, [this] { return tier_stop_ || (tier_queue_.empty() && !tier_busy_); });
+}
+
 void JitExecutionEngine::execute_void_function(const std::string& name) {
     auto sym = jit_->lookup(name);
     if (!sym) {
@@ -134,9 +525,12 @@ void JitExecutionEngine::execute_void_function(const std::string& name) {
     auto* entry = reinterpret_cast<FnPtr>(static_cast<uintptr_t>(addr));
     try {
         entry();
+        nv_flush_all();   // a saída de cada entrada aparece antes do próximo prompt
     } catch (const std::exception& e) {
+        nv_flush_all();
         throw std::runtime_error("JIT execution failed: " + std::string(e.what()));
     } catch (...) {
+        nv_flush_all();
         throw std::runtime_error("JIT execution failed: unknown error");
     }
 }
@@ -0,0 +1,133 @@
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+#include "frontend/interactive/interactive_orchestrator.hpp"
+#include "test_support.hpp"
+
+namespace fs = std::filesystem;
+using namespace nv::test;
+using namespace narval::frontend::interactive;
+
+namespace {
+    fs::path dir;
+
+    // Executa `source` como o fragmento `id` (reexecutar um id redefine o
+    // fragmento, como uma célula editada) e devolve o que ele escreveu em stdout
+    std::string run(InteractiveOrchestrator& session, const std::string& id, const std::string& source) {
+        IncrementalUnit unit;
+        unit.id = id;
+        unit.virtual_filename = "jit_test_" + id;
+        unit.source = source;
+        unit.origin = Origin{Origin::Kind::ReplStep, id};
+
+        InteractiveOrchestrator::ExecuteOptions options;
+        options.auto_print_last_expr = false;
+
+        auto path = dir / "stdout.txt";
+        std::fflush(stdout);
+        int saved = dup(STDOUT_FILENO);
+        std::FILE* capture = std::fopen(path.c_str(), "wb");
+        dup2(fileno(capture), STDOUT_FILENO);
+        auto result = session.execute(unit, options);
+        std::fflush(stdout);
+        dup2(saved, STDOUT_FILENO);
+        close(saved);
+        std::fclose(capture);
+
+        if (!result.ok) return "<erro: " + result.error + ">";
+        return read_file(path);
+    }
+
+    void configure(const char* threshold, const char* lazy) {
+        setenv("NV_JIT_TIERING", "1", 1);
+        setenv("NV_JIT_HOT_THRESHOLD", threshold, 1);
+        setenv("NV_JIT_LAZY", lazy, 1);
+    }
+
+    // Uma função promovida ao tier 1 e depois redefinida: chamadas novas usam
+    // a definição nova, mesmo com o stub apontando para o código otimizado
+    void test_redefine_after_tier_up() {
+        std::cout << "redefinição depois do tier-up\n";
+        configure("10", "1");
+        InteractiveOrchestrator session;
+
+        run(session, "def", "def dobro(x: int): int { return x * 2; }");
+        check(run(session, "quente", "for i in 0..100 { dobro(i); }\nwrite(dobro(21));") == "42\n",
+              "tier 0 antes do limite");
+        session.wait_for_tier_up();
+        check(run(session, "tier1", "write(dobro(21));") == "42\n", "tier 1 dá o mesmo resultado");
+
+        run(session, "def", "def dobro(x: int): int { return x * 3; }");
+        check(run(session, "nova", "write(dobro(21));") == "63\n", "redefinição chamada depois do tier-up");
+
+        check(run(session, "quente2", "for i in 0..100 { dobro(i); }\nwrite(dobro(21));") == "63\n",
+              "definição nova também fica quente");
+        session.wait_for_tier_up();
+        check(run(session, "tier1b", "write(dobro(21));") == "63\n", "tier 1 da definição nova");
+    }
+
+    // Destruir a sessão com funções na fila (ou compilando) não pode travar
+    // nem tocar em stubs já liberados
+    void test_shutdown_pending() {
+        std::cout << "encerramento com tier-up pendente\n";
+        configure("1", "1");
+        bool ok = true;
+        for (int round = 0; round < 5; round++) {
+            InteractiveOrchestrator session;
+            std::string defs, calls;
+            for (int i = 0; i < 20; i++) {
+                auto name = "f" + std::to_string(i);
+                defs += "def " + name + "(x: int): int { return x + " + std::to_string(i) + "; }\n";
+                calls += name + "(1);\n";
+            }
+            run(session, "defs", defs);
+            ok &= run(session, "calls", calls + "write(f19(1));") == "20\n";
+            if (round % 2) run(session, "defs", "def f0(x: int): int { return x; }");
+        }
+        check(ok, "5 sessões destruídas com a fila cheia");
+
+        InteractiveOrchestrator session;
+        check(run(session, "depois", "write(40 + 2);") == "42\n", "sessão nova depois do encerramento");
+    }
+
+    // Funções definidas e nunca chamadas não são compiladas; a saída é a
+    // mesma com compilação preguiçosa ou antecipada
+    void test_lazy() {
+        std::cout << "compilação sob demanda\n";
+        for (const char* lazy : {"1", "0"}) {
+            configure("1000", lazy);
+            InteractiveOrchestrator session;
+            std::string library;
+            for (int i = 0; i < 200; i++) {
+                library += "def g" + std::to_string(i) + "(x: int): int { return x * " + std::to_string(i) + "; }\n";
+            }
+            std::string mode = std::string(" (NV_JIT_LAZY=") + lazy + ")";
+            check(run(session, "lib", library) == "", "200 funções definidas" + mode);
+            check(run(session, "uso", "write(g7(6));") == "42\n", "chamada a uma delas" + mode);
+
+            run(session, "def", "def tarde(): int { return 1; }");
+            run(session, "def", "def tarde(): int { return 2; }");
+            check(run(session, "tarde", "write(tarde());") == "2\n", "redefinida antes da primeira chamada" + mode);
+        }
+    }
+}
+
+int main() {
+    // Um tier-up que trava o encerramento derruba o teste em vez de pendurá-lo
+    alarm(300);
+    dir = temp_dir("narval_jit_test");
+
+    std::cout << "Iniciando teste do JIT interativo...\n";
+    try {
+        test_redefine_after_tier_up();
+        test_shutdown_pending();
+        test_lazy();
+    } catch (const std::exception& e) {
+        std::cerr << "Erro durante teste do JIT interativo: " << e.what() << "\n";
+        failures++;
+    }
+    fs::remove_all(dir);
+    return finish("JIT interativo");
+}
@@ -9,7 +9,7 @@ namespace narval::frontend::interactive {
 namespace {
 
 static bool is_builtin_name(const std::string& s) {
-    return s == "write" || s == "read" || s == "json";
+    return s == "write" || s == "read" || s == "json" || s == "csv" || s == "snapshot";
 }
 
 static void collect_expr_uses(const Expr* expr, std::unordered_set<std::string>& used) {
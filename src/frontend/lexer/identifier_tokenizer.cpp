@@ -1,34 +1,60 @@
 #include "frontend/lexer/identifier_tokenizer.hpp"
-#include <cctype>
+#include "frontend/lexer/char_table.hpp"
 
-Token tokenize_identifier_or_keyword(const std::string& input, size_t& pos, size_t& line, size_t& column, const std::string& filename) {
-    std::string value;
+// Palavras-chave por tamanho e primeiro caractere: no máximo duas comparações
+// de string por identificador.
+static TokenType keyword_type(std::string_view word) {
+    switch (word.size()) {
+        case 1:
+            if (word[0] == '_') return TokenType::UNDERSCORE;
+            break;
+        case 2:
+            if (word == "if") return TokenType::IF;
+            break;
+        case 3:
+            if (word == "for") return TokenType::FOR;
+            if (word == "def") return TokenType::DEF;
+            break;
+        case 4:
+            switch (word[0]) {
+                case 'e':
+                    if (word == "elif") return TokenType::ELIF;
+                    if (word == "else") return TokenType::ELSE;
+                    break;
+                case 'l':
+                    if (word == "loop") return TokenType::LOOP;
+                    if (word == "lock") return TokenType::LOCK;
+                    break;
+                case 't':
+                    if (word == "true") return TokenType::TRUE;
+                    break;
+            }
+            break;
+        case 5:
+            switch (word[0]) {
+                case 'm': if (word == "match") return TokenType::MATCH; break;
+                case 'w': if (word == "while") return TokenType::WHILE; break;
+                case 'b': if (word == "break") return TokenType::BREAK; break;
+                case 'f': if (word == "false") return TokenType::FALSE; break;
+            }
+            break;
+        case 6:
+            if (word == "return") return TokenType::RETURN;
+            break;
+        case 8:
+            if (word == "continue") return TokenType::CONTINUE;
+            break;
+    }
+    return TokenType::IDENTIFIER;
+}
+
+Token tokenize_identifier_or_keyword(std::string_view input, size_t& pos, size_t& line, size_t& column, FileId file) {
     size_t start_column = column;
     size_t start_position = pos;
 
-    while (pos < input.size() && (std::isalnum(input[pos]) || input[pos] == '_')) {
-        value += input[pos];
-        ++pos;
-        ++column;
-    }
-
-    TokenType type = TokenType::IDENTIFIER;
-    
-         if (value == "if") type = TokenType::IF;
-    else if (value == "elif") type = TokenType::ELIF;
-    else if (value == "else") type = TokenType::ELSE;
-    else if (value == "match") type = TokenType::MATCH;
-    else if (value == "for") type = TokenType::FOR;
-    else if (value == "while") type = TokenType::WHILE;
-    else if (value == "loop") type = TokenType::LOOP;
-    else if (value == "break") type = TokenType::BREAK;
-    else if (value == "continue") type = TokenType::CONTINUE;
-    else if (value == "lock") type = TokenType::LOCK;
-    else if (value == "def") type = TokenType::DEF;
-    else if (value == "return") type = TokenType::RETURN;
-    else if (value == "true") type = TokenType::TRUE;
-    else if (value == "false") type = TokenType::FALSE;
-    else if (value == "_") type = TokenType::UNDERSCORE;
+    pos = scan_identifier(input, pos);
+    column += pos - start_position;
+    std::string_view value = input.substr(start_position, pos - start_position);
 
-    return Token(type, value, line, start_column, column, start_position, pos, filename);
+    return Token(keyword_type(value), value.data(), value.size(), line, start_column, column, start_position, pos, file);
 }
@@ -3,50 +3,18 @@
 #include "frontend/lexer/operator_tokenizer.hpp"
 #include "frontend/lexer/number_tokenizer.hpp"
 #include "frontend/lexer/string_tokenizer.hpp"
+#include "frontend/lexer/char_table.hpp"
 
 Lexer::Lexer(std::string src, std::string file)
-    : input(std::move(src)), filename(std::move(file)), current(input.cbegin()), line(1), column(1), position(0)
+    : Lexer(SourceManager::instance().add_buffer(std::move(file), std::move(src)))
 {
-    operators = {
-        {"=", "="},
-        {";", ";"},
-        {":", ":"},
-        {",", ","},
-        {".", "."},
-        {"(", "("},
-        {")", ")"},
-        {"{", "{"},
-        {"}", "}"},
-        {"[", "["},
-        {"]", "]"},
-        {"+", "+"},
-        {"-", "-"},
-        {"*", "*"},
-        {"/", "/"},
-        {"%", "%"},
-        {"**", "**"},
-        {"--", "--"},
-        {"++", "++"},
-        {"//", "//"},
-        {"&&", "&&"},
-        {"||", "||"},
-        {"==", "=="},
-        {"!=", "!="},
-        {"<=", "<="},
-        {">=", ">="},
-        {"->", "->"},
-        {"..", ".."},
-        {"..=", "..="},
-        {"...", "..."},
-        {"+=", "+="},
-        {"-=", "-="},
-        {"*=", "*="},
-        {"/=", "/="},
-        {"//=", "//="},
-        {"**=", "**="},
-        {"%=", "%="},
-    };
+}
 
+Lexer::Lexer(FileId file)
+    : file_id(file),
+      input(SourceManager::instance().buffer(file_id)),
+      filename(SourceManager::instance().filename(file_id)), current(input.cbegin()), line(1), column(1), position(0)
+{
     size_t last_slash = filename.find_last_of("/\\");
     size_t last_dot = filename.find_last_of(".");
     if (last_dot != std::string::npos) {
@@ -92,26 +60,13 @@ void Lexer::advance()
 
 void Lexer::skip_whitespace()
 {
-    while (!is_eof() && std::isspace(peek()))
-    {
-        advance();
-    }
+    position = skip_spaces(input, position, line, column);
+    current = input.cbegin() + position;
 }
 
 bool Lexer::is_operator_start(char c)
 {
-    return operators.find(std::string(1, c)) != operators.end() ||
-           c == '!' ||
-           c == '<' ||
-           c == '>' ||
-           c == '.' ||
-           c == '*' ||
-           c == ':' ||
-           c == '|' ||
-           c == '&' ||
-           c == '%' ||
-           c == '+' ||
-           c == '-';
+    return char_is(c, CHAR_OPERATOR);
 }
 
 const std::vector<std::string>& Lexer::get_imported_modules() const { return imported_modules; }
@@ -121,6 +76,7 @@ const std::string& Lexer::get_module_name() const { return module_name; }
 std::vector<Token> Lexer::tokenize()
 {
     std::vector<Token> tokens;
+    tokens.reserve(input.size() / 8 + 16);
 
     while (!is_eof())
     {
@@ -134,19 +90,16 @@ std::vector<Token> Lexer::tokenize()
         // ignore comments
         if (c == '#' && std::distance(current, input.cend()) > 1)
         {
-            advance();
-            
-            while (!is_eof() && peek() != '\n')
-            {
-                advance();
-            }
-            
+            size_t line_end = find_line_end(input, position);
+            column += line_end - position;
+            position = line_end;
+            current = input.cbegin() + position;
             continue;
         }
 
         // strings
-        if (c == '"' || c == '\'') {
-            tokens.push_back(tokenize_string(input, position, line, column, filename));
+        if (char_is(c, CHAR_QUOTE)) {
+            tokens.push_back(tokenize_string(input, position, line, column, file_id));
             current = input.cbegin() + position;
             continue;
         }
@@ -170,17 +123,17 @@ std::vector<Token> Lexer::tokenize()
                 current = input.cbegin() + position;
             } else {
                 // Tokeniza a string do módulo
-                Token module_token = tokenize_string(input, position, line, column, filename);
+                Token module_token = tokenize_string(input, position, line, column, file_id);
                 current = input.cbegin() + position;
                 
-                std::string module_path = module_token.lexeme;
+                std::string module_path = module_token.string_value();
                 
                 skip_whitespace();
                 
                 // Verifica se há "import"
                 if (is_eof() || std::distance(current, input.cend()) < 6 || 
                     input.substr(position, 6) != "import") {
-                    tokens.emplace_back(TokenType::UNKNOWN, "from " + module_path, start_line, start_col, column, start_pos, position, filename);
+                    tokens.emplace_back(TokenType::UNKNOWN, input.data() + start_pos, position - start_pos, start_line, start_col, column, start_pos, position, file_id);
                     continue;
                 }
                 
@@ -196,15 +149,15 @@ std::vector<Token> Lexer::tokenize()
                     if (peek() == ';') break;
                     
                     // Tokeniza identificador
-                    Token ident_token = tokenize_identifier_or_keyword(input, position, line, column, filename);
+                    Token ident_token = tokenize_identifier_or_keyword(input, position, line, column, file_id);
                     current = input.cbegin() + position;
                     
                     if (ident_token.type != TokenType::IDENTIFIER) {
-                        tokens.emplace_back(TokenType::UNKNOWN, "from " + module_path + " import ...", start_line, start_col, column, start_pos, position, filename);
+                        tokens.emplace_back(TokenType::UNKNOWN, input.data() + start_pos, position - start_pos, start_line, start_col, column, start_pos, position, file_id);
                         break;
                     }
                     
-                    std::string import_name = ident_token.lexeme;
+                    std::string import_name(ident_token.lexeme());
                     std::string alias;
                     size_t item_line = ident_token.line;
                     size_t item_col_start = ident_token.column_start;
@@ -215,21 +168,21 @@ std::vector<Token> Lexer::tokenize()
                     // Verifica se há "as" (precisa ser uma palavra completa)
                     if (!is_eof() && std::distance(current, input.cend()) >= 2 && 
                         input.substr(position, 2) == "as" &&
-                        (position + 2 >= input.size() || !std::isalnum(input[position + 2]))) {
+                        (position + 2 >= input.size() || !char_is(input[position + 2], CHAR_IDENT) || input[position + 2] == '_')) {
                         // Consome "as"
                         for (int i = 0; i < 2; ++i) advance();
                         skip_whitespace();
                         
                         // Tokeniza o alias
-                        Token alias_token = tokenize_identifier_or_keyword(input, position, line, column, filename);
+                        Token alias_token = tokenize_identifier_or_keyword(input, position, line, column, file_id);
                         current = input.cbegin() + position;
                         
                         if (alias_token.type != TokenType::IDENTIFIER) {
-                            tokens.emplace_back(TokenType::UNKNOWN, "from " + module_path + " import " + import_name + " as ...", start_line, start_col, column, start_pos, position, filename);
+                            tokens.emplace_back(TokenType::UNKNOWN, input.data() + start_pos, position - start_pos, start_line, start_col, column, start_pos, position, file_id);
                             break;
                         }
                         
-                        alias = alias_token.lexeme;
+                        alias = std::string(alias_token.lexeme());
                         // Usar posição do alias se houver
                         item_line = alias_token.line;
                         item_col_start = alias_token.column_start;
@@ -247,7 +200,7 @@ std::vector<Token> Lexer::tokenize()
                         skip_whitespace();
                     } else if (!is_eof() && peek() != ';') {
                         // Erro de sintaxe
-                        tokens.emplace_back(TokenType::UNKNOWN, "from " + module_path + " import ...", start_line, start_col, column, start_pos, position, filename);
+                        tokens.emplace_back(TokenType::UNKNOWN, input.data() + start_pos, position - start_pos, start_line, start_col, column, start_pos, position, file_id);
                         break;
                     }
                 }
@@ -258,7 +211,7 @@ std::vector<Token> Lexer::tokenize()
                 }
                 
                 // Cria token de importação e armazena informações
-                tokens.emplace_back(TokenType::IMPORT, "from " + module_path + " import ...", start_line, start_col, column, start_pos, position, filename);
+                tokens.emplace_back(TokenType::IMPORT, input.data() + start_pos, position - start_pos, start_line, start_col, column, start_pos, position, file_id);
                 import_infos.push_back(import_info);
                 
                 // Mantém compatibilidade com código antigo
@@ -269,17 +222,17 @@ std::vector<Token> Lexer::tokenize()
         }
 
         // identifiers or keywords
-        if (std::isalpha(c) || c == '_')
+        if (char_is(c, CHAR_IDENT_START))
         {
-            tokens.push_back(tokenize_identifier_or_keyword(input, position, line, column, filename));
+            tokens.push_back(tokenize_identifier_or_keyword(input, position, line, column, file_id));
             current = input.cbegin() + position;
             continue;
         }
 
         // numbers
-        if (std::isdigit(c) || (c == '-' && std::distance(current, input.cend()) > 1 && std::isdigit(*(current + 1))))
+        if (char_is(c, CHAR_DIGIT) || (c == '-' && std::distance(current, input.cend()) > 1 && char_is(*(current + 1), CHAR_DIGIT)))
         {
-            tokens.push_back(tokenize_number(input, position, line, column, filename));
+            tokens.push_back(tokenize_number(input, position, line, column, file_id));
             current = input.cbegin() + position;
             continue;
         }
@@ -287,7 +240,7 @@ std::vector<Token> Lexer::tokenize()
         // operators
         if (is_operator_start(c))
         {
-            tokens.push_back(tokenize_operator(input, position, line, column, filename));
+            tokens.push_back(tokenize_operator(input, position, line, column, file_id));
             current = input.cbegin() + position;
             continue;
         }
@@ -295,11 +248,10 @@ std::vector<Token> Lexer::tokenize()
         // unknown character
         size_t start_col = column;
         size_t start_pos = position;
-        char ch = peek();
         advance();
-        tokens.emplace_back(TokenType::UNKNOWN, std::string(1, ch), line, start_col, column, start_pos, position, filename);
+        tokens.emplace_back(TokenType::UNKNOWN, input.data() + start_pos, 1, line, start_col, column, start_pos, position, file_id);
     }
 
-    tokens.emplace_back(TokenType::EOF_TOKEN, "EOF", line, column, column, position, position, filename);
+    tokens.emplace_back(TokenType::EOF_TOKEN, "EOF", 3, line, column, column, position, position, file_id);
     return tokens;
 }
\ No newline at end of file
@@ -34,7 +34,7 @@ int main(int argc, char* argv[]) {
             std::cout << "Tokens:\n";
             for (const auto& token : module.tokens) {
                 std::cout << "  Token: " << get_token_name(token.type)
-                    << ", Lexeme: '" << token.lexeme
+                    << ", Lexeme: '" << token.lexeme()
                     << "', Line: " << token.line
                     << ", Col: " << token.column_start << "-" << token.column_end
                     << std::endl;
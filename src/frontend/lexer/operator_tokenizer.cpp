@@ -1,223 +1,100 @@
 #include "frontend/lexer/operator_tokenizer.hpp"
 #include "frontend/lexer/lexer.hpp"
 
-Token tokenize_operator(const std::string& input, size_t& pos, size_t& line, size_t& column, const std::string& filename) {
-    std::string value;
+// Casamento do operador mais longo por switch no primeiro caractere, olhando
+// no máximo dois caracteres adiante.
+Token tokenize_operator(std::string_view input, size_t& pos, size_t& line, size_t& column, FileId file) {
     size_t start_column = column;
     size_t start_position = pos;
 
-    if (pos + 3 <= input.size()) {
-        std::string candidate = input.substr(pos, 3);
-        if (candidate == "...") {
-            value = candidate;
-            pos += 3;
-            column += 3;
-            return Token(TokenType::ELIPSIS, value, line, start_column, column, start_position, pos, filename);
-        } else if (candidate == "..=") {
-            value = candidate;
-            pos += 3;
-            column += 3;
-            return Token(TokenType::INCLUSIVE_RANGE, value, line, start_column, column, start_position, pos, filename);
-        } else if (candidate == "**=") {
-            value = candidate;
-            pos += 3;
-            column += 3;
-            return Token(TokenType::POWER_ASSIGN, value, line, start_column, column, start_position, pos, filename);
-        } else if (candidate == "//=") {
-            value = candidate;
-            pos += 3;
-            column += 3;
-            return Token(TokenType::INTEGER_DIV_ASSIGN, value, line, start_column, column, start_position, pos, filename);
-        }
-    }
+    auto at = [&](size_t offset) -> char {
+        return pos + offset < input.size() ? input[pos + offset] : '\0';
+    };
+    const char c = input[pos];
+    const char n1 = at(1);
+    const char n2 = at(2);
 
-    if (pos + 2 <= input.size()) {
-        std::string candidate = input.substr(pos, 2);
-        if (candidate == "==") {
-            value = candidate;
-            pos += 2;
-            column += 2;
-            return Token(TokenType::EQUALS, value, line, start_column, column, start_position, pos, filename);
-        } else if (candidate == "**") {
-            value = candidate;
-            pos += 2;
-            column += 2;
-            return Token(TokenType::POWER, value, line, start_column, column, start_position, pos, filename);
-        } else if (candidate == "&&") {
-            value = candidate;
-            pos += 2;
-            column += 2;
-            return Token(TokenType::AND, value, line, start_column, column, start_position, pos, filename);
-        } else if (candidate == "++") {
-            value = candidate;
-            pos += 2;
-            column += 2;
-            return Token(TokenType::INCREMENT, value, line, start_column, column, start_position, pos, filename);
-        } else if (candidate == "--") {
-            value = candidate;
-            pos += 2;
-            column += 2;
-            return Token(TokenType::DECREMENT, value, line, start_column, column, start_position, pos, filename);
-        } else if (candidate == "//") {
-            value = candidate;
-            pos += 2;
-            column += 2;
-            return Token(TokenType::INTEGER_DIV, value, line, start_column, column, start_position, pos, filename);
-        } else if (candidate == "||") {
-            value = candidate;
-            pos += 2;
-            column += 2;
-            return Token(TokenType::OR, value, line, start_column, column, start_position, pos, filename);
-        } else if (candidate == "!=") {
-            value = candidate;
-            pos += 2;
-            column += 2;
-            return Token(TokenType::DIFFERENT, value, line, start_column, column, start_position, pos, filename);
-        } else if (candidate == "<=") {
-            value = candidate;
-            pos += 2;
-            column += 2;
-            return Token(TokenType::LESS_THAN_EQUALS, value, line, start_column, column, start_position, pos, filename);
-        } else if (candidate == ">=") {
-            value = candidate;
-            pos += 2;
-            column += 2;
-            return Token(TokenType::GREATER_THAN_EQUALS, value, line, start_column, column, start_position, pos, filename);
-        } else if (candidate == "=>") {
-            value = candidate;
-            pos += 2;
-            column += 2;
-            return Token(TokenType::ARROW, value, line, start_column, column, start_position, pos, filename);
-        } else if (candidate == "..") {
-            value = candidate;
-            pos += 2;
-            column += 2;
-            return Token(TokenType::RANGE, value, line, start_column, column, start_position, pos, filename);
-        } else if (candidate == "+=") {
-            value = candidate;
-            pos += 2;
-            column += 2;
-            return Token(TokenType::PLUS_ASSIGN, value, line, start_column, column, start_position, pos, filename);
-        } else if (candidate == "-=") {
-            value = candidate;
-            pos += 2;
-            column += 2;
-            return Token(TokenType::MINUS_ASSIGN, value, line, start_column, column, start_position, pos, filename);
-        } else if (candidate == "*=") {
-            value = candidate;
-            pos += 2;
-            column += 2;
-            return Token(TokenType::MUL_ASSIGN, value, line, start_column, column, start_position, pos, filename);
-        } else if (candidate == "/=") {
-            value = candidate;
-            pos += 2;
-            column += 2;
-            return Token(TokenType::DIV_ASSIGN, value, line, start_column, column, start_position, pos, filename);
-        } else if (candidate == "%=") {
-            value = candidate;
-            pos += 2;
-            column += 2;
-            return Token(TokenType::MOD_ASSIGN, value, line, start_column, column, start_position, pos, filename);
-        }
+    TokenType type;
+    size_t length = 1;
+    switch (c) {
+        case '.':
+            if (n1 == '.') {
+                if (n2 == '.') { type = TokenType::ELIPSIS; length = 3; }
+                else if (n2 == '=') { type = TokenType::INCLUSIVE_RANGE; length = 3; }
+                else { type = TokenType::RANGE; length = 2; }
+            } else {
+                type = TokenType::DOT;
+            }
+            break;
+        case '*':
+            if (n1 == '*') {
+                if (n2 == '=') { type = TokenType::POWER_ASSIGN; length = 3; }
+                else { type = TokenType::POWER; length = 2; }
+            } else if (n1 == '=') { type = TokenType::MUL_ASSIGN; length = 2; }
+            else type = TokenType::MUL;
+            break;
+        case '/':
+            if (n1 == '/') {
+                if (n2 == '=') { type = TokenType::INTEGER_DIV_ASSIGN; length = 3; }
+                else { type = TokenType::INTEGER_DIV; length = 2; }
+            } else if (n1 == '=') { type = TokenType::DIV_ASSIGN; length = 2; }
+            else type = TokenType::DIV;
+            break;
+        case '=':
+            if (n1 == '=') { type = TokenType::EQUALS; length = 2; }
+            else if (n1 == '>') { type = TokenType::ARROW; length = 2; }
+            else type = TokenType::ASSIGNMENT;
+            break;
+        case '+':
+            if (n1 == '+') { type = TokenType::INCREMENT; length = 2; }
+            else if (n1 == '=') { type = TokenType::PLUS_ASSIGN; length = 2; }
+            else type = TokenType::PLUS;
+            break;
+        case '-':
+            if (n1 == '-') { type = TokenType::DECREMENT; length = 2; }
+            else if (n1 == '=') { type = TokenType::MINUS_ASSIGN; length = 2; }
+            else type = TokenType::MINUS;
+            break;
+        case '%':
+            if (n1 == '=') { type = TokenType::MOD_ASSIGN; length = 2; }
+            else type = TokenType::MOD;
+            break;
+        case '!':
+            if (n1 == '=') { type = TokenType::DIFFERENT; length = 2; }
+            else type = TokenType::NOT;
+            break;
+        case '<':
+            if (n1 == '=') { type = TokenType::LESS_THAN_EQUALS; length = 2; }
+            else type = TokenType::LT;
+            break;
+        case '>':
+            if (n1 == '=') { type = TokenType::GREATER_THAN_EQUALS; length = 2; }
+            else type = TokenType::GT;
+            break;
+        case '&':
+            if (n1 != '&') throw std::runtime_error("Invalid operator at line " + std::to_string(line) + ", column " + std::to_string(start_column));
+            type = TokenType::AND;
+            length = 2;
+            break;
+        case '|':
+            if (n1 != '|') throw std::runtime_error("Invalid operator at line " + std::to_string(line) + ", column " + std::to_string(start_column));
+            type = TokenType::OR;
+            length = 2;
+            break;
+        case ',': type = TokenType::COMMA; break;
+        case ';': type = TokenType::SEMICOLON; break;
+        case ':': type = TokenType::COLON; break;
+        case '(': type = TokenType::OPAREN; break;
+        case ')': type = TokenType::CPAREN; break;
+        case '[': type = TokenType::OBRACKET; break;
+        case ']': type = TokenType::CBRACKET; break;
+        case '{': type = TokenType::OBRACE; break;
+        case '}': type = TokenType::CBRACE; break;
+        default:
+            throw std::runtime_error("Invalid operator at line " + std::to_string(line) + ", column " + std::to_string(start_column));
     }
 
-    char c = input[pos];
-    if (c == '=') {
-        value = std::string(1, c);
-        pos += 1;
-        column += 1;
-        return Token(TokenType::ASSIGNMENT, value, line, start_column, column, start_position, pos, filename);
-    } else if (c == '+') {
-        value = std::string(1, c);
-        pos += 1;
-        column += 1;
-        return Token(TokenType::PLUS, value, line, start_column, column, start_position, pos, filename);
-    } else if (c == '-') {
-        value = std::string(1, c);
-        pos += 1;
-        column += 1;
-        return Token(TokenType::MINUS, value, line, start_column, column, start_position, pos, filename);
-    } else if (c == '*') {
-        value = std::string(1, c);
-        pos += 1;
-        column += 1;
-        return Token(TokenType::MUL, value, line, start_column, column, start_position, pos, filename);
-    } else if (c == '/') {
-        value = std::string(1, c);
-        pos += 1;
-        column += 1;
-        return Token(TokenType::DIV, value, line, start_column, column, start_position, pos, filename);
-    } else if (c == '%') {
-        value = std::string(1, c);
-        pos += 1;
-        column += 1;
-        return Token(TokenType::MOD, value, line, start_column, column, start_position, pos, filename);
-    } else if (c == '!') {
-        value = std::string(1, c);
-        pos += 1;
-        column += 1;
-        return Token(TokenType::NOT, value, line, start_column, column, start_position, pos, filename);
-    } else if (c == '<') {
-        value = std::string(1, c);
-        pos += 1;
-        column += 1;
-        return Token(TokenType::LT, value, line, start_column, column, start_position, pos, filename);
-    } else if (c == '>') {
-        value = std::string(1, c);
-        pos += 1;
-        column += 1;
-        return Token(TokenType::GT, value, line, start_column, column, start_position, pos, filename);
-    } else if (c == '.') {
-        value = std::string(1, c);
-        pos += 1;
-        column += 1;
-        return Token(TokenType::DOT, value, line, start_column, column, start_position, pos, filename);
-    }else if (c == ',') {
-        value = std::string(1, c);
-        pos += 1;
-        column += 1;
-        return Token(TokenType::COMMA, value, line, start_column, column, start_position, pos, filename);
-    } else if (c == ';') {
-        value = std::string(1, c);
-        pos += 1;
-        column += 1;
-        return Token(TokenType::SEMICOLON, value, line, start_column, column, start_position, pos, filename);
-    } else if (c == '(') {
-        value = std::string(1, c);
-        pos += 1;
-        column += 1;
-        return Token(TokenType::OPAREN, value, line, start_column, column, start_position, pos, filename);
-    } else if (c == ')') {
-        value = std::string(1, c);
-        pos += 1;
-        column += 1;
-        return Token(TokenType::CPAREN, value, line, start_column, column, start_position, pos, filename);
-    } else if (c == '[') {
-        value = std::string(1, c);
-        pos += 1;
-        column += 1;
-        return Token(TokenType::OBRACKET, value, line, start_column, column, start_position, pos, filename);
-    } else if (c == ']') {
-        value = std::string(1, c);
-        pos += 1;
-        column += 1;
-        return Token(TokenType::CBRACKET, value, line, start_column, column, start_position, pos, filename);
-    } else if (c == '{') {
-        value = std::string(1, c);
-        pos += 1;
-        column += 1;
-        return Token(TokenType::OBRACE, value, line, start_column, column, start_position, pos, filename);
-    } else if (c == '}') {
-        value = std::string(1, c);
-        pos += 1;
-        column += 1;
-        return Token(TokenType::CBRACE, value, line, start_column, column, start_position, pos, filename);
-    } else if (c == ':') {
-        value = std::string(1, c);
-        pos += 1;
-        column += 1; //voltaste
-        return Token(TokenType::COLON, value, line, start_column, column, start_position, pos, filename);
-    } else {
-        throw std::runtime_error("Invalid operator at line " + std::to_string(line) + ", column " + std::to_string(start_column));
-    }
-}
\ No newline at end of file
+    pos += length;
+    column += length;
+    return Token(type, input.data() + start_position, length, line, start_column, column, start_position, pos, file);
+}
@@ -0,0 +1,151 @@
+#include "frontend/lexer/source_manager.hpp"
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+    // Chave de busca por nome: o mesmo arquivo pode chegar como caminho
+    // relativo (ModuleManager) ou canônico (imports no checker)
+    std::string name_key(const std::string& name) {
+        std::error_code ec;
+        auto canonical = std::filesystem::weakly_canonical(name, ec);
+        return ec ? name : canonical.string();
+    }
+
+    // Offsets do início de cada linha; blocos de 16 bytes comparados com '\n' de uma vez
+    void scan_line_starts(const char* data, size_t size, std::vector<size_t>& starts) {
+        starts.clear();
+        starts.push_back(0);
+        size_t pos = 0;
+#if defined(__SSE2__)
+        const __m128i newline = _mm_set1_epi8('\n');
+        for (; pos + 16 <= size; pos += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, newline)));
+            while (mask) {
+                starts.push_back(pos + static_cast<size_t>(__builtin_ctz(mask)) + 1);
+                mask &= mask - 1;
+            }
+        }
+#endif
+        for (; pos < size; ++pos) {
+            if (data[pos] == '\n') starts.push_back(pos + 1);
+        }
+        // Um '\n' final não abre uma linha nova (mesmo comportamento de getline)
+        if (starts.size() > 1 && starts.back() == size) starts.pop_back();
+    }
+}
+
+SourceManager& SourceManager::instance() {
+    static SourceManager manager;
+    return manager;
+}
+
+SourceManager::SourceFile::~SourceFile() {
+    if (mapping) munmap(mapping, size);
+}
+
+const std::vector<size_t>& SourceManager::SourceFile::lines() const {
+    std::call_once(lines_once, [this] { scan_line_starts(data, size, line_starts); });
+    return line_starts;
+}
+
+FileId SourceManager::register_file(std::unique_ptr<SourceFile> source) {
+    std::string key = name_key(source->name);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    files.push_back(std::move(source));
+    FileId id = static_cast<FileId>(files.size() - 1);
+    by_name[key] = id;
+    return id;
+}
+
+FileId SourceManager::add_buffer(std::string name, std::string contents) {
+    auto source = std::make_unique<SourceFile>();
+    source->name = std::move(name);
+    source->contents = std::move(contents);
+    source->data = source->contents.data();
+    source->size = source->contents.size();
+    return register_file(std::move(source));
+}
+
+FileId SourceManager::load_file(const std::string& path) {
+    if (auto id = find(path)) return *id;
+
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+
+    auto source = std::make_unique<SourceFile>();
+    source->name = path;
+    source->size = static_cast<size_t>(st.st_size);
+    if (source->size == 0) {
+        source->data = source->contents.data();
+    } else {
+        void* mapping = mmap(nullptr, source->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Failed to map file: " + path);
+        }
+        madvise(mapping, source->size, MADV_SEQUENTIAL);
+        source->mapping = mapping;
+        source->data = static_cast<const char*>(mapping);
+    }
+    close(fd);
+    return register_file(std::move(source));
+}
+
+std::optional<FileId> SourceManager::find(const std::string& name) const {
+    std::string key = name_key(name);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = by_name.find(key);
+    if (it == by_name.end()) return std::nullopt;
+    return it->second;
+}
+
+const SourceManager::SourceFile& SourceManager::file(FileId id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (id >= files.size()) {
+        throw std::out_of_range("Invalid source file id " + std::to_string(id));
+    }
+    return *files[id];
+}
+
+std::string_view SourceManager::buffer(FileId id) const {
+    const SourceFile& source = file(id);
+    return std::string_view(source.data, source.size);
+}
+
+const std::string& SourceManager::filename(FileId id) const {
+    return file(id).name;
+}
+
+std::string_view SourceManager::line(FileId id, size_t line) const {
+    const SourceFile& source = file(id);
+    const auto& starts = source.lines();
+    if (line == 0 || line > starts.size() || source.size == 0) return {};
+
+    size_t begin = starts[line - 1];
+    size_t end = line < starts.size() ? starts[line] - 1 : source.size;
+    if (end > begin && source.data[end - 1] == '\n') --end;
+    return std::string_view(source.data + begin, end - begin);
+}
+
+size_t SourceManager::line_count(FileId id) const {
+    const SourceFile& source = file(id);
+    return source.size == 0 ? 0 : source.lines().size();
+}
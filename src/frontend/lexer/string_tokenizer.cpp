@@ -1,7 +1,9 @@
 #include "frontend/lexer/string_tokenizer.hpp"
 #include <stdexcept>
 
-Token tokenize_string(const std::string& input, size_t& position, size_t line, size_t column, const std::string& filename) {
+// O token guarda só o trecho entre as aspas; os escapes são resolvidos em
+// Token::string_value(), quando o parser precisa do valor.
+Token tokenize_string(std::string_view input, size_t& position, size_t line, size_t column, FileId file) {
     size_t start_pos = position;
     size_t start_col = column;
     char quote = input[position]; // ' or "
@@ -10,12 +12,39 @@ Token tokenize_string(const std::string& input, size_t& position, size_t line, s
     ++position;
     ++column;
 
-    std::string value;
+    size_t body_start = position;
     bool escaped = false;
 
     while (position < input.size()) {
         char c = input[position];
 
+        if (escaped) {
+            escaped = false;
+        } else if (c == '\\') {
+            escaped = true;
+        } else if (c == quote) {
+            // End of string
+            size_t body_length = position - body_start;
+            ++position;
+            ++column;
+            return Token(TokenType::STRING, input.data() + body_start, body_length, line, start_col, column, start_pos, position, file);
+        } else if (c == '\n') {
+            throw std::runtime_error("Line break not allowed inside string literal");
+        }
+
+        ++position;
+        ++column;
+    }
+
+    throw std::runtime_error("String literal not closed");
+}
+
+std::string Token::string_value() const {
+    std::string value;
+    value.reserve(length);
+    bool escaped = false;
+
+    for (char c : lexeme()) {
         if (escaped) {
             switch (c) {
                 case 'n': value += '\n'; break;
@@ -29,20 +58,10 @@ Token tokenize_string(const std::string& input, size_t& position, size_t line, s
             escaped = false;
         } else if (c == '\\') {
             escaped = true;
-        } else if (c == quote) {
-            // End of string
-            ++position;
-            ++column;
-            return Token(TokenType::STRING, value, line, start_col, column, start_pos, position, filename);
-        } else if (c == '\n') {
-            throw std::runtime_error("Line break not allowed inside string literal");
         } else {
             value += c;
         }
-
-        ++position;
-        ++column;
     }
 
-    throw std::runtime_error("String literal not closed");
-}
\ No newline at end of file
+    return value;
+}
@@ -7,32 +7,23 @@
 #include "frontend/ast/statements/def_stmt_node.hpp"
 #include "frontend/ast/expressions/assignment_expr_node.hpp"
 #include "frontend/ast/expressions/identifier_node.hpp"
-#include <fstream>
 #include <stdexcept>
 #include <iostream>
 #include <regex>
 #include <filesystem>
 #include <functional>
-
-std::string ModuleManager::read_file(const std::string& file_path) {
-    std::ifstream file(file_path);
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open file: " + file_path);
-    }
-    std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-    file.close();
-    return source;
-}
+#include <algorithm>
 
 void ModuleManager::load_module(const std::string& module_name, const std::string& file_path, int config) {
     if (modules.find(module_name) != modules.end()) return;
 
-    std::string source = read_file(file_path);
+    // Um único mmap do arquivo, compartilhado por lexer, parser e checker
+    FileId file_id = SourceManager::instance().load_file(file_path);
     Module module;
-    module.source = source;
+    module.source = SourceManager::instance().buffer(file_id);
     module.directory = std::filesystem::path(file_path).parent_path().string();
 
-    Lexer lexer(source, file_path);
+    Lexer lexer(file_id);
     module.tokens = lexer.tokenize();
     module.dependencies = lexer.get_imported_modules();
     module.import_infos = lexer.get_import_infos();
@@ -63,7 +54,7 @@ void ModuleManager::resolve_dependencies(const std::string& module_name, const s
     for (const auto& import_info : module.import_infos) {
         std::string clean_dep = std::regex_replace(import_info.module_path, std::regex("\""), "");
         std::string dep_path = (std::filesystem::path(module.directory) / (clean_dep)).string();
-        if (!std::ifstream(dep_path).good()) {
+        if (!std::filesystem::exists(dep_path)) {
             throw std::runtime_error("Module " + import_info.module_path + " not found");
         }
         resolve_dependencies(clean_dep, dep_path, config);
@@ -82,7 +73,7 @@ void ModuleManager::resolve_dependencies(const std::string& module_name, const s
         if (!already_processed) {
             std::string clean_dep = std::regex_replace(dep, std::regex("\""), "");
             std::string dep_path = (std::filesystem::path(module.directory) / (clean_dep)).string();
-            if (!std::ifstream(dep_path).good()) {
+            if (!std::filesystem::exists(dep_path)) {
                 throw std::runtime_error("Module " + dep + " not found");
             }
             resolve_dependencies(clean_dep, dep_path, config);
@@ -175,10 +166,10 @@ std::unique_ptr<Node> ModuleManager::get_combined_ast(const std::string& main_mo
             Program* module_program = dynamic_cast<Program*>(module.ast.get());
             const auto& imported_from_this = imported_symbols[mod_name];
             
-            for (auto& stmt : module_program->get_statements()) {
+            for (auto& stmt : module_program->body) {
                 // Se for o módulo principal, incluir todos os statements
                 if (is_main) {
-                    combined_program->add_statement(std::unique_ptr<Stmt>(static_cast<Stmt*>(stmt->clone())));
+                    combined_program->add_statement(std::move(stmt));
                     continue;
                 }
                 
@@ -189,7 +180,7 @@ std::unique_ptr<Node> ModuleManager::get_combined_ast(const std::string& main_mo
                     if (decl->target && decl->target->kind == NodeType::Identifier) {
                         auto* id = static_cast<IdentifierNode*>(decl->target.get());
                         if (imported_from_this.find(id->symbol) != imported_from_this.end()) {
-                            combined_program->add_statement(std::unique_ptr<Stmt>(static_cast<Stmt*>(stmt->clone())));
+                            combined_program->add_statement(std::move(stmt));
                         }
                     }
                 } else if (stmt->kind == NodeType::AssignmentExpression) {
@@ -198,18 +189,23 @@ std::unique_ptr<Node> ModuleManager::get_combined_ast(const std::string& main_mo
                     if (assign->target && assign->target->kind == NodeType::Identifier) {
                         auto* id = static_cast<IdentifierNode*>(assign->target.get());
                         if (imported_from_this.find(id->symbol) != imported_from_this.end()) {
-                            combined_program->add_statement(std::unique_ptr<Stmt>(static_cast<Stmt*>(stmt->clone())));
+                            combined_program->add_statement(std::move(stmt));
                         }
                     }
                 } else if (stmt->kind == NodeType::DefStatement) {
                     // Incluir funções (defs) que foram importadas
                     auto* def = static_cast<DefStmtNode*>(stmt.get());
                     if (imported_from_this.find(def->name) != imported_from_this.end()) {
-                        combined_program->add_statement(std::unique_ptr<Stmt>(static_cast<Stmt*>(stmt->clone())));
+                        combined_program->add_statement(std::move(stmt));
                     }
                 }
                 // Não incluir outros tipos de statements (CallExpression, IfStatement, etc.)
             }
+
+            // Statements usados foram movidos para o programa combinado; o
+            // módulo fica só com o que não foi incluído
+            auto& body = module_program->body;
+            body.erase(std::remove(body.begin(), body.end(), nullptr), body.end());
         }
         
         processed.insert(mod_name);
@@ -47,7 +47,7 @@ std::unique_ptr<Node> parse_access_expr(Parser* parser, std::unique_ptr<Node> ex
             parser->current_token().type == TokenType::POWER_ASSIGN ||
             parser->current_token().type == TokenType::MOD_ASSIGN
         ) {
-            std::string assign = parser->consume_token().lexeme;
+            std::string assign(parser->consume_token().lexeme());
 
             auto value = parse_expr(parser);
 
@@ -107,7 +107,7 @@ std::unique_ptr<Node> parse_access_expr(Parser* parser, std::unique_ptr<Node> ex
             std::unique_ptr<PositionData> bpos = std::make_unique<PositionData>(bline, bcolumn[0], bcolumn[1], bposition[0], bposition[1]);
 
             while (parser->current_token().type == TokenType::POWER) {
-                std::string opToken = parser->consume_token().lexeme;
+                std::string opToken(parser->consume_token().lexeme());
                 auto right = parse_call_member_expr(parser, nullptr);
 
                 auto bin = std::make_unique<BinaryExprNode>(
@@ -135,7 +135,7 @@ std::unique_ptr<Node> parse_access_expr(Parser* parser, std::unique_ptr<Node> ex
                 parser->current_token().type == TokenType::MOD ||
                 parser->current_token().type == TokenType::INTEGER_DIV
             ) {
-                std::string opToken = parser->consume_token().lexeme;
+                std::string opToken(parser->consume_token().lexeme());
                 auto right = parse_power_expr(parser);
 
                 auto bin = std::make_unique<BinaryExprNode>(
@@ -161,7 +161,7 @@ std::unique_ptr<Node> parse_access_expr(Parser* parser, std::unique_ptr<Node> ex
                 parser->current_token().type == TokenType::PLUS ||
                 parser->current_token().type == TokenType::MINUS
             ) {
-                std::string opToken = parser->consume_token().lexeme;
+                std::string opToken(parser->consume_token().lexeme());
                 auto right = parse_multiplicative_expr(parser);
 
                 auto bin = std::make_unique<BinaryExprNode>(
@@ -190,7 +190,7 @@ std::unique_ptr<Node> parse_access_expr(Parser* parser, std::unique_ptr<Node> ex
                 parser->current_token().type == TokenType::LT ||
                 parser->current_token().type == TokenType::GT
             ) {
-                std::string opToken = parser->consume_token().lexeme;
+                std::string opToken(parser->consume_token().lexeme());
                 auto right = parse_logical_not_expr(parser);
 
                 auto bin = std::make_unique<BinaryExprNode>(
@@ -217,7 +217,7 @@ std::unique_ptr<Node> parse_access_expr(Parser* parser, std::unique_ptr<Node> ex
                 parser->current_token().type == TokenType::EQUALS ||
                 parser->current_token().type == TokenType::DIFFERENT
             ) {
-                std::string opToken = parser->consume_token().lexeme;
+                std::string opToken(parser->consume_token().lexeme());
                 auto right = parse_relational_expr(parser);
 
                 auto bin = std::make_unique<BinaryExprNode>(
@@ -244,7 +244,7 @@ std::unique_ptr<Node> parse_access_expr(Parser* parser, std::unique_ptr<Node> ex
                 parser->current_token().type == TokenType::AND ||
                 parser->current_token().type == TokenType::OR
             ) {
-                std::string opToken = parser->consume_token().lexeme;
+                std::string opToken(parser->consume_token().lexeme());
                 auto right = parse_equality_expr(parser);
 
                 auto bin = std::make_unique<BinaryExprNode>(
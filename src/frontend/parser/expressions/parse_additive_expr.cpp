@@ -13,7 +13,7 @@ std::unique_ptr<Node> parse_additive_expr(Parser* parser) {
         parser->current_token().type == TokenType::PLUS ||
         parser->current_token().type == TokenType::MINUS
     ) {
-        std::string opToken = parser->consume_token().lexeme;
+        std::string opToken(parser->consume_token().lexeme());
         auto right = parse_multiplicative_expr(parser);
         
         auto binaryNode = std::make_unique<BinaryExprNode>(
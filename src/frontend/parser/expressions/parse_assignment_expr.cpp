@@ -35,7 +35,7 @@ std::unique_ptr<Node> parse_assignment_expr(Parser* parser) {
         parser->current_token().type == TokenType::POWER_ASSIGN ||
         parser->current_token().type == TokenType::MOD_ASSIGN
     ) {
-        std::string assign = parser->consume_token().lexeme;
+        std::string assign(parser->consume_token().lexeme());
 
         std::unique_ptr<Node> value;
 
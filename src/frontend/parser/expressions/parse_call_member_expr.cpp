@@ -70,7 +70,7 @@ std::unique_ptr<Node> parse_call_member_expr(Parser* parser, std::unique_ptr<Nod
     std::unique_ptr<PositionData> pos = std::make_unique<PositionData>(line, column[0], column[1], position[0], position[1]);
 
     while (parser->current_token().type == TokenType::POWER) {
-        std::string opToken = parser->consume_token().lexeme;
+        std::string opToken(parser->consume_token().lexeme());
         auto right = parse_call_member_expr(parser, nullptr);
 
         auto binaryNode = std::make_unique<BinaryExprNode>(
@@ -100,7 +100,7 @@ std::unique_ptr<Node> parse_call_member_expr(Parser* parser, std::unique_ptr<Nod
         parser->current_token().type == TokenType::MOD ||
         parser->current_token().type == TokenType::INTEGER_DIV
     ) {
-        std::string opToken = parser->consume_token().lexeme;
+        std::string opToken(parser->consume_token().lexeme());
         auto right = parse_power_expr(parser);
 
         auto binaryNode = std::make_unique<BinaryExprNode>(
@@ -127,7 +127,7 @@ std::unique_ptr<Node> parse_call_member_expr(Parser* parser, std::unique_ptr<Nod
         parser->current_token().type == TokenType::PLUS ||
         parser->current_token().type == TokenType::MINUS
     ) {
-        std::string opToken = parser->consume_token().lexeme;
+        std::string opToken(parser->consume_token().lexeme());
         auto right = parse_multiplicative_expr(parser);
 
         auto binaryNode = std::make_unique<BinaryExprNode>(
@@ -157,7 +157,7 @@ std::unique_ptr<Node> parse_call_member_expr(Parser* parser, std::unique_ptr<Nod
         parser->current_token().type == TokenType::LT ||
         parser->current_token().type == TokenType::GT
     ) {
-        std::string opToken = parser->consume_token().lexeme;
+        std::string opToken(parser->consume_token().lexeme());
         auto right = parse_logical_not_expr(parser);
 
         auto binaryNode = std::make_unique<BinaryExprNode>(
@@ -185,7 +185,7 @@ std::unique_ptr<Node> parse_call_member_expr(Parser* parser, std::unique_ptr<Nod
         parser->current_token().type == TokenType::EQUALS ||
         parser->current_token().type == TokenType::DIFFERENT
     ) {
-        std::string opToken = parser->consume_token().lexeme;
+        std::string opToken(parser->consume_token().lexeme());
         auto right = parse_relational_expr(parser);
 
         auto binaryNode = std::make_unique<BinaryExprNode>(
@@ -213,7 +213,7 @@ std::unique_ptr<Node> parse_call_member_expr(Parser* parser, std::unique_ptr<Nod
         parser->current_token().type == TokenType::AND ||
         parser->current_token().type == TokenType::OR
     ) {
-        std::string opToken = parser->consume_token().lexeme;
+        std::string opToken(parser->consume_token().lexeme());
         auto right = parse_equality_expr(parser);
 
         auto binaryNode = std::make_unique<BinaryExprNode>(
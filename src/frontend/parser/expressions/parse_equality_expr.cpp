@@ -13,7 +13,7 @@ std::unique_ptr<Node> parse_equality_expr(Parser* parser) {
         parser->current_token().type == TokenType::EQUALS ||
         parser->current_token().type == TokenType::DIFFERENT
     ) {
-        std::string opToken = parser->consume_token().lexeme;
+        std::string opToken(parser->consume_token().lexeme());
         auto right = parse_relational_expr(parser);
         
         auto binaryNode = std::make_unique<BinaryExprNode>(
@@ -13,7 +13,7 @@ std::unique_ptr<Node> parse_logical_expr(Parser* parser) {
         parser->current_token().type == TokenType::AND ||
         parser->current_token().type == TokenType::OR
     ) {
-        std::string opToken = parser->consume_token().lexeme;
+        std::string opToken(parser->consume_token().lexeme());
         auto right = parse_equality_expr(parser);
         
         auto binaryNode = std::make_unique<BinaryExprNode>(
@@ -21,16 +21,15 @@ std::unique_ptr<Node> parse_member_expr(Parser* parser) {
         std::unique_ptr<PositionData> pos_property = std::make_unique<PositionData>(line_property, column_property[0], column_property[1], position_property[0], position_property[1]);
 
         // Only allow IDENTIFIER or integer NUMBER as a member property
-        Token current = parser->current_token();
+        const Token& current = parser->current_token();
         if (current.type == TokenType::IDENTIFIER) {
-            Token idTok = parser->consume_token();
-            auto idNode = std::make_unique<IdentifierNode>(idTok.lexeme);
+            const Token& idTok = parser->consume_token();
+            auto idNode = std::make_unique<IdentifierNode>(std::string(idTok.lexeme()));
             idNode->position = std::make_unique<PositionData>(line_property, column_property[0], column_property[1], position_property[0], position_property[1]);
             property = std::move(idNode);
         } else if (current.type == TokenType::NUMBER) {
-            Token numTok = parser->consume_token();
-            const std::string &lex = numTok.lexeme;
-            auto numNode = std::make_unique<NumericLiteralNode>(numTok.lexeme);
+            const Token& numTok = parser->consume_token();
+            auto numNode = std::make_unique<NumericLiteralNode>(std::string(numTok.lexeme()));
             numNode->position = std::make_unique<PositionData>(line_property, column_property[0], column_property[1], position_property[0], position_property[1]);
             property = std::move(numNode);
         } else {
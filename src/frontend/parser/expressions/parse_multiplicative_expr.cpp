@@ -15,7 +15,7 @@ std::unique_ptr<Node> parse_multiplicative_expr(Parser* parser) {
         parser->current_token().type == TokenType::MOD ||
         parser->current_token().type == TokenType::INTEGER_DIV
     ) {
-        std::string opToken = parser->consume_token().lexeme;
+        std::string opToken(parser->consume_token().lexeme());
         auto right = parse_power_expr(parser);
         
         auto binaryNode = std::make_unique<BinaryExprNode>(
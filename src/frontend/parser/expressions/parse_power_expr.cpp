@@ -10,7 +10,7 @@ std::unique_ptr<Node> parse_power_expr(Parser* parser) {
     auto left = parse_call_member_expr(parser, nullptr);
     
     while (parser->current_token().type == TokenType::POWER) {
-        std::string opToken = parser->consume_token().lexeme;
+        std::string opToken(parser->consume_token().lexeme());
         auto right = parse_call_member_expr(parser, nullptr); //ta ai?
         
         auto binaryNode = std::make_unique<BinaryExprNode>(
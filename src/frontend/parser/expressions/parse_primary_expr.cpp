@@ -18,22 +18,22 @@ std::unique_ptr<Node> parse_primary_expr(Parser* parser) {
     std::unique_ptr<Node> expr;
     switch (type) {
         case TokenType::NUMBER: {
-            Token numToken = parser->consume_token();
-            auto node = std::make_unique<NumericLiteralNode>(numToken.lexeme);
+            const Token& numToken = parser->consume_token();
+            auto node = std::make_unique<NumericLiteralNode>(std::string(numToken.lexeme()));
             node->position = std::move(pos);
             expr = std::move(node);
             break;
         }
         case TokenType::IDENTIFIER: {
-            Token idToken = parser->consume_token();
-            auto node = std::make_unique<IdentifierNode>(idToken.lexeme);
+            const Token& idToken = parser->consume_token();
+            auto node = std::make_unique<IdentifierNode>(std::string(idToken.lexeme()));
             node->position = std::move(pos);
             expr = std::move(node);
             break;
         }
         case TokenType::STRING: {
-            Token strToken = parser->consume_token();
-            const std::string& s = strToken.lexeme;
+            const Token& strToken = parser->consume_token();
+            const std::string s = strToken.string_value();
             size_t i = 0;
             std::vector<std::unique_ptr<Expr>> parts;
             std::string litbuf;
@@ -196,7 +196,7 @@ std::unique_ptr<Node> parse_primary_expr(Parser* parser) {
             expr = parse_boolean_literal(parser);
             break;
         default:
-            parser->error("Unexpected token in primary expression: '" + parser->current_token().lexeme + "'");
+            parser->error("Unexpected token in primary expression: '" + std::string(parser->current_token().lexeme()) + "'");
             return nullptr;
     }
     return expr;
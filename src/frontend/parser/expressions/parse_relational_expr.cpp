@@ -15,7 +15,7 @@ std::unique_ptr<Node> parse_relational_expr(Parser* parser) {
         parser->current_token().type == TokenType::LT ||
         parser->current_token().type == TokenType::GT
     ) {
-        std::string opToken = parser->consume_token().lexeme;
+        std::string opToken(parser->consume_token().lexeme());
         auto right = parse_logical_not_expr(parser);
         
         auto binaryNode = std::make_unique<BinaryExprNode>(
@@ -13,12 +13,12 @@ static std::string join(const std::vector<std::string>& v, const std::string& se
 std::string parse_type(Parser* parser) {
     std::string type_str;
 
-    Token curr = parser->current_token();
+    const Token& curr = parser->current_token();
 
     // 1. Pode começar com: IDENTIFIER, OBRACKET, ou OPAREN
     if (curr.type == TokenType::IDENTIFIER) {
-        Token base = parser->consume_token();
-        type_str = base.lexeme;
+        const Token& base = parser->consume_token();
+        type_str = std::string(base.lexeme());
 
         // 2. Generics: map<K,V>
         if (type_str == "map") {
@@ -38,32 +38,32 @@ std::string parse_type(Parser* parser) {
         else if (parser->current_token().type == TokenType::OBRACKET) {
             // Verificar se é array com tamanho: int[10]
             parser->consume_token(); // [
-            Token num = parser->consume_token();
+            const Token& num = parser->consume_token();
             if (num.type != TokenType::NUMBER) {
                 parser->error("Expected number > 0 in array size. Use 'vector' for dynamic lists.");
             }
-            int size = std::stoi(num.lexeme);
+            int size = std::stoi(std::string(num.lexeme()));
             if (size <= 0) {
                 parser->error("Array size must be greater than 0. Use 'vector' for dynamic lists.");
             }
             parser->expect(TokenType::CBRACKET, "Expected ']' after array size.");
-            type_str = type_str + "[" + num.lexeme + "]";
+            type_str = type_str + "[" + std::string(num.lexeme()) + "]";
         }
     }
     else if (curr.type == TokenType::OBRACKET) {
         // Array fixo: [3]int (sintaxe antiga, ainda suportada)
         parser->consume_token(); // [
-        Token num = parser->consume_token();
+        const Token& num = parser->consume_token();
         if (num.type != TokenType::NUMBER) {
             parser->error("Expected number > 0 in array size. Use 'vector' for dynamic lists.");
         }
-        int size = std::stoi(num.lexeme);
+        int size = std::stoi(std::string(num.lexeme()));
         if (size <= 0) {
             parser->error("Array size must be greater than 0. Use 'vector' for dynamic lists.");
         }
         parser->expect(TokenType::CBRACKET, "Expected ']' after array size.");
         std::string elem = parse_type(parser);
-        type_str = "[" + num.lexeme + "]" + elem;
+        type_str = "[" + std::string(num.lexeme()) + "]" + elem;
     }
     else if (curr.type == TokenType::OPAREN) {
         // Tuple: (int, str, int)
@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "frontend/lexer/lexer.hpp"
+#include "frontend/lexer/token.hpp"
+#include "frontend/parser/parser.hpp"
+
+// Microbenchmark do parser: gera um fonte sintético grande, tokeniza uma vez
+// e mede tokens/s e nós/s só da análise sintática.
+//
+// Uso: parser_bench [funções] [repetições]
+namespace {
+    std::string synthetic_source(size_t functions) {
+        std::string src;
+        src.reserve(functions * 320);
+        for (size_t i = 0; i < functions; ++i) {
+            std::string n = std::to_string(i);
+            src += "def f" + n + "(a: int, b: int): int {\n";
+            src += "    x = a * 2 + b - " + n + " / (a + 1);\n";
+            src += "    if x > 10 && a != b { x = x / 2; } elif x < 0 { x = 0 - x; } else { x = x % 7; }\n";
+            src += "    for k: 0..10 { x = x + k * b; }\n";
+            src += "    while x > 100 { x = x - 1; }\n";
+            src += "    v = [x, a, b, " + n + "];\n";
+            src += "    return g(x, v[0], \"s" + n + "\");\n";
+            src += "}\n";
+        }
+        return src;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t functions = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    int runs = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    // O fonte vai para disco e é carregado como no ModuleManager (mmap)
+    std::string source = synthetic_source(functions);
+    std::string filename = (std::filesystem::temp_directory_path() / "narval_parser_bench.nv").string();
+    std::ofstream(filename, std::ios::binary) << source;
+
+    Lexer lexer(SourceManager::instance().load_file(filename));
+    std::vector<Token> tokens = lexer.tokenize();
+    auto imports = lexer.get_import_infos();
+
+    double best = 0.0;
+    size_t nodes = 0;
+    for (int run = 0; run < runs; ++run) {
+        Parser parser;
+        auto start = std::chrono::steady_clock::now();
+        auto ast = parser.produce_ast(tokens, imports);
+        auto end = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+        if (run == 0 || seconds < best) best = seconds;
+        nodes = parser.get_node_count();
+    }
+
+    std::filesystem::remove(filename);
+
+    std::cout << "Fonte: " << source.size() / 1024 << " KiB, " << tokens.size() << " tokens, " << nodes << " nós\n";
+    std::cout << "Melhor de " << runs << ": " << best * 1000.0 << " ms\n";
+    std::cout << "Tokens/s: " << static_cast<size_t>(tokens.size() / best) << "\n";
+    std::cout << "Nós/s: " << static_cast<size_t>(nodes / best) << "\n";
+    return 0;
+}
@@ -2,13 +2,11 @@
 #include "frontend/parser/statements/parse_stmt.hpp"
 #include "frontend/ast/statements/import_stmt_node.hpp"
 #include <iostream>
-#include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <cmath>
 #include <filesystem>
 
-constexpr size_t MAX_LINE_LENGTH = 1024;
 constexpr const char* ANSI_BOLD = "\x1b[1m";
 constexpr const char* ANSI_RESET = "\x1b[0m";
 constexpr const char* ANSI_RED = "\x1b[31m";
@@ -45,28 +43,13 @@ namespace {
     }
 }
 
-void Parser::read_lines(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Error opening file: " + filename);
-    }
-
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.size() > MAX_LINE_LENGTH) {
-            throw std::runtime_error("Line exceeds maximum length");
-        }
-        lines.push_back(line);
-    }
-    line_count = lines.size();
-}
-
 void Parser::print_error_context(const Token& token) {
-    if (lines.empty() || token.line - 1 >= line_count) {
+    const SourceManager& sources = SourceManager::instance();
+    if (token.line == 0 || token.line > sources.line_count(token.file_id)) {
         return;
     }
 
-    std::string line_content = lines[token.line - 1];
+    std::string line_content(sources.line(token.file_id, token.line));
     std::replace(line_content.begin(), line_content.end(), '\n', ' ');
 
     std::cerr << " " << token.line << " |   " << line_content << "\n";
@@ -87,8 +70,8 @@ bool Parser::has_error() const {
 }
 
 void Parser::error(const std::string& message) {
-    Token token = current_token();
-    std::string abs_filename = to_absolute_path(token.filename);
+    const Token& token = current_token();
+    std::string abs_filename = to_absolute_path(token.filename());
     std::cerr << ANSI_BOLD
               << abs_filename << ":" << token.line << ":" << token.column_start << ": "
               << ANSI_RED << "ERROR" << ANSI_RESET << ANSI_BOLD << ": "
@@ -102,33 +85,37 @@ size_t Parser::get_token_count() const {
     return token_count;
 }
 
+size_t Parser::get_node_count() const {
+    return node_count;
+}
+
 bool Parser::not_eof() const {
     return index < token_count && tokens[index].type != TokenType::EOF_TOKEN;
 }
 
-Token Parser::current_token() const {
+const Token& Parser::current_token() const {
     if (index >= token_count) {
         throw std::out_of_range("Parser index out of bounds");
     }
     return tokens[index];
 }
 
-Token Parser::consume_token() {
+const Token& Parser::consume_token() {
     if (index >= token_count) {
         throw std::out_of_range("Parser index out of bounds");
     }
     return tokens[index++];
 }
 
-Token Parser::next_token() const {
+const Token& Parser::next_token() const {
     if (index + 1 >= token_count) {
         return current_token();
     }
     return tokens[index + 1];
 }
 
-Token Parser::expect(TokenType expected_type, const std::string& error_msg) {
-    Token prev = consume_token();
+const Token& Parser::expect(TokenType expected_type, const std::string& error_msg) {
+    const Token& prev = consume_token();
 
     if (prev.type == TokenType::EOF_TOKEN) {
         error(error_msg);
@@ -139,7 +126,7 @@ Token Parser::expect(TokenType expected_type, const std::string& error_msg) {
     if (prev.type != expected_type) {
         std::ostringstream oss;
         oss << "Expected token type " << get_token_name(expected_type)
-            << ", but got token: '" << prev.lexeme << "'.";
+            << ", but got token: '" << prev.lexeme() << "'.";
         --index;
         error(oss.str());
     }
@@ -148,31 +135,23 @@ Token Parser::expect(TokenType expected_type, const std::string& error_msg) {
 }
 
 std::unique_ptr<Node> Parser::produce_ast(const std::vector<Token>& tokens, const std::vector<ImportInfo>& imports) {
-    this->tokens = tokens;
+    this->tokens = tokens.data();
     this->import_infos = imports;
     token_count = tokens.size();
+    node_count = 0;
     index = 0;
     has_errors = false;
-    lines.clear();
-    line_count = 0;
     size_t import_index = 0;
 
-    if (!tokens.empty()) {
-        // Avoid attempting to read REPL or notebook virtual filenames
-        const std::string& fname = tokens[0].filename;
-        if (fname.rfind("repl_line_", 0) != 0 && fname.rfind("cell_", 0) != 0) {
-            try {
-                read_lines(fname);
-            } catch (const std::exception& e) {
-                std::cerr << "Warning: Could not read source file: " << e.what() << "\n";
-            }
-        }
-    }
+    // Todos os nós deste módulo saem de uma arena própria; os blocos vivem
+    // enquanto houver nós neles, então a arena pode morrer com a análise
+    AstArena arena;
+    AstArena::Scope arena_scope(arena);
 
     auto program = std::make_unique<Program>();
 
     while (not_eof()) {
-        Token current = current_token();
+        const Token& current = current_token();
         if (current.type == TokenType::IMPORT) {
             // Cria nó ImportStatement usando as informações do lexer
             if (import_index < import_infos.size()) {
@@ -191,22 +170,22 @@ std::unique_ptr<Node> Parser::produce_ast(const std::vector<Token>& tokens, cons
                 
                 // Procurar o token STRING correspondente ao module_path
                 // O token STRING vem antes do token IMPORT na lista de tokens
-                Token string_token = current;
+                const Token* string_token = &current;
                 // Procurar para trás pelo token STRING que corresponde ao module_path
                 for (int i = static_cast<int>(index) - 1; i >= 0; --i) {
                     if (tokens[i].type == TokenType::STRING && 
-                        tokens[i].lexeme == import_info.module_path &&
-                        tokens[i].filename == current.filename) {
-                        string_token = tokens[i];
+                        tokens[i].file_id == current.file_id &&
+                        tokens[i].string_value() == import_info.module_path) {
+                        string_token = &tokens[i];
                         break;
                     }
                 }
                 
-                auto import_stmt = std::make_unique<ImportStmtNode>(import_info.module_path, items, current.filename);
+                auto import_stmt = std::make_unique<ImportStmtNode>(import_info.module_path, items, current.filename());
                 // Usar a posição do token STRING (que contém o caminho do módulo)
                 import_stmt->position = std::make_unique<PositionData>(
-                    string_token.line, string_token.column_start, string_token.column_end,
-                    string_token.position_start, string_token.position_end
+                    string_token->line, string_token->column_start, string_token->column_end,
+                    string_token->position_start, string_token->position_end
                 );
                 program->add_statement(std::move(import_stmt));
                 import_index++;
@@ -225,5 +204,6 @@ std::unique_ptr<Node> Parser::produce_ast(const std::vector<Token>& tokens, cons
         }
     }
 
+    node_count = arena.node_count();
     return program;
 }
\ No newline at end of file
@@ -11,12 +11,12 @@ std::unique_ptr<Node> parse_def_stmt(Parser* parser) {
 
     parser->consume_token();
 
-    auto def_name = parser->expect(TokenType::IDENTIFIER, "Expected def identifier");
+    const auto& def_name = parser->expect(TokenType::IDENTIFIER, "Expected def identifier");
 
     parser->expect(TokenType::OPAREN, "Expected '(' .");
 
     auto def_node = std::make_unique<DefStmtNode>(
-        def_name.lexeme,
+        std::string(def_name.lexeme()),
         std::vector<ParamNode>{},
         "void",
         std::vector<std::unique_ptr<Stmt>>{}
@@ -28,12 +28,12 @@ std::unique_ptr<Node> parse_def_stmt(Parser* parser) {
         size_t position_param[2] = { parser->current_token().position_start, parser->current_token().position_end };
         std::unique_ptr<PositionData> pos_param = std::make_unique<PositionData>(line_param, column_param[0], column_param[1], position_param[0], position_param[1]);
 
-        auto arg_name_token = parser->expect(TokenType::IDENTIFIER, "Expected argument name.");
+        const auto& arg_name_token = parser->expect(TokenType::IDENTIFIER, "Expected argument name.");
         parser->expect(TokenType::COLON, "Expected ':'.");
         std::string arg_type = parse_type(parser);
 
         std::unordered_map<std::string, std::string> param;
-        param[arg_name_token.lexeme] = arg_type;
+        param[std::string(arg_name_token.lexeme())] = arg_type;
 
         ParamNode param_node(param);
         param_node.position = std::move(pos_param);
@@ -7,23 +7,23 @@
 static std::vector<std::unique_ptr<Expr>> parse_binding_list(Parser* parser) {
     std::vector<std::unique_ptr<Expr>> bindings;
 
-    auto first = parser->expect(TokenType::IDENTIFIER, "Expected identifier in for binding.");
+    const auto& first = parser->expect(TokenType::IDENTIFIER, "Expected identifier in for binding.");
     auto pos = std::make_unique<PositionData>(
         first.line,
         first.column_start, first.column_end,
         first.position_start, first.position_end
     );
-    bindings.push_back(std::make_unique<IdentifierNode>(first.lexeme));
+    bindings.push_back(std::make_unique<IdentifierNode>(std::string(first.lexeme())));
 
     while (parser->current_token().type == TokenType::COMMA) {
         parser->consume_token();
-        auto id = parser->expect(TokenType::IDENTIFIER, "Expected identifier after ','.");
+        const auto& id = parser->expect(TokenType::IDENTIFIER, "Expected identifier after ','.");
         auto id_pos = std::make_unique<PositionData>(
             id.line,
             id.column_start, id.column_end,
             id.position_start, id.position_end
         );
-        bindings.push_back(std::make_unique<IdentifierNode>(id.lexeme));
+        bindings.push_back(std::make_unique<IdentifierNode>(std::string(id.lexeme())));
     }
 
     return bindings;
@@ -58,8 +58,8 @@ std::unique_ptr<Node> parse_for_stmt(Parser* parser) {
         if (expr && expr->kind == NodeType::RangeExpression) {
             auto* r = static_cast<RangeExprNode*>(expr.get());
             range_inclusive = r->inclusive;
-            range_start = std::unique_ptr<Expr>(static_cast<Expr*>(r->start->clone()));
-            range_end = std::unique_ptr<Expr>(static_cast<Expr*>(r->end->clone()));
+            range_start = std::move(r->start);
+            range_end = std::move(r->end);
         } else {
             iterable = std::unique_ptr<Expr>(static_cast<Expr*>(expr.release()));
         }
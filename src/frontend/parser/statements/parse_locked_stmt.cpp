@@ -3,13 +3,13 @@
 #include "frontend/parser/expressions/parse_type.hpp"
 
 std::unique_ptr<Node> parse_locked_stmt(Parser* parser, bool lockd) {
-    auto nametoken = parser->expect(TokenType::IDENTIFIER, "Expected an identifier");
+    const auto& nametoken = parser->expect(TokenType::IDENTIFIER, "Expected an identifier");
     
     size_t line = nametoken.line;
     size_t pos[2] = { nametoken.position_start, nametoken.position_end };
     size_t col[2] = { nametoken.column_start, nametoken.column_end };
 
-    std::string namestring = nametoken.lexeme;
+    std::string namestring(nametoken.lexeme());
     auto name = std::make_unique<IdentifierNode>(namestring);
     std::string typ = "automatic";
     if (parser->current_token().type == TokenType::COLON) {
@@ -64,7 +64,7 @@ std::unique_ptr<Node> parse_match_stmt(Parser* parser) {
             parser->consume_token();
         }
     }
-    auto tok = parser->expect(TokenType::CBRACE, "Expected '}'.");
+    const auto& tok = parser->expect(TokenType::CBRACE, "Expected '}'.");
     pos->col[1] = tok.column_end;
     pos->pos[1] = tok.position_end;
     
@@ -28,7 +28,7 @@ extern "C" const char* nv_base_dir = nullptr; // visible to C runtime
 static std::string nv_base_dir_storage;
 
 // Função para executar modo batch (compilação normal)
-int run_batch_mode(const std::string& filename) {
+int run_batch_mode(const std::string& filename, bool explain_parallel) {
     std::string module_name = "main";
 
     // Initialize base dir from source file path (directory containing main.nv)
@@ -52,6 +52,7 @@ int run_batch_mode(const std::string& filename) {
         llvm::Module Mod("narval_module", Context);
         llvm::IRBuilder<llvm::NoFolder> Builder(Context);
         nv::IRGenerationContext context(Context, Mod, Builder, &checker);
+        context.set_auto_parallel(true);
 
         // === Debug info setup (same as main.cpp) ===
         llvm::DIBuilder DIB(Mod);
@@ -106,6 +107,14 @@ int run_batch_mode(const std::string& filename) {
         context.set_current_function(main_start);
 
         nv::generate_ir(std::move(ast), context);
+
+        if (explain_parallel) {
+            for (const auto& report : context.get_parallel_reports()) {
+                std::cerr << filename << ":" << report.line << ":" << report.column << ": "
+                          << (report.parallelized ? "loop paralelizado: " : "loop não paralelizado: ")
+                          << report.reason << "\n";
+            }
+        }
         
         // IMPORTANTE: Finalizar inicializações de globais DEPOIS de gerar o código principal
         // Isso garante que todas as declarações foram processadas
@@ -218,6 +227,11 @@ int run_batch_mode(const std::string& filename) {
             }
         }
 
+        // _exit não passa pelo teardown do stdio: esvaziar a saída buferizada do runtime
+        llvm::FunctionCallee flush_fn = Mod.getOrInsertFunction(
+            "nv_flush_all", llvm::FunctionType::get(llvm::Type::getVoidTy(Context), false));
+        context.get_builder().CreateCall(flush_fn);
+
         // declare _exit(int);
         auto* exit_ty = llvm::FunctionType::get(llvm::Type::getVoidTy(Context), {i32_ty}, false);
         llvm::FunctionCallee exit_fn = Mod.getOrInsertFunction("_exit", exit_ty);
@@ -565,6 +579,7 @@ int main(int argc, char* argv[]) {
     // Parse argumentos de linha de comando
     bool repl_mode = false;
     bool notebook_mode = false;
+    bool explain_parallel = false;
     std::string filename;
     
     for (int i = 1; i < argc; i++) {
@@ -574,11 +589,14 @@ int main(int argc, char* argv[]) {
             repl_mode = true;
         } else if (arg == "--notebook" || arg == "-n") {
             notebook_mode = true;
+        } else if (arg == "--explain-parallel") {
+            explain_parallel = true;
         } else if (arg == "--help" || arg == "-h") {
             std::cout << "Uso: narval [opções] [arquivo.nv]\n";
             std::cout << "\nOpções:\n";
             std::cout << "  --repl, -i, -r     Iniciar REPL interativo\n";
             std::cout << "  --notebook, -n     Iniciar modo Notebook\n";
+            std::cout << "  --explain-parallel Explicar quais loops foram paralelizados\n";
             std::cout << "  --help, -h          Mostrar esta ajuda\n";
             std::cout << "\nModos:\n";
             std::cout << "  Se nenhuma opção for fornecida e um arquivo for especificado,\n";
@@ -615,7 +633,7 @@ int main(int argc, char* argv[]) {
     } else if (notebook_mode) {
         return run_notebook_mode();
     } else if (!filename.empty()) {
-        return run_batch_mode(filename);
+        return run_batch_mode(filename, explain_parallel);
     } else {
         std::cerr << "Uso: narval [--repl|--notebook] [arquivo.nv]\n";
         std::cerr << "Use --help para mais informações.\n";